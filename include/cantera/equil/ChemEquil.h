@@ -28,12 +28,18 @@ class EquilOpt
 {
 public:
     EquilOpt() : relTolerance(1.e-8), absElemTol(1.0E-70),maxIterations(1000),
-        iterations(0),
+        maxWarmStartIterations(50), iterations(0),
         maxStepSize(10.0), propertyPair(TP), contin(false) {}
 
     doublereal relTolerance; ///< Relative tolerance
     doublereal absElemTol; ///< Abs Tol in element number
     int maxIterations; ///< Maximum number of iterations
+
+    //! Maximum number of iterations for a warm-started calculation. If the
+    //! warm-started calculation does not converge, the calculation is
+    //! restarted from scratch.
+    int maxWarmStartIterations;
+
     int iterations; ///< Iteration counter
 
     /**
@@ -52,10 +58,54 @@ public:
      * Continuation flag. Set true if the calculation should be initialized from
      * the last calculation. Otherwise, the calculation will be started from
      * scratch and the initial composition and element potentials estimated.
+     * @see EquilState
      */
     bool contin;
 };
 
+/**
+ * Solver state of the ChemEquil solver at the end of a successful calculation.
+ * For a sequence of calculations at nearby conditions, using this state as the
+ * starting point skips the initial estimates of the temperature, the
+ * composition, and the element potentials, and usually allows the Newton
+ * iteration to converge in a few steps.
+ */
+class EquilState
+{
+public:
+    EquilState() : temperature(0.0), nComponents(0), iterations(0),
+        warmStarted(false), valid(false) {}
+
+    //! Dimensionless element potentials, \f$ \lambda_m / RT \f$.
+    //! length = number of elements
+    vector_fp lambda_RT;
+
+    //! Temperature [K] of the converged solution
+    double temperature;
+
+    //! Number of components (rank of the element composition matrix)
+    size_t nComponents;
+
+    //! Element ordering, where the first #nComponents elements are the ones
+    //! whose abundances are constrained by the component species
+    std::vector<size_t> orderVectorElements;
+
+    //! Species ordering, where the first #nComponents species are the
+    //! component species
+    std::vector<size_t> orderVectorSpecies;
+
+    //! Number of Newton iterations taken by the calculation which produced
+    //! this state
+    int iterations;
+
+    //! True if the calculation which produced this state was initialized from
+    //! a previous solver state
+    bool warmStarted;
+
+    //! True if this object contains a converged solver state
+    bool valid;
+};
+
 /**
  * @defgroup equil Chemical Equilibrium
  */
@@ -131,6 +181,17 @@ public:
         return m_lambda;
     }
 
+    //! Solver state at the end of the last successful calculation
+    const EquilState& solverState() const {
+        return m_state;
+    }
+
+    //! Set the solver state used to initialize the next calculation when
+    //! `options.contin` is true.
+    void setSolverState(const EquilState& state) {
+        m_state = state;
+    }
+
     /**
      * Options controlling how the calculation is carried out.
      * @see EquilOptions
@@ -151,6 +212,16 @@ protected:
         return m_comp[k*m_mm + m];
     }
 
+    //! Equilibrate the phase, optionally starting from the solver state
+    //! #m_state instead of estimating the initial solution.
+    int solveEquil(thermo_t& s, const char* XY, vector_fp& elMolesGoal,
+                   bool useThermoPhaseElementPotentials, int loglevel,
+                   bool warmStart);
+
+    //! Check whether #m_state can be used as the initial solution for a
+    //! calculation with the element abundances *elMolesGoal*.
+    bool canWarmStart(const vector_fp& elMolesGoal) const;
+
     /*!
      * Prepare for equilibrium calculations.
      * @param s object representing the solution phase.
@@ -309,6 +380,9 @@ protected:
 
     std::vector<size_t> m_orderVectorElements;
     std::vector<size_t> m_orderVectorSpecies;
+
+    //! Solver state saved after the last successful calculation
+    EquilState m_state;
 };
 
 extern int ChemEquil_print_lvl;
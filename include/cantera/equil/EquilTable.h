@@ -0,0 +1,236 @@
+/**
+ * @file EquilTable.h
+ * Tabulated chemical equilibrium states on an enthalpy, pressure, and mixture
+ * fraction grid (see \ref equilfunctions and classes
+ * \link Cantera::EquilTable EquilTable\endlink and
+ * \link Cantera::EquilTableLookup EquilTableLookup\endlink).
+ */
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_EQUILTABLE_H
+#define CT_EQUILTABLE_H
+
+#include "cantera/thermo/ThermoPhase.h"
+
+namespace Cantera
+{
+
+//! A table of adiabatic equilibrium states on a grid of specific enthalpy,
+//! pressure, and mixture fraction.
+/*!
+ * Each grid point holds the equilibrium state obtained by mixing the fuel and
+ * oxidizer streams to the mixture fraction *Z* (on a mass basis), and then
+ * equilibrating the mixture at constant specific enthalpy *h* and pressure
+ * *p*. The tabulated variables are the temperature, the density, the mean
+ * molecular weight, the specific heat capacity, and the mass fractions of a
+ * selected set of species.
+ *
+ * The table is computed by build(), which divides the grid among several
+ * threads. Each thread works on its own copy of the phase, and each
+ * equilibrium calculation is initialized from the solution at the neighboring
+ * grid point (see EquilState). The table is stored in single precision, and
+ * can be written to and read from a compact binary file using save() and
+ * load(). Values at arbitrary points are obtained using class
+ * EquilTableLookup.
+ *
+ * Example:
+ *
+ * @code
+ * EquilTable table;
+ * table.setGrid(h, p, Z);
+ * table.setStreams(Yfuel, Yoxidizer);
+ * table.build(gas, {"CO2", "H2O", "CO", "OH"}, 4);
+ * table.save("equil.bin");
+ *
+ * EquilTableLookup lookup(table);
+ * double T = lookup.value(lookup.table().variableIndex("T"), h0, p0, Z0);
+ * @endcode
+ *
+ * @ingroup equilfunctions
+ */
+class EquilTable
+{
+public:
+    EquilTable();
+
+    //! Set the grid of the table.
+    /*!
+     * @param h  Specific enthalpies [J/kg], in increasing order
+     * @param p  Pressures [Pa], in increasing order
+     * @param Z  Mixture fractions, in increasing order, between 0 and 1
+     */
+    void setGrid(const vector_fp& h, const vector_fp& p, const vector_fp& Z);
+
+    //! Set the compositions of the fuel (*Z* = 1) and oxidizer (*Z* = 0)
+    //! streams, as mass fraction vectors of length nSpecies().
+    void setStreams(const vector_fp& Yfuel, const vector_fp& Yoxidizer);
+
+    //! Compute the equilibrium states at all grid points.
+    /*!
+     * The phase *phase* is not modified. Each thread uses a separate copy of
+     * the phase created from its XML definition, so the phase must have been
+     * created from an input file.
+     *
+     * Grid points where the equilibrium calculation fails are filled with
+     * NaN, and counted by nFailed(). These points are not used by
+     * EquilTableLookup.
+     *
+     * @param phase     Phase used to compute the equilibrium states
+     * @param species   Names of the species whose mass fractions are stored.
+     *                  If empty, all species are stored.
+     * @param nThreads  Number of threads to use. If 0, the number of hardware
+     *                  threads is used.
+     */
+    void build(ThermoPhase& phase, const std::vector<std::string>& species,
+               size_t nThreads=0);
+
+    //! Write the table to the binary file *filename*. The file uses the
+    //! native byte order, and load() refuses to read it on a machine with a
+    //! different byte order.
+    void save(const std::string& filename) const;
+
+    //! Read a table previously written by save() from the file *filename*
+    void load(const std::string& filename);
+
+    //! Grid of specific enthalpies [J/kg]
+    const vector_fp& enthalpies() const {
+        return m_h;
+    }
+
+    //! Grid of pressures [Pa]
+    const vector_fp& pressures() const {
+        return m_p;
+    }
+
+    //! Grid of mixture fractions
+    const vector_fp& mixtureFractions() const {
+        return m_Z;
+    }
+
+    //! Total number of grid points
+    size_t nPoints() const {
+        return m_h.size() * m_p.size() * m_Z.size();
+    }
+
+    //! Number of variables stored at each grid point
+    size_t nVariables() const {
+        return m_names.size();
+    }
+
+    //! Name of variable *i*. The first variables are "T", "density",
+    //! "mean_molecular_weight", and "cp_mass", followed by the names of the
+    //! species whose mass fractions are stored.
+    const std::string& variableName(size_t i) const {
+        return m_names.at(i);
+    }
+
+    //! Index of the variable named *name*, or npos if it is not in the table
+    size_t variableIndex(const std::string& name) const;
+
+    //! Flat index of the grid point (*ih*, *ip*, *iz*)
+    size_t pointIndex(size_t ih, size_t ip, size_t iz) const {
+        return (iz * m_p.size() + ip) * m_h.size() + ih;
+    }
+
+    //! Values of all variables at grid point *j*, where *j* is computed by
+    //! pointIndex(). length = nVariables()
+    const float* point(size_t j) const {
+        return &m_data[j * m_names.size()];
+    }
+
+    //! Number of grid points where the equilibrium calculation failed during
+    //! the last call to build()
+    size_t nFailed() const {
+        return m_nFailed;
+    }
+
+    //! Total number of Newton iterations taken by the element potential
+    //! solver during the last call to build()
+    long int nIterations() const {
+        return m_nIterations;
+    }
+
+protected:
+    //! Compute the equilibrium states along the enthalpy grid for each
+    //! (pressure, mixture fraction) line from *lineStart* to *lineEnd*.
+    void buildLines(ThermoPhase& phase, size_t lineStart, size_t lineEnd,
+                    const std::vector<size_t>& species, size_t& nFailed,
+                    long int& nIterations);
+
+    vector_fp m_h; //!< specific enthalpy grid [J/kg]
+    vector_fp m_p; //!< pressure grid [Pa]
+    vector_fp m_Z; //!< mixture fraction grid
+    vector_fp m_Yfuel; //!< fuel stream mass fractions
+    vector_fp m_Yox; //!< oxidizer stream mass fractions
+
+    //! Names of the stored variables
+    std::vector<std::string> m_names;
+
+    //! Values of the stored variables. The value of variable *v* at grid point
+    //! *j* is `m_data[j * nVariables() + v]`.
+    std::vector<float> m_data;
+
+    size_t m_nFailed;
+    long int m_nIterations;
+};
+
+//! Multilinear interpolation in an EquilTable
+/*!
+ * The interpolation is linear in each of the specific enthalpy, pressure, and
+ * mixture fraction. Points outside the grid are clipped to the grid
+ * boundaries. Corners of the grid cell where the equilibrium calculation
+ * failed are skipped, and the weights of the remaining corners are
+ * renormalized. If the calculation failed at all corners with nonzero
+ * weights, a CanteraError is thrown. The referenced table must outlive this
+ * object.
+ *
+ * @ingroup equilfunctions
+ */
+class EquilTableLookup
+{
+public:
+    explicit EquilTableLookup(const EquilTable& table);
+
+    //! Interpolate all variables at the given state.
+    /*!
+     * @param h       Specific enthalpy [J/kg]
+     * @param p       Pressure [Pa]
+     * @param Z       Mixture fraction
+     * @param values  Output array of interpolated values.
+     *                length = EquilTable::nVariables()
+     */
+    void lookup(double h, double p, double Z, double* values) const;
+
+    //! Interpolate variable *i* at the given state.
+    double value(size_t i, double h, double p, double Z) const;
+
+    //! Interpolated temperature [K] at the given state
+    double temperature(double h, double p, double Z) const {
+        return value(0, h, p, Z);
+    }
+
+    //! The table used for the interpolation
+    const EquilTable& table() const {
+        return m_table;
+    }
+
+protected:
+    //! Find the interval of *grid* containing *x* and the interpolation weight
+    //! of the upper end of that interval. For a grid with a single point, the
+    //! index is 0 and the weight is 0.
+    static void locate(const vector_fp& grid, double x, size_t& i, double& w);
+
+    //! Compute the flat indices and weights of the corners of the grid cell
+    //! containing the given state. Corners where the equilibrium calculation
+    //! failed have zero weight.
+    void corners(double h, double p, double Z, size_t* index,
+                 double* weight) const;
+
+    const EquilTable& m_table;
+};
+
+}
+
+#endif
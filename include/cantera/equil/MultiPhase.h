@@ -16,6 +16,8 @@
 namespace Cantera
 {
 
+class vcs_MultiPhaseEquil;
+
 //! @defgroup equilfunctions
 
 //! A class for multiphase mixtures. The mixture can contain any
@@ -66,7 +68,7 @@ public:
 
     //! Destructor. Does nothing. Class MultiPhase does not take "ownership"
     //! (i.e. responsibility for destroying) the phase objects.
-    virtual ~MultiPhase() {}
+    virtual ~MultiPhase();
 
     //! Add a vector of phases to the mixture
     /*!
@@ -363,6 +365,16 @@ public:
                      double rtol=1e-9, int max_steps=50000, int max_iter=100,
                      int estimate_equil=0, int log_level=0);
 
+    //! The VCS equilibrium solver used by equilibrate()
+    /*!
+     * The solver is created the first time it is needed, and then reused for
+     * all subsequent calls to equilibrate(), with only the state of the
+     * mixture reloaded for each call. The solver's counters (iterations,
+     * basis optimizations, and species deletions) accumulate over all of
+     * these calls. The solver is discarded if a calculation fails.
+     */
+    vcs_MultiPhaseEquil& vcsSolver();
+
     /// Set the temperature [K].
     /*!
      * @param T   value of the temperature (Kelvin)
@@ -630,6 +642,9 @@ private:
     //! True if the init() routine has been called, and the MultiPhase frozen
     bool m_init;
 
+    //! Persistent VCS solver, created by vcsSolver()
+    std::unique_ptr<vcs_MultiPhaseEquil> m_vcsSolver;
+
     //! Global ID of the element corresponding to the electronic charge. If
     //! there is none, then this is equal to -1
     size_t m_eloc;
@@ -53,11 +53,49 @@ public:
 
     virtual ~vcs_MultiPhaseEquil() {}
 
-    //! return the number of iterations
+    //! return the number of iterations taken by the last call to the solver
     int iterations() const {
         return m_iter;
     }
 
+    //! Reload the state of the MultiPhase object into the solver
+    /*!
+     * The species mole numbers, phase electric potentials, and element
+     * abundances of the mixture are transferred to the solver, while all of
+     * the work space allocated by the solver is kept. This is used to reuse
+     * the same solver object for a sequence of equilibrium calculations on
+     * the same MultiPhase object with different compositions. The
+     * temperature and pressure are always taken from the mixture at the start
+     * of each calculation.
+     */
+    void reload();
+
+    //! Total number of iterations of the main loop of the solver
+    int totalIterations() const {
+        return m_vsolve.m_VCount->T_Its;
+    }
+
+    //! Total number of optimizations of the component basis
+    int totalBasisOptimizations() const {
+        return m_vsolve.m_VCount->T_Basis_Opts;
+    }
+
+    //! Total number of species deleted from the problem because their mole
+    //! numbers became negligible
+    int totalSpeciesDeletions() const {
+        return m_vsolve.m_VCount->T_Species_Deletions;
+    }
+
+    //! Total number of calls to the constant T and P solver
+    int totalCalls() const {
+        return m_vsolve.m_VCount->T_Calls_vcs_TP;
+    }
+
+    //! Reset all of the counters to zero
+    void resetCounters() {
+        m_vsolve.vcs_counters_init(1);
+    }
+
     //! Equilibrate the solution using the current element abundances
     //! stored in the MultiPhase object
     /*!
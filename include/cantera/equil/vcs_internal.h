@@ -49,6 +49,13 @@ public:
     //! number of optimizations of the components basis set done
     int Basis_Opts;
 
+    //! Total number of species deleted from the problem
+    int T_Species_Deletions;
+
+    //! Number of species deleted from the problem in the current call to
+    //! vcs_solve_TP()
+    int Species_Deletions;
+
     //! Current number of times the initial thermo equilibrium estimator has
     //! been called
     int T_Calls_Inest;
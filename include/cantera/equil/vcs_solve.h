@@ -25,6 +25,7 @@
 #include "cantera/equil/vcs_defs.h"
 #include "cantera/equil/vcs_internal.h"
 #include "cantera/base/Array.h"
+#include "cantera/numerics/DenseMatrix.h"
 
 namespace Cantera
 {
@@ -742,6 +743,31 @@ public:
     //! Fully specify the problem to be solved
     void vcs_prob_specifyFully();
 
+    //! Reload the problem state from the MultiPhase object
+    /*!
+     * Transfers the species mole numbers, the phase electric potentials, and
+     * the element abundance goals from the MultiPhase object into the current
+     * (possibly reordered) species and element ordering of the solver. All
+     * other data, including the allocated work arrays, is kept, so that the
+     * same object can be used to equilibrate a sequence of compositions.
+     */
+    void vcs_prob_reload();
+
+    //! Calculate the element abundance goals from the current species mole
+    //! numbers, m_molNumSpecies_old[]
+    void vcs_elemAbundancesGoal_calc();
+
+    //! Initialize the internal counters
+    /*!
+     * Initialize the internal counters containing the subroutine call
+     * values and times spent in the subroutines.
+     *
+     *  ifunc = 0     Initialize only those counters appropriate for the top of
+     *                vcs_solve_TP().
+     *        = 1     Initialize all counters.
+     */
+    void vcs_counters_init(int ifunc);
+
 private:
     //! Zero out the concentration of a species.
     /*!
@@ -926,17 +952,6 @@ private:
      */
     void vcs_delete_memory();
 
-    //! Initialize the internal counters
-    /*!
-     * Initialize the internal counters containing the subroutine call
-     * values and times spent in the subroutines.
-     *
-     *  ifunc = 0     Initialize only those counters appropriate for the top of
-     *                vcs_solve_TP().
-     *        = 1     Initialize all counters.
-     */
-    void vcs_counters_init(int ifunc);
-
     //! Create a report on the plog file containing timing and its information
     /*!
      * @param timing_print_lvl If 0, just report the iteration count. If larger
@@ -979,6 +994,9 @@ private:
     vector_fp m_aw;
     vector_fp m_wx;
 
+    //! Work matrix used by vcs_basopt() to calculate the reaction matrix
+    DenseMatrix m_basisMatrix;
+
 public:
     //! Print level for print routines
     int m_printLvl;
@@ -12,8 +12,11 @@
 #include "Kinetics.h"
 #include "Reaction.h"
 #include "cantera/base/utilities.h"
+#include "cantera/base/Array.h"
 #include "RateCoeffMgr.h"
 
+#include <cstdint>
+
 namespace Cantera
 {
 
@@ -265,6 +268,32 @@ public:
     void solvePseudoSteadyStateProblem(int ifuncOverride = -1,
                                        doublereal timeScaleOverride = 1.0);
 
+    //! Get the derivatives of the species net production rates with respect
+    //! to the concentrations of the species in the surface phase
+    /*!
+     * The derivatives are evaluated analytically from the mass action rate
+     * expressions, including the coverage dependence of the SurfaceArrhenius
+     * rate constants and the Motz-Wise correction for sticking reactions. The
+     * concentrations of the species in all other phases are held constant.
+     * Modifications of the rates of progress made for phases which do not
+     * exist (see setPhaseExistence()) are not taken into account. Charge
+     * transfer reactions are not supported (see hasChargeTransferReactions()),
+     * since their rates depend on the electric potentials and may be given
+     * in Butler-Volmer form.
+     *
+     * @param dwdot  Output matrix, resized to have nTotalSpecies() rows and
+     *     one column for each species in the surface phase. dwdot(k,j) is the
+     *     derivative of the net production rate of kinetics species k with
+     *     respect to the concentration of surface species j. Units = 1/s.
+     */
+    void getNetProductionRatesSurfaceJacobian(Array2D& dwdot);
+
+    //! True if any reaction is a charge transfer reaction with rate
+    //! parameters given by an ElectrochemicalReaction
+    bool hasChargeTransferReactions() const {
+        return m_has_electrochem_rxns;
+    }
+
     void setIOFlag(int ioFlag);
 
     //! Update the standard state chemical potentials and species equilibrium
@@ -634,21 +663,38 @@ protected:
      */
     vector_int m_phaseIsStable;
 
-    //! Vector of vector of booleans indicating whether a phase participates in
-    //! a reaction as a reactant
+    //! Bitmasks indicating which phases participate in each reaction as
+    //! reactants
     /*!
-     *  m_rxnPhaseIsReactant[j][p] indicates whether a species in phase p
+     *  Bit p of m_rxnPhaseIsReactant[j] is set if a species in phase p
      *  participates in reaction j as a reactant.
      */
-    std::vector<std::vector<bool> > m_rxnPhaseIsReactant;
+    std::vector<uint64_t> m_rxnPhaseIsReactant;
 
-    //! Vector of vector of booleans indicating whether a phase participates in a
-    //! reaction as a product
+    //! Bitmasks indicating which phases participate in each reaction as
+    //! products
     /*!
-     *  m_rxnPhaseIsReactant[j][p] indicates whether a species in phase p
+     *  Bit p of m_rxnPhaseIsProduct[j] is set if a species in phase p
      *  participates in reaction j as a product.
      */
-    std::vector<std::vector<bool> > m_rxnPhaseIsProduct;
+    std::vector<uint64_t> m_rxnPhaseIsProduct;
+
+    //! Bitmask of the phases which don't exist. Bit p is set if
+    //! m_phaseExists[p] is false.
+    uint64_t m_phaseMissingMask;
+
+    //! Bitmask of the phases which are not stable. Bit p is set if
+    //! m_phaseIsStable[p] is false.
+    uint64_t m_phaseUnstableMask;
+
+    //! Indices of the reactions which involve a phase which doesn't exist or
+    //! is not stable. Only these reactions have their rates of progress
+    //! modified by updateROP() when #m_phaseExistsCheck is set.
+    std::vector<size_t> m_phaseCheckRxns;
+
+    //! Update #m_phaseCheckRxns after a change in the existence or stability
+    //! of a phase or the addition of a reaction
+    void updatePhaseCheckReactions();
 
     //! Values used for converting sticking coefficients into rate constants
     struct StickData {
@@ -663,6 +709,42 @@ protected:
 
     void applyStickingCorrection(double T, double* kf);
 
+    //! Parameters of a coverage dependency of a forward rate constant, used
+    //! for evaluating derivatives with respect to the surface concentrations
+    struct CoverageDependence {
+        size_t k; //!< index of the species within the surface phase
+        double a; //!< coverage dependence of the log10 of the pre-exponential
+        double m; //!< exponent applied to the coverage
+        double E; //!< coverage dependence of the activation energy [K]
+    };
+
+    //! Coverage dependencies of each reaction. Length = number of reactions
+    std::vector<std::vector<CoverageDependence> > m_rxnCoverageDeps;
+
+    //! Reaction orders of the forward direction of each reaction, given as
+    //! (kinetics species index, order) pairs. Length = number of reactions
+    std::vector<std::vector<std::pair<size_t, double> > > m_rxnFwdOrders;
+
+    //! Reaction orders of the reverse direction of each reaction, given as
+    //! (kinetics species index, order) pairs. Empty for irreversible
+    //! reactions. Length = number of reactions
+    std::vector<std::vector<std::pair<size_t, double> > > m_rxnRevOrders;
+
+    //! Net stoichiometric coefficients (products minus reactants) of each
+    //! reaction, given as (kinetics species index, coefficient) pairs.
+    //! Length = number of reactions
+    std::vector<std::vector<std::pair<size_t, double> > > m_rxnNetStoich;
+
+    //! Derivatives of the natural logarithm of the forward rate constant of
+    //! one reaction with respect to the surface species concentrations,
+    //! given as (surface species index, derivative) pairs
+    std::vector<std::pair<size_t, double> > m_dlnkf_work;
+
+    //! Derivatives of the net rate of progress of one reaction with respect
+    //! to the surface species concentrations, given as (surface species
+    //! index, derivative) pairs
+    std::vector<std::pair<size_t, double> > m_dropnet_work;
+
     int m_ioFlag;
 
     //! Number of dimensions of reacting phase (2 for InterfaceKinetics, 1 for
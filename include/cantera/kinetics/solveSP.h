@@ -288,6 +288,10 @@ private:
 
     //! Main routine that calculates the current residual and Jacobian
     /*!
+     *  The Jacobian is evaluated from the analytic derivatives of the net
+     *  production rates when possible (see #m_analyticJac), and by finite
+     *  differences otherwise.
+     *
      *  @param jac     Jacobian to be evaluated.
      *  @param resid   output Vector of residuals, length = m_neq
      *  @param CSolnSP  Vector of species concentrations, unknowns in the
@@ -454,6 +458,21 @@ private:
     //! -> also maxed wrt the total # of solution species
     size_t m_maxTotSpecies;
 
+    //! True if the Jacobian can be obtained from the analytic derivatives of
+    //! the net production rates provided by the InterfaceKinetics objects.
+    /*!
+     * This is false if bulk phases are included in the problem, if an
+     * InterfaceKinetics object includes the surface phase of another
+     * InterfaceKinetics object, or if any InterfaceKinetics object has charge
+     * transfer reactions. In these cases, the Jacobian is evaluated by
+     * perturbing each of the unknowns.
+     */
+    bool m_analyticJac;
+
+    //! Derivatives of the net production rates of one InterfaceKinetics
+    //! object with respect to the concentrations of its surface species
+    Array2D m_dwdot;
+
     //! Temporary vector with length equal to max m_maxTotSpecies
     vector_fp m_netProductionRatesSave;
 
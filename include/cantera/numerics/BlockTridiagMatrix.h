@@ -0,0 +1,217 @@
+/**
+ *  @file BlockTridiagMatrix.h
+ *   Declarations for the class BlockTridiagMatrix, used for block-tridiagonal
+ *   linear systems such as the Jacobians of one-dimensional problems
+ *   (see class \ref numerics and
+ *   \link Cantera::BlockTridiagMatrix BlockTridiagMatrix\endlink).
+ */
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_BLOCKTRIDIAGMATRIX_H
+#define CT_BLOCKTRIDIAGMATRIX_H
+
+#include "cantera/base/ct_defs.h"
+
+namespace Cantera
+{
+
+//! A class for block-tridiagonal matrices.
+/*!
+ * The matrix is partitioned into square diagonal blocks *D_k* of arbitrary
+ * (possibly zero) sizes *n_k*. Only the diagonal blocks and the blocks
+ * directly below (*L_k*, coupling block *k* to block *k-1*) and above (*U_k*,
+ * coupling block *k* to block *k+1*) the diagonal are stored, each as a dense
+ * column-major array. This is the structure of the Jacobian of a problem
+ * discretized on a one-dimensional grid using three-point stencils, where
+ * each block holds the variables at one grid point. Compared to storing the
+ * same matrix in banded form, no space is used for the zeros outside of the
+ * off-diagonal blocks.
+ *
+ * Linear systems are solved using the block Thomas algorithm. The forward
+ * sweep computes the LU factorization of the Schur complements
+ * \f$ D'_k = D_k - L_k D'^{-1}_{k-1} U_{k-1} \f$ using partial pivoting
+ * within each block, and stores \f$ G_k = D'^{-1}_k U_k \f$. If one of the
+ * Schur complements is singular, which happens when a variable only appears
+ * in the equations of a neighboring block (for example, the pressure
+ * eigenvalue at the first point of a counterflow flame), the block is merged
+ * with the following blocks until the Schur complement of the merged block
+ * can be factored. The factorization of a merged block allows pivoting
+ * across the original blocks, and costs about as much as the factorization
+ * of a band matrix over the same rows. Operations involving elements of the
+ * off-diagonal blocks which are zero are skipped, which takes advantage of
+ * the sparsity of the blocks of typical Jacobians. Like BandMatrix, the
+ * original matrix is kept along with its factorization.
+ *
+ * If the matrix is created as *diagonal-only*, the off-diagonal blocks are
+ * neither stored nor used, and the matrix is block-diagonal. This is useful
+ * for cheap approximations of a block-tridiagonal matrix, such as
+ * preconditioners. Since the off-diagonal blocks are not available, singular
+ * diagonal blocks can not be merged in this case.
+ *
+ * @ingroup numerics
+ */
+class BlockTridiagMatrix
+{
+public:
+    //! Create an empty matrix
+    BlockTridiagMatrix();
+
+    //! Create a matrix with diagonal blocks of the given sizes, and set all
+    //! elements to zero. If *diagonalOnly* is true, the off-diagonal blocks
+    //! are not stored.
+    explicit BlockTridiagMatrix(const std::vector<size_t>& blockSizes,
+                                bool diagonalOnly=false);
+
+    //! Resize the matrix to have diagonal blocks of the given sizes. All data
+    //! is lost. If *diagonalOnly* is true, the off-diagonal blocks are not
+    //! stored.
+    void resize(const std::vector<size_t>& blockSizes,
+                bool diagonalOnly=false);
+
+    //! Set all elements to zero
+    void zero();
+
+    //! Return a changeable reference to element (i,j).
+    /*!
+     * Since this method may alter the element value, the matrix will be
+     * refactored before the next solve. For elements outside of the stored
+     * blocks, a reference to a dummy value is returned, and values assigned
+     * to it are discarded.
+     */
+    doublereal& value(size_t i, size_t j);
+
+    //! Return the value of element (i,j)
+    doublereal value(size_t i, size_t j) const;
+
+    doublereal& operator()(size_t i, size_t j) {
+        return value(i, j);
+    }
+
+    doublereal operator()(size_t i, size_t j) const {
+        return value(i, j);
+    }
+
+    //! Number of rows (and columns)
+    size_t nRows() const {
+        return m_n;
+    }
+
+    //! Number of diagonal blocks
+    size_t nBlocks() const {
+        return m_size.size();
+    }
+
+    //! Size of diagonal block *k*
+    size_t blockSize(size_t k) const {
+        return m_size[k];
+    }
+
+    //! Index of the first row of diagonal block *k*
+    size_t blockStart(size_t k) const {
+        return m_start[k];
+    }
+
+    //! True if only the diagonal blocks are stored
+    bool diagonalOnly() const {
+        return m_diagonalOnly;
+    }
+
+    //! Number of matrix elements stored, not including the factorization
+    size_t nStored() const {
+        return m_diag.size() + m_lower.size() + m_upper.size();
+    }
+
+    //! Multiply A*b and write result to *prod*.
+    void mult(const doublereal* b, doublereal* prod) const;
+
+    //! Perform an LU decomposition of the matrix using the block Thomas
+    //! algorithm. Throws a CanteraError if the matrix is singular; info()
+    //! then gives the row where a zero pivot was first found.
+    int factor();
+
+    //! Number of diagonal blocks of the last factorization, after merging
+    //! blocks whose Schur complements were singular
+    size_t nFactorBlocks() const {
+        return m_groups.size() - 1;
+    }
+
+    //! True if the factorization is up to date with the matrix
+    bool factored() const {
+        return m_factored;
+    }
+
+    //! Solve the matrix problem Ax = b
+    /*!
+     * @param b    INPUT right hand side
+     * @param x    OUTPUT solution vector. May be the same as *b*.
+     */
+    int solve(const doublereal* const b, doublereal* const x);
+
+    //! Solve the matrix problem Ax = b in place
+    /*!
+     * @param b    INPUT right hand side. OUTPUT solution vector
+     */
+    int solve(doublereal* b);
+
+    //! Status flag after the last factorization. If nonzero, the value is
+    //! one plus the index of the row where a zero pivot was found.
+    int info() const {
+        return m_info;
+    }
+
+protected:
+    //! Sizes of the diagonal blocks
+    std::vector<size_t> m_size;
+
+    //! Index of the first row of each diagonal block. length = nBlocks() + 1
+    std::vector<size_t> m_start;
+
+    //! Index of the diagonal block containing each row
+    std::vector<size_t> m_block;
+
+    //! Locations of the diagonal blocks in #m_diag
+    std::vector<size_t> m_diagLoc;
+
+    //! Locations of the blocks below the diagonal in #m_lower
+    std::vector<size_t> m_lowerLoc;
+
+    //! Locations of the blocks above the diagonal in #m_upper
+    std::vector<size_t> m_upperLoc;
+
+    //! Index of the first block of each diagonal block of the factorization,
+    //! which may consist of several merged blocks. length =
+    //! nFactorBlocks() + 1
+    std::vector<size_t> m_groups;
+
+    //! Locations of the diagonal blocks of the factorization in #m_lu
+    std::vector<size_t> m_luLoc;
+
+    //! Locations of the diagonal blocks of the factorization in #m_gain
+    std::vector<size_t> m_gainLoc;
+
+    vector_fp m_diag; //!< Diagonal blocks *D_k*
+    vector_fp m_lower; //!< Blocks below the diagonal, *L_k*, for k >= 1
+    vector_fp m_upper; //!< Blocks above the diagonal, *U_k*, for k < nBlocks-1
+    vector_fp m_lu; //!< LU factorizations of the Schur complements *D'_k*
+    vector_fp m_gain; //!< The blocks \f$ G_k = D'^{-1}_k U_k \f$
+
+    //! Pivots of the LU factorizations, local to each diagonal block of the
+    //! factorization
+    std::vector<size_t> m_ipiv;
+
+    //! Work array holding the nonzero elements of one column of an
+    //! off-diagonal block
+    std::vector<std::pair<size_t, double>> m_nonzeros;
+
+    size_t m_n; //!< Number of rows
+    bool m_diagonalOnly; //!< True if the off-diagonal blocks are not stored
+    bool m_factored; //!< True if #m_lu and #m_gain are current
+    int m_info; //!< Status of the last factorization
+    doublereal m_zero; //!< Value returned for elements outside the blocks
+};
+
+}
+
+#endif
@@ -153,6 +153,9 @@ public:
     friend int solve(DenseMatrix& A, double* b, size_t nrhs, size_t ldb);
     friend int solve(DenseMatrix& A, DenseMatrix& b);
     friend int invert(DenseMatrix& A, int nn);
+    friend int factor(DenseMatrix& A);
+    friend int solveFactored(DenseMatrix& A, double* b, size_t nrhs,
+                             size_t ldb);
 };
 
 
@@ -184,6 +187,29 @@ int solve(DenseMatrix& A, double* b, size_t nrhs=1, size_t ldb=0);
  */
 int solve(DenseMatrix& A, DenseMatrix& b);
 
+//! Compute the LU factorization of the square matrix A, in place.
+/*!
+ * A is overwritten with its factors, and the pivots are stored in
+ * A.ipiv(). The factorization can then be used for any number of solves
+ * with solveFactored(). Uses the LAPACK routine dgetrf.
+ *
+ * @param A  Dense matrix to be factored
+ * @returns zero on success. A positive return value indicates that the
+ *     matrix is singular, if A.m_useReturnErrorCode is set; otherwise, an
+ *     exception is thrown.
+ */
+int factor(DenseMatrix& A);
+
+//! Solve Ax = b, where A has been factored by factor(). Array b is
+//! overwritten on exit with x. Uses the LAPACK routine dgetrs.
+/*!
+ * @param A    Dense matrix factored by factor()
+ * @param b    RHS(s) to be solved.
+ * @param nrhs Number of right hand sides to solve
+ * @param ldb  Leading dimension of b, if nrhs > 1
+ */
+int solveFactored(DenseMatrix& A, double* b, size_t nrhs=1, size_t ldb=0);
+
 //! Multiply \c A*b and return the result in \c prod. Uses BLAS routine DGEMV.
 /*!
  * \f[
@@ -0,0 +1,292 @@
+//! @file Continuation1D.h
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_CONTINUATION1D_H
+#define CT_CONTINUATION1D_H
+
+#include "Sim1D.h"
+#include <functional>
+
+namespace Cantera
+{
+
+class Inlet1D;
+class StFlow;
+
+/**
+ * Continuation of the steady-state solution of a Sim1D with respect to a
+ * scalar parameter, such as the mass flow rate or the composition of an
+ * inlet, the pressure, or the width of the domain.
+ *
+ * Starting from a converged solution \f$ x_0 \f$ at the parameter value
+ * \f$ p_0 \f$, each step predicts the solution at the next parameter value
+ * from the tangent to the solution branch, which is found by solving
+ * \f[ J \frac{dx}{dp} = -\frac{\partial F}{\partial p} \f]
+ * with the steady-state Jacobian \f$ J \f$ which was last factored. The
+ * derivative of the residual with respect to the parameter is computed by a
+ * finite difference. The prediction is then corrected with damped Newton
+ * iterations which keep using this Jacobian, which is only re-evaluated if
+ * the iterations converge slowly. If the corrector fails with a new
+ * Jacobian, the step size is reduced.
+ *
+ * Two methods are available:
+ *
+ * - With natural-parameter continuation, the parameter is set to the next
+ *   value and the corrector solves for \f$ x \f$ with the parameter fixed.
+ *   This fails at turning points, where \f$ J \f$ is singular and the branch
+ *   does not continue in the same direction of the parameter.
+ * - With pseudo-arclength continuation (see setArcLength()), the parameter
+ *   is an unknown of the corrector, and the step size is measured along the
+ *   tangent of the branch. The corrector solves the bordered system
+ *   \f[ F(x, p) = 0, \quad \tau_x \cdot (x - x_0) + \tau_p (p - p_0)
+ *       = \Delta s \f]
+ *   using two solves with \f$ J \f$ per iteration. This allows the branch to
+ *   be followed around turning points, such as the extinction point of a
+ *   strained flame. In the inner product, each solution component is scaled
+ *   by its largest magnitude in the current solution, so that \f$ \Delta s
+ *   \f$ has the units of the parameter.
+ *
+ * The Jacobian used for the tangent and the corrector is the one held by the
+ * Sim1D, which is therefore modified by the continuation.
+ * @ingroup onedim
+ */
+class Continuation1D
+{
+public:
+    /**
+     * @param sim  The simulation, which must contain a converged steady-state
+     *     solution for the parameter value *p0*.
+     * @param setParameter  Function which applies a value of the parameter to
+     *     the domains of *sim*. Functions for common parameters are provided
+     *     by massFlowRate(), compositionBlend(), pressure(), and
+     *     domainWidth().
+     * @param p0  Current value of the parameter, which is applied to the
+     *     domains using *setParameter*.
+     */
+    Continuation1D(Sim1D& sim, std::function<void(double)> setParameter,
+                   double p0);
+
+    //! Use pseudo-arclength continuation instead of natural-parameter
+    //! continuation
+    void setArcLength(bool arclength) {
+        m_arclength = arclength;
+    }
+
+    //! True if pseudo-arclength continuation is used
+    bool arcLength() const {
+        return m_arclength;
+    }
+
+    //! Set the step size.
+    /*!
+     * @param ds  Initial step size. The sign determines whether the
+     *     parameter initially increases or decreases.
+     * @param dsMin  Smallest step size. If the corrector fails at this step
+     *     size, step() returns an error.
+     * @param dsMax  Largest step size. The step size is increased after steps
+     *     where the corrector converges quickly.
+     */
+    void setStepSize(double ds, double dsMin=1e-8,
+                     double dsMax=BigNumber);
+
+    //! Signed size of the next step
+    double stepSize() const {
+        return m_direction * m_ds;
+    }
+
+    //! Set the maximum number of Newton iterations of the corrector in each
+    //! step
+    void setMaxIterations(size_t n) {
+        m_maxIter = n;
+    }
+
+    //! Refine the grid after each step. If the grid changes, the solution is
+    //! converged on the new grid with Sim1D::solve() before the next step.
+    void setRefineGrid(bool refine) {
+        m_refine = refine;
+    }
+
+    //! Take a single continuation step.
+    /*!
+     * On success, the Sim1D contains the converged solution for the new value
+     * of the parameter. On failure, the solution and parameter of the last
+     * successful step are restored.
+     * @return  0 on success, or -1 if the corrector failed at the smallest
+     *     step size
+     */
+    int step(int loglevel=0);
+
+    //! Take continuation steps until the parameter reaches or crosses *pEnd*.
+    /*!
+     * With natural-parameter continuation, the last step is shortened so that
+     * the parameter ends exactly at *pEnd*. With pseudo-arclength
+     * continuation, the last step is the first one which crosses *pEnd*. The
+     * steps also stop if step() fails.
+     * @param pEnd  Final value of the parameter
+     * @param maxSteps  Maximum number of steps
+     * @param loglevel  Level of diagnostic output
+     * @return  The number of successful steps
+     */
+    size_t advance(double pEnd, size_t maxSteps=1000, int loglevel=0);
+
+    //! Current value of the parameter
+    double parameter() const {
+        return m_p;
+    }
+
+    //! Derivative of the parameter with respect to the arc length along the
+    //! branch at the current solution. A change of sign between steps
+    //! indicates that a turning point has been passed.
+    double parameterSlope() const {
+        return m_tangent_p;
+    }
+
+    //! Number of turning points passed by pseudo-arclength continuation
+    size_t nTurningPoints() const {
+        return m_nTurning;
+    }
+
+    //! Number of successful steps
+    size_t nSteps() const {
+        return m_nSteps;
+    }
+
+    //! Number of steps which failed and were retried with a smaller step size
+    size_t nFailedSteps() const {
+        return m_nFailed;
+    }
+
+    //! Total number of Newton iterations of the corrector
+    size_t nIterations() const {
+        return m_nIter;
+    }
+
+    //! Number of Jacobian evaluations by the continuation
+    size_t nJacobianEvals() const {
+        return m_nJacEvals;
+    }
+
+    //! Sensitivities of the value of the parameter at a turning point of the
+    //! branch, such as the extinction strain rate, to the rate multipliers of
+    //! all reactions.
+    /*!
+     * At a turning point \f$ p^* \f$, the steady-state Jacobian is singular
+     * with a left null vector \f$ \phi \f$, and
+     * \f[ \frac{dp^*}{d\ln k_i} = -\frac{\phi^T \partial F / \partial \ln k_i}
+     *     {\phi^T \partial F / \partial p} \f]
+     * The null vector is approximated by inverse iteration with \f$ J^T \f$
+     * at the current solution, which must therefore be close to the turning
+     * point, for example the last solution before parameterSlope() changes
+     * sign when advancing with a small step size. All iterations use a single
+     * factorization, see Sim1D::solveAdjoint().
+     * @param nIter  Number of inverse iterations
+     * @returns  \f$ dp^* / d\ln k_i \f$ for each reaction
+     */
+    vector_fp turningPointSensitivities(size_t nIter=3);
+
+    //! @name Common continuation parameters
+    //! Each function returns a function which applies the parameter value to
+    //! the given domains.
+    //! @{
+
+    //! The mass flux [kg/m^2/s] of *inlet*
+    static std::function<void(double)> massFlowRate(Inlet1D& inlet);
+
+    //! The mole fractions of *inlet* interpolated linearly between *X0*, for
+    //! a parameter value of 0, and *X1*, for a parameter value of 1. This can
+    //! be used, for example, to vary the equivalence ratio.
+    static std::function<void(double)> compositionBlend(Inlet1D& inlet,
+        const vector_fp& X0, const vector_fp& X1);
+
+    //! The pressure [Pa] of *flow*
+    static std::function<void(double)> pressure(StFlow& flow);
+
+    //! The width [m] of *flow*. The grid is stretched about its left end,
+    //! and the solution at each grid point is retained.
+    static std::function<void(double)> domainWidth(StFlow& flow);
+    //! @}
+
+protected:
+    //! Evaluate the steady-state Jacobian at the current solution
+    void evalJacobian();
+
+    //! Solve J*x = b in place with the Jacobian held by the Sim1D
+    void solveJacobian(double* b);
+
+    //! Compute the derivative of the steady-state residual with respect to
+    //! the parameter at the current solution and store it in #m_fp. The
+    //! residual is left in #m_f.
+    void evalParameterDerivative();
+
+    //! Compute the tangent to the solution branch at the current solution,
+    //! using the current Jacobian
+    void computeTangent();
+
+    //! Compute the scale factors of the solution components used in the
+    //! inner product of the arclength constraint
+    void computeScales();
+
+    //! Compute the Newton step of the corrector at *x*, which must be the
+    //! solution held by the Sim1D.
+    //! @param x  Current iterate
+    //! @param[out] dx  Step of the solution
+    //! @param[out] dp  Step of the parameter
+    //! @return  The weighted norm of the step
+    double newtonStep(const double* x, double* dx, double& dp);
+
+    //! Damped Newton iterations of the corrector, starting from the predicted
+    //! solution in the Sim1D and the predicted parameter value #m_p. If no
+    //! damping coefficient reduces the norm of the step, the Jacobian is
+    //! re-evaluated at the current iterate.
+    //! @return  The number of iterations, or -1 if they did not converge
+    int correct(int loglevel);
+
+    //! Set the parameter to *p* in the domains and in #m_p
+    void applyParameter(double p);
+
+    Sim1D& m_sim;
+    std::function<void(double)> m_setParameter;
+
+    double m_p; //!< Current parameter value
+    double m_pscale; //!< Scale of the parameter
+    double m_ds; //!< Magnitude of the next step
+    double m_dsMin; //!< Smallest step size
+    double m_dsMax; //!< Largest step size
+    double m_direction; //!< +1 or -1; direction of the parameter or branch
+    bool m_arclength; //!< True if pseudo-arclength continuation is used
+    bool m_refine; //!< True if the grid is refined after each step
+    size_t m_maxIter; //!< Maximum corrector iterations per step
+
+    //! True if the Jacobian held by the Sim1D may be used for the current
+    //! grid and was evaluated by this object
+    bool m_jacValid;
+
+    vector_fp m_x0; //!< Solution at the start of the step
+    double m_p0; //!< Parameter at the start of the step
+    vector_fp m_tangent; //!< dx/ds (or dx/dp) at the start of the step
+    double m_tangent_p; //!< dp/ds at the start of the step
+    vector_fp m_scale; //!< scale of each solution component
+    vector_fp m_weight; //!< weights of the arclength constraint
+    double m_weight_p; //!< weight of the parameter in the constraint
+
+    //! @name Work arrays
+    //! @{
+    vector_fp m_f; //!< residual
+    vector_fp m_fp; //!< derivative of the residual w.r.t. the parameter
+    vector_fp m_dx; //!< Newton step
+    vector_fp m_dx1; //!< Newton step after a damped step
+    vector_fp m_b; //!< solution of J*b = -F_p
+    //! @}
+
+    size_t m_nSteps;
+    size_t m_nFailed;
+    size_t m_nIter;
+    size_t m_nJacEvals;
+    size_t m_nTurning;
+};
+
+}
+
+#endif
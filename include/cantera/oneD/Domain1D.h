@@ -10,6 +10,7 @@
 #include "cantera/base/ctexceptions.h"
 #include "cantera/base/global.h"
 #include "refine.h"
+#include "Profile1D.h"
 
 namespace Cantera
 {
@@ -478,6 +479,12 @@ public:
         m_force_full_update = update;
     }
 
+    //! Timers and counters for the work done by this domain on the current
+    //! grid. See OneDim::enableProfiling().
+    Profile1D& profiler() {
+        return m_profiler;
+    }
+
 protected:
     doublereal m_rdt;
     size_t m_nv;
@@ -510,6 +517,9 @@ protected:
     std::vector<std::string> m_name;
     int m_bw;
     bool m_force_full_update;
+
+    //! Timers and counters for the current grid
+    Profile1D m_profiler;
 };
 }
 
@@ -0,0 +1,247 @@
+//! @file FlameSweep.h
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_FLAMESWEEP_H
+#define CT_FLAMESWEEP_H
+
+#include "Sim1D.h"
+#include "Inlet1D.h"
+#include "StFlow.h"
+#include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/kinetics/Kinetics.h"
+#include "cantera/transport/TransportBase.h"
+#include <functional>
+#include <mutex>
+
+namespace Cantera
+{
+
+/**
+ * Solve many independent one-dimensional flame problems which differ in a set
+ * of parameters, such as the equivalence ratio, temperature, and pressure for
+ * a table of laminar flame speeds, or the strain rate for a library of
+ * counterflow flamelets.
+ *
+ * The cases are solved concurrently by several threads. Each thread owns a
+ * flame (see FlameSweep::Flame), with its own copies of the phase, kinetics
+ * manager, and transport manager, which are created from the XML definition
+ * of the phase passed to the constructor, so the mechanism is not parsed
+ * again for each thread.
+ *
+ * Each case is started from the solution of the converged case whose
+ * parameters are closest to its own, where each parameter is scaled by its
+ * range over all cases. The grid of that solution is used, and its profiles
+ * are interpolated onto the grid after the parameters of the new case have
+ * been applied. Cases should therefore be added in an order where successive
+ * cases are close to each other, for example by looping over each parameter
+ * in turn. If no case has converged yet, or if the solution fails to converge
+ * from the neighboring solution, the case is started from the initial guess.
+ *
+ * The converged solutions are kept in a single store, which can be written to
+ * one XML file by save(). Each case is saved as a separate solution, which
+ * can be read back using Sim1D::restore().
+ *
+ * Example:
+ *
+ * @code
+ * FlameSweep sweep(gas, "Mix", "free");
+ * // The parameters are the equivalence ratio and the pressure
+ * sweep.setParameterFunction([](FlameSweep::Flame& f, const vector_fp& p) {
+ *     f.inlet->setMoleFractions("CH4:" + std::to_string(p[0]) +
+ *                               ", O2:2, N2:7.52");
+ *     f.inlet->setTemperature(300.0);
+ *     f.flow->setPressure(p[1]);
+ * });
+ * for (double P : {OneAtm, 2 * OneAtm}) {
+ *     for (double phi : {0.8, 0.9, 1.0, 1.1}) {
+ *         sweep.addCase({phi, P});
+ *     }
+ * }
+ * sweep.run(4);
+ * double Su = sweep.result(0).flameSpeed;
+ * sweep.save("flamespeeds.xml");
+ * @endcode
+ *
+ * @ingroup onedim
+ */
+class FlameSweep
+{
+public:
+    //! The domains and the objects providing properties for one flame
+    //! problem. Each thread owns one Flame.
+    struct Flame {
+        std::unique_ptr<IdealGasPhase> gas;
+        std::unique_ptr<Kinetics> kinetics;
+        std::unique_ptr<Transport> transport;
+        //! The inlet at the left boundary. For a counterflow flame, this is
+        //! the fuel inlet.
+        std::unique_ptr<Inlet1D> inlet;
+        //! The flow domain, which is either a FreeFlame or an AxiStagnFlow
+        std::unique_ptr<StFlow> flow;
+        //! The outlet of a free flame, or the oxidizer inlet of a counterflow
+        //! flame
+        std::unique_ptr<Bdry1D> right;
+        std::unique_ptr<Sim1D> sim;
+    };
+
+    //! The solution of one case
+    struct Result {
+        vector_fp parameters; //!< parameters of the case
+        bool converged; //!< True if a solution was found
+        //! True if the case was started from the solution of another case
+        bool seeded;
+        vector_fp grid; //!< grid of the flow domain [m]
+        //! Solution of the flow domain. Component *n* at grid point *j* is
+        //! at index `j * nComponents + n`.
+        vector_fp solution;
+        //! Velocity at the inlet [m/s], which is the flame speed for a free
+        //! flame
+        double flameSpeed;
+        double maxTemperature; //!< Largest temperature [K]
+        double zfixed; //!< Location of the fixed temperature of a free flame
+        double tfixed; //!< Fixed temperature of a free flame
+        //! Solution of all domains, in the format used by Sim1D::save()
+        std::shared_ptr<XML_Node> xml;
+    };
+
+    /**
+     * @param gas  Phase defining the mechanism. This phase is not modified.
+     *     It must have been created from an input file, and it must be
+     *     associated with a reaction mechanism.
+     * @param transportModel  Transport model used by the flames, such as
+     *     "Mix" or "Multi"
+     * @param flameType  Either "free" for freely-propagating premixed flames,
+     *     or "counterflow" for axisymmetric counterflow flames between two
+     *     inlets.
+     */
+    FlameSweep(IdealGasPhase& gas, const std::string& transportModel,
+               const std::string& flameType);
+
+    //! Set the function which applies the parameters of a case to a flame.
+    //! This is required. The function typically sets the pressure of the
+    //! flow domain and the composition, temperature, and mass flux of the
+    //! inlets.
+    void setParameterFunction(
+        std::function<void(Flame&, const vector_fp&)> setParameters) {
+        m_setParameters = setParameters;
+    }
+
+    //! Set a function which is called once for each flame after it is
+    //! created, which can be used to set options such as the tolerances, the
+    //! grid refinement criteria, or which equations are solved. The energy
+    //! equation is enabled by default.
+    void setSetupFunction(std::function<void(Flame&)> setup) {
+        m_setup = setup;
+    }
+
+    //! Set the function which sets the initial guess for a case which is not
+    //! started from another solution. The function is called after the
+    //! initial grid and the parameters of the case have been set. The default
+    //! for free flames is a linear profile from the inlet state to the
+    //! adiabatic equilibrium state, with the temperature fixed halfway
+    //! between them. The default for counterflow flames is a linear profile
+    //! between the states of the two inlets.
+    void setInitialGuessFunction(std::function<void(Flame&)> setGuess) {
+        m_setGuess = setGuess;
+    }
+
+    //! Set the grid of the flow domain used for the initial guess
+    void setInitialGrid(const vector_fp& z);
+
+    //! Add a case with the given parameters. All cases must have the same
+    //! number of parameters.
+    void addCase(const vector_fp& parameters);
+
+    //! Solve all cases which have not been solved yet.
+    /*!
+     * @param nThreads  Number of threads to use. If 0, the number of hardware
+     *     threads is used.
+     * @param refine  If true, the grid of each solution is refined
+     * @param loglevel  Level of diagnostic output. Values greater than 1 are
+     *     passed to Sim1D::solve(), which is only useful with a single thread.
+     */
+    void run(size_t nThreads=0, bool refine=true, int loglevel=0);
+
+    //! Number of cases
+    size_t nCases() const {
+        return m_results.size();
+    }
+
+    //! Solution of case *i*
+    const Result& result(size_t i) const {
+        return m_results.at(i);
+    }
+
+    //! Number of cases which failed to converge
+    size_t nFailed() const;
+
+    //! Number of cases which were solved starting from the initial guess
+    size_t nInitialGuess() const;
+
+    //! Names of the components of the flow domain, in the order used by
+    //! Result::solution
+    const std::vector<std::string>& componentNames() const {
+        return m_componentNames;
+    }
+
+    //! Write the solutions of all converged cases to the XML file *fname*,
+    //! replacing any solutions with the same ids. Case *i* is saved with the
+    //! id `prefix + std::to_string(i)`, and its parameters are listed in the
+    //! description.
+    void save(const std::string& fname, const std::string& prefix="case") const;
+
+protected:
+    //! Create a flame using copies of the phase
+    std::unique_ptr<Flame> newFlame() const;
+
+    //! Solve the cases taken from the shared queue using *flame*
+    void solveCases(Flame& flame, bool refine, int loglevel);
+
+    //! Set up *flame* for case *i* starting from the initial guess
+    void setInitialGuess(Flame& flame, size_t i);
+
+    //! Set up *flame* for case *i* starting from the solution *seed*
+    void setSeed(Flame& flame, size_t i, const Result& seed);
+
+    //! Store the solution of *flame* in the result *r*
+    void storeResult(Flame& flame, Result& r) const;
+
+    //! Default initial guess for a free flame
+    static void freeFlameGuess(Flame& flame);
+
+    //! Default initial guess for a counterflow flame
+    static void counterflowGuess(Flame& flame);
+
+    //! Index of the converged case closest to case *i*, or npos if no case
+    //! has converged. Must be called with #m_mutex locked.
+    size_t closestCase(size_t i) const;
+
+    IdealGasPhase& m_gas;
+    std::string m_transportModel;
+    bool m_free; //!< True for free flames, false for counterflow flames
+
+    std::function<void(Flame&, const vector_fp&)> m_setParameters;
+    std::function<void(Flame&)> m_setup;
+    std::function<void(Flame&)> m_setGuess;
+    vector_fp m_grid; //!< initial grid
+
+    std::vector<Result> m_results;
+    std::vector<std::string> m_componentNames;
+
+    //! Range of each parameter over all cases, used to scale the distance
+    //! between cases
+    vector_fp m_paramScale;
+
+    //! @name Shared state of the threads in run()
+    //! @{
+    std::vector<bool> m_done; //!< true if the case has been solved
+    size_t m_next; //!< next case to be solved
+    std::mutex m_mutex; //!< protects the shared state and #m_results
+    //! @}
+};
+
+}
+
+#endif
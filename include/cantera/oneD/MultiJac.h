@@ -7,6 +7,7 @@
 #define CT_MULTIJAC_H
 
 #include "cantera/numerics/BandMatrix.h"
+#include "cantera/numerics/BlockTridiagMatrix.h"
 #include "OneDim.h"
 
 namespace Cantera
@@ -17,9 +18,21 @@ namespace Cantera
  * residual function supplied by an instance of class OneDim. The residual
  * function may consist of several linked 1D domains, with different variables
  * in each domain.
+ *
+ * Since the residual at each grid point depends only on the solution at that
+ * point and its two neighbors, the Jacobian is block-tridiagonal, with one
+ * block for each grid point. Depending on OneDim::linearSolver(), the
+ * Jacobian is stored and factored either as a BandMatrix, or as a
+ * BlockTridiagMatrix. When the Jacobian-free Newton-Krylov solver is used,
+ * only the diagonal blocks are stored, and the resulting block-diagonal
+ * matrix serves as the preconditioner. If the diagonal blocks are singular,
+ * the full block-tridiagonal Jacobian is stored and used as the
+ * preconditioner instead (see storeOffDiagonalBlocks()). The elements of the Jacobian are
+ * accessed and linear systems are solved through the methods of this class,
+ * which select the appropriate storage.
  * @ingroup onedim
  */
-class MultiJac : public BandMatrix
+class MultiJac
 {
 public:
     MultiJac(OneDim& r);
@@ -32,7 +45,7 @@ public:
      */
     void eval(doublereal* x0, doublereal* resid0, double rdt);
 
-    //! Elapsed CPU time spent computing the Jacobian.
+    //! Elapsed wall-clock time spent computing the Jacobian.
     doublereal elapsedTime() const {
         return m_elapsed;
     }
@@ -65,7 +78,74 @@ public:
 
     void incrementDiagonal(int j, doublereal d);
 
+    //! Return a changeable reference to element (i,j) of the Jacobian
+    doublereal& value(size_t i, size_t j) {
+        if (m_blockTridiag) {
+            return m_blocks.value(i, j);
+        }
+        return m_band.value(i, j);
+    }
+
+    //! Return the value of element (i,j) of the Jacobian
+    doublereal value(size_t i, size_t j) const {
+        if (m_blockTridiag) {
+            return m_blocks.value(i, j);
+        }
+        return m_band.value(i, j);
+    }
+
+    //! Number of rows (and columns) of the Jacobian
+    size_t nRows() const {
+        return m_size;
+    }
+
+    //! Multiply the Jacobian by *b* and write the result to *prod*.
+    void mult(const doublereal* b, doublereal* prod) const;
+
+    //! Solve the linear system J*x = b. *x* may be the same as *b*.
+    int solve(const doublereal* const b, doublereal* const x);
+
+    //! Status flag of the last factorization. If nonzero, the value is one
+    //! plus the index of the row where the factorization failed.
+    int info() const;
+
+    //! True if the Jacobian is stored as a block-tridiagonal matrix
+    bool blockTridiagonal() const {
+        return m_blockTridiag;
+    }
+
+    //! True if only the diagonal blocks of the Jacobian are stored
+    bool diagonalOnly() const {
+        return m_blockTridiag && m_blocks.diagonalOnly();
+    }
+
+    //! Store the blocks coupling neighboring points as well, if only the
+    //! diagonal blocks were stored. This is done by eval() if the diagonal
+    //! blocks are singular. The Jacobian needs to be evaluated again.
+    void storeOffDiagonalBlocks();
+
+    //! Copy the rows of the Jacobian *old*, evaluated before the grid was
+    //! refined, which are still valid for the current grid.
+    /*!
+     * The rows for a grid point are kept if the point and both of its
+     * neighbors are unchanged by the refinement. The next call to eval() then
+     * only evaluates the remaining rows, perturbing only the solution
+     * components which affect them.
+     *
+     * @param old  Jacobian for the grid before refinement
+     * @param oldPoint  For each point of the current grid, the index of the
+     *     same point in the previous grid, or npos for a new point
+     * @param oldLoc  Location of each point of the previous grid in the
+     *     solution vector
+     * @return  the number of points whose rows were copied
+     */
+    size_t transfer(const MultiJac& old, const std::vector<size_t>& oldPoint,
+                    const std::vector<size_t>& oldLoc);
+
 protected:
+    //! Resize #m_blocks to have one block for each grid point
+    void resizeBlocks(bool diagonalOnly);
+
     //! Residual evaluator for this Jacobian
     /*!
      * This is a pointer to the residual evaluator. This object isn't owned by
@@ -82,6 +162,21 @@ protected:
     int m_age;
     size_t m_size;
     size_t m_points;
+
+    //! True if the Jacobian is stored in #m_blocks instead of #m_band
+    bool m_blockTridiag;
+
+    //! Band storage of the Jacobian. Empty if the Jacobian is stored as a
+    //! block-tridiagonal matrix.
+    BandMatrix m_band;
+
+    //! Block-tridiagonal storage of the Jacobian, with one block per grid
+    //! point
+    BlockTridiagMatrix m_blocks;
+
+    //! For each grid point, true if its rows were copied by transfer() and
+    //! do not need to be evaluated by the next call to eval()
+    std::vector<bool> m_rowValid;
 };
 }
 
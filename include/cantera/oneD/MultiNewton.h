@@ -14,6 +14,19 @@ namespace Cantera
 /**
  * Newton iterator for multi-domain, one-dimensional problems.
  * Used by class OneDim.
+ *
+ * By default, each Newton step is found by solving a linear system with the
+ * Jacobian computed by MultiJac. Alternatively, the Jacobian-free
+ * Newton-Krylov (JFNK) method can be used (see setJacobianFree()). In this
+ * case, the linear system is solved approximately using restarted GMRES,
+ * where products of the Jacobian with a vector are computed from differences
+ * of the residual along that vector, and the matrix held by MultiJac serves
+ * only as a (left) preconditioner. The preconditioner may therefore be a
+ * cheap approximation of the Jacobian, such as its diagonal blocks, or a
+ * Jacobian which has been kept for many steps. GMRES is applied to the
+ * step scaled by the error weights used by norm2(), so that the linear
+ * iterations are converged in the same norm as the Newton iterations. The
+ * damping logic of dampStep() is the same for both methods.
  * @ingroup onedim
  */
 class MultiNewton
@@ -69,13 +82,97 @@ public:
         m_maxAge = maxJacAge;
     }
 
+    //! Use the Jacobian-free Newton-Krylov method to compute Newton steps.
+    //! The Jacobian passed to step() is then used as the preconditioner.
+    void setJacobianFree(bool jfnk) {
+        m_jacobianFree = jfnk;
+    }
+
+    //! True if the Jacobian-free Newton-Krylov method is used
+    bool jacobianFree() const {
+        return m_jacobianFree;
+    }
+
+    //! Set options for the GMRES iterations of the Jacobian-free method.
+    /*!
+     * @param rtol     Relative tolerance. The iterations stop when the
+     *                 weighted norm (see norm2()) of the preconditioned
+     *                 linear residual is reduced by this factor.
+     * @param maxIter  Maximum number of iterations for each Newton step. If
+     *                 the tolerance is not met, the last iterate is used.
+     * @param restart  Number of iterations after which GMRES is restarted,
+     *                 which sets the number of basis vectors that are stored
+     */
+    void setKrylovOptions(double rtol=1e-4, size_t maxIter=200,
+                          size_t restart=30);
+
+    //! Total number of GMRES iterations taken by the Jacobian-free method
+    size_t krylovIterations() const {
+        return m_nKrylovIter;
+    }
+
+    //! Number of Newton steps where GMRES did not reach the tolerance
+    size_t krylovFailures() const {
+        return m_nKrylovFail;
+    }
+
     /// Change the problem size.
     void resize(size_t points);
 
 protected:
+    //! Solve the linear system with the Jacobian (or preconditioner) *jac*
+    //! in place, translating a singular matrix error into the domain,
+    //! component, and point where it occurs.
+    void solveJacobian(doublereal* b, OneDim& r, MultiJac& jac);
+
+    //! Solve for the Newton step at *x* using preconditioned GMRES. On input,
+    //! *b* contains the negative of the residual at *x*. On output, it
+    //! contains the Newton step.
+    void krylovSolve(const doublereal* x, doublereal* b, OneDim& r,
+                     MultiJac& jac, int loglevel);
+
+    //! Approximate the product of the Jacobian at *x* with *v* by a
+    //! directional difference of the residual. #m_fx must contain the
+    //! residual at *x*.
+    void jacobianProduct(const doublereal* x, const doublereal* v,
+                         doublereal* Jv, OneDim& r);
+
+    //! Compute the product of the scaled, preconditioned Jacobian with *v*,
+    //! \f$ w = W^{-1} M^{-1} J W v \f$, where *W* is the diagonal matrix of
+    //! the error weights #m_ewt and *M* is the preconditioner *jac*.
+    void preconditionedProduct(const doublereal* x, const doublereal* v,
+                               doublereal* w, OneDim& r, MultiJac& jac);
+
     //! Work arrays of size #m_n used in solve().
     vector_fp m_x, m_stp, m_stp1;
 
+    //! @name Work arrays used by the Jacobian-free method
+    //! @{
+    vector_fp m_fx; //!< residual at the current solution
+    vector_fp m_xp; //!< perturbed solution
+    vector_fp m_fp; //!< residual at the perturbed solution
+    vector_fp m_krylov; //!< Krylov basis vectors, stored consecutively
+    vector_fp m_hess; //!< Hessenberg matrix, column-major
+    vector_fp m_cs, m_sn; //!< Givens rotations
+    vector_fp m_g; //!< rotated residual vector of the least-squares problem
+    vector_fp m_z; //!< unscaled Krylov vector
+    vector_fp m_w; //!< Jacobian-vector product
+    vector_fp m_s; //!< current approximation of the scaled Newton step
+    vector_fp m_rhs; //!< scaled, preconditioned right hand side
+    vector_fp m_ewt; //!< error weights of the solution components
+    //! @}
+
+    bool m_jacobianFree; //!< True if the Jacobian-free method is used
+    double m_krylovTol; //!< Relative tolerance for GMRES
+    size_t m_maxKrylovIter; //!< Maximum GMRES iterations per Newton step
+    size_t m_krylovRestart; //!< GMRES restart length
+    size_t m_nKrylovIter; //!< Total number of GMRES iterations
+    size_t m_nKrylovFail; //!< Number of unconverged GMRES solves
+
+    //! True if the last GMRES solve needed to be restarted, which indicates
+    //! that the preconditioner should be updated
+    bool m_krylovSlow;
+
     int m_maxAge;
 
     //! number of variables
@@ -119,6 +119,35 @@ public:
         return m_bw;
     }
 
+    //! Set the method used to store the Jacobian and solve the linear systems
+    //! for the Newton steps.
+    /*!
+     * @param type  One of:
+     *   - "banded" (the default): store the Jacobian as a band matrix which
+     *     is factored using LAPACK.
+     *   - "block-tridiagonal": store only the blocks coupling each grid
+     *     point to itself and its neighbors, and factor the Jacobian using the
+     *     block Thomas algorithm (see BlockTridiagMatrix).
+     *   - "jfnk": use the Jacobian-free Newton-Krylov solver of MultiNewton,
+     *     preconditioned by the diagonal blocks of the Jacobian, which are
+     *     the only part of the Jacobian that is stored. This greatly reduces
+     *     the memory required for large mechanisms. If the diagonal blocks
+     *     are singular, as for counterflow flames, the block-tridiagonal
+     *     Jacobian is stored and used as the preconditioner instead.
+     *     Sensitivity analysis requires one of the other methods.
+     *
+     * To use the Jacobian-free solver preconditioned by the full (band or
+     * block-tridiagonal) Jacobian, select the corresponding type here and
+     * then call `newton().setJacobianFree(true)`.
+     */
+    void setLinearSolver(const std::string& type);
+
+    //! The method used to store the Jacobian and solve the linear systems for
+    //! the Newton steps. See setLinearSolver().
+    const std::string& linearSolver() const {
+        return m_linearSolver;
+    }
+
     /*!
      * Initialize all domains. On the first call, this methods calls the init
      * method of each domain, proceeding from left to right. Subsequent calls
@@ -242,6 +271,40 @@ public:
         return m_nsteps_max;
     }
 
+    //! Set the method used to integrate the transient problem in timeStep().
+    /*!
+     * @param method  Either "backward-euler" (the default) or "bdf2". With
+     *     "bdf2", the variable-step, second-order backward differentiation
+     *     formula is used. Its local truncation error is estimated from the
+     *     difference between the solution and a quadratic extrapolation of
+     *     the previous solutions, and the step size is chosen to keep this
+     *     estimate within the transient tolerances (scaled by the factor set
+     *     with setTimeStepErrorTolerance()). Steps where the estimate is too
+     *     large are rejected and repeated with a smaller step size. After a
+     *     failed Newton iteration, the history is discarded and the next
+     *     step is a backward Euler step.
+     *
+     * "bdf2" needs fewer time steps when the transient solution is smooth,
+     * as for a counterflow flame starting from a reasonable initial guess.
+     * Starting from a crude initial guess, as for a freely propagating flame,
+     * the strong damping of backward Euler is more useful, and "bdf2"
+     * typically needs more time steps and Jacobian evaluations.
+     */
+    void setTransientMethod(const std::string& method);
+
+    //! The method used to integrate the transient problem
+    const std::string& transientMethod() const {
+        return m_transientMethod;
+    }
+
+    //! Set the factor multiplying the transient tolerances in the local error
+    //! test of the "bdf2" method. Larger values allow larger time steps. Since
+    //! time stepping only serves to approach the steady-state solution, the
+    //! default (1000) only limits steps which would be very inaccurate.
+    void setTimeStepErrorTolerance(double tol) {
+        m_transientErrorTol = tol;
+    }
+
     void setJacAge(int ss_age, int ts_age=-1);
 
     /**
@@ -251,10 +314,12 @@ public:
      *
      * - number of grid points
      * - number of Jacobian evaluations
-     * - CPU time spent evaluating Jacobians
+     * - wall-clock time spent evaluating Jacobians
      * - number of non-Jacobian function evaluations
-     * - CPU time spent evaluating functions
+     * - wall-clock time spent evaluating functions
      * - number of time steps
+     * - the profiling data of the solver and each domain, if profiling is
+     *   enabled (see enableProfiling())
      */
     void saveStats();
 
@@ -267,14 +332,15 @@ public:
         return m_gridpts;
     }
 
-    //! Return CPU time spent evaluating Jacobians in each call to solve()
+    //! Return wall-clock time spent evaluating Jacobians in each call to
+    //! solve()
     const vector_fp& jacobianTimeStats() {
         saveStats();
         return m_jacElapsed;
     }
 
-    //! Return CPU time spent on non-Jacobian function evaluations in each call
-    //! to solve()
+    //! Return wall-clock time spent on non-Jacobian function evaluations in
+    //! each call to solve()
     const vector_fp& evalTimeStats() {
         saveStats();
         return m_funcElapsed;
@@ -299,6 +365,47 @@ public:
         return m_timeSteps;
     }
 
+    //! Enable or disable the profiling timers of the solver and all domains.
+    /*!
+     * When enabled, the wall-clock time and number of calls are recorded for
+     * the property updates (thermo, transport, diffusive fluxes, kinetics)
+     * and residual evaluation of each domain, and for the evaluation,
+     * factorization and solution of the Jacobian. Like the other statistics,
+     * the data is saved separately for each grid by saveStats(). See
+     * Profile1D.
+     */
+    void enableProfiling(bool enable=true);
+
+    //! True if profiling is enabled
+    bool profilingEnabled() const {
+        return m_profiler.enabled();
+    }
+
+    //! Timers and counters for the tasks of the solver on the current grid
+    Profile1D& profiler() {
+        return m_profiler;
+    }
+
+    //! Return the profiling data for each call to solve(). The entries
+    //! correspond to those of gridSizeStats().
+    const std::vector<GridProfile1D>& profileStats() {
+        saveStats();
+        return m_profileStats;
+    }
+
+    //! Return the profiling data and the other statistics as a JSON document.
+    /*!
+     * The document contains a list "grids" with an entry for each call to
+     * solve(), with the number of grid points, time steps, residual and
+     * Jacobian evaluations, and the time and number of calls for each task of
+     * the solver and of each domain. The object "total" contains the times
+     * and counts summed over all grids. Times are in seconds.
+     */
+    std::string profileJSON();
+
+    //! Write the document returned by profileJSON() to the file *filename*
+    void writeProfile(const std::string& filename);
+
     //! Set a function that will be called every time #eval is called.
     //! Can be used to provide keyboard interrupt support in the high-level
     //! language interfaces.
@@ -317,6 +424,13 @@ public:
 protected:
     void evalSSJacobian(doublereal* x, doublereal* xnew);
 
+    //! Estimate the local error of a BDF2 step from *x* to *xnew* of size
+    //! *dt*, relative to the error tolerance
+    double bdf2Error(double dt, const double* x, const double* xnew);
+
+    //! Extrapolate the solution history to a step of size *dt* from *x*
+    void bdf2Predict(double dt, const double* x, vector_fp& xpred);
+
     doublereal m_tmin; //!< minimum timestep size
     doublereal m_tmax; //!< maximum timestep size
 
@@ -331,6 +445,9 @@ protected:
     size_t m_bw; //!< Jacobian bandwidth
     size_t m_size; //!< solution vector size
 
+    //! Jacobian storage and linear solver type. See setLinearSolver().
+    std::string m_linearSolver;
+
     std::vector<Domain1D*> m_dom, m_connect, m_bulk;
 
     bool m_init;
@@ -355,6 +472,29 @@ protected:
     //! Maximum number of timesteps allowed per call to solve()
     int m_nsteps_max;
 
+    //! Method used by timeStep(). See setTransientMethod().
+    std::string m_transientMethod;
+
+    //! Factor multiplying the tolerances in the BDF2 local error test
+    double m_transientErrorTol;
+
+    //! @name Solution history used by the BDF2 method
+    //! @{
+    vector_fp m_xn; //!< solution after the last call to timeStep()
+    vector_fp m_xnm1, m_xnm2; //!< solutions at the previous two steps
+    double m_hn; //!< size of the last step
+    double m_hnm1; //!< size of the step before the last one
+    size_t m_nhist; //!< number of valid entries in the history (0 to 2)
+    vector_fp m_xhat; //!< work array
+    vector_fp m_xpred; //!< extrapolated solution
+    //! @}
+
+    //! For each point of a refined grid, the index of the same point in the
+    //! grid before refinement, or npos for a new point. If set before calling
+    //! resize(), the rows of the Jacobian for unchanged regions of the grid
+    //! are kept (see MultiJac::transfer()).
+    std::vector<size_t> m_oldPoints;
+
 private:
     // statistics
     int m_nevals;
@@ -368,6 +508,12 @@ private:
     //! Number of time steps taken in each call to solve() (e.g. for each
     //! successive grid refinement)
     vector_int m_timeSteps;
+
+    //! Timers and counters for the solver on the current grid
+    Profile1D m_profiler;
+
+    //! Profiling data for each call to solve()
+    std::vector<GridProfile1D> m_profileStats;
 };
 
 }
@@ -0,0 +1,148 @@
+//! @file Profile1D.h
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_PROFILE1D_H
+#define CT_PROFILE1D_H
+
+#include "cantera/base/ct_defs.h"
+#include <chrono>
+
+namespace Cantera
+{
+
+/**
+ * Wall-clock timers and counters for the tasks performed while solving a
+ * one-dimensional problem. Each domain of a OneDim container keeps a
+ * Profile1D for the work done at its grid points (property updates and
+ * residual evaluation), and the container keeps one for the tasks of the
+ * Newton solver, which involve all domains. Profiling is disabled by default,
+ * and is switched on with OneDim::enableProfiling().
+ * @ingroup onedim
+ */
+class Profile1D
+{
+public:
+    //! Tasks which are timed
+    enum Task {
+        ThermoUpdate, //!< Thermodynamic properties (density, cp, etc.)
+        TransportUpdate, //!< Transport properties
+        DiffusiveFluxes, //!< Diffusive fluxes of the species
+        Kinetics, //!< Net production rates
+        Residual, //!< Residual evaluation, including the property updates
+        Jacobian, //!< Finite-difference evaluation of the Jacobian
+        Factor, //!< LU factorization of the Jacobian
+        Solve, //!< Linear solves using the factored Jacobian
+        nTasks
+    };
+
+    Profile1D();
+
+    //! Name of a task, used as the key in profileJSON()
+    static std::string taskName(Task task);
+
+    //! Enable or disable the timers. Timers of a disabled profile are not
+    //! started, so the cost of profiling is a single test per timed section.
+    void enable(bool enable) {
+        m_enabled = enable;
+    }
+
+    bool enabled() const {
+        return m_enabled;
+    }
+
+    //! Reset all counters and timers, without changing enabled()
+    void clear();
+
+    //! Add *seconds* of elapsed time for one call of *task*, which processed
+    //! *points* grid points
+    void add(Task task, double seconds, size_t points=0) {
+        m_elapsed[task] += seconds;
+        m_calls[task]++;
+        m_points[task] += points;
+    }
+
+    //! Add the times and counts of another profile to this one
+    Profile1D& operator+=(const Profile1D& other);
+
+    //! Total wall-clock time [s] spent on *task*
+    double elapsed(Task task) const {
+        return m_elapsed[task];
+    }
+
+    //! Number of times *task* was performed
+    size_t calls(Task task) const {
+        return m_calls[task];
+    }
+
+    //! Total number of grid points processed by *task*. Only counted for the
+    //! property updates.
+    size_t points(Task task) const {
+        return m_points[task];
+    }
+
+    //! JSON object with the time and counts for each task which was
+    //! performed at least once
+    std::string toJSON() const;
+
+    //! Timer which adds the wall-clock time between its construction and
+    //! destruction to a task of a Profile1D, if the profile is enabled.
+    class Timer
+    {
+    public:
+        Timer(Profile1D& profile, Task task, size_t points=0)
+            : m_profile(profile.enabled() ? &profile : nullptr)
+            , m_task(task)
+            , m_points(points)
+        {
+            if (m_profile) {
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Timer() {
+            if (m_profile) {
+                std::chrono::duration<double> dt =
+                    std::chrono::steady_clock::now() - m_start;
+                m_profile->add(m_task, dt.count(), m_points);
+            }
+        }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        Profile1D* m_profile;
+        Task m_task;
+        size_t m_points;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+protected:
+    bool m_enabled;
+    double m_elapsed[nTasks];
+    size_t m_calls[nTasks];
+    size_t m_points[nTasks];
+};
+
+//! Profiling data for the solution of a one-dimensional problem on one grid.
+//! See OneDim::profileStats().
+struct GridProfile1D
+{
+    //! Total number of grid points
+    size_t points;
+
+    //! Tasks of the Newton solver, involving all domains. The Residual task
+    //! only includes evaluations of the complete residual, not those made
+    //! while evaluating the Jacobian.
+    Profile1D solver;
+
+    //! Tasks performed by each domain, including the residual evaluations
+    //! made while evaluating the Jacobian
+    std::vector<Profile1D> domains;
+};
+
+}
+
+#endif
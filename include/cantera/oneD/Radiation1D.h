@@ -0,0 +1,97 @@
+//! @file Radiation1D.h
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_RADIATION1D_H
+#define CT_RADIATION1D_H
+
+#include "cantera/base/ct_defs.h"
+
+namespace Cantera
+{
+
+class ThermoPhase;
+
+/**
+ * Base class for models of the radiative heat loss in one-dimensional flows.
+ * A model is attached to a flow domain with StFlow::setRadiationModel(), and
+ * its heat loss is subtracted from the energy equation at each interior grid
+ * point. The state of the gas is passed to the model as contiguous arrays, so
+ * that models can be implemented as loops over the grid points.
+ * @ingroup onedim
+ */
+class Radiation1D
+{
+public:
+    virtual ~Radiation1D() {}
+
+    //! Set the phase of the flow domain. Called when the model is attached to
+    //! a flow domain, and can be used to find the indices of the radiating
+    //! species.
+    virtual void setThermo(const ThermoPhase& thermo) {}
+
+    //! Compute the radiative heat loss [W/m^3] at the grid points
+    //! *j0* <= *j* < *j1*.
+    /*!
+     * @param nPoints  Number of grid points in the domain
+     * @param T  Temperature at each grid point [K]. Length *nPoints*.
+     * @param Y  Mass fractions. The mass fraction of species *k* at point *j*
+     *     is `Y[j * ldY + k]`.
+     * @param ldY  Stride between grid points in *Y*
+     * @param wtm  Mean molecular weight at each grid point [kg/kmol]
+     * @param pressure  Pressure [Pa]
+     * @param epsLeft  Emissivity of the left boundary
+     * @param epsRight  Emissivity of the right boundary
+     * @param j0  First grid point
+     * @param j1  One past the last grid point
+     * @param[out] qdot  Heat loss at each grid point. Only the points *j0* to
+     *     *j1 - 1* are set.
+     */
+    virtual void getHeatLoss(size_t nPoints, const double* T, const double* Y,
+                             size_t ldY, const double* wtm, double pressure,
+                             double epsLeft, double epsRight,
+                             size_t j0, size_t j1, double* qdot) = 0;
+};
+
+/**
+ * Radiative heat loss in the optically thin limit with the gray-gas
+ * approximation, considering the radiation of CO2 and H2O.
+ *
+ * The model was established by Y. Liu and B. Rogg [Y. Liu and B. Rogg,
+ * Modelling of thermally radiating diffusion flames with detailed chemistry
+ * and transport, EUROTHERM Seminars, 17:114-127, 1991]. The volumetric heat
+ * loss is computed from the Planck mean absorption coefficient, the
+ * temperature, and the emissivities of the boundaries. The Planck mean
+ * absorption coefficients of H2O and CO2 are polynomials in \f$ 1000/T \f$
+ * fitted to data from the RADCAL program [Grosshandler, W. L., RADCAL: A
+ * Narrow-Band Model for Radiation Calculations in a Combustion Environment,
+ * NIST technical note 1402, 1993]. The coefficients of the polynomials are
+ * taken from [http://www.sandia.gov/TNF/radiation.html].
+ *
+ * This is the model used by StFlow::enableRadiation().
+ * @ingroup onedim
+ */
+class OpticallyThinRadiation : public Radiation1D
+{
+public:
+    OpticallyThinRadiation();
+
+    virtual void setThermo(const ThermoPhase& thermo);
+
+    virtual void getHeatLoss(size_t nPoints, const double* T, const double* Y,
+                             size_t ldY, const double* wtm, double pressure,
+                             double epsLeft, double epsRight,
+                             size_t j0, size_t j1, double* qdot);
+
+protected:
+    //! Indices of CO2 and H2O, or npos if they are not in the phase
+    size_t m_kCO2, m_kH2O;
+
+    //! Molecular weights of CO2 and H2O [kg/kmol]
+    double m_wtCO2, m_wtH2O;
+};
+
+}
+
+#endif
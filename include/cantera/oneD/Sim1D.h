@@ -9,6 +9,8 @@
 #define CT_SIM1D_H
 
 #include "OneDim.h"
+#include "cantera/base/Array.h"
+#include "cantera/numerics/BandMatrix.h"
 
 namespace Cantera
 {
@@ -128,6 +130,19 @@ public:
     /// Refine the grid in all domains.
     int refine(int loglevel=0);
 
+    //! Use incremental grid refinement in refine().
+    /*!
+     * If enabled, the solution at new grid points is interpolated using the
+     * monotone piecewise cubic Hermite interpolant of each component instead
+     * of linearly, and the rows of the Jacobian for grid points whose
+     * neighborhood is unchanged by the refinement are kept. After
+     * refinement, only the remaining rows of the Jacobian are evaluated. This
+     * is disabled by default.
+     */
+    void setIncrementalRefine(bool incremental) {
+        m_incrementalRefine = incremental;
+    }
+
     //! Add node for fixed temperature point of freely propagating flame
     int setFixedTemperature(doublereal t);
 
@@ -210,6 +225,64 @@ public:
      */
     void solveAdjoint(const double* b, double* lambda);
 
+    //! Solve the equation \f$ J^T \Lambda = B \f$ for several right-hand
+    //! sides with a single factorization of \f$ J^T \f$.
+    /*!
+     * @param b  Right-hand sides. Column *r* starts at `b + r * size()`.
+     * @param lambda  Solutions, stored in the same way as *b*
+     * @param nrhs  Number of right-hand sides
+     * @param newJacobian  If true, the steady-state Jacobian is evaluated at
+     *     the current solution. Otherwise, the factored \f$ J^T \f$ from the
+     *     previous call is reused. A CanteraError is thrown if the grid, the
+     *     bandwidth or the solution have changed since then.
+     */
+    void solveAdjoint(const double* b, double* lambda, size_t nrhs,
+                      bool newJacobian=true);
+
+    //! Compute the products \f$ \lambda_r^T \partial f / \partial \ln k_i \f$
+    //! of adjoint vectors with the derivatives of the steady-state residual
+    //! with respect to the rate multiplier of each reaction.
+    /*!
+     * The derivatives are computed analytically from the net rates of
+     * progress at each grid point of the flow domains, which must all use the
+     * same Kinetics object.
+     * @param lambda  Adjoint vectors. Vector *r* starts at `lambda + r * size()`.
+     * @param nrhs  Number of adjoint vectors
+     * @returns  An array with *nrhs* rows and one column for each reaction
+     */
+    Array2D reactionDerivativeProducts(const double* lambda, size_t nrhs);
+
+    //! Compute the sensitivities of several scalar functions of the solution
+    //! to the rate multipliers of all reactions.
+    /*!
+     * For each function \f$ g_r(x) \f$, this computes \f$ dg_r / d\ln k_i \f$,
+     * where \f$ k_i \f$ is the multiplier of reaction \f$ i \f$, using
+     * solveAdjoint() with one right-hand side per function. The functions
+     * must not depend on the multipliers directly. Dividing by \f$ g_r \f$
+     * gives the normalized sensitivities.
+     *
+     * @code
+     * // sensitivities of the flame speed of a free flame (domain 1)
+     * size_t ju = sim.domain(1).loc() + sim.domain(1).index(c_offset_U, 0);
+     * vector_fp dgdx(sim.size(), 0.0);
+     * dgdx[ju] = 1.0;
+     * Array2D s = sim.reactionSensitivities({dgdx});
+     * @endcode
+     *
+     * @param dgdx  Derivative of each function with respect to the solution
+     *     vector
+     * @returns  An array with one row for each function and one column for
+     *     each reaction
+     */
+    Array2D reactionSensitivities(const std::vector<vector_fp>& dgdx);
+
+    //! The derivative of the value of component *n* at point *j* of domain
+    //! *dom* with respect to the solution vector, for use with
+    //! reactionSensitivities(). Objectives of this form include the flame
+    //! speed (component `u` at the first point of a free flame) and the
+    //! peak temperature (component `T` at the point where it is largest).
+    vector_fp componentDerivative(size_t dom, size_t n, size_t j) const;
+
     virtual void resize();
 
     //! Set a function that will be called after each successful steady-state
@@ -247,6 +320,23 @@ protected:
     //! User-supplied function called after a successful steady-state solve.
     Func1* m_steady_callback;
 
+    //! If true, refine() interpolates new points using a monotone cubic
+    //! interpolant and keeps the Jacobian for unchanged regions of the grid
+    bool m_incrementalRefine;
+
+    //! Transpose of the steady-state Jacobian, factored by solveAdjoint()
+    BandMatrix m_adjointJac;
+
+    //! Grid points of all domains for which #m_adjointJac was evaluated
+    vector_fp m_adjointGrid;
+
+    //! Bandwidth for which #m_adjointJac was evaluated
+    size_t m_adjointBandwidth;
+
+    //! Solution for which #m_adjointJac was evaluated. Empty if there is no
+    //! factored Jacobian.
+    vector_fp m_adjointSoln;
+
 private:
     /// Calls method _finalize in each domain.
     void finalize();
@@ -7,6 +7,7 @@
 #define CT_STFLOW_H
 
 #include "Domain1D.h"
+#include "Radiation1D.h"
 #include "cantera/base/Array.h"
 #include "cantera/thermo/IdealGasPhase.h"
 #include "cantera/kinetics/Kinetics.h"
@@ -68,6 +69,9 @@ public:
      */
     void setThermo(IdealGasPhase& th) {
         m_thermo = &th;
+        if (m_radiation) {
+            m_radiation->setThermo(th);
+        }
     }
 
     //! Set the kinetics manager. The kinetics manager must
@@ -156,13 +160,20 @@ public:
 
     //! Turn radiation on / off.
     /*!
-     *  The simple radiation model used was established by Y. Liu and B. Rogg
-     *  [Y. Liu and B. Rogg, Modelling of thermally radiating diffusion flames
-     *  with detailed chemistry and transport, EUROTHERM Seminars, 17:114-127,
-     *  1991]. This model considers the radiation of CO2 and H2O.
+     *  If no radiation model has been set with setRadiationModel(), the
+     *  optically thin model of Y. Liu and B. Rogg is used, which considers
+     *  the radiation of CO2 and H2O (see OpticallyThinRadiation).
      */
-    void enableRadiation(bool doRadiation) {
-        m_do_radiation = doRadiation;
+    void enableRadiation(bool doRadiation);
+
+    //! Set the model used to compute the radiative heat loss, and turn
+    //! radiation on. Setting an empty pointer turns radiation off.
+    void setRadiationModel(std::shared_ptr<Radiation1D> model);
+
+    //! The model used to compute the radiative heat loss, or an empty pointer
+    //! if no model has been set
+    std::shared_ptr<Radiation1D> radiationModel() const {
+        return m_radiation;
     }
 
     //! Returns `true` if the radiation term in the energy equation is enabled
@@ -170,6 +181,26 @@ public:
         return m_do_radiation;
     }
 
+    //! Turn reuse of properties during Jacobian evaluation on / off.
+    /*!
+     * When the Jacobian is evaluated, the solution is perturbed at one grid
+     * point at a time. If the cache is enabled (the default), the
+     * thermodynamic properties, production rates, and diffusive fluxes at the
+     * grid points and intervals which are not affected by the perturbation
+     * are taken from the preceding evaluation of the full residual at the
+     * unperturbed solution, instead of being recomputed. This requires that
+     * the full residual is evaluated at the unperturbed solution before the
+     * Jacobian, as is done by OneDim. The Jacobian is identical in both cases.
+     */
+    void enableJacobianCache(bool cache) {
+        m_jacobianCache = cache;
+    }
+
+    //! Returns `true` if properties are reused during Jacobian evaluation
+    bool jacobianCacheEnabled() const {
+        return m_jacobianCache;
+    }
+
     //! Set the emissivities for the boundary values
     /*!
      * Reads the emissivities for the left and right boundary values in the
@@ -226,6 +257,29 @@ public:
     virtual void evalContinuity(size_t j, doublereal* x, doublereal* r,
                                 integer* diag, doublereal rdt) = 0;
 
+    //! Add the products of adjoint vectors with the derivatives of the
+    //! steady-state residual with respect to the rate multipliers of the
+    //! reactions.
+    /*!
+     * The rate of progress of each reaction is proportional to its rate
+     * multiplier, so the derivative of the net production rate of species
+     * \f$ k \f$ with respect to the logarithm of the multiplier of reaction
+     * \f$ i \f$ is \f$ \nu_{k,i} q_i \f$, where \f$ q_i \f$ is the net rate of
+     * progress. These terms appear in the species and energy equations at the
+     * interior points.
+     *
+     * @param x  Global solution vector
+     * @param lambda  Global adjoint vectors. Vector *r* starts at
+     *     `lambda + r * ld`.
+     * @param nrhs  Number of adjoint vectors
+     * @param ld  Leading dimension of *lambda*
+     * @param[out] prod  Array with *nrhs* rows and one column for each
+     *     reaction, to which \f$ \lambda_r^T \partial F / \partial \ln k_i \f$
+     *     is added
+     */
+    void addReactionDerivativeProducts(const double* x, const double* lambda,
+                                       size_t nrhs, size_t ld, Array2D& prod);
+
     //! Index of the species on the left boundary with the largest mass fraction
     size_t leftExcessSpecies() const {
         return m_kExcessLeft;
@@ -247,11 +301,20 @@ protected:
         m_kin->getNetProductionRates(&m_wdot(0,j));
     }
 
-    //! Update the properties (thermo, transport, and diffusion flux).
-    //! This function is called in eval after the points which need
-    //! to be updated are defined.
+    //! Update the properties (thermo, transport, diffusion flux, and net
+    //! production rates). This function is called in eval after the points
+    //! which need to be updated are defined.
     virtual void updateProperties(size_t jg, double* x, size_t jmin, size_t jmax);
 
+    //! Update the properties which depend on the solution at the local grid
+    //! point `j` only, which is perturbed while evaluating the Jacobian. The
+    //! previous values are saved, and are restored by restorePoint() at the
+    //! start of the next evaluation.
+    void updatePerturbedPoint(double* x, size_t j);
+
+    //! Restore the properties saved by updatePerturbedPoint().
+    void restorePoint(size_t j);
+
     //! Evaluate the residual function. This function is called in eval
     //! after updateProperties is called.
     virtual void evalResidual(double* x, double* rsd, int* diag,
@@ -399,10 +462,6 @@ protected:
     doublereal m_epsilon_left;
     doublereal m_epsilon_right;
 
-    //! Indices within the ThermoPhase of the radiating species. First index is
-    //! for CO2, second is for H2O.
-    std::vector<size_t> m_kRadiating;
-
     // flags
     std::vector<bool> m_do_energy;
     bool m_do_soret;
@@ -415,6 +474,12 @@ protected:
     //! radiative heat loss vector
     vector_fp m_qdotRadiation;
 
+    //! Model used to compute #m_qdotRadiation
+    std::shared_ptr<Radiation1D> m_radiation;
+
+    //! Temperature at each grid point, gathered for the radiation model
+    vector_fp m_Tgrid;
+
     // fixed T and Y values
     vector_fp m_fixedtemp;
     vector_fp m_zfix;
@@ -428,6 +493,22 @@ protected:
 
     bool m_dovisc;
 
+    //! Reuse properties at unperturbed points during Jacobian evaluation.
+    //! See enableJacobianCache().
+    bool m_jacobianCache;
+
+    //! Local index of the point whose properties were updated by
+    //! updatePerturbedPoint(), or npos if there is none
+    size_t m_perturbedPoint;
+
+    //! @name Properties at the perturbed point saved by updatePerturbedPoint()
+    //! @{
+    double m_savedRho, m_savedWtm, m_savedCp;
+    vector_fp m_savedWdot;
+    //! Diffusive fluxes in the intervals on either side of the point
+    vector_fp m_savedFlux;
+    //! @}
+
     //! Update the transport properties at grid points in the range from `j0`
     //! to `j1`, based on solution `x`.
     virtual void updateTransport(doublereal* x, size_t j0, size_t j1);
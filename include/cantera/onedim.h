@@ -15,5 +15,8 @@
 #include "oneD/Domain1D.h"
 #include "oneD/Inlet1D.h"
 #include "oneD/StFlow.h"
+#include "oneD/Radiation1D.h"
+#include "oneD/Continuation1D.h"
+#include "oneD/FlameSweep.h"
 
 #endif
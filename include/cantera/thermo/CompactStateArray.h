@@ -0,0 +1,158 @@
+/**
+ * @file CompactStateArray.h
+ * Header for reduced-precision storage of many phase states (see class
+ * \link Cantera::CompactStateArray CompactStateArray\endlink).
+ */
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_COMPACTSTATEARRAY_H
+#define CT_COMPACTSTATEARRAY_H
+
+#include "cantera/base/ct_defs.h"
+#include <cstdint>
+
+namespace Cantera
+{
+
+class Phase;
+
+//! Storage for a large number of phase states in reduced precision.
+/*!
+ * Each entry holds a state in the layout used by Phase::saveState(), that is
+ * the temperature, the density and the nSpecies() mass fractions. The
+ * entries are stored contiguously, either as single precision floating point
+ * numbers, or as 16-bit unsigned integers which are scaled linearly between
+ * a lower and an upper bound for each component of the state vector. This
+ * reduces the memory needed for the states, and the bandwidth needed to
+ * access them, by a factor of 2 or 4, respectively, compared to storing the
+ * states as `double`.
+ *
+ * With the `Scaled16` storage, the absolute error in each component is half
+ * of the range of that component divided by 65535. Values outside the range
+ * are clipped. The range of the mass fractions is [0, 1] and the ranges of
+ * the temperature and density are [0, 1e4] K and [0, 1e3] kg/m^3 unless set
+ * with setRange() or fitRanges(), which should be done before any states are
+ * stored. Ranges which are fit to the states to be stored give the smallest
+ * errors. With the `Float32` storage, the relative error in each component
+ * is about 6e-8, and mass fractions smaller than about 1e-38 are stored as
+ * zero.
+ *
+ * Conversions of blocks of states to and from arrays of double precision
+ * state vectors are done by setStates() and getStates(), whose inner loops
+ * over the components of each state vector are vectorized by the compiler.
+ * Since the stored mass fractions are rounded, they are normalized when the
+ * state of a phase is set by restore().
+ */
+class CompactStateArray
+{
+public:
+    //! Format used to store the components of the state vectors
+    enum class Precision {
+        Float32, //!< single precision floating point
+        Scaled16 //!< 16-bit unsigned integers, scaled for each component
+    };
+
+    //! Constructor.
+    /*!
+     * @param phase   The phase whose states are stored. Only its number of
+     *                species is used.
+     * @param n       Number of states
+     * @param prec    Storage format
+     */
+    CompactStateArray(const Phase& phase, size_t n,
+                      Precision prec=Precision::Float32);
+
+    //! Number of stored states
+    size_t size() const {
+        return m_size;
+    }
+
+    //! Number of components in each state vector, nSpecies() + 2
+    size_t stateSize() const {
+        return m_stateSize;
+    }
+
+    //! Storage format
+    Precision precision() const {
+        return m_prec;
+    }
+
+    //! Number of bytes used to store the states
+    size_t storageBytes() const {
+        return m_float.size() * sizeof(float) +
+               m_scaled.size() * sizeof(uint16_t);
+    }
+
+    //! Change the number of stored states. Existing states are kept.
+    void resize(size_t n);
+
+    //! Set the range of component *m* of the state vector for the `Scaled16`
+    //! storage format. Ignored for the `Float32` format.
+    void setRange(size_t m, double lower, double upper);
+
+    //! Lower bound of the range of component *m* of the state vector
+    double lowerBound(size_t m) const {
+        return m_lower[m];
+    }
+
+    //! Upper bound of the range of component *m* of the state vector
+    double upperBound(size_t m) const {
+        return m_upper[m];
+    }
+
+    //! Set the ranges of all components of the state vector to the smallest
+    //! ranges containing the *n* double precision state vectors in *states*.
+    void fitRanges(size_t n, const double* states);
+
+    //! Store the state of *phase* as entry *i*.
+    void save(size_t i, const Phase& phase);
+
+    //! Set the state of *phase* to the one stored in entry *i*.
+    void restore(size_t i, Phase& phase) const;
+
+    //! Store *n* double precision state vectors as entries *i0* to *i0+n-1*.
+    //! @param i0      Index of the first entry
+    //! @param n       Number of states
+    //! @param states  Array of `n * stateSize()` values, in the layout of
+    //!                Phase::saveState()
+    void setStates(size_t i0, size_t n, const double* states);
+
+    //! Get entries *i0* to *i0+n-1* as double precision state vectors.
+    //! @param i0           Index of the first entry
+    //! @param n            Number of states
+    //! @param[out] states  Array of length `n * stateSize()`
+    void getStates(size_t i0, size_t n, double* states) const;
+
+protected:
+    //! Throw an exception unless entries *i0* to *i0+n-1* exist
+    void checkEntries(const std::string& method, size_t i0, size_t n) const;
+
+    //! Update #m_scale and #m_invScale from the ranges
+    void updateScales();
+
+    size_t m_size; //!< Number of states
+    size_t m_stateSize; //!< Number of components in each state vector
+    Precision m_prec; //!< Storage format
+
+    //! Stored states, if the storage format is `Float32`
+    std::vector<float> m_float;
+
+    //! Stored states, if the storage format is `Scaled16`
+    std::vector<uint16_t> m_scaled;
+
+    //! Lower and upper bounds of each component of the state vector
+    vector_fp m_lower, m_upper;
+
+    //! Value of one unit of the scaled integers for each component, and its
+    //! inverse
+    vector_fp m_scale, m_invScale;
+
+    //! Work array for one double precision state vector
+    mutable vector_fp m_work;
+};
+
+}
+
+#endif
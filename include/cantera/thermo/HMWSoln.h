@@ -2135,87 +2135,50 @@ private:
     //! derivative of gfunc(x), so I renamed it. Vector index is counterIJ
     mutable vector_fp m_h2func_IJ;
 
-    //! Intermediate variable called BMX in Pitzer's paper. This is the basic
-    //! cation - anion interaction. Vector index is counterIJ
-    mutable vector_fp m_BMX_IJ;
-
-    //! Derivative of BMX_IJ wrt T. Vector index is counterIJ
-    mutable vector_fp m_BMX_IJ_L;
-
-    //! Derivative of BMX_IJ wrt TT. Vector index is counterIJ
-    mutable vector_fp m_BMX_IJ_LL;
-
-    //! Derivative of BMX_IJ wrt P. Vector index is counterIJ
-    mutable vector_fp m_BMX_IJ_P;
-
-    //! Intermediate variable called BprimeMX in Pitzer's paper. Vector index is
-    //! counterIJ
-    mutable vector_fp m_BprimeMX_IJ;
-
-    //! Derivative of BprimeMX wrt T. Vector index is counterIJ
-    mutable vector_fp m_BprimeMX_IJ_L;
-
-    //! Derivative of BprimeMX wrt TT. Vector index is counterIJ
-    mutable vector_fp m_BprimeMX_IJ_LL;
-
-    //! Derivative of BprimeMX wrt P. Vector index is counterIJ
-    mutable vector_fp m_BprimeMX_IJ_P;
-
-    //! Intermediate variable called BphiMX in Pitzer's paper. Vector index is
-    //! counterIJ
-    mutable vector_fp m_BphiMX_IJ;
-
-    //! Derivative of BphiMX_IJ wrt T. Vector index is counterIJ
-    mutable vector_fp m_BphiMX_IJ_L;
-
-    //! Derivative of BphiMX_IJ wrt TT. Vector index is counterIJ
-    mutable vector_fp m_BphiMX_IJ_LL;
-
-    //! Derivative of BphiMX_IJ wrt P. Vector index is counterIJ
-    mutable vector_fp m_BphiMX_IJ_P;
-
-    //! Intermediate variable called Phi in Pitzer's paper. Vector index is
-    //! counterIJ
-    mutable vector_fp m_Phi_IJ;
-
-    //! Derivative of m_Phi_IJ wrt T. Vector index is counterIJ
-    mutable vector_fp m_Phi_IJ_L;
-
-    //! Derivative of m_Phi_IJ wrt TT. Vector index is counterIJ
-    mutable vector_fp m_Phi_IJ_LL;
-
-    //! Derivative of m_Phi_IJ wrt P. Vector index is counterIJ
-    mutable vector_fp m_Phi_IJ_P;
-
-    //! Intermediate variable called Phiprime in Pitzer's paper. Vector index is
-    //! counterIJ
-    mutable vector_fp m_Phiprime_IJ;
-
-    //! Intermediate variable called PhiPhi in Pitzer's paper. Vector index is
-    //! counterIJ
-    mutable vector_fp m_PhiPhi_IJ;
-
-    //! Derivative of m_PhiPhi_IJ wrt T. Vector index is counterIJ
-    mutable vector_fp m_PhiPhi_IJ_L;
-
-    //! Derivative of m_PhiPhi_IJ wrt TT. Vector index is counterIJ
-    mutable vector_fp m_PhiPhi_IJ_LL;
-
-    //! Derivative of m_PhiPhi_IJ wrt P. Vector index is counterIJ
-    mutable vector_fp m_PhiPhi_IJ_P;
-
-    //! Intermediate variable called CMX in Pitzer's paper. Vector index is
-    //! counterIJ
-    mutable vector_fp m_CMX_IJ;
-
-    //! Derivative of m_CMX_IJ wrt T. Vector index is counterIJ
-    mutable vector_fp m_CMX_IJ_L;
-
-    //! Derivative of m_CMX_IJ wrt TT. Vector index is counterIJ
-    mutable vector_fp m_CMX_IJ_LL;
-
-    //! Derivative of m_CMX_IJ wrt P. Vector index is counterIJ
-    mutable vector_fp m_CMX_IJ_P;
+    //! A pair of solute species with a nonzero Pitzer interaction
+    struct InteractionPair {
+        size_t i; //!< first species: the cation of a cation-anion pair
+        size_t j; //!< second species: the anion of a cation-anion pair
+        size_t counterIJ; //!< index into the binary parameter vectors
+    };
+
+    //! A triplet of solute species with a nonzero Pitzer interaction
+    struct InteractionTriplet {
+        size_t i; //!< first species
+        size_t j; //!< second species
+        size_t k; //!< third species
+        size_t n; //!< index into m_Psi_ijk: k + j * m_kk + i * m_kk * m_kk
+    };
+
+    //! Cation-anion pairs with nonzero Beta0, Beta1, Beta2 or Cphi
+    //! parameters. Set up by setupInteractions().
+    mutable std::vector<InteractionPair> m_pairsMX;
+
+    //! Pairs of ions of like sign (i < j) with a nonzero Theta parameter or
+    //! with different charge magnitudes, for which the unsymmetrical mixing
+    //! term E-theta is nonzero.
+    mutable std::vector<InteractionPair> m_pairsLike;
+
+    //! Pairs (i, j) with neutral species i and a nonzero Lambda_nj(i, j).
+    //! Here, *counterIJ* is the column index of m_Lambda_nj_coeff.
+    mutable std::vector<InteractionPair> m_pairsLambda;
+
+    //! Ternary interactions with a nonzero parameter in m_Psi_ijk. These are
+    //! either Psi interactions between two ions of like sign, i < j, and an
+    //! ion of opposite sign, k, or Zeta interactions between a neutral species
+    //! i, a cation j and an anion k. Both enter the activity coefficients in
+    //! the same way.
+    mutable std::vector<InteractionTriplet> m_triplets;
+
+    //! Neutral species with a nonzero Mu_nnn parameter
+    mutable std::vector<size_t> m_neutralsMu;
+
+    //! True if the interaction parameters were changed since the lists of
+    //! nonzero interactions were last set up
+    mutable bool m_interactionsChanged;
+
+    //! Molarcharge of the solution, called Z in Pitzer's notation
+    mutable double m_molarCharge;
 
     //! Intermediate storage of the activity coefficient itself. Vector index is
     //! the species index
@@ -2344,8 +2307,8 @@ private:
     //! Calculates the temperature derivative of the natural logarithm of the
     //! molality activity coefficients.
     /*!
-     * Public function makes sure that all dependent data is
-     * up to date, before calling a private function
+     * It is assumed that the Pitzer activity coefficient routine is called
+     * immediately preceding the call to this routine.
      */
     void s_updatePitzer_dlnMolalityActCoeff_dT() const;
 
@@ -2353,16 +2316,16 @@ private:
      * This function calculates the temperature second derivative of the
      * natural logarithm of the molality activity coefficients.
      *
-     * It is assumed that the Pitzer activity coefficient and first derivative
-     * routine are called immediately preceding the call to this routine.
+     * It is assumed that the Pitzer activity coefficient routine is called
+     * immediately preceding the call to this routine.
      */
     void s_updatePitzer_d2lnMolalityActCoeff_dT2() const;
 
     //! Calculates the Pressure derivative of the natural logarithm of the
     //! molality activity coefficients.
     /*!
-     * It is assumed that the Pitzer activity coefficient and first derivative
-     * routine are called immediately preceding the calling of this routine.
+     * It is assumed that the Pitzer activity coefficient routine is called
+     * immediately preceding the call to this routine.
      */
     void s_updatePitzer_dlnMolalityActCoeff_dP() const;
 
@@ -2378,6 +2341,41 @@ private:
      */
     void s_updatePitzer_CoeffWRTemp(int doDerivs = 2) const;
 
+    //! Set up the lists of nonzero interactions from the parameters which
+    //! have been set, so that the activity coefficient routines don't need to
+    //! loop over all pairs and triplets of species.
+    void setupInteractions() const;
+
+    //! Evaluate the Pitzer sums for one set of interaction parameters.
+    /*!
+     * At fixed composition, the logarithms of the activity coefficients are
+     * linear in the interaction parameters and in A_Debye. Therefore, their
+     * temperature and pressure derivatives are given by the same expressions
+     * evaluated with the corresponding derivatives of the parameters. The
+     * functions of the ionic strength that these expressions share (the g and
+     * h functions of each cation-anion pair) are evaluated once per state by
+     * s_updatePitzer_lnMolalityActCoeff(), which must be called first.
+     *
+     * @param beta0, beta1, beta2, Cphi, theta  Binary parameters (or their
+     *     derivatives), indexed by counterIJ
+     * @param psi     Ternary parameters (or their derivatives)
+     * @param lambda  Neutral species parameters (or their derivatives)
+     * @param mu      Neutral species self-ternary parameters (or their
+     *     derivatives)
+     * @param Aphi    A_Debye / 3 (or its derivative)
+     * @param etheta  Include the unsymmetrical mixing terms E-theta, which
+     *     only depend on the ionic strength
+     * @param lnGamma Output vector of the solute activity coefficient terms.
+     *     Element 0 (the solvent) is not changed.
+     * @returns the sum over all solutes of molality*(osmotic_coeff - 1)
+     */
+    double s_updatePitzer_sums(const vector_fp& beta0, const vector_fp& beta1,
+                               const vector_fp& beta2, const vector_fp& Cphi,
+                               const vector_fp& theta, const vector_fp& psi,
+                               const Array2D& lambda, const vector_fp& mu,
+                               double Aphi, bool etheta,
+                               vector_fp& lnGamma) const;
+
     //! Calculate the lambda interactions.
     /*!
      * Calculate E-lambda terms for charge combinations of like sign, using
@@ -0,0 +1,512 @@
+//! @file PengRobinsonMFTP.h
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef CT_PENGROBINSONMFTP_H
+#define CT_PENGROBINSONMFTP_H
+
+#include "MixtureFugacityTP.h"
+#include "cantera/base/Array.h"
+
+namespace Cantera
+{
+/**
+ * Implementation of a multi-species Peng-Robinson equation of state
+ *
+ * The equation of state is
+ *
+ * \f[
+ *    P = \frac{RT}{v-b_{mix}} - \frac{a_{mix}(T)}{v^2 + 2 b_{mix} v - b_{mix}^2}
+ * \f]
+ *
+ * with the usual van der Waals mixing rules
+ *
+ * \f[
+ *    a_{mix} = \sum_i \sum_j X_i X_j a_{ij} \sqrt{\alpha_i(T) \alpha_j(T)},
+ *    \qquad b_{mix} = \sum_i X_i b_i
+ * \f]
+ *
+ * where \f$ a_{ii} \f$ and \f$ b_i \f$ are the pure species parameters, and
+ * \f$ a_{ij} = \sqrt{a_{ii} a_{jj}} \f$ unless it is set explicitly with
+ * setBinaryCoeffs(). The temperature dependence of the "a" parameters is
+ *
+ * \f[
+ *    \alpha_i(T) = \left[ 1 + \kappa_i \left( 1 - \sqrt{T / T_{c,i}} \right)
+ *                  \right]^2
+ * \f]
+ *
+ * where \f$ \kappa_i \f$ is a function of the acentric factor of the species,
+ * and the critical temperature \f$ T_{c,i} \f$ is calculated from
+ * \f$ a_{ii} \f$ and \f$ b_i \f$.
+ *
+ * Since \f$ \sqrt{a_{ii} \alpha_i(T)} \f$ is a linear function of
+ * \f$ \sqrt{T} \f$, the mixture "a" parameter and its sums over the species,
+ * which appear in all of the partial molar properties, are quadratic
+ * functions of \f$ \sqrt{T} \f$ whose coefficients only depend on the
+ * composition. These coefficients are only recomputed when the composition or
+ * the species parameters change, and the temperature derivatives of the "a"
+ * parameter, which are needed by the heat capacities, the speed of sound and
+ * the pressure derivatives, are evaluated analytically.
+ *
+ * Properties at many states can be evaluated with getPropertiesBatch(), which
+ * shares the intermediate quantities between the properties of each state.
+ *
+ * @ingroup thermoprops
+ */
+class PengRobinsonMFTP : public MixtureFugacityTP
+{
+public:
+    //! @name Constructors and Duplicators
+    //! @{
+
+    //! Base constructor.
+    PengRobinsonMFTP();
+
+    //! Construct and initialize a PengRobinsonMFTP object directly from an
+    //! ASCII input file
+    /*!
+     * @param infile    Name of the input file containing the phase XML data
+     *                  to set up the object
+     * @param id        ID of the phase in the input file. Defaults to the empty
+     *     string.
+     */
+    PengRobinsonMFTP(const std::string& infile, const std::string& id="");
+
+    //! Construct and initialize a PengRobinsonMFTP object directly from an
+    //! XML database
+    /*!
+     *  @param phaseRef XML phase node containing the description of the phase
+     *  @param id       id attribute containing the name of the phase.  (default
+     *      is the empty string)
+     */
+    PengRobinsonMFTP(XML_Node& phaseRef, const std::string& id = "");
+
+    virtual std::string type() const {
+        return "PengRobinson";
+    }
+
+    //! @name Molar Thermodynamic properties
+    //! @{
+
+    virtual doublereal enthalpy_mole() const;
+    virtual doublereal entropy_mole() const;
+    virtual doublereal cp_mole() const;
+    virtual doublereal cv_mole() const;
+
+    //! @}
+    //! @name Mechanical Properties
+    //! @{
+
+    //! Return the thermodynamic pressure (Pa).
+    /*!
+     *  Since the mass density, temperature, and mass fractions are stored,
+     *  this method uses these values to implement the
+     *  mechanical equation of state \f$ P(T, \rho, Y_1, \dots, Y_K) \f$.
+     *
+     * \f[
+     *    P = \frac{RT}{v-b_{mix}} - \frac{a_{mix}}{v^2 + 2 b_{mix} v - b_{mix}^2}
+     * \f]
+     */
+    virtual doublereal pressure() const;
+
+    virtual doublereal isothermalCompressibility() const;
+    virtual doublereal thermalExpansionCoeff() const;
+
+    //! Speed of sound [m/s]
+    /*!
+     * \f[
+     *    c^2 = -\frac{c_p}{c_v} \frac{v^2}{W} \left( \frac{\partial P}
+     *          {\partial v} \right)_T
+     * \f]
+     *
+     * where \f$ W \f$ is the mean molecular weight.
+     */
+    doublereal soundSpeed() const;
+
+    //! Get the derivatives of the pressure at the current state
+    /*!
+     * These are the terms needed to form the Jacobian of a solver which uses
+     * the temperature, the molar volume and the species mole numbers as
+     * variables. They are evaluated analytically.
+     *
+     * @param dpdT  (output) derivative with respect to the temperature at
+     *     constant molar volume and composition [Pa/K]
+     * @param dpdV  (output) derivative with respect to the molar volume at
+     *     constant temperature and composition [Pa-kmol/m^3]
+     * @param dpdn  (output) if not null, derivatives with respect to the mole
+     *     numbers at constant temperature and total volume, multiplied by the
+     *     total number of moles [Pa]. Length: m_kk.
+     */
+    void getPressureDerivatives(doublereal& dpdT, doublereal& dpdV,
+                                doublereal* dpdn=0) const;
+
+    // @}
+
+    //! Evaluate the properties at many states
+    /*!
+     * For each state, the density is calculated from the temperature and the
+     * pressure, and the requested properties are evaluated together, sharing
+     * the terms which are common to several of them. When several states
+     * have the same composition, the mixing rules are only evaluated once.
+     * The state of the phase is not changed.
+     *
+     * When the equation of state has more than one root at a state, the root
+     * with the lowest Gibbs free energy is used, which is not necessarily the
+     * root which setState_TP() would find starting from the current state.
+     *
+     * The output arrays may be null if the corresponding property is not
+     * needed. All outputs are on a mass basis.
+     *
+     * @param nStates  Number of states
+     * @param T        Temperatures [K]. Length: nStates.
+     * @param P        Pressures [Pa]. Length: nStates.
+     * @param X        Mole fractions of state *n*, starting at `X + n * ldX`.
+     * @param ldX      Stride between the compositions of successive states.
+     *     If 0, all states have the composition *X*.
+     * @param rho      (output) Densities [kg/m^3]
+     * @param h        (output) Enthalpies [J/kg]
+     * @param s        (output) Entropies [J/kg/K]
+     * @param cp       (output) Heat capacities at constant pressure [J/kg/K]
+     * @param cv       (output) Heat capacities at constant volume [J/kg/K]
+     * @param c        (output) Speeds of sound [m/s]
+     */
+    void getPropertiesBatch(size_t nStates, const double* T, const double* P,
+                            const double* X, size_t ldX, double* rho,
+                            double* h, double* s, double* cp, double* cv,
+                            double* c);
+
+protected:
+    /**
+     * Calculate the density of the mixture using the partial molar volumes and
+     * mole fractions as input
+     *
+     * The formula for this is
+     *
+     * \f[
+     * \rho = \frac{\sum_k{X_k W_k}}{\sum_k{X_k V_k}}
+     * \f]
+     *
+     * where \f$X_k\f$ are the mole fractions, \f$W_k\f$ are the molecular
+     * weights, and \f$V_k\f$ are the partial molar volumes.
+     */
+    virtual void calcDensity();
+
+    virtual void setTemperature(const doublereal temp);
+    virtual void compositionChanged();
+
+public:
+    virtual void getActivityConcentrations(doublereal* c) const;
+
+    //! Returns the standard concentration \f$ C^0_k \f$, which is used to
+    //! normalize the generalized concentration.
+    /*!
+     * The standard state is an ideal gas at the temperature and pressure of
+     * the solution, so \f$ C^0_k = P/\hat R T \f$.
+     *
+     * @param k Optional parameter indicating the species. The default is to
+     *          assume this refers to species 0.
+     * @return
+     *   Returns the standard Concentration in units of m3 kmol-1.
+     */
+    virtual doublereal standardConcentration(size_t k=0) const;
+
+    //! Get the array of non-dimensional activity coefficients at the current
+    //! solution temperature, pressure, and solution concentration.
+    /*!
+     * For all objects with the Mixture Fugacity approximation, we define the
+     * standard state as an ideal gas at the current temperature and pressure of
+     * the solution. The activity coefficients are then the fugacity
+     * coefficients of the species.
+     *
+     * @param ac Output vector of activity coefficients. Length: m_kk.
+     */
+    virtual void getActivityCoefficients(doublereal* ac) const;
+
+    /// @name  Partial Molar Properties of the Solution
+    //@{
+
+    virtual void getChemPotentials_RT(doublereal* mu) const;
+    virtual void getChemPotentials(doublereal* mu) const;
+    virtual void getPartialMolarEnthalpies(doublereal* hbar) const;
+
+    //! Get the species partial molar entropies [J/kmol/K]. These are
+    //! calculated from the partial molar enthalpies and the chemical
+    //! potentials.
+    virtual void getPartialMolarEntropies(doublereal* sbar) const;
+
+    virtual void getPartialMolarIntEnergies(doublereal* ubar) const;
+
+    //! Get the species partial molar heat capacities [J/kmol/K]. Only the
+    //! ideal gas contributions are included.
+    virtual void getPartialMolarCp(doublereal* cpbar) const;
+
+    virtual void getPartialMolarVolumes(doublereal* vbar) const;
+
+    //@}
+    /// @name Critical State Properties.
+    //@{
+
+    virtual doublereal critTemperature() const;
+    virtual doublereal critPressure() const;
+    virtual doublereal critVolume() const;
+    virtual doublereal critCompressibility() const;
+    virtual doublereal critDensity() const;
+
+public:
+    //@}
+    //! @name Initialization Methods - For Internal use
+    /*!
+     * The following methods are used in the process of constructing
+     * the phase and setting its parameters from a specification in an
+     * input file. They are not normally used in application programs.
+     * To see how they are used, see importPhase().
+     */
+    //@{
+
+    virtual bool addSpecies(shared_ptr<Species> spec);
+    virtual void setToEquilState(const doublereal* lambda_RT);
+    virtual void initThermoXML(XML_Node& phaseNode, const std::string& id);
+
+    //! Set the pure fluid interaction parameters for a species
+    /*!
+     *  @param species   Name of the species
+     *  @param a         "a" parameter in the Peng-Robinson model at the
+     *      critical temperature [Pa-m^6/kmol^2]
+     *  @param b         "b" parameter in the Peng-Robinson model [m^3/kmol]
+     *  @param w         acentric factor
+     */
+    void setSpeciesCoeffs(const std::string& species, double a, double b,
+                          double w);
+
+    //! Set the interaction parameter between two species
+    /*!
+     *  The "a" parameter for interactions between species *i* and *j* is
+     *  computed by default as \f$ a_{ij} = \sqrt{a_{ii} a_{jj}} \f$. This
+     *  function overrides the default with the specified value. In both cases,
+     *  the temperature dependence is given by
+     *  \f$ \sqrt{\alpha_i(T) \alpha_j(T)} \f$.
+     *
+     *  @param species_i   Name of one species
+     *  @param species_j   Name of the other species
+     *  @param a           "a" parameter for the pair [Pa-m^6/kmol^2]
+     */
+    void setBinaryCoeffs(const std::string& species_i,
+                         const std::string& species_j, double a);
+
+private:
+    //! Read the pure species PengRobinson input parameters
+    /*!
+     *  @param pureFluidParam   XML_Node for the pure fluid parameters
+     */
+    void readXMLPureFluid(XML_Node& pureFluidParam);
+
+    //! Read the cross species PengRobinson input parameters
+    /*!
+     *  @param crossFluidParam   XML_Node for the cross fluid parameters
+     */
+    void readXMLCrossFluid(XML_Node& crossFluidParam);
+
+    // @}
+
+protected:
+    // Special functions inherited from MixtureFugacityTP
+    virtual doublereal sresid() const;
+    virtual doublereal hresid() const;
+
+public:
+    virtual doublereal liquidVolEst(doublereal TKelvin, doublereal& pres) const;
+    virtual doublereal densityCalc(doublereal TKelvin, doublereal pressure, int phase, doublereal rhoguess);
+
+    virtual doublereal densSpinodalLiquid() const;
+    virtual doublereal densSpinodalGas() const;
+    virtual doublereal pressureCalc(doublereal TKelvin, doublereal molarVol) const;
+    virtual doublereal dpdVCalc(doublereal TKelvin, doublereal molarVol, doublereal& presCalc) const;
+
+    //! Calculate dpdV and dpdT at the current conditions
+    /*!
+     *  These are stored internally.
+     */
+    void pressureDerivatives() const;
+
+    virtual void updateMixingExpressions();
+
+    //! Update the a and b parameters
+    /*!
+     *  The a and the b parameters depend on the mole fraction and the
+     *  temperature. This function updates the internal numbers based on the
+     *  state of the object.
+     *
+     *  The coefficients of the mixing sums are only recomputed when the
+     *  composition or the species parameters have changed. A change of
+     *  temperature only requires an update which is linear in the number of
+     *  species.
+     */
+    void updateAB();
+
+    //! Calculate the a and the b parameters given the temperature
+    /*!
+     * This function doesn't change the internal state of the object, so it is a
+     * const function. It uses the mixing sums for the current composition
+     * computed by updateAB().
+     *
+     * @param temp  Temperature (TKelvin)
+     * @param aCalc (output)  Returns the a value
+     * @param bCalc (output)  Returns the b value.
+     */
+    void calculateAB(doublereal temp, doublereal& aCalc, doublereal& bCalc) const;
+
+    // Special functions not inherited from MixtureFugacityTP
+
+    //! Temperature derivative of the mixture "a" parameter
+    doublereal da_dt() const;
+
+    //! Second temperature derivative of the mixture "a" parameter
+    doublereal d2a_dt2() const;
+
+    //! Calculate the pseudo-critical properties of the mixture
+    /*!
+     * The critical temperature is the temperature at which
+     * \f$ a_{mix}(T) / (b_{mix} R T) \f$ takes the value it has at the
+     * critical point of a pure Peng-Robinson fluid. This is a quadratic
+     * equation in \f$ \sqrt{T} \f$.
+     */
+    void calcCriticalConditions(doublereal& pc, doublereal& tc,
+                                doublereal& vc) const;
+
+    //! Solve the cubic equation of state
+    /*!
+     * The P-R equation of state is solved for the compressibility factor,
+     * which is better conditioned than the cubic in the molar volume at low
+     * pressures:
+     *
+     *     Z**3 - (1 - B) Z**2 + (A - 3 B**2 - 2 B) Z - (A B - B**2 - B**3) = 0
+     *
+     * where A = a P / (R T)**2 and B = b P / (R T). The roots are returned as
+     * molar volumes in increasing order.
+     *
+     * Returns the number of solutions found. If it only finds the liquid
+     * branch solution, it will return a -1 or a -2 instead of 1 or 2.
+     */
+    int solveCubic(double TKelvin, double pres, doublereal a, doublereal b,
+                   doublereal Vroot[3]) const;
+
+protected:
+    //! Value of b in the equation of state
+    /*!
+     *  m_b is a function of the mole fraction.
+     */
+    doublereal m_b_current;
+
+    //! Value of a in the equation of state
+    /*!
+     *  a_b is a function of the temperature and the mole fraction.
+     */
+    doublereal m_a_current;
+
+    //! Temperature derivative of #m_a_current
+    doublereal m_dadT_current;
+
+    //! Second temperature derivative of #m_a_current
+    doublereal m_d2adT2_current;
+
+    //! Pure species "b" parameters
+    vector_fp b_vec_Curr_;
+
+    //! Pure species "a" parameters at the critical temperature (diagonal) and
+    //! the pairwise "a" parameters (off-diagonal) [Pa-m^6/kmol^2]
+    Array2D m_a_coeffs;
+
+    //! Acentric factors of the species
+    vector_fp m_acentric;
+
+    //! Coefficients of the square roots of the pure species "a" parameters,
+    //! \f$ \sqrt{a_{ii} \alpha_i(T)} = A_i - B_i \sqrt{T} \f$. `m_sqrtA0[k]`
+    //! is \f$ A_k \f$.
+    vector_fp m_sqrtA0;
+
+    //! Coefficients \f$ B_k \f$ of the square roots of the pure species "a"
+    //! parameters. See #m_sqrtA0.
+    vector_fp m_sqrtA1;
+
+    //! Pairs of species (*i*, *j*) with *i* < *j* for which the pairwise "a"
+    //! parameter differs from the default value
+    std::vector<std::pair<size_t, size_t>> m_binaryPairs;
+
+    //! Deviations \f$ a_{ij} / \sqrt{a_{ii} a_{jj}} - 1 \f$ of the pairs in
+    //! #m_binaryPairs from the default mixing rule
+    vector_fp m_binaryDelta;
+
+    //! Sums over the mole fractions \f$ \sum_j X_j (a_{ij} / \sqrt{a_{ii}
+    //! a_{jj}}) A_j \f$, which only depend on the composition. These are
+    //! the same for all species except for the corrections from the pairs in
+    //! #m_binaryPairs, so their cost is linear in the number of species.
+    vector_fp m_sumA0;
+
+    //! Sums over the mole fractions \f$ \sum_j X_j (a_{ij} / \sqrt{a_{ii}
+    //! a_{jj}}) B_j \f$, which only depend on the composition
+    vector_fp m_sumA1;
+
+    //! Coefficients of the mixture "a" parameter, \f$ a_{mix} = c_0 - 2 c_1
+    //! \sqrt{T} + c_2 T \f$, which only depend on the composition
+    double m_aCoeffs[3];
+
+    //! Sums over the mole fractions of the pairwise "a" parameters at the
+    //! current temperature: `m_aSum[k]` is the sum of \f$ X_i a_{ki}(T) \f$
+    vector_fp m_aSum;
+
+    //! Temperature derivatives of #m_aSum
+    vector_fp m_daSumdT;
+
+    //! Value of stateMFNumber() for which the composition-dependent sums were
+    //! computed, or -2 if they need to be recomputed because the parameters
+    //! changed
+    int m_mixStateNum;
+
+    int NSolns_;
+
+    doublereal Vroot_[3];
+
+    //! Temporary storage - length = m_kk.
+    mutable vector_fp m_pp;
+
+    //! Temporary storage - length = m_kk.
+    mutable vector_fp m_tmpV;
+
+    // Partial molar volumes of the species
+    mutable vector_fp m_partialMolarVolumes;
+
+    //! The derivative of the pressure wrt the volume
+    /*!
+     * Calculated at the current conditions. temperature and mole number kept
+     * constant
+     */
+    mutable doublereal dpdV_;
+
+    //! The derivative of the pressure wrt the temperature
+    /*!
+     *  Calculated at the current conditions. Total volume and mole number kept
+     *  constant
+     */
+    mutable doublereal dpdT_;
+
+    //! Vector of derivatives of pressure wrt mole number
+    /*!
+     *  Calculated at the current conditions. Total volume, temperature and
+     *  other mole number kept constant
+     */
+    mutable vector_fp dpdni_;
+
+public:
+    //! Omega constant for a -> value of a in terms of critical properties
+    static const doublereal omega_a;
+
+    //! Omega constant for b
+    static const doublereal omega_b;
+
+    //! Omega constant for the critical molar volume
+    static const doublereal omega_vc;
+};
+}
+
+#endif
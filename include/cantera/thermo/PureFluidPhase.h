@@ -15,7 +15,7 @@
 #define CT_EOS_TPX_H
 
 #include "ThermoPhase.h"
-#include "cantera/tpx/Sub.h"
+#include "cantera/tpx/SubTable.h"
 
 namespace Cantera
 {
@@ -90,6 +90,12 @@ public:
     //! Returns a reference to the substance object
     tpx::Substance& TPX_Substance();
 
+    //! Use a tabulated approximation of the equation of state of the
+    //! substance, or go back to the exact one if *table* is empty. The table
+    //! must have been built for the same substance. See tpx::SubstanceTable.
+    //! This function should be called after initThermo().
+    void useTable(shared_ptr<const tpx::SubstanceTable> table);
+
     //@}
     /// @name Properties of the Standard State of the Species in the Solution
     /*!
@@ -262,13 +262,20 @@ public:
      *  The a and the b parameters depend on the mole fraction and the
      *  temperature. This function updates the internal numbers based on the
      *  state of the object.
+     *
+     *  The sums of the pairwise "a" coefficients over the mole fractions,
+     *  which are needed by the mixture "a" parameter and by all of the partial
+     *  molar properties, are only recomputed when the composition or the
+     *  coefficients have changed. A change of temperature only requires an
+     *  update which is linear in the number of species.
      */
     void updateAB();
 
     //! Calculate the a and the b parameters given the temperature
     /*!
      * This function doesn't change the internal state of the object, so it is a
-     * const function.  It does use the stored mole fractions in the object.
+     * const function.  It uses the sums over the current composition computed
+     * by updateAB().
      *
      * @param temp  Temperature (TKelvin)
      * @param aCalc (output)  Returns the a value
@@ -278,6 +285,7 @@ public:
 
     // Special functions not inherited from MixtureFugacityTP
 
+    //! Temperature derivative of the mixture "a" parameter
     doublereal da_dt() const;
 
     void calcCriticalConditions(doublereal a, doublereal b, doublereal a0_coeff, doublereal aT_coeff,
@@ -296,6 +304,21 @@ public:
     int NicholsSolve(double TKelvin, double pres, doublereal a, doublereal b,
                      doublereal Vroot[3]) const;
 
+    //! Solve the cubic equation of state using Newton's method, starting from
+    //! the molar volume *Vguess*.
+    /*!
+     * This is used by densityCalc() to reuse the molar volume of the previous
+     * state when the equation of state has a single real root, which is
+     * checked before Newton's method is used.
+     *
+     * @returns the number of solutions found, with the same meaning as for
+     *     NicholsSolve(), or 0 if the cubic has more than one real root or
+     *     Newton's method did not converge. In that case, NicholsSolve()
+     *     should be used instead.
+     */
+    int NewtonSolve(double TKelvin, double pres, doublereal a, doublereal b,
+                    doublereal Vguess, doublereal Vroot[3]) const;
+
 protected:
     //! Form of the temperature parameterization
     /*!
@@ -316,11 +339,37 @@ protected:
      */
     doublereal m_a_current;
 
-    vector_fp a_vec_Curr_;
+    //! Constant part of the mixture "a" parameter
+    doublereal m_a0_current;
+
+    //! Temperature derivative of the mixture "a" parameter
+    doublereal m_dadT_current;
+
     vector_fp b_vec_Curr_;
 
+    //! Coefficients of the pairwise "a" parameters. The constant and the
+    //! temperature-proportional terms for species *i* and *j* are
+    //! `a_coeff_vec(0, i + m_kk * j)` and `a_coeff_vec(1, i + m_kk * j)`.
     Array2D a_coeff_vec;
 
+    //! Sums over the mole fractions of the constant parts of the pairwise "a"
+    //! parameters: `m_aSum0[k]` is the sum of \f$ X_i a_{ki,0} \f$
+    vector_fp m_aSum0;
+
+    //! Sums over the mole fractions of the temperature-proportional parts of
+    //! the pairwise "a" parameters
+    vector_fp m_aSum1;
+
+    //! Sums over the mole fractions of the pairwise "a" parameters at the
+    //! current temperature. These appear in all of the partial molar
+    //! properties.
+    vector_fp m_aSum;
+
+    //! Value of stateMFNumber() for which #m_aSum0 and #m_aSum1 were
+    //! computed, or -2 if they need to be recomputed because the coefficients
+    //! changed
+    int m_mixStateNum;
+
     int NSolns_;
 
     doublereal Vroot_[3];
@@ -18,6 +18,8 @@
 namespace Cantera
 {
 
+class EquilState;
+
 /*!
  * @name CONSTANTS - Specification of the Molality convention
  */
@@ -1140,6 +1142,63 @@ public:
      */
     virtual void setState_RPY(doublereal rho, doublereal p, const std::string& y);
 
+    //! Set the temperature so that the specific enthalpy, internal energy or
+    //! entropy equals a target value, using Newton's method.
+    /*!
+     * The composition and either the pressure or the density are held fixed.
+     * The iteration starts from the current temperature, so only one or two
+     * iterations are needed when the target is close to the current state, as
+     * it is when the state is updated repeatedly during time integration. Each
+     * iteration evaluates the property and the corresponding heat capacity,
+     * cp or cv, once at the same temperature. Each step is limited to a
+     * factor of two change in the temperature.
+     *
+     * setState_HP(), setState_UV(), setState_SP() and setState_SV() try this
+     * method first, and fall back to a slower but more robust iteration if it
+     * fails.
+     *
+     * @param target  Specific enthalpy or internal energy (J/kg), or specific
+     *                entropy (J/kg/K)
+     * @param rtol    The iteration has converged when the last temperature
+     *                step is smaller than rtol * T.
+     * @param doV     If true, the density is held fixed and the target is the
+     *                internal energy (or the entropy). Otherwise, the pressure
+     *                is held fixed and the target is the enthalpy (or the
+     *                entropy).
+     * @param doS     If true, the target is the entropy.
+     * @param maxIter Maximum number of iterations
+     * @returns true if the iteration converged. Otherwise, including when
+     *     the phase can't be evaluated at one of the iterates, the initial
+     *     temperature is restored and false is returned.
+     */
+    bool solveTemperature(double target, double rtol, bool doV, bool doS,
+                          int maxIter=20);
+
+    //! Number of calls to solveTemperature() since the last call to
+    //! resetTemperatureStats()
+    size_t nTemperatureSolves() const {
+        return m_nTempSolves;
+    }
+
+    //! Number of evaluations of the property and heat capacity by
+    //! solveTemperature() since the last call to resetTemperatureStats()
+    size_t nTemperatureEvals() const {
+        return m_nTempEvals;
+    }
+
+    //! Number of calls to solveTemperature() which failed to converge since
+    //! the last call to resetTemperatureStats()
+    size_t nTemperatureFailures() const {
+        return m_nTempFailures;
+    }
+
+    //! Reset the counters of solveTemperature()
+    void resetTemperatureStats() {
+        m_nTempSolves = 0;
+        m_nTempEvals = 0;
+        m_nTempFailures = 0;
+    }
+
     //@}
 
 private:
@@ -1205,12 +1264,19 @@ public:
      *  @param log_level  loglevel Controls amount of diagnostic output.
      *      log_level=0 suppresses diagnostics, and increasingly-verbose
      *      messages are written as loglevel increases.
+     *  @param warm_start  Optional solver state for the 'element_potential'
+     *      solver. If it holds the state of a previous calculation, that state
+     *      is used as the initial guess instead of estimating the element
+     *      potentials and temperature. On a successful return, it contains the
+     *      new solver state, including the number of iterations taken. It is
+     *      marked as invalid if the 'element_potential' solver fails.
      *
      * @ingroup equilfunctions
      */
     void equilibrate(const std::string& XY, const std::string& solver="auto",
                      double rtol=1e-9, int max_steps=50000, int max_iter=100,
-                     int estimate_equil=0, int log_level=0);
+                     int estimate_equil=0, int log_level=0,
+                     EquilState* warm_start=nullptr);
 
     //!This method is used by the ChemEquil equilibrium solver.
     /*!
@@ -1639,6 +1705,12 @@ protected:
 
     //! last value of the temperature processed by reference state
     mutable doublereal m_tlast;
+
+private:
+    //! Counters of solveTemperature()
+    size_t m_nTempSolves;
+    size_t m_nTempEvals;
+    size_t m_nTempFailures;
 };
 
 //! typedef for the ThermoPhase class
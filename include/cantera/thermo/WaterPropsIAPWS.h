@@ -12,6 +12,7 @@
 #define WATERPROPSIAPWS_H
 
 #include "WaterPropsIAPWSphi.h"
+#include "WaterPropsIAPWSTable.h"
 
 namespace Cantera
 {
@@ -392,6 +393,24 @@ public:
         return 322.;
     }
 
+    //! Use a tabulated approximation of the equation of state.
+    /*!
+     * The residual Helmholtz free energy and its derivatives are interpolated
+     * from *table* wherever the table meets its tolerance, and psat() uses
+     * the tabulated saturation curve. All other states are evaluated with the
+     * exact formulation. The same table may be shared by many objects. See
+     * WaterPropsIAPWSTable.
+     *
+     * @param table  Table to use, or an empty pointer to go back to the exact
+     *     formulation.
+     */
+    void useTable(shared_ptr<const WaterPropsIAPWSTable> table);
+
+    //! The table used by this object, if any. See useTable().
+    shared_ptr<const WaterPropsIAPWSTable> table() const {
+        return m_table;
+    }
+
 private:
     //! Calculate the dimensionless temp and rho and store internally.
     /*!
@@ -435,6 +454,9 @@ private:
 
     //! Current state of the system
     mutable int iState;
+
+    //! Tabulated equation of state, if any. See useTable().
+    shared_ptr<const WaterPropsIAPWSTable> m_table;
 };
 
 }
@@ -0,0 +1,196 @@
+/**
+ * @file WaterPropsIAPWSTable.h
+ * Header for a tabulated approximation to the residual Helmholtz free energy
+ * of water (see class \link Cantera::WaterPropsIAPWSTable
+ * WaterPropsIAPWSTable\endlink).
+ */
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef WATERPROPSIAPWSTABLE_H
+#define WATERPROPSIAPWSTABLE_H
+
+#include "cantera/base/ct_defs.h"
+#include <array>
+
+namespace Cantera
+{
+
+//! Tabulated fast evaluation of the IAPWS-95 formulation for water.
+/*!
+ * The residual part of the dimensionless Helmholtz free energy,
+ * \f$ \phi^r(\tau, \delta) \f$, and its first and second derivatives are
+ * interpolated with piecewise bicubic Hermite polynomials in
+ * \f$ \tau = T_c / T \f$ and \f$ \delta = \rho / \rho_c \f$. The grid is
+ * uniform in \f$ \tau \f$. Above \f$ \delta = 0.2 \f$ it is also uniform in
+ * \f$ \delta \f$; below, it is uniform in \f$ \ln(1 + \delta / 10^{-5})
+ * \f$, so that the dilute vapor at low temperatures is resolved right up to
+ * the saturation curve, beyond which \f$ \phi^r \f$ grows by many orders of
+ * magnitude within the two-phase region. Three fields
+ * are tabulated: \f$ \phi^r \f$, \f$ \phi^r_\delta \f$ and \f$ \phi^r_\tau
+ * \f$. The second derivatives are the derivatives of the interpolants of the
+ * first derivatives, so that the pressure and \f$ dp/d\rho \f$ used by the
+ * density iteration are consistent with each other. The ideal gas part
+ * \f$ \phi^o \f$ is inexpensive and is always evaluated exactly by
+ * WaterPropsIAPWSphi.
+ *
+ * When the table is constructed, every cell is checked against the exact
+ * formulation at its center and at its four 2x2 Gauss points, where the
+ * errors in the interpolated values and derivatives, respectively, are
+ * largest. A cell is only used if, at all of these points,
+ *   - the relative error in the density at fixed (T, P) implied by the
+ *     error in the pressure,
+ *   - the relative errors in \f$ dp/d\rho \f$, \f$ c_v \f$ and \f$ c_p \f$,
+ *   - the absolute errors in \f$ \phi^r \f$ and \f$ \tau \phi^r_\tau \f$
+ *     (that is, in g/RT, h/RT and s/R)
+ *
+ * are below half of the requested tolerance. Cells that fail the test, for example
+ * those near the critical point or crossing a spinodal, and states outside
+ * the tabulated range are evaluated with the exact formulation.
+ *
+ * The saturation curve is handled explicitly by a separate one-dimensional
+ * table of ln(psat), and of the saturated liquid and vapor densities, as
+ * cubic Hermite polynomials in T. The derivatives at the nodes are exact:
+ * dpsat/dT comes from the Clapeyron equation and the slopes of the
+ * saturated densities from the equation of state. The table stops at the
+ * highest temperature below which all of its intervals meet the tolerance.
+ *
+ * A table is immutable after construction, and may be shared by any number
+ * of WaterPropsIAPWS objects through WaterPropsIAPWS::useTable().
+ *
+ * @ingroup thermoprops
+ */
+class WaterPropsIAPWSTable
+{
+public:
+    //! Build the table.
+    /*!
+     * @param rtol     Tolerance used to accept or reject each cell
+     * @param Tmin     Lowest tabulated temperature (K)
+     * @param Tmax     Highest tabulated temperature (K)
+     * @param rhoMax   Highest tabulated density (kg m-3)
+     * @param nTau     Number of grid points in tau
+     * @param nDense   Number of density grid points above the vapor region
+     * @param nVapor   Number of density grid points in the vapor region
+     * @param nSat     Number of grid points of the saturation table
+     */
+    WaterPropsIAPWSTable(double rtol = 1.0e-6, double Tmin = 273.16,
+                         double Tmax = 1273.15, double rhoMax = 1250.0,
+                         size_t nTau = 121, size_t nDense = 241,
+                         size_t nVapor = 101, size_t nSat = 201);
+
+    WaterPropsIAPWSTable(const WaterPropsIAPWSTable& right) = delete;
+    WaterPropsIAPWSTable& operator=(const WaterPropsIAPWSTable& right) = delete;
+
+    //! Interpolate the residual Helmholtz free energy and its derivatives.
+    /*!
+     * @param tau      Dimensionless temperature = T_c/T
+     * @param delta    Dimensionless density = rho / Rho_c
+     * @param phiR     Output array of length 6 containing, in order,
+     *     phiR, phiR_d, phiR_dd, phiR_t, phiR_tt and phiR_dt.
+     * @returns false, and leaves *phiR* untouched, if (tau, delta) is
+     *     outside of the table or in a cell that did not meet the tolerance.
+     */
+    bool evalResidual(double tau, double delta, double* phiR) const;
+
+    //! Interpolate the saturation pressure and the densities of the
+    //! saturated liquid and vapor.
+    /*!
+     * @param T        Temperature (K)
+     * @param psat     Output saturation pressure (Pa)
+     * @param rhoLiq   Output density of the saturated liquid (kg m-3)
+     * @param rhoGas   Output density of the saturated vapor (kg m-3)
+     * @returns false if T is outside of the saturation table.
+     */
+    bool saturation(double T, double& psat, double& rhoLiq,
+                    double& rhoGas) const;
+
+    //! Tolerance used to build the table
+    double rtol() const {
+        return m_rtol;
+    }
+
+    //! Fraction of the cells of the Helmholtz table which met the tolerance
+    double validFraction() const;
+
+    //! Highest temperature covered by the saturation table (K)
+    double maxSaturationTemperature() const {
+        return m_satTmax;
+    }
+
+private:
+    //! Node values of the tabulated fields
+    /*!
+     * For each of the fields phiR, phiR_d and phiR_t, the value and its
+     * derivatives with respect to tau, y, and tau and y, where y is the
+     * density coordinate of the patch.
+     */
+    struct Node {
+        double f[3][4];
+    };
+
+    //! Part of the table that is uniform in tau and in a density coordinate
+    /*!
+     * The density coordinate is y = ln(1 + delta / deltaScale) if deltaScale
+     * is positive, and y = delta otherwise.
+     */
+    struct Patch {
+        double deltaScale;
+        double tauMin, dtau;
+        double yMin, dy;
+        size_t nTau, nY;
+
+        //! Node data, stored with y varying fastest
+        std::vector<Node> nodes;
+
+        //! Whether each cell met the tolerance
+        std::vector<char> valid;
+    };
+
+    //! Fill the nodes of *patch* and check all of its cells
+    void buildPatch(Patch& patch, double deltaMin, double deltaMax,
+                    double deltaScale, size_t nY);
+
+    //! Evaluate the exact node data at (tau, delta)
+    /*!
+     * @param jac  Derivative of delta with respect to the density coordinate
+     */
+    void exactNode(double tau, double delta, double jac, Node& node) const;
+
+    //! Check the interpolant against the exact formulation at (tau, y)
+    bool checkPoint(const Patch& patch, size_t i, size_t j, double tau,
+                    double y) const;
+
+    //! Interpolate at (tau, y) in cell (i, j), without the validity check
+    void interpolate(const Patch& patch, size_t i, size_t j, double tau,
+                     double y, double* phiR) const;
+
+    //! Find the valid cell of *patch* containing (tau, delta) and interpolate
+    bool evalPatch(const Patch& patch, double tau, double delta,
+                   double* phiR) const;
+
+    //! Build the saturation table
+    void buildSaturation(size_t nSat);
+
+    //! Evaluate the saturation interpolant in interval *k*
+    void interpolateSat(size_t k, double T, double* y) const;
+
+    double m_rtol;
+
+    //! Table of the dilute vapor, with a logarithmic density coordinate
+    Patch m_vapor;
+
+    //! Table of the dense fluid, uniform in density
+    Patch m_dense;
+
+    //! Grid of the saturation table
+    double m_satTmin, m_satdT, m_satTmax;
+
+    //! Node data of the saturation table: ln(psat), rhoLiq and rhoGas,
+    //! followed by their temperature derivatives
+    std::vector<std::array<double, 6>> m_sat;
+};
+
+}
+#endif
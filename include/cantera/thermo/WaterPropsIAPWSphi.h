@@ -18,6 +18,8 @@
 namespace Cantera
 {
 
+class WaterPropsIAPWSTable;
+
 //! Low level class for the real description of water.
 /*!
  * The reference is W. Wagner, A. Pruss, "The IAPWS Formulation 1995 for the
@@ -149,6 +151,17 @@ public:
      */
     doublereal phiR() const;
 
+    //! Use a tabulated approximation of the residual Helmholtz free energy.
+    /*!
+     * After this call, tdpolycalc() interpolates phiR and its derivatives
+     * from *table* wherever the table is valid, and the exact polynomials are
+     * only evaluated elsewhere. The table is not owned by this object.
+     *
+     * @param table  Table to use, or nullptr to go back to the exact
+     *     formulation everywhere.
+     */
+    void setTable(const WaterPropsIAPWSTable* table);
+
 protected:
     //! Calculate Equation 6.5 for phi0, the ideal gas part of the
     //! dimensionless Helmholtz free energy.
@@ -190,6 +203,18 @@ protected:
 
     //! Last delta that was used to calculate polynomials
     doublereal DELTAsave;
+
+    //! Table of the residual Helmholtz free energy, if any
+    const WaterPropsIAPWSTable* m_table;
+
+    //! True if the values in #m_tabPhiR are used for the current state
+    bool m_useTab;
+
+    //! Tabulated phiR, phiR_d, phiR_dd, phiR_t, phiR_tt and phiR_dt at the
+    //! current state
+    doublereal m_tabPhiR[6];
+
+    friend class WaterPropsIAPWSTable;
 };
 
 } // namespace Cantera
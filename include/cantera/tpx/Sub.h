@@ -8,6 +8,7 @@
 
 #include "cantera/base/ctexceptions.h"
 #include <algorithm>
+#include <memory>
 
 namespace tpx
 {
@@ -31,6 +32,8 @@ enum type { H, S, U, V, P, T };
 
 const double Undef = 999.1234;
 
+class SubstanceTable;
+
 /*!
  * Base class from which all pure substances are derived
  */
@@ -172,6 +175,23 @@ public:
     //! second property.
     void Set(PropertyPair::type XY, double x0, double y0);
 
+    //! Use a tabulated approximation of the equation of state.
+    /*!
+     * The single-phase properties and the saturation states are interpolated
+     * from *table* wherever the table meets its tolerance. All other states
+     * are evaluated with the exact equation of state. The same table may be
+     * shared by many objects for the same substance. See SubstanceTable.
+     *
+     * @param table  Table to use, or an empty pointer to go back to the exact
+     *     equation of state.
+     */
+    void useTable(std::shared_ptr<const SubstanceTable> table);
+
+    //! The table used by this object, if any. See useTable().
+    std::shared_ptr<const SubstanceTable> table() const {
+        return m_table;
+    }
+
 protected:
     double T, Rho;
     double Tslast, Rhf, Rhv;
@@ -217,11 +237,45 @@ private:
                 double X, double Y,
                 double atx, double aty, double rtx, double rty);
 
+    //! Evaluate the tabulated properties at the current state, if the table
+    //! is valid there. The results are stored in #m_tab.
+    bool tabulated();
+
+    //! Tabulated value of property *ijob* at the current state, followed by
+    //! its derivatives with respect to ln(T) and ln(rho). Requires that
+    //! tabulated() has returned true for the current state.
+    void tabulatedProp(propertyFlag::type ijob, double* f);
+
+    //! Set a single-phase state for the property pair (*ifx*, *ify*) with
+    //! Newton's method, using the derivatives of the tabulated equation of
+    //! state and starting from the current state. Returns false, and restores
+    //! the current state, if an iterate leaves the valid part of the table,
+    //! if the iteration does not converge, or if the solution is inside the
+    //! dome. The tolerances are the same as for set_xy().
+    bool set_xy_tabulated(propertyFlag::type ifx, propertyFlag::type ify,
+                          double X, double Y, double atx, double aty,
+                          double rtx, double rty);
+
+    //! Tabulated equation of state, if any. See useTable().
+    std::shared_ptr<const SubstanceTable> m_table;
+
+    //! State at which #m_tab was last evaluated
+    double m_tabT, m_tabRho;
+
+    //! True if the table was valid at (#m_tabT, #m_tabRho)
+    bool m_tabValid;
+
+    //! Tabulated P, u and s and their derivatives at (#m_tabT, #m_tabRho),
+    //! including the energy and entropy offsets. See SubstanceTable::eval().
+    double m_tab[9];
+
     int kbr;
     double Vmin, Vmax;
     double Pmin, Pmax;
     double dvbf, dv;
     double v_here, P_here;
+
+    friend class SubstanceTable;
 };
 
 }
@@ -0,0 +1,187 @@
+//! @file SubTable.h
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#ifndef TPX_SUBTABLE_H
+#define TPX_SUBTABLE_H
+
+#include "cantera/tpx/Sub.h"
+#include <array>
+#include <vector>
+
+namespace tpx
+{
+
+//! Tabulated fast evaluation of the equation of state of a Substance.
+/*!
+ * The compressibility factor \f$ Z = P / (\rho R T) \f$, the internal energy
+ * and the entropy of the single-phase fluid are interpolated with piecewise
+ * bicubic Hermite polynomials in \f$ x = \ln T \f$ and
+ * \f$ y = \rho / \rho_s + \ln(\rho / \rho_s) \f$, where
+ * \f$ \rho_s = \rho_c / 4 \f$. The density coordinate is logarithmic for the
+ * dilute vapor and nearly linear for the dense liquid, so that a single
+ * uniform grid resolves both. The derivatives with respect
+ * to T and rho, which give \f$ c_v \f$, \f$ c_p \f$ and the derivatives used
+ * to invert the property pairs, are the derivatives of the interpolants.
+ * The values at the nodes are those of the exact equation of state; the
+ * derivatives at the nodes are central differences of it.
+ *
+ * When the table is constructed, every cell is checked against the exact
+ * equation of state at its center and at its four 2x2 Gauss points. A cell is
+ * only used if, at all of these points, dP/drho is positive and
+ *   - the relative error in the density at fixed (T, P) implied by the error
+ *     in the pressure,
+ *   - the errors in u/RT, h/RT and s/R,
+ *   - the relative errors in \f$ c_v \f$ and \f$ c_p \f$
+ *
+ * are below half of the requested tolerance. Cells that fail the test, for
+ * example those near the critical point or inside the spinodals, and states
+ * outside the tabulated range are evaluated with the exact equation of state.
+ *
+ * The saturation curve is handled by a separate one-dimensional table of
+ * ln(Psat), and of the saturated liquid and vapor densities, as cubic Hermite
+ * polynomials in T. The derivatives at the nodes are exact: dPsat/dT comes
+ * from the Clapeyron equation and the slopes of the saturated densities from
+ * the equation of state. The table stops at the highest temperature below
+ * which all of its intervals meet the tolerance.
+ *
+ * The table does not include the energy and entropy offsets set by
+ * Substance::setStdState(). It is immutable after construction, and may be
+ * shared by any number of Substance objects for the same fluid through
+ * Substance::useTable().
+ */
+class SubstanceTable
+{
+public:
+    //! Build the table.
+    /*!
+     * @param sub   Substance to tabulate. Its state is restored after the
+     *     table has been built.
+     * @param rtol  Tolerance used to accept or reject each cell
+     * @param nT    Number of grid points in ln(T)
+     * @param nRho  Number of grid points in the density coordinate
+     * @param nSat  Number of grid points of the saturation table
+     */
+    SubstanceTable(Substance& sub, double rtol = 1.0e-6, size_t nT = 161,
+                   size_t nRho = 401, size_t nSat = 201);
+
+    SubstanceTable(const SubstanceTable& right) = delete;
+    SubstanceTable& operator=(const SubstanceTable& right) = delete;
+
+    //! Interpolate the single-phase properties at (T, rho).
+    /*!
+     * @param T      Temperature (K)
+     * @param rho    Density (kg m-3)
+     * @param props  Output array of length 9 containing, in order, P, dP/dT,
+     *     dP/drho, u, du/dT, du/drho, s, ds/dT and ds/drho, in SI units per
+     *     unit mass. The energy and entropy offsets are not included.
+     * @returns false, and leaves *props* untouched, if (T, rho) is outside of
+     *     the table or in a cell that did not meet the tolerance.
+     */
+    bool eval(double T, double rho, double* props) const;
+
+    //! Interpolate the saturation pressure and the densities of the saturated
+    //! liquid and vapor.
+    /*!
+     * @param T       Temperature (K)
+     * @param psat    Output saturation pressure (Pa)
+     * @param rhoLiq  Output density of the saturated liquid (kg m-3)
+     * @param rhoGas  Output density of the saturated vapor (kg m-3)
+     * @returns false if T is outside of the saturation table.
+     */
+    bool saturation(double T, double& psat, double& rhoLiq,
+                    double& rhoGas) const;
+
+    //! Name of the tabulated substance
+    const std::string& name() const {
+        return m_name;
+    }
+
+    //! Tolerance used to build the table
+    double rtol() const {
+        return m_rtol;
+    }
+
+    //! Fraction of the cells of the (T, rho) table which met the tolerance
+    double validFraction() const;
+
+    //! Highest temperature covered by the saturation table (K)
+    double maxSaturationTemperature() const {
+        return m_satTmax;
+    }
+
+private:
+    //! Node values of the tabulated fields
+    /*!
+     * For each of the fields Z, u and s, the value and its derivatives with
+     * respect to x, y, and x and y.
+     */
+    struct Node {
+        double f[3][4];
+    };
+
+    //! Evaluate Z, u and s of the exact equation of state at (T, rho)
+    void exactState(Substance& sub, double T, double rho, double* f) const;
+
+    //! Evaluate the exact node data at (x, y)
+    void exactNode(Substance& sub, double x, double y, Node& node) const;
+
+    //! Interpolate Z, u and s, and their derivatives with respect to x and y,
+    //! at local coordinates (a, b) in cell (i, j)
+    void interpolate(size_t i, size_t j, double a, double b,
+                     double (&f)[3][3]) const;
+
+    //! Convert interpolated fields to the output of eval()
+    void convert(double T, double rho, const double (&f)[3][3],
+                 double* props) const;
+
+    //! Check the interpolant against the exact equation of state at local
+    //! coordinates (a, b) of cell (i, j)
+    bool checkPoint(Substance& sub, size_t i, size_t j, double a,
+                    double b) const;
+
+    //! Build the saturation table
+    void buildSaturation(Substance& sub, size_t nSat);
+
+    //! Evaluate the exact saturation state and its temperature derivatives
+    //! (ln(psat), rhoLiq, rhoGas, followed by their derivatives)
+    void exactSaturation(Substance& sub, double T,
+                         std::array<double, 6>& y) const;
+
+    //! Evaluate the saturation interpolant in interval *k*
+    void interpolateSat(size_t k, double T, double* y) const;
+
+    //! Density at the density coordinate *y*
+    double density(double y) const;
+
+    std::string m_name;
+    double m_rtol;
+
+    //! Specific gas constant (J/kg/K)
+    double m_R;
+
+    //! Scale of the density coordinate (kg m-3)
+    double m_rhos;
+
+    //! Grid of the (T, rho) table
+    double m_xmin, m_dx, m_ymin, m_dy;
+    size_t m_nT, m_nRho;
+
+    //! Node data, stored with y varying fastest
+    std::vector<Node> m_nodes;
+
+    //! Whether each cell met the tolerance
+    std::vector<char> m_valid;
+
+    //! Grid of the saturation table
+    double m_satTmin, m_satdT, m_satTmax;
+
+    //! Node data of the saturation table: ln(psat), rhoLiq and rhoGas,
+    //! followed by their temperature derivatives
+    std::vector<std::array<double, 6>> m_sat;
+};
+
+}
+
+#endif
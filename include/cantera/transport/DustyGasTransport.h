@@ -95,6 +95,29 @@ public:
                                 const doublereal* const state2, const doublereal delta,
                                 doublereal* const fluxes);
 
+    //! Get the molar fluxes [kmol/m^2/s] for many pairs of nearby points.
+    /*!
+     * Equivalent to calling getMolarFluxes() for each pair. The factorization
+     * of the H matrix is reused between consecutive pairs with the same mean
+     * state, for example for control volumes that share a state at one of
+     * their faces. As with getMolarFluxes(), the state of the phase is left
+     * at the mean state of the last pair.
+     *
+     * @param n        Number of pairs of points
+     * @param states1  Arrays of temperature, density, and mass fractions for
+     *     the first point of each pair. The state of pair *i* starts at
+     *     `states1 + i * (nSpecies() + 2)`.
+     * @param states2  Arrays of temperature, density, and mass fractions for
+     *     the second point of each pair, with the same layout as *states1*.
+     * @param delta    Distances between the points of each pair (m).
+     *     Length *n*.
+     * @param fluxes   Output molar fluxes. The fluxes of pair *i* start at
+     *     `fluxes + i * nSpecies()`.
+     */
+    void getMolarFluxesBatch(size_t n, const double* states1,
+                             const double* states2, const double* delta,
+                             double* fluxes);
+
     // new methods added in this class
 
     //! Set the porosity (dimensionless)
@@ -175,8 +198,8 @@ private:
 
     //! Update concentration-dependent quantities within the object
     /*!
-     * The object keeps a value m_temp, which is the temperature at which
-     * quantities were last evaluated at. If the temperature is changed, update
+     * The object keeps the mole fractions and the pressure at which
+     * quantities were last evaluated. If either of them has changed, update
      * Booleans are set false, triggering recomputation.
      */
     void updateTransport_C();
@@ -199,7 +222,9 @@ private:
     //! Update the Multicomponent diffusion coefficients that are used in the
     //! approximation
     /*!
-     * This routine updates the H matrix and then inverts it.
+     * This routine updates the H matrix and computes its LU factorization,
+     * if the temperature, pressure, or composition have changed since the
+     * last update.
      */
     void updateMultiDiffCoeffs();
 
@@ -245,7 +270,11 @@ private:
     //! temperature
     doublereal m_temp;
 
-    //! Multicomponent diffusion coefficients. @see eval_H_matrix()
+    //! pressure
+    doublereal m_pres;
+
+    //! LU factorization of the H matrix, whose inverse is the matrix of
+    //! multicomponent diffusion coefficients. @see eval_H_matrix()
     DenseMatrix m_multidiff;
 
     //! work space of size m_nsp;
@@ -263,6 +292,9 @@ private:
     //! Update-to-date variable for Binary diffusion coefficients
     bool m_bulk_ok;
 
+    //! Update-to-date variable for the factorization of the H matrix
+    bool m_multidiff_ok;
+
     //! Porosity
     doublereal m_porosity;
 
@@ -33,6 +33,12 @@ namespace Cantera
  * averaging rules for the mixture properties, and the Lucas method for the
  * viscosity of a high-pressure gas mixture.
  *
+ * The critical properties and the other constants of the pure species are
+ * evaluated once, by init(). The mixture critical properties and the other
+ * terms of the mixing rules which depend only on the composition are cached,
+ * and recomputed only when the composition of the phase changes. Properties
+ * at many states can be evaluated with getPropertiesBatch().
+ *
  * @ingroup tranprops
  */
 class HighPressureGasTransport : public MultiTransport
@@ -70,6 +76,27 @@ public:
 
     virtual doublereal viscosity();
 
+    //! Evaluate the viscosity and thermal conductivity at many states.
+    /*!
+     * The state of the phase is restored on return. If all states have the
+     * same composition, the composition-dependent terms are only evaluated
+     * once.
+     *
+     * @param nStates  Number of states
+     * @param T        Temperatures [K]. Length: nStates.
+     * @param P        Pressures [Pa]. Length: nStates.
+     * @param X        Mole fractions of state *n*, starting at `X + n * ldX`.
+     * @param ldX      Stride between the compositions of successive states.
+     *     If 0, all states have the composition *X*.
+     * @param visc     (output) Viscosities [Pa-s]. May be NULL.
+     * @param cond     (output) Thermal conductivities [W/m/K]. May be NULL.
+     */
+    void getPropertiesBatch(size_t nStates, const double* T, const double* P,
+                            const double* X, size_t ldX, double* visc,
+                            double* cond);
+
+    virtual void init(thermo_t* thermo, int mode=0, int log_level=0);
+
     friend class TransportFactory;
 
 protected:
@@ -86,6 +113,77 @@ protected:
     virtual doublereal FQ_i(doublereal Q, doublereal Tr, doublereal MW);
 
     virtual doublereal setPcorr(doublereal Pr, doublereal Tr);
+
+    //! Update the composition-dependent terms of the mixing rules if the
+    //! composition has changed since they were last evaluated.
+    void updateMixingRules();
+
+    //! Pressure correction factor of the Takahashi correlation for the
+    //! binary diffusion coefficient of species *i* and *j* at pressure *P*.
+    //! Requires that update_T() and updateMixingRules() have been called.
+    double Pcorr_ij(size_t i, size_t j, double P);
+
+    //! @name Pure species constants, evaluated by init()
+    //! @{
+
+    //! Critical temperatures [K]
+    vector_fp m_Tcrit;
+
+    //! Critical pressures [Pa]
+    vector_fp m_Pcrit;
+
+    //! Critical molar volumes [m^3/kmol]
+    vector_fp m_Vcrit;
+
+    //! Critical compressibilities
+    vector_fp m_Zcrit;
+
+    //! Reduced dipole moments used by the polarity correction of the Lucas
+    //! method
+    vector_fp m_mu_r;
+
+    //! Polarity correction term `30.55*(0.292 - Zc)^1.72` of the Lucas method
+    vector_fp m_FP_polar;
+
+    //! Quantum parameter of the Lucas method, or 0 for species without a
+    //! quantum correction
+    vector_fp m_quantumQ;
+
+    //! Square root of the reduced inverse molecular weight of each pair of
+    //! species, `sqrt((M_i + M_j)/(2*M_i*M_j))`, used by the Ely-Hanley
+    //! method
+    DenseMatrix m_sqrt_mw_inv;
+
+    //! @}
+    //! @name Composition-dependent terms, evaluated by updateMixingRules()
+    //! @{
+
+    //! State number of the phase for which these terms were evaluated. See
+    //! Phase::stateMFNumber().
+    int m_mix_state;
+
+    //! Mole fractions
+    vector_fp m_X;
+
+    //! Mole-fraction-weighted mixture critical temperature [K]
+    double m_Tc_mix;
+
+    //! Mixture critical pressure [Pa]
+    double m_Pc_mix;
+
+    //! Inverse reduced viscosity of the Lucas method
+    double m_ksi;
+
+    //! Factor applied to the quantum correction of mixtures of light and
+    //! heavy species
+    double m_FQ_ratio;
+
+    //! @}
+
+    //! Work arrays for the Ely-Hanley method: the density-independent
+    //! conductivities, and the cube roots of the reduced volumes and the
+    //! fourth roots of the reduced temperatures of the species.
+    vector_fp m_L_i, m_h_cbrt, m_f_root4;
 };
 }
 #endif
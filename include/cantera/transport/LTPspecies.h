@@ -127,6 +127,21 @@ public:
     //! Return the weight mixture
     doublereal getMixWeight() const;
 
+    //! Model type for the temperature dependence
+    LTPTemperatureDependenceType model() const {
+        return m_model;
+    }
+
+    //! Transport property described by this object
+    TransportPropertyType property() const {
+        return m_property;
+    }
+
+    //! Coefficients of the temperature dependence. Their meaning depends on
+    //! model().
+    const vector_fp& coeffs() const {
+        return m_coeffs;
+    }
 
 
 private:
@@ -368,5 +383,80 @@ protected:
     doublereal m_prop;
 };
 
+//! Class LTPspeciesArray evaluates the temperature dependence of a set of
+//! LTPspecies objects together.
+/*!
+ * The coefficients of the LTPspecies_Const, LTPspecies_Arrhenius,
+ * LTPspecies_Poly and LTPspecies_ExpT parameterizations are copied into
+ * contiguous arrays, grouped by model, so that all of the values are evaluated
+ * in a few simple loops over the species instead of through one virtual call
+ * each. The results are identical to those of
+ * LTPspecies::getSpeciesTransProp(). Objects with any other model are
+ * evaluated by calling getSpeciesTransProp(). Null entries evaluate to zero,
+ * with a mixing weight of one.
+ *
+ * The LTPspecies objects are not owned by this class. Objects which are not
+ * flattened must outlive it.
+ */
+class LTPspeciesArray
+{
+public:
+    LTPspeciesArray() : m_size(0), m_nPoly(0), m_nExp(0) {}
+
+    //! Copy the parameterizations of the objects in *props*
+    void init(const std::vector<LTPspecies*>& props);
+
+    //! Number of properties
+    size_t size() const {
+        return m_size;
+    }
+
+    //! Evaluate all of the properties
+    /*!
+     * @param T      Temperature [K]. This must be the temperature of the
+     *     ThermoPhase objects used by LTPspecies which are not flattened.
+     * @param values Output array of length size()
+     */
+    void getValues(double T, double* values);
+
+    //! Mixing weights of the properties (see LTPspecies::getMixWeight())
+    const vector_fp& mixWeights() const {
+        return m_weights;
+    }
+
+protected:
+    size_t m_size;
+    vector_fp m_weights;
+
+    //! Indices and values of the constant properties
+    std::vector<size_t> m_constIndex;
+    vector_fp m_const;
+
+    //! Indices and coefficients of the Arrhenius properties. The sign of the
+    //! activation temperature includes the sign convention for viscosity.
+    std::vector<size_t> m_arrIndex;
+    vector_fp m_logA, m_arrN, m_arrTact;
+
+    //! Indices and coefficients of the polynomial properties. Coefficient *i*
+    //! of property *j* is `m_poly[i * m_polyIndex.size() + j]`. Shorter
+    //! polynomials are padded with zeros.
+    std::vector<size_t> m_polyIndex;
+    size_t m_nPoly;
+    vector_fp m_poly;
+
+    //! Indices and coefficients of the exponential properties, stored like
+    //! those of the polynomials
+    std::vector<size_t> m_expIndex;
+    size_t m_nExp;
+    vector_fp m_exp;
+
+    //! Properties evaluated through LTPspecies::getSpeciesTransProp()
+    std::vector<size_t> m_otherIndex;
+    std::vector<LTPspecies*> m_other;
+
+    //! Work array of length equal to the largest group
+    vector_fp m_work;
+};
+
 }
 #endif
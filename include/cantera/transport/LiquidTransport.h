@@ -761,6 +761,16 @@ protected:
     //! wrt T using calls to the appropriate LTPspecies subclass
     void updateDiff_T();
 
+    //! Evaluate a mixture property from the pure species values
+    /*!
+     * @param model   Mixing rule
+     * @param values  Pure species values, `values[k*stride]` for species *k*
+     * @param weights Mixing weights of the species, stored like *values*
+     * @param stride  Distance between the values of consecutive species
+     */
+    double mixProperty(LiquidTranInteraction& model, const double* values,
+                       const double* weights, size_t stride=1);
+
 private:
     //! Number of species squared
     size_t m_nsp2;
@@ -780,6 +790,9 @@ private:
      */
     std::vector<LTPspecies*> m_viscTempDep_Ns;
 
+    //! Flattened form of m_viscTempDep_Ns used to evaluate m_viscSpecies
+    LTPspeciesArray m_viscTempDep;
+
     //! Viscosity of the mixture expressed as a subclass of
     //! LiquidTranInteraction
     /*!
@@ -798,6 +811,10 @@ private:
      */
     std::vector<LTPspecies*> m_ionCondTempDep_Ns;
 
+    //! Flattened form of m_ionCondTempDep_Ns used to evaluate
+    //! m_ionCondSpecies
+    LTPspeciesArray m_ionCondTempDep;
+
     //! Ionic Conductivity of the mixture expressed as a subclass of
     //! LiquidTranInteraction
     /*!
@@ -819,6 +836,10 @@ private:
      */
     std::vector<LTPvector> m_mobRatTempDep_Ns;
 
+    //! Flattened form of m_mobRatTempDep_Ns, in the same order as the
+    //! elements of m_mobRatSpecies
+    LTPspeciesArray m_mobRatTempDep;
+
     //! Mobility ratio for each binary combination of mobile species in the mixture
     //! expressed as a subclass of LiquidTranInteraction
     /*!
@@ -837,6 +858,10 @@ private:
      */
     std::vector<LTPvector> m_selfDiffTempDep_Ns;
 
+    //! Flattened form of m_selfDiffTempDep_Ns, in the same order as the
+    //! elements of m_selfDiffSpecies
+    LTPspeciesArray m_selfDiffTempDep;
+
     //! Self Diffusion for each species in the mixture expressed as a subclass of
     //! LiquidTranInteraction
     /*!
@@ -855,6 +880,9 @@ private:
      */
     std::vector<LTPspecies*> m_lambdaTempDep_Ns;
 
+    //! Flattened form of m_lambdaTempDep_Ns used to evaluate m_lambdaSpecies
+    LTPspeciesArray m_lambdaTempDep;
+
     //! Thermal conductivity of the mixture expressed as a subclass of
     //! LiquidTranInteraction
     /*!
@@ -900,6 +928,10 @@ private:
      */
     std::vector<LTPspecies*> m_radiusTempDep_Ns;
 
+    //! Flattened form of m_radiusTempDep_Ns used to evaluate
+    //! m_hydrodynamic_radius
+    LTPspeciesArray m_radiusTempDep;
+
     //! (Not used in LiquidTransport) Hydrodynamic radius of the mixture
     //! expressed as a subclass of LiquidTranInteraction
     /*!
@@ -1171,6 +1203,9 @@ private:
     //! work space. Length is equal to m_nsp
     vector_fp m_spwork;
 
+    //! work space. Length is equal to m_nsp
+    vector_fp m_spwork2;
+
 private:
     //! Boolean indicating that the top-level mixture viscosity is current. This
     //! is turned false for every change in T, P, or C.
@@ -1194,9 +1229,6 @@ private:
     //! are current wrt the concentration
     bool m_ionCond_conc_ok;
 
-    //! Flag to indicate that the mixture conductivity is current
-    bool m_cond_mix_ok;
-
     //! Boolean indicating that the top-level mixture mobility ratio is current.
     //! This is turned false for every change in T, P, or C.
     bool m_mobRat_mix_ok;
@@ -1243,6 +1275,15 @@ private:
     //! Boolean indicating that mixture conductivity is current
     bool m_lambda_mix_ok;
 
+    //! Boolean indicating that the solution of the Stefan-Maxwell equations
+    //! in m_Vdiff and m_flux is current. This is turned false for every
+    //! change in T, P, C or in the gradients.
+    bool m_vdiff_ok;
+
+    //! Velocity basis used for the current solution of the Stefan-Maxwell
+    //! equations
+    int m_vdiffBasis;
+
     //! Mode indicator for transport models -- currently unused.
     int m_mode;
 
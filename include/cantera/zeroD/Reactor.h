@@ -160,6 +160,11 @@ protected:
     //! Update the state of SurfPhase objects attached to this reactor
     virtual void updateSurfaceState(double* y);
 
+    //! Set the temperature which gives the total internal energy *U* at the
+    //! current density by bracketing the root. Used by updateState() if the
+    //! Newton iteration of ThermoPhase::solveTemperature() fails.
+    void bracketTemperature(double U);
+
     //! Get initial conditions for SurfPhase objects attached to this reactor
     virtual void getSurfaceInitialConditions(double* y);
 
@@ -733,6 +733,10 @@ cdef extern from "cantera/oneD/Sim1D.h":
         vector[int]& jacobianCountStats()
         vector[int]& evalCountStats()
         vector[int]& timeStepStats()
+        void enableProfiling(cbool)
+        cbool profilingEnabled()
+        string profileJSON() except +translate_exception
+        void writeProfile(string) except +translate_exception
 
         int domainIndex(string) except +translate_exception
         double value(size_t, size_t, size_t) except +translate_exception
@@ -221,7 +221,7 @@ eV = 9.64853364595687e7
 # Electron Mass in kg
 ElectronMass = 9.10938291e-31
 
-import math, copy
+import math, copy, numbers
 
 # default units
 _ulen = 'm'
@@ -801,27 +801,49 @@ class activityCoefficients(object):
     pass
 
 
+def _build_a_coeff(f, a_coeff):
+    if isinstance(a_coeff, numbers.Real):
+        ac = f.addChild("a_coeff", '%10.4E \n' % a_coeff)
+        ac["model"] = "constant"
+    else:
+        s = '%10.4E, %10.4E \n' % (a_coeff[0], a_coeff[1])
+        ac = f.addChild("a_coeff", s)
+        ac["model"] = "linear_a"
+    ac["units"] = _upres+'-'+_ulen+'6/'+_umol+'2'
+
+
 class pureFluidParameters(activityCoefficients):
     """
     """
 
-    def __init__(self, species = None, a_coeff = [], b_coeff = 0):
+    def __init__(self, species = None, a_coeff = [], b_coeff = 0,
+                 acentric_factor = None):
         """
+        :param species:
+            Name of the species
+        :param a_coeff:
+            "a" parameter of the equation of state. A sequence of a constant
+            and a temperature-proportional term for `RedlichKwongMFTP`, or a
+            single value for `PengRobinsonMFTP`.
+        :param b_coeff:
+            "b" parameter of the equation of state
+        :param acentric_factor:
+            Acentric factor of the species. Only used by `PengRobinsonMFTP`.
         """
         self._species = species
         self._acoeff = a_coeff
         self._bcoeff = b_coeff
+        self._acentric = acentric_factor
 
     def build(self,a):
         f= a.addChild("pureFluidParameters")
         f['species'] = self._species
-        s = '%10.4E, %10.4E \n' % (self._acoeff[0], self._acoeff[1])
-        ac = f.addChild("a_coeff",s)
-        ac["units"] = _upres+'-'+_ulen+'6/'+_umol+'2'
-        ac["model"] = "linear_a"
+        _build_a_coeff(f, self._acoeff)
         s = '%0.2f \n' % self._bcoeff
         bc = f.addChild("b_coeff",s)
         bc["units"] = _ulen+'3/'+_umol
+        if self._acentric is not None:
+            f.addChild("acentric_factor", repr(self._acentric))
 
 
 class crossFluidParameters(activityCoefficients):
@@ -834,10 +856,7 @@ class crossFluidParameters(activityCoefficients):
         f= a.addChild("crossFluidParameters")
         f["species2"] = self._species2
         f["species1"] = self._species1
-        s = '%10.4E, %10.4E \n' % (self._acoeff[0], self._acoeff[1])
-        ac = f.addChild("a_coeff",s)
-        ac["units"] = _upres+'-'+_ulen+'6/'+_umol+'2'
-        ac["model"] = "linear_a"
+        _build_a_coeff(f, self._acoeff)
         if self._bcoeff:
             s = '%0.2f \n' % self._bcoeff
             bc = f.addChild("b_coeff",s)
@@ -2318,6 +2337,19 @@ class RedlichKwongMFTP(phase):
         if self._kin:
             k = ph.addChild("kinetics")
             k['model'] = self._kin
+        return ph
+
+
+class PengRobinsonMFTP(RedlichKwongMFTP):
+    """A multi-component fluid model for non-ideal gas fluids, using the
+    Peng-Robinson equation of state. The species parameters are given with
+    `pureFluidParameters` and `crossFluidParameters` entries in
+    *activity_coefficients*."""
+
+    def build(self, p):
+        ph = RedlichKwongMFTP.build(self, p)
+        ph.child("thermo")['model'] = 'PengRobinsonMFTP'
+        return ph
 
 
 class ideal_interface(phase):
@@ -2,6 +2,7 @@
 # at http://www.cantera.org/license.txt for license and copyright information.
 
 import interrupts
+import json
 
 # Need a pure-python class to store weakrefs to
 class _WeakrefProxy(object):
@@ -1220,7 +1221,10 @@ cdef class Sim1D:
             return self.sim.gridSizeStats()
 
     property jacobian_time_stats:
-        """Return CPU time spent evaluating Jacobians in each call to solve()"""
+        """
+        Return wall-clock time spent evaluating Jacobians in each call to
+        solve()
+        """
         def __get__(self):
             return self.sim.jacobianTimeStats()
 
@@ -1231,8 +1235,8 @@ cdef class Sim1D:
 
     property eval_time_stats:
         """
-        Return CPU time spent on non-Jacobian function evaluations in each call
-        to solve()
+        Return wall-clock time spent on non-Jacobian function evaluations in
+        each call to solve()
         """
         def __get__(self):
             return self.sim.evalTimeStats()
@@ -1250,6 +1254,36 @@ cdef class Sim1D:
         def __get__(self):
             return self.sim.timeStepStats()
 
+    property profiling:
+        """
+        Get or set whether the wall-clock time and number of calls are
+        recorded for the property updates and residual evaluations of each
+        domain, and for the evaluation, factorization and solution of the
+        Jacobian. See `profile_stats`.
+        """
+        def __get__(self):
+            return self.sim.profilingEnabled()
+        def __set__(self, enable):
+            self.sim.enableProfiling(<cbool>enable)
+
+    property profile_stats:
+        """
+        Return the profiling data and the other solver statistics as a `dict`.
+        The list ``grids`` has an entry for each call to solve(), with the
+        number of grid points, time steps, residual and Jacobian evaluations,
+        and the time and number of calls for each task of the solver and of
+        each domain. ``total`` contains the times and counts summed over all
+        grids.
+        """
+        def __get__(self):
+            return json.loads(pystr(self.sim.profileJSON()))
+
+    def write_profile(self, filename):
+        """
+        Write the data of `profile_stats` to the JSON file *filename*.
+        """
+        self.sim.writeProfile(stringify(filename))
+
     def set_max_grid_points(self, domain, npmax):
         """ Set the maximum number of grid points in the specified domain. """
         idom = self.domain_index(domain)
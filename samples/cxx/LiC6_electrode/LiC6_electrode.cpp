@@ -1,4 +1,6 @@
 #include "cantera/thermo.h"
+#include "cantera/kinetics.h"
+#include "cantera/kinetics/InterfaceKinetics.h"
 #include <iostream>
 #include <fstream>
 
@@ -60,10 +62,49 @@ void calc_potentials()
     }
 }
 
+// Evaluate the interface rates of progress with all phases present and with
+// the electrolyte phase flagged as missing, in which case no Li+ can be
+// exchanged with the electrolyte and the Li(C6) content doesn't change.
+void calc_interface_rates()
+{
+    std::unique_ptr<ThermoPhase> electrodebulk(
+        newPhase("LiC6_electrodebulk.xml", "LiC6_and_Vacancies"));
+    std::unique_ptr<ThermoPhase> electron(
+        newPhase("LiC6_electrode_interface.xml", "electron"));
+    std::unique_ptr<ThermoPhase> electrolyte(
+        newPhase("LiC6_electrode_interface.xml", "electrolyte"));
+    std::unique_ptr<ThermoPhase> surf(
+        newPhase("LiC6_electrode_interface.xml", "LiC6_electrolyte_interface"));
+    std::vector<ThermoPhase*> phases{electrodebulk.get(), electron.get(),
+                                     electrolyte.get(), surf.get()};
+    std::unique_ptr<Kinetics> kin(newKineticsMgr(surf->xml(), phases));
+    InterfaceKinetics* iface = dynamic_cast<InterfaceKinetics*>(kin.get());
+    if (!iface) {
+        throw CanteraError("calc_interface_rates",
+                           "Expected an InterfaceKinetics object");
+    }
+
+    vector_fp xv(electrodebulk->nSpecies(), 0.0);
+    xv[electrodebulk->speciesIndex("Li(C6)")] = 0.75;
+    xv[electrodebulk->speciesIndex("V(C6)")] = 0.25;
+    electrodebulk->setState_TX(273.15 + 25.0, xv.data());
+
+    vector_fp wdot(kin->nTotalSpecies());
+    size_t iElectrolyte = kin->phaseIndex("electrolyte");
+    for (int pass = 0; pass < 2; pass++) {
+        iface->setPhaseExistence(iElectrolyte, pass == 0);
+        kin->getNetProductionRates(wdot.data());
+        std::cout << fmt::format("electrolyte {:7s}: Li(C6) production rate "
+            "= {:12.5g} kmol/m^2/s\n", pass == 0 ? "present" : "missing",
+            wdot[kin->kineticsSpeciesIndex("Li(C6)")]);
+    }
+}
+
 int main(int argc, char** argv)
 {
     try {
         calc_potentials();
+        calc_interface_rates();
         return 0;
     } catch (CanteraError& err) {
         std::cout << err.what() << std::endl;
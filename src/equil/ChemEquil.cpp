@@ -320,6 +320,48 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
                            vector_fp& elMolesGoal,
                            bool useThermoPhaseElementPotentials,
                            int loglevel)
+{
+    if (options.contin && m_state.valid) {
+        vector_fp state;
+        s.saveState(state);
+        try {
+            return solveEquil(s, XYstr, elMolesGoal,
+                              useThermoPhaseElementPotentials, loglevel, true);
+        } catch (CanteraError& err) {
+            // The warm-started calculation failed, so start over from scratch
+            s.restoreState(state);
+            if (ChemEquil_print_lvl > 0) {
+                writelog("ChemEquil: warm start failed:\n{}\n", err.what());
+            }
+        }
+    }
+    return solveEquil(s, XYstr, elMolesGoal, useThermoPhaseElementPotentials,
+                      loglevel, false);
+}
+
+bool ChemEquil::canWarmStart(const vector_fp& elMolesGoal) const
+{
+    if (!m_state.valid || m_state.lambda_RT.size() != m_mm ||
+        m_state.orderVectorElements.size() != m_mm ||
+        m_state.orderVectorSpecies.size() != m_kk) {
+        return false;
+    }
+    // An element which was absent from the previous solution has its element
+    // potential driven to -1000, which is a poor starting point if the element
+    // is now present.
+    for (size_t m = 0; m < m_mm; m++) {
+        if (elMolesGoal[m] >= m_elemFracCutoff && m != m_eloc &&
+            m_state.lambda_RT[m] <= -999.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int ChemEquil::solveEquil(thermo_t& s, const char* XYstr,
+                          vector_fp& elMolesGoal,
+                          bool useThermoPhaseElementPotentials,
+                          int loglevel, bool warmStart)
 {
     int fail = 0;
     bool tempFixed = true;
@@ -425,115 +467,138 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
     // mole fractions.
     update(s);
 
-    doublereal tmaxPhase = s.maxTemp();
-    doublereal tminPhase = s.minTemp();
-    // loop to estimate T
-    if (!tempFixed) {
-        doublereal tmin = std::max(s.temperature(), tminPhase);
-        if (tmin > tmaxPhase) {
-            tmin = tmaxPhase - 20;
+    warmStart = warmStart && canWarmStart(elMolesGoal);
+    int info = 0;
+    int maxIterations = options.maxIterations;
+    if (warmStart) {
+        // Start from the element potentials, temperature, and component
+        // basis of the previous solution
+        maxIterations = std::min(maxIterations, options.maxWarmStartIterations);
+        m_nComponents = m_state.nComponents;
+        m_orderVectorElements = m_state.orderVectorElements;
+        m_orderVectorSpecies = m_state.orderVectorSpecies;
+        for (size_t m = 0; m < m_nComponents; m++) {
+            m_component[m] = m_orderVectorSpecies[m];
         }
-        doublereal tmax = std::min(tmin + 10., tmaxPhase);
-        if (tmax < tminPhase) {
-            tmax = tminPhase + 20;
+        copy(m_state.lambda_RT.begin(), m_state.lambda_RT.end(), x.begin());
+        if (!tempFixed) {
+            s.setTemperature(clip(m_state.temperature, s.minTemp(),
+                                  s.maxTemp()));
         }
+        setToEquilState(s, x, s.temperature());
+    } else {
+        doublereal tmaxPhase = s.maxTemp();
+        doublereal tminPhase = s.minTemp();
+        // loop to estimate T
+        if (!tempFixed) {
+            doublereal tmin = std::max(s.temperature(), tminPhase);
+            if (tmin > tmaxPhase) {
+                tmin = tmaxPhase - 20;
+            }
+            doublereal tmax = std::min(tmin + 10., tmaxPhase);
+            if (tmax < tminPhase) {
+                tmax = tminPhase + 20;
+            }
 
-        doublereal slope, phigh, plow, pval, dt;
+            doublereal slope, phigh, plow, pval, dt;
 
-        // first get the property values at the upper and lower temperature
-        // limits. Since p1 (h, s, or u) is monotonic in T, these values
-        // determine the upper and lower bounds (phigh, plow) for p1.
+            // first get the property values at the upper and lower temperature
+            // limits. Since p1 (h, s, or u) is monotonic in T, these values
+            // determine the upper and lower bounds (phigh, plow) for p1.
 
-        s.setTemperature(tmax);
-        setInitialMoles(s, elMolesGoal, loglevel - 1);
-        phigh = m_p1(s);
+            s.setTemperature(tmax);
+            setInitialMoles(s, elMolesGoal, loglevel - 1);
+            phigh = m_p1(s);
 
-        s.setTemperature(tmin);
-        setInitialMoles(s, elMolesGoal, loglevel - 1);
-        plow = m_p1(s);
+            s.setTemperature(tmin);
+            setInitialMoles(s, elMolesGoal, loglevel - 1);
+            plow = m_p1(s);
 
-        // start with T at the midpoint of the range
-        doublereal t0 = 0.5*(tmin + tmax);
-        s.setTemperature(t0);
+            // start with T at the midpoint of the range
+            doublereal t0 = 0.5*(tmin + tmax);
+            s.setTemperature(t0);
 
-        // loop up to 5 times
-        for (int it = 0; it < 10; it++) {
-            // set the composition and get p1
-            setInitialMoles(s, elMolesGoal, loglevel - 1);
-            pval = m_p1(s);
-
-            // If this value of p1 is greater than the specified property value,
-            // then the current temperature is too high. Use it as the new upper
-            // bound. Otherwise, it is too low, so use it as the new lower
-            // bound.
-            if (pval > xval) {
-                tmax = t0;
-                phigh = pval;
-            } else {
-                tmin = t0;
-                plow = pval;
-            }
+            // loop up to 5 times
+            for (int it = 0; it < 10; it++) {
+                // set the composition and get p1
+                setInitialMoles(s, elMolesGoal, loglevel - 1);
+                pval = m_p1(s);
+
+                // If this value of p1 is greater than the specified property
+                // value, then the current temperature is too high. Use it as
+                // the new upper bound. Otherwise, it is too low, so use it as
+                // the new lower bound.
+                if (pval > xval) {
+                    tmax = t0;
+                    phigh = pval;
+                } else {
+                    tmin = t0;
+                    plow = pval;
+                }
 
-            // Determine the new T estimate by linearly interpolating
-            // between the upper and lower bounds
-            slope = (phigh - plow)/(tmax - tmin);
-            dt = (xval - pval)/slope;
+                // Determine the new T estimate by linearly interpolating
+                // between the upper and lower bounds
+                slope = (phigh - plow)/(tmax - tmin);
+                dt = (xval - pval)/slope;
 
-            // If within 50 K, terminate the search
-            if (fabs(dt) < 50.0) {
-                break;
-            }
-            dt = clip(dt, -200.0, 200.0);
-            if ((t0 + dt) < tminPhase) {
-                dt = 0.5*((t0) + tminPhase) - t0;
-            }
-            if ((t0 + dt) > tmaxPhase) {
-                dt = 0.5*((t0) + tmaxPhase) - t0;
-            }
-            // update the T estimate
-            t0 += dt;
-            if (t0 <= tminPhase || t0 >= tmaxPhase || t0 < 100.0) {
-                throw CanteraError("ChemEquil::equilibrate", "T out of bounds");
+                // If within 50 K, terminate the search
+                if (fabs(dt) < 50.0) {
+                    break;
+                }
+                dt = clip(dt, -200.0, 200.0);
+                if ((t0 + dt) < tminPhase) {
+                    dt = 0.5*((t0) + tminPhase) - t0;
+                }
+                if ((t0 + dt) > tmaxPhase) {
+                    dt = 0.5*((t0) + tmaxPhase) - t0;
+                }
+                // update the T estimate
+                t0 += dt;
+                if (t0 <= tminPhase || t0 >= tmaxPhase || t0 < 100.0) {
+                    throw CanteraError("ChemEquil::equilibrate",
+                                       "T out of bounds");
+                }
+                s.setTemperature(t0);
             }
-            s.setTemperature(t0);
         }
-    }
 
-    setInitialMoles(s, elMolesGoal,loglevel);
+        setInitialMoles(s, elMolesGoal,loglevel);
 
-    // If requested, get the initial estimate for the chemical potentials from
-    // the ThermoPhase object itself. Or else, create our own estimate.
-    if (useThermoPhaseElementPotentials) {
-        bool haveEm = s.getElementPotentials(x.data());
-        if (haveEm) {
-            if (s.temperature() < 100.) {
-                writelog("we are here {:g}\n", s.temperature());
-            }
-            for (size_t m = 0; m < m_mm; m++) {
-                x[m] *= 1.0 / s.RT();
+        // If requested, get the initial estimate for the chemical potentials
+        // from the ThermoPhase object itself. Or else, create our own estimate.
+        if (useThermoPhaseElementPotentials) {
+            bool haveEm = s.getElementPotentials(x.data());
+            if (haveEm) {
+                if (s.temperature() < 100.) {
+                    writelog("we are here {:g}\n", s.temperature());
+                }
+                for (size_t m = 0; m < m_mm; m++) {
+                    x[m] *= 1.0 / s.RT();
+                }
+            } else {
+                estimateElementPotentials(s, x, elMolesGoal);
             }
         } else {
+            // Calculate initial estimates of the element potentials. This
+            // algorithm uses the MultiPhaseEquil object's initialization
+            // capabilities to calculate an initial estimate of the mole
+            // fractions for a set of linearly independent component species.
+            // Then, the element potentials are solved for based on the
+            // chemical potentials of the component species.
             estimateElementPotentials(s, x, elMolesGoal);
         }
-    } else {
-        // Calculate initial estimates of the element potentials. This algorithm
-        // uses the MultiPhaseEquil object's initialization capabilities to
-        // calculate an initial estimate of the mole fractions for a set of
-        // linearly independent component species. Then, the element potentials
-        // are solved for based on the chemical potentials of the component
-        // species.
-        estimateElementPotentials(s, x, elMolesGoal);
-    }
 
-    // Do a better estimate of the element potentials. We have found that the
-    // current estimate may not be good enough to avoid drastic numerical issues
-    // associated with the use of a numerically generated Jacobian.
-    //
-    // The Brinkley algorithm assumes a constant T, P system and uses a
-    // linearized analytical Jacobian that turns out to be very stable.
-    int info = estimateEP_Brinkley(s, x, elMolesGoal);
-    if (info == 0) {
-        setToEquilState(s, x, s.temperature());
+        // Do a better estimate of the element potentials. We have found that
+        // the current estimate may not be good enough to avoid drastic
+        // numerical issues associated with the use of a numerically generated
+        // Jacobian.
+        //
+        // The Brinkley algorithm assumes a constant T, P system and uses a
+        // linearized analytical Jacobian that turns out to be very stable.
+        info = estimateEP_Brinkley(s, x, elMolesGoal);
+        if (info == 0) {
+            setToEquilState(s, x, s.temperature());
+        }
     }
 
     // Install the log(temp) into the last solution unknown slot.
@@ -561,7 +626,7 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
     vector_fp oldx(nvar, 0.0); // old solution
     vector_fp oldresid(nvar, 0.0);
 
-    for (int iter = 0; iter < options.maxIterations; iter++) {
+    for (int iter = 0; iter < maxIterations; iter++) {
         // check for convergence.
         equilResidual(s, x, elMolesGoal, res_trial, xval, yval);
         double f = 0.5*dot(res_trial.begin(), res_trial.end(), res_trial.begin());
@@ -602,6 +667,16 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
                 m_lambda[m] = x[m]* s.RT();
             }
 
+            // Save the solver state for warm-starting later calculations
+            m_state.lambda_RT.assign(x.begin(), x.begin() + m_mm);
+            m_state.temperature = s.temperature();
+            m_state.nComponents = m_nComponents;
+            m_state.orderVectorElements = m_orderVectorElements;
+            m_state.orderVectorSpecies = m_orderVectorSpecies;
+            m_state.iterations = iter;
+            m_state.warmStarted = warmStart;
+            m_state.valid = true;
+
             if (m_eloc != npos) {
                 adjustEloc(s, elMolesGoal);
             }
@@ -707,7 +782,7 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
     // no convergence
     s.restoreState(state);
     throw CanteraError("ChemEquil::equilibrate",
-                       "no convergence in {} iterations.", options.maxIterations);
+                       "no convergence in {} iterations.", maxIterations);
 }
 
 
@@ -0,0 +1,435 @@
+/**
+ * @file EquilTable.cpp
+ * Implementation of classes EquilTable and EquilTableLookup.
+ */
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/equil/EquilTable.h"
+#include "cantera/equil/ChemEquil.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace {
+
+//! Identifies a binary equilibrium table file, and the version of the format
+const char tableMagic[8] = {'C', 'T', 'E', 'Q', 'T', 'B', 'L', '2'};
+
+//! Written after #tableMagic in the native byte order, to detect files written
+//! on machines with a different byte order
+const uint32_t byteOrderMark = 0x01020304;
+
+template <class T>
+void writeValue(ostream& s, const T& value)
+{
+    s.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+void writeArray(ostream& s, const T* values, size_t n)
+{
+    s.write(reinterpret_cast<const char*>(values), n * sizeof(T));
+}
+
+template <class T>
+void readValue(istream& s, T& value)
+{
+    s.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+template <class T>
+void readArray(istream& s, T* values, size_t n)
+{
+    s.read(reinterpret_cast<char*>(values), n * sizeof(T));
+}
+
+void checkGrid(const vector_fp& grid, const string& name)
+{
+    if (grid.empty()) {
+        throw CanteraError("EquilTable::setGrid",
+                           "The {} grid is empty", name);
+    }
+    for (size_t i = 1; i < grid.size(); i++) {
+        if (grid[i] <= grid[i-1]) {
+            throw CanteraError("EquilTable::setGrid",
+                "The {} grid must be strictly increasing", name);
+        }
+    }
+}
+
+}
+
+EquilTable::EquilTable()
+    : m_nFailed(0)
+    , m_nIterations(0)
+{
+}
+
+void EquilTable::setGrid(const vector_fp& h, const vector_fp& p,
+                         const vector_fp& Z)
+{
+    checkGrid(h, "enthalpy");
+    checkGrid(p, "pressure");
+    checkGrid(Z, "mixture fraction");
+    if (Z.front() < 0.0 || Z.back() > 1.0) {
+        throw CanteraError("EquilTable::setGrid",
+                           "Mixture fractions must be between 0 and 1");
+    }
+    m_h = h;
+    m_p = p;
+    m_Z = Z;
+    m_data.clear();
+}
+
+void EquilTable::setStreams(const vector_fp& Yfuel, const vector_fp& Yoxidizer)
+{
+    if (Yfuel.size() != Yoxidizer.size()) {
+        throw CanteraError("EquilTable::setStreams", "Fuel and oxidizer "
+            "composition vectors have different lengths ({} and {})",
+            Yfuel.size(), Yoxidizer.size());
+    }
+    m_Yfuel = Yfuel;
+    m_Yox = Yoxidizer;
+}
+
+void EquilTable::build(ThermoPhase& phase, const vector<string>& species,
+                       size_t nThreads)
+{
+    if (m_h.empty()) {
+        throw CanteraError("EquilTable::build", "The grid has not been set");
+    }
+    if (m_Yfuel.size() != phase.nSpecies()) {
+        throw CanteraError("EquilTable::build", "Fuel and oxidizer stream "
+            "compositions are not set, or do not match the number of species "
+            "in phase '{}'", phase.name());
+    }
+
+    m_names = {"T", "density", "mean_molecular_weight", "cp_mass"};
+    vector<size_t> kStored;
+    if (species.empty()) {
+        for (size_t k = 0; k < phase.nSpecies(); k++) {
+            kStored.push_back(k);
+            m_names.push_back(phase.speciesName(k));
+        }
+    } else {
+        for (const auto& name : species) {
+            size_t k = phase.speciesIndex(name);
+            if (k == npos) {
+                throw CanteraError("EquilTable::build",
+                                   "Unknown species '{}'", name);
+            }
+            kStored.push_back(k);
+            m_names.push_back(name);
+        }
+    }
+    m_data.assign(nPoints() * nVariables(),
+                  numeric_limits<float>::quiet_NaN());
+
+    size_t nLines = m_p.size() * m_Z.size();
+    if (nThreads == 0) {
+        nThreads = std::max(thread::hardware_concurrency(), 1u);
+    }
+    nThreads = std::min(nThreads, nLines);
+
+    // Each thread needs its own copy of the phase. The copies are created
+    // here, before any threads are started.
+    vector<unique_ptr<ThermoPhase>> phases;
+    for (size_t i = 0; i < nThreads; i++) {
+        phases.emplace_back(newPhase(phase.xml()));
+    }
+
+    // Each thread computes a contiguous range of (pressure, mixture fraction)
+    // lines, so that each line can be started from the solution for the
+    // neighboring line.
+    vector<size_t> nFailed(nThreads, 0);
+    vector<long int> nIterations(nThreads, 0);
+    vector<exception_ptr> errors(nThreads);
+    vector<thread> threads;
+    for (size_t i = 0; i < nThreads; i++) {
+        size_t start = i * nLines / nThreads;
+        size_t end = (i + 1) * nLines / nThreads;
+        threads.emplace_back([&, i, start, end]() {
+            try {
+                buildLines(*phases[i], start, end, kStored, nFailed[i],
+                           nIterations[i]);
+            } catch (...) {
+                errors[i] = current_exception();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (auto& err : errors) {
+        if (err) {
+            rethrow_exception(err);
+        }
+    }
+
+    m_nFailed = 0;
+    m_nIterations = 0;
+    for (size_t i = 0; i < nThreads; i++) {
+        m_nFailed += nFailed[i];
+        m_nIterations += nIterations[i];
+    }
+}
+
+void EquilTable::buildLines(ThermoPhase& phase, size_t lineStart,
+                            size_t lineEnd, const vector<size_t>& species,
+                            size_t& nFailed, long int& nIterations)
+{
+    size_t nh = m_h.size();
+    size_t nv = nVariables();
+    vector_fp Y(phase.nSpecies());
+
+    // Solver state at the first point of the previous line
+    EquilState lineState;
+    for (size_t line = lineStart; line < lineEnd; line++) {
+        double p = m_p[line % m_p.size()];
+        double Z = m_Z[line / m_p.size()];
+        for (size_t k = 0; k < Y.size(); k++) {
+            Y[k] = Z * m_Yfuel[k] + (1.0 - Z) * m_Yox[k];
+        }
+
+        // March down from the highest enthalpy, starting each point from the
+        // solution at the previous one
+        EquilState state = lineState;
+        for (size_t n = 0; n < nh; n++) {
+            size_t ih = nh - 1 - n;
+            float* values = &m_data[(line * nh + ih) * nv];
+            try {
+                double T0 = state.valid ? state.temperature : 300.0;
+                phase.setState_TPY(T0, p, Y.data());
+                phase.setState_HP(m_h[ih], p);
+                phase.equilibrate("HP", "auto", 1e-9, 50000, 100, 0, 0,
+                                  &state);
+                if (state.valid) {
+                    nIterations += state.iterations;
+                }
+                values[0] = static_cast<float>(phase.temperature());
+                values[1] = static_cast<float>(phase.density());
+                values[2] = static_cast<float>(phase.meanMolecularWeight());
+                values[3] = static_cast<float>(phase.cp_mass());
+                for (size_t i = 0; i < species.size(); i++) {
+                    values[4 + i] =
+                        static_cast<float>(phase.massFraction(species[i]));
+                }
+            } catch (CanteraError&) {
+                // Leave the values for this point as NaN
+                nFailed++;
+                state.valid = false;
+            }
+            if (n == 0) {
+                lineState = state;
+            }
+        }
+    }
+}
+
+size_t EquilTable::variableIndex(const string& name) const
+{
+    for (size_t i = 0; i < m_names.size(); i++) {
+        if (m_names[i] == name) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+void EquilTable::save(const string& filename) const
+{
+    if (m_data.empty()) {
+        throw CanteraError("EquilTable::save", "The table has not been built");
+    }
+    ofstream s(filename, ios::binary);
+    if (!s) {
+        throw CanteraError("EquilTable::save",
+                           "Could not open file '{}' for writing", filename);
+    }
+    writeArray(s, tableMagic, sizeof(tableMagic));
+    writeValue(s, byteOrderMark);
+    writeValue(s, static_cast<uint32_t>(m_h.size()));
+    writeValue(s, static_cast<uint32_t>(m_p.size()));
+    writeValue(s, static_cast<uint32_t>(m_Z.size()));
+    writeValue(s, static_cast<uint32_t>(m_names.size()));
+    writeArray(s, m_h.data(), m_h.size());
+    writeArray(s, m_p.data(), m_p.size());
+    writeArray(s, m_Z.data(), m_Z.size());
+    for (const auto& name : m_names) {
+        writeValue(s, static_cast<uint32_t>(name.size()));
+        writeArray(s, name.data(), name.size());
+    }
+    writeArray(s, m_data.data(), m_data.size());
+    if (!s) {
+        throw CanteraError("EquilTable::save",
+                           "Error writing to file '{}'", filename);
+    }
+}
+
+void EquilTable::load(const string& filename)
+{
+    ifstream s(filename, ios::binary);
+    if (!s) {
+        throw CanteraError("EquilTable::load",
+                           "Could not open file '{}' for reading", filename);
+    }
+    char magic[sizeof(tableMagic)];
+    readArray(s, magic, sizeof(magic));
+    if (!s || !equal(magic, magic + sizeof(magic), tableMagic)) {
+        throw CanteraError("EquilTable::load", "File '{}' is not an "
+            "equilibrium table file, or uses a different format version",
+            filename);
+    }
+    uint32_t mark = 0;
+    readValue(s, mark);
+    if (mark != byteOrderMark) {
+        throw CanteraError("EquilTable::load", "File '{}' was written on a "
+            "machine with a different byte order", filename);
+    }
+    uint32_t nh, np, nz, nv;
+    readValue(s, nh);
+    readValue(s, np);
+    readValue(s, nz);
+    readValue(s, nv);
+    if (!s) {
+        throw CanteraError("EquilTable::load",
+                           "Error reading header of file '{}'", filename);
+    }
+    m_h.resize(nh);
+    m_p.resize(np);
+    m_Z.resize(nz);
+    readArray(s, m_h.data(), nh);
+    readArray(s, m_p.data(), np);
+    readArray(s, m_Z.data(), nz);
+    m_names.resize(nv);
+    for (auto& name : m_names) {
+        uint32_t len = 0;
+        readValue(s, len);
+        name.resize(len);
+        readArray(s, &name[0], len);
+    }
+    m_data.resize(nPoints() * nVariables());
+    readArray(s, m_data.data(), m_data.size());
+    if (!s) {
+        throw CanteraError("EquilTable::load",
+                           "Unexpected end of file '{}'", filename);
+    }
+    m_Yfuel.clear();
+    m_Yox.clear();
+    m_nFailed = 0;
+    m_nIterations = 0;
+}
+
+EquilTableLookup::EquilTableLookup(const EquilTable& table)
+    : m_table(table)
+{
+    if (table.nVariables() == 0) {
+        throw CanteraError("EquilTableLookup::EquilTableLookup",
+                           "The table has not been built or loaded");
+    }
+}
+
+void EquilTableLookup::locate(const vector_fp& grid, double x, size_t& i,
+                              double& w)
+{
+    if (grid.size() < 2 || x <= grid.front()) {
+        i = 0;
+        w = 0.0;
+    } else if (x >= grid.back()) {
+        i = grid.size() - 2;
+        w = 1.0;
+    } else {
+        i = upper_bound(grid.begin(), grid.end(), x) - grid.begin() - 1;
+        w = (x - grid[i]) / (grid[i+1] - grid[i]);
+    }
+}
+
+void EquilTableLookup::corners(double h, double p, double Z, size_t* index,
+                               double* weight) const
+{
+    const vector_fp& hgrid = m_table.enthalpies();
+    const vector_fp& pgrid = m_table.pressures();
+    const vector_fp& Zgrid = m_table.mixtureFractions();
+    size_t ih, ip, iz;
+    double wh, wp, wz;
+    locate(hgrid, h, ih, wh);
+    locate(pgrid, p, ip, wp);
+    locate(Zgrid, Z, iz, wz);
+    size_t jh[2] = {ih, std::min(ih + 1, hgrid.size() - 1)};
+    size_t jp[2] = {ip, std::min(ip + 1, pgrid.size() - 1)};
+    size_t jz[2] = {iz, std::min(iz + 1, Zgrid.size() - 1)};
+    double fh[2] = {1.0 - wh, wh};
+    double fp[2] = {1.0 - wp, wp};
+    double fz[2] = {1.0 - wz, wz};
+    double sum = 0.0;
+    for (size_t c = 0; c < 8; c++) {
+        size_t a = c & 1;
+        size_t b = (c >> 1) & 1;
+        size_t d = (c >> 2) & 1;
+        index[c] = m_table.pointIndex(jh[a], jp[b], jz[d]);
+        weight[c] = fh[a] * fp[b] * fz[d];
+        // Skip points where the equilibrium calculation failed
+        if (std::isnan(m_table.point(index[c])[0])) {
+            weight[c] = 0.0;
+        }
+        sum += weight[c];
+    }
+    if (sum == 0.0) {
+        throw CanteraError("EquilTableLookup::corners", "The equilibrium "
+            "calculation failed at all corners of grid cell ({}, {}, {}) "
+            "used for h = {}, p = {}, Z = {}", ih, ip, iz, h, p, Z);
+    }
+    for (size_t c = 0; c < 8; c++) {
+        weight[c] /= sum;
+    }
+}
+
+void EquilTableLookup::lookup(double h, double p, double Z,
+                              double* values) const
+{
+    size_t index[8];
+    double weight[8];
+    corners(h, p, Z, index, weight);
+    size_t nv = m_table.nVariables();
+    fill(values, values + nv, 0.0);
+    for (size_t c = 0; c < 8; c++) {
+        if (weight[c] == 0.0) {
+            continue;
+        }
+        const float* v = m_table.point(index[c]);
+        for (size_t i = 0; i < nv; i++) {
+            values[i] += weight[c] * v[i];
+        }
+    }
+}
+
+double EquilTableLookup::value(size_t i, double h, double p, double Z) const
+{
+    if (i >= m_table.nVariables()) {
+        throw IndexError("EquilTableLookup::value", "variables", i,
+                         m_table.nVariables() - 1);
+    }
+    size_t index[8];
+    double weight[8];
+    corners(h, p, Z, index, weight);
+    double value = 0.0;
+    for (size_t c = 0; c < 8; c++) {
+        if (weight[c] != 0.0) {
+            value += weight[c] * m_table.point(index[c])[i];
+        }
+    }
+    return value;
+}
+
+}
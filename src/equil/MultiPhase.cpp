@@ -30,6 +30,10 @@ MultiPhase::MultiPhase() :
 {
 }
 
+MultiPhase::~MultiPhase()
+{
+}
+
 void MultiPhase::addPhases(MultiPhase& mix)
 {
     for (size_t n = 0; n < mix.nPhases(); n++) {
@@ -654,9 +658,14 @@ void MultiPhase::equilibrate(const std::string& XY, const std::string& solver,
     if (solver == "auto" || solver == "vcs") {
         try {
             debuglog("Trying VCS equilibrium solver\n", log_level);
-            vcs_MultiPhaseEquil eqsolve(this, log_level-1);
-            int ret = eqsolve.equilibrate(ixy, estimate_equil, log_level-1,
-                                          rtol, max_steps);
+            if (m_vcsSolver) {
+                m_vcsSolver->reload();
+            } else {
+                init();
+                m_vcsSolver.reset(new vcs_MultiPhaseEquil(this, log_level-1));
+            }
+            int ret = m_vcsSolver->equilibrate(ixy, estimate_equil,
+                                               log_level-1, rtol, max_steps);
             if (ret) {
                 throw CanteraError("MultiPhase::equilibrate",
                     "VCS solver failed. Return code: {}", ret);
@@ -666,6 +675,7 @@ void MultiPhase::equilibrate(const std::string& XY, const std::string& solver,
         } catch (std::exception& err) {
             debuglog("VCS solver failed.\n", log_level);
             debuglog(err.what(), log_level);
+            m_vcsSolver.reset();
             m_moleFractions = initial_moleFractions;
             m_moles = initial_moles;
             m_temp = initial_T;
@@ -704,6 +714,15 @@ void MultiPhase::equilibrate(const std::string& XY, const std::string& solver,
     }
 }
 
+vcs_MultiPhaseEquil& MultiPhase::vcsSolver()
+{
+    if (!m_vcsSolver) {
+        init();
+        m_vcsSolver.reset(new vcs_MultiPhaseEquil(this, 0));
+    }
+    return *m_vcsSolver;
+}
+
 void MultiPhase::setTemperature(const doublereal T)
 {
     if (!m_init) {
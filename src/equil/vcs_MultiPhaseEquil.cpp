@@ -24,10 +24,16 @@ namespace Cantera
 vcs_MultiPhaseEquil::vcs_MultiPhaseEquil(MultiPhase* mix, int printLvl) :
     m_mix(mix),
     m_printLvl(printLvl),
+    m_iter(0),
     m_vsolve(mix, printLvl)
 {
 }
 
+void vcs_MultiPhaseEquil::reload()
+{
+    m_vsolve.vcs_prob_reload();
+}
+
 int vcs_MultiPhaseEquil::equilibrate_TV(int XY, doublereal xtarget,
                                         int estimateEquil,
                                         int printLvl, doublereal err,
@@ -442,6 +448,7 @@ int vcs_MultiPhaseEquil::equilibrate_TP(int estimateEquil,
         ip1 = 0;
     }
     int iSuccess = m_vsolve.vcs(ipr, ip1, maxit);
+    m_iter = m_vsolve.m_VCount->Its;
 
     double te = tickTock.secondsWC();
     if (printLvl > 0) {
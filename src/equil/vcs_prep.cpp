@@ -125,18 +125,16 @@ int VCS_SOLVE::vcs_prep(int printLvl)
     }
 
     // NC = number of components is in the vcs.h common block. This call to
-    // BASOPT doesn't calculate the stoichiometric reaction matrix.
-    vector_fp awSpace(m_nsp + (m_nelem + 2)*(m_nelem), 0.0);
-    double* aw = &awSpace[0];
-    if (aw == NULL) {
-        plogf("vcs_prep_oneTime: failed to get memory: global bailout\n");
-        return VCS_NOMEMORY;
-    }
-    double* sa = aw + m_nsp;
-    double* sm = sa + m_nelem;
-    double* ss = sm + m_nelem * m_nelem;
+    // BASOPT doesn't calculate the stoichiometric reaction matrix. The work
+    // arrays are the ones used later by vcs_solve_TP(), so that no memory is
+    // allocated when the same object is used for repeated calculations.
+    m_aw.assign(m_nsp, 0.0);
+    m_sa.assign(m_nelem, 0.0);
+    m_sm.assign(m_nelem * m_nelem, 0.0);
+    m_ss.assign(m_nelem, 0.0);
     bool conv;
-    retn = vcs_basopt(true, aw, sa, sm, ss, test, &conv);
+    retn = vcs_basopt(true, &m_aw[0], &m_sa[0], &m_sm[0], &m_ss[0], test,
+                      &conv);
     if (retn != VCS_SUCCESS) {
         plogf("vcs_prep_oneTime:");
         plogf(" Determination of number of components failed: %d\n",
@@ -155,12 +153,11 @@ int VCS_SOLVE::vcs_prep(int printLvl)
     }
 
     // The elements might need to be rearranged.
-    awSpace.resize(m_nelem + (m_nelem + 2)*m_nelem, 0.0);
-    aw = &awSpace[0];
-    sa = aw + m_nelem;
-    sm = sa + m_nelem;
-    ss = sm + m_nelem * m_nelem;
-    retn = vcs_elem_rearrange(aw, sa, sm, ss);
+    m_aw.assign(std::max(m_nsp, m_nelem), 0.0);
+    m_sa.assign(m_nelem, 0.0);
+    m_sm.assign(m_nelem * m_nelem, 0.0);
+    m_ss.assign(m_nelem, 0.0);
+    retn = vcs_elem_rearrange(&m_aw[0], &m_sa[0], &m_sm[0], &m_ss[0]);
     if (retn != VCS_SUCCESS) {
         plogf("vcs_prep_oneTime:");
         plogf(" Determination of element reordering failed: %d\n",
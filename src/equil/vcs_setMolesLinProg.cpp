@@ -40,11 +40,17 @@ int VCS_SOLVE::vcs_setMolesLinProg()
     int iter = 0;
     bool abundancesOK = true;
     bool usedZeroedSpecies;
-    vector_fp sm(m_nelem * m_nelem, 0.0);
-    vector_fp ss(m_nelem, 0.0);
-    vector_fp sa(m_nelem, 0.0);
-    vector_fp wx(m_nelem, 0.0);
-    vector_fp aw(m_nsp, 0.0);
+    // temporary space, shared with vcs_solve_TP()
+    vector_fp& sm = m_sm;
+    vector_fp& ss = m_ss;
+    vector_fp& sa = m_sa;
+    vector_fp& wx = m_wx;
+    vector_fp& aw = m_aw;
+    sm.assign(m_nelem * m_nelem, 0.0);
+    ss.assign(m_nelem, 0.0);
+    sa.assign(m_nelem, 0.0);
+    wx.assign(m_nelem, 0.0);
+    aw.assign(m_nsp, 0.0);
 
     for (size_t ik = 0; ik < m_nsp; ik++) {
         if (m_speciesUnknownType[ik] != VCS_SPECIES_INTERFACIALVOLTAGE) {
@@ -323,16 +323,7 @@ VCS_SOLVE::VCS_SOLVE(MultiPhase* mphase, int printLvl) :
     }
 
     // Transfer initial element abundances based on the species mole numbers
-    for (size_t j = 0; j < m_nelem; j++) {
-        for (size_t kspec = 0; kspec < m_nsp; kspec++) {
-            if (m_speciesUnknownType[kspec] != VCS_SPECIES_TYPE_INTERFACIALVOLTAGE) {
-                m_elemAbundancesGoal[j] += m_formulaMatrix(kspec,j) * m_molNumSpecies_old[kspec];
-            }
-        }
-        if (m_elType[j] == VCS_ELEM_TYPE_LATTICERATIO && m_elemAbundancesGoal[j] < 1.0E-10) {
-            m_elemAbundancesGoal[j] = 0.0;
-        }
-    }
+    vcs_elemAbundancesGoal_calc();
 
     // Printout the species information: PhaseID's and mole nums
     if (m_printLvl > 1) {
@@ -421,25 +412,6 @@ VCS_SOLVE::VCS_SOLVE(MultiPhase* mphase, int printLvl) :
         }
     }
 
-    for (size_t i = 0; i < m_nelem; i++) {
-        if (m_elType[i] == VCS_ELEM_TYPE_CHARGENEUTRALITY) {
-            if (m_elemAbundancesGoal[i] != 0.0) {
-                if (fabs(m_elemAbundancesGoal[i]) > 1.0E-9) {
-                    throw CanteraError("VCS_SOLVE::vcs_prob_specifyFully",
-                            "Charge neutrality condition {} is signicantly "
-                            "nonzero, {}. Giving up",
-                            m_elementName[i], m_elemAbundancesGoal[i]);
-                } else {
-                    if (m_debug_print_lvl >= 2) {
-                        plogf("Charge neutrality condition %s not zero, %g. Setting it zero\n",
-                              m_elementName[i], m_elemAbundancesGoal[i]);
-                    }
-                    m_elemAbundancesGoal[i] = 0.0;
-                }
-            }
-        }
-    }
-
     // Copy over the species names
     for (size_t i = 0; i < m_nsp; i++) {
         m_speciesName[i] = m_mix->speciesName(i);
@@ -536,6 +508,58 @@ int VCS_SOLVE::vcs(int ipr, int ip1, int maxit)
     return iconv;
 }
 
+void VCS_SOLVE::vcs_elemAbundancesGoal_calc()
+{
+    for (size_t j = 0; j < m_nelem; j++) {
+        m_elemAbundancesGoal[j] = 0.0;
+        for (size_t kspec = 0; kspec < m_nsp; kspec++) {
+            if (m_speciesUnknownType[kspec] != VCS_SPECIES_TYPE_INTERFACIALVOLTAGE) {
+                m_elemAbundancesGoal[j] += m_formulaMatrix(kspec,j) * m_molNumSpecies_old[kspec];
+            }
+        }
+        if (m_elType[j] == VCS_ELEM_TYPE_LATTICERATIO && m_elemAbundancesGoal[j] < 1.0E-10) {
+            m_elemAbundancesGoal[j] = 0.0;
+        }
+        if (m_elType[j] == VCS_ELEM_TYPE_CHARGENEUTRALITY &&
+            m_elemAbundancesGoal[j] != 0.0) {
+            if (fabs(m_elemAbundancesGoal[j]) > 1.0E-9) {
+                throw CanteraError("VCS_SOLVE::vcs_elemAbundancesGoal_calc",
+                        "Charge neutrality condition {} is signicantly "
+                        "nonzero, {}. Giving up",
+                        m_elementName[j], m_elemAbundancesGoal[j]);
+            } else {
+                if (m_debug_print_lvl >= 2) {
+                    plogf("Charge neutrality condition %s not zero, %g. Setting it zero\n",
+                          m_elementName[j], m_elemAbundancesGoal[j]);
+                }
+                m_elemAbundancesGoal[j] = 0.0;
+            }
+        }
+    }
+}
+
+void VCS_SOLVE::vcs_prob_reload()
+{
+    // The species and elements may have been reordered by a previous call to
+    // the solver, so the current ordering is used to transfer the state.
+    for (size_t kspec = 0; kspec < m_nsp; kspec++) {
+        size_t k = m_speciesMapIndex[kspec];
+        if (m_speciesUnknownType[kspec] == VCS_SPECIES_TYPE_INTERFACIALVOLTAGE) {
+            m_molNumSpecies_old[kspec] =
+                m_mix->phase(m_phaseID[kspec]).electricPotential();
+        } else {
+            m_molNumSpecies_old[kspec] = m_mix->speciesMoles(k);
+        }
+    }
+    for (size_t iph = 0; iph < m_numPhases; iph++) {
+        vcs_VolPhase* Vphase = m_VolPhaseList[iph].get();
+        Vphase->setElectricPotential(m_mix->phase(iph).electricPotential());
+        Vphase->setMolesFromVCS(VCS_STATECALC_OLD, &m_molNumSpecies_old[0]);
+        TPhInertMoles[iph] = Vphase->totalMolesInert();
+    }
+    vcs_elemAbundancesGoal_calc();
+}
+
 void VCS_SOLVE::vcs_prob_specifyFully()
 {
     // Whether we have an estimate or not gets overwritten on
@@ -642,11 +666,13 @@ void VCS_SOLVE::vcs_counters_init(int ifunc)
 {
     m_VCount->Its = 0;
     m_VCount->Basis_Opts = 0;
+    m_VCount->Species_Deletions = 0;
     m_VCount->Time_vcs_TP = 0.0;
     m_VCount->Time_basopt = 0.0;
     if (ifunc) {
         m_VCount->T_Its = 0;
         m_VCount->T_Basis_Opts = 0;
+        m_VCount->T_Species_Deletions = 0;
         m_VCount->T_Calls_Inest = 0;
         m_VCount->T_Calls_vcs_TP = 0;
         m_VCount->T_Time_vcs_TP = 0.0;
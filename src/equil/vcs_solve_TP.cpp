@@ -27,7 +27,8 @@ namespace Cantera
 void VCS_SOLVE::checkDelta1(double* const dsLocal,
                             double* const delTPhMoles, size_t kspec)
 {
-    vector_fp dchange(m_numPhases, 0.0);
+    vector_fp& dchange = m_TmpPhase2;
+    dchange.assign(m_numPhases, 0.0);
     for (size_t k = 0; k < kspec; k++) {
         if (m_speciesUnknownType[k] != VCS_SPECIES_TYPE_INTERFACIALVOLTAGE) {
             size_t iph = m_phaseID[k];
@@ -279,6 +280,7 @@ int VCS_SOLVE::vcs_solve_TP(int print_lvl, int printDetails, int maxit)
     m_VCount->T_Calls_vcs_TP++;
     m_VCount->T_Its += m_VCount->Its;
     m_VCount->T_Basis_Opts += m_VCount->Basis_Opts;
+    m_VCount->T_Species_Deletions += m_VCount->Species_Deletions;
     m_VCount->T_Time_basopt += m_VCount->Time_basopt;
 
     // Return a Flag indicating whether convergence occurred
@@ -1522,6 +1524,7 @@ int VCS_SOLVE::vcs_delete_species(const size_t kspec)
         --m_numRxnMinorZeroed;
     }
     m_speciesStatus[kspec] = VCS_SPECIES_DELETED;
+    m_VCount->Species_Deletions++;
     m_deltaGRxn_new[irxn] = 0.0;
     m_deltaGRxn_old[irxn] = 0.0;
     m_feSpecies_new[kspec] = 0.0;
@@ -2025,7 +2028,7 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
     size_t k;
     size_t juse = npos;
     size_t jlose = npos;
-    DenseMatrix C;
+    DenseMatrix& C = m_basisMatrix;
     clockWC tickTock;
     if (m_debug_print_lvl >= 2) {
         plogf("   ");
@@ -2069,7 +2072,6 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
     size_t ncTrial = std::min(m_nelem, m_nsp);
     m_numComponents = ncTrial;
     *usedZeroedSpecies = false;
-    vector_int ipiv(ncTrial);
 
     // Use a temporary work array for the mole numbers, aw[]
     std::copy(m_molNumSpecies_old.begin(),
@@ -28,6 +28,8 @@ InterfaceKinetics::InterfaceKinetics(thermo_t* thermo) :
     m_has_electrochem_rxns(false),
     m_has_exchange_current_density_formulation(false),
     m_phaseExistsCheck(false),
+    m_phaseMissingMask(0),
+    m_phaseUnstableMask(0),
     m_ioFlag(0),
     m_nDim(2)
 {
@@ -353,47 +355,36 @@ void InterfaceKinetics::updateROP()
     // For reactions involving multiple phases, we must check that the phase
     // being consumed actually exists. This is particularly important for phases
     // that are stoichiometric phases containing one species with a unity
-    // activity
+    // activity. Only reactions involving a phase which doesn't exist or isn't
+    // stable need to be checked.
     if (m_phaseExistsCheck) {
-        for (size_t j = 0; j != nReactions(); ++j) {
+        for (size_t j : m_phaseCheckRxns) {
+            uint64_t reacMissing = m_rxnPhaseIsReactant[j] & m_phaseMissingMask;
+            uint64_t prodMissing = m_rxnPhaseIsProduct[j] & m_phaseMissingMask;
             if ((m_ropr[j] > m_ropf[j]) && (m_ropr[j] > 0.0)) {
-                for (size_t p = 0; p < nPhases(); p++) {
-                    if (m_rxnPhaseIsProduct[j][p] && !m_phaseExists[p]) {
-                        m_ropnet[j] = 0.0;
-                        m_ropr[j] = m_ropf[j];
-                        if (m_ropf[j] > 0.0) {
-                            for (size_t rp = 0; rp < nPhases(); rp++) {
-                                if (m_rxnPhaseIsReactant[j][rp] && !m_phaseExists[rp]) {
-                                    m_ropnet[j] = 0.0;
-                                    m_ropr[j] = m_ropf[j] = 0.0;
-                                }
-                            }
-                        }
-                    }
-                    if (m_rxnPhaseIsReactant[j][p] && !m_phaseIsStable[p]) {
-                        m_ropnet[j] = 0.0;
-                        m_ropr[j] = m_ropf[j];
+                if (prodMissing) {
+                    m_ropnet[j] = 0.0;
+                    m_ropr[j] = m_ropf[j];
+                    if (m_ropf[j] > 0.0 && reacMissing) {
+                        m_ropr[j] = m_ropf[j] = 0.0;
                     }
                 }
+                if (m_rxnPhaseIsReactant[j] & m_phaseUnstableMask) {
+                    m_ropnet[j] = 0.0;
+                    m_ropr[j] = m_ropf[j];
+                }
             } else if ((m_ropf[j] > m_ropr[j]) && (m_ropf[j] > 0.0)) {
-                for (size_t p = 0; p < nPhases(); p++) {
-                    if (m_rxnPhaseIsReactant[j][p] && !m_phaseExists[p]) {
-                        m_ropnet[j] = 0.0;
-                        m_ropf[j] = m_ropr[j];
-                        if (m_ropf[j] > 0.0) {
-                            for (size_t rp = 0; rp < nPhases(); rp++) {
-                                if (m_rxnPhaseIsProduct[j][rp] && !m_phaseExists[rp]) {
-                                    m_ropnet[j] = 0.0;
-                                    m_ropf[j] = m_ropr[j] = 0.0;
-                                }
-                            }
-                        }
-                    }
-                    if (m_rxnPhaseIsProduct[j][p] && !m_phaseIsStable[p]) {
-                        m_ropnet[j] = 0.0;
-                        m_ropf[j] = m_ropr[j];
+                if (reacMissing) {
+                    m_ropnet[j] = 0.0;
+                    m_ropf[j] = m_ropr[j];
+                    if (m_ropf[j] > 0.0 && prodMissing) {
+                        m_ropf[j] = m_ropr[j] = 0.0;
                     }
                 }
+                if (m_rxnPhaseIsProduct[j] & m_phaseUnstableMask) {
+                    m_ropnet[j] = 0.0;
+                    m_ropf[j] = m_ropr[j];
+                }
             }
         }
     }
@@ -585,18 +576,46 @@ bool InterfaceKinetics::addReaction(shared_ptr<Reaction> r_base)
         m_irrev.push_back(i);
     }
 
-    m_rxnPhaseIsReactant.emplace_back(nPhases(), false);
-    m_rxnPhaseIsProduct.emplace_back(nPhases(), false);
+    // Reaction orders and net stoichiometry used for evaluating the
+    // derivatives of the rates of progress
+    std::vector<std::pair<size_t, double> > fwdOrders, revOrders;
+    std::map<size_t, double> netStoich;
+    for (const auto& sp : r.reactants) {
+        size_t k = kineticsSpeciesIndex(sp.first);
+        fwdOrders.emplace_back(k, getValue(r.orders, sp.first, sp.second));
+        netStoich[k] -= sp.second;
+    }
+    for (const auto& sp : r.orders) {
+        if (r.reactants.find(sp.first) == r.reactants.end()) {
+            fwdOrders.emplace_back(kineticsSpeciesIndex(sp.first), sp.second);
+        }
+    }
+    for (const auto& sp : r.products) {
+        size_t k = kineticsSpeciesIndex(sp.first);
+        if (r.reversible) {
+            revOrders.emplace_back(k, sp.second);
+        }
+        netStoich[k] += sp.second;
+    }
+    m_rxnFwdOrders.push_back(fwdOrders);
+    m_rxnRevOrders.push_back(revOrders);
+    m_rxnNetStoich.emplace_back(netStoich.begin(), netStoich.end());
 
+    uint64_t reactantPhases = 0;
+    uint64_t productPhases = 0;
     for (const auto& sp : r.reactants) {
         size_t k = kineticsSpeciesIndex(sp.first);
-        size_t p = speciesPhaseIndex(k);
-        m_rxnPhaseIsReactant[i][p] = true;
+        reactantPhases |= uint64_t(1) << speciesPhaseIndex(k);
     }
     for (const auto& sp : r.products) {
         size_t k = kineticsSpeciesIndex(sp.first);
-        size_t p = speciesPhaseIndex(k);
-        m_rxnPhaseIsProduct[i][p] = true;
+        productPhases |= uint64_t(1) << speciesPhaseIndex(k);
+    }
+    m_rxnPhaseIsReactant.push_back(reactantPhases);
+    m_rxnPhaseIsProduct.push_back(productPhases);
+    if ((reactantPhases | productPhases)
+        & (m_phaseMissingMask | m_phaseUnstableMask)) {
+        m_phaseCheckRxns.push_back(i);
     }
 
     deltaElectricEnergy_.push_back(0.0);
@@ -704,9 +723,16 @@ SurfaceArrhenius InterfaceKinetics::buildSurfaceArrhenius(
                           r.rate.activationEnergy_R());
 
     // Set up coverage dependencies
+    std::vector<CoverageDependence> deps;
     for (const auto& sp : r.coverage_deps) {
         size_t k = thermo(reactionPhaseIndex()).speciesIndex(sp.first);
         rate.addCoverageDependence(k, sp.second.a, sp.second.m, sp.second.E);
+        deps.push_back({k, sp.second.a, sp.second.m, sp.second.E});
+    }
+    if (replace) {
+        m_rxnCoverageDeps[i] = deps;
+    } else {
+        m_rxnCoverageDeps.push_back(deps);
     }
     return rate;
 }
@@ -721,6 +747,10 @@ void InterfaceKinetics::setIOFlag(int ioFlag)
 
 void InterfaceKinetics::addPhase(thermo_t& thermo)
 {
+    if (nPhases() == 64) {
+        throw CanteraError("InterfaceKinetics::addPhase", "An InterfaceKinetics"
+            " object may contain at most 64 phases.");
+    }
     Kinetics::addPhase(thermo);
     m_phaseExists.push_back(true);
     m_phaseIsStable.push_back(true);
@@ -796,11 +826,102 @@ void InterfaceKinetics::solvePseudoSteadyStateProblem(
     m_integrator->solvePseudoSteadyStateProblem(ifuncOverride, timeScaleOverride);
 }
 
+void InterfaceKinetics::getNetProductionRatesSurfaceJacobian(Array2D& dwdot)
+{
+    if (m_has_electrochem_rxns) {
+        throw CanteraError("InterfaceKinetics::getNetProductionRatesSurfaceJacobian",
+            "Not implemented for charge transfer reactions");
+    }
+    updateROP();
+    size_t nsurf = m_surf->nSpecies();
+    size_t kstart = m_start[reactionPhaseIndex()];
+    dwdot.resize(m_kk, nsurf);
+    dwdot.zero();
+
+    double n0 = m_surf->siteDensity();
+    double recipT = 1.0 / m_temp;
+    for (size_t i = 0; i < nReactions(); i++) {
+        // Derivatives of ln(kf) arising from the coverage dependence of the
+        // rate constant. The reverse rate constant is proportional to kf, so
+        // ln(kr) has the same derivatives.
+        m_dlnkf_work.clear();
+        for (const auto& dep : m_rxnCoverageDeps[i]) {
+            double theta = m_conc[kstart + dep.k] * m_surf->size(dep.k) / n0;
+            double dlnk_dtheta = log(10.0) * dep.a - dep.E * recipT;
+            if (dep.m != 0.0 && theta > Tiny) {
+                dlnk_dtheta += dep.m / theta;
+            }
+            m_dlnkf_work.emplace_back(dep.k,
+                dlnk_dtheta * m_surf->size(dep.k) / n0);
+        }
+        if (!m_dlnkf_work.empty()) {
+            // The Motz-Wise correction is applied to the coverage-dependent
+            // rate constant k as k / (1 - k/2)
+            for (size_t n = 0; n < m_stickingData.size(); n++) {
+                const StickData& item = m_stickingData[n];
+                if (item.index == i && item.use_motz_wise) {
+                    double q = m_rfn[i] / (pow(n0, -item.order) *
+                                           sqrt(m_temp) * item.multiplier);
+                    for (auto& d : m_dlnkf_work) {
+                        d.second *= 1.0 + 0.5 * q;
+                    }
+                }
+            }
+        }
+
+        m_dropnet_work.clear();
+        for (const auto& d : m_dlnkf_work) {
+            m_dropnet_work.emplace_back(d.first,
+                                        (m_ropf[i] - m_ropr[i]) * d.second);
+        }
+
+        // Derivatives of the concentration products
+        double kf = m_rfn[i] * m_perturb[i];
+        for (const auto& sp : m_rxnFwdOrders[i]) {
+            if (sp.first < kstart || sp.first >= kstart + nsurf
+                || sp.second == 0.0) {
+                continue;
+            }
+            double d = kf * sp.second *
+                pow(std::max(m_actConc[sp.first], Tiny), sp.second - 1.0);
+            for (const auto& other : m_rxnFwdOrders[i]) {
+                if (other.first != sp.first) {
+                    d *= pow(m_actConc[other.first], other.second);
+                }
+            }
+            m_dropnet_work.emplace_back(sp.first - kstart, d);
+        }
+        double kr = kf * m_rkcn[i];
+        if (kr != 0.0) {
+            for (const auto& sp : m_rxnRevOrders[i]) {
+                if (sp.first < kstart || sp.first >= kstart + nsurf) {
+                    continue;
+                }
+                double d = kr * sp.second *
+                    pow(std::max(m_actConc[sp.first], Tiny), sp.second - 1.0);
+                for (const auto& other : m_rxnRevOrders[i]) {
+                    if (other.first != sp.first) {
+                        d *= pow(m_actConc[other.first], other.second);
+                    }
+                }
+                m_dropnet_work.emplace_back(sp.first - kstart, -d);
+            }
+        }
+
+        for (const auto& nu : m_rxnNetStoich[i]) {
+            for (const auto& d : m_dropnet_work) {
+                dwdot(nu.first, d.first) += nu.second * d.second;
+            }
+        }
+    }
+}
+
 void InterfaceKinetics::setPhaseExistence(const size_t iphase, const int exists)
 {
     if (iphase >= m_thermo.size()) {
         throw CanteraError("InterfaceKinetics:setPhaseExistence", "out of bounds");
     }
+    uint64_t bit = uint64_t(1) << iphase;
     if (exists) {
         if (!m_phaseExists[iphase]) {
             m_phaseExistsCheck--;
@@ -808,13 +929,18 @@ void InterfaceKinetics::setPhaseExistence(const size_t iphase, const int exists)
             m_phaseExists[iphase] = true;
         }
         m_phaseIsStable[iphase] = true;
+        m_phaseMissingMask &= ~bit;
+        m_phaseUnstableMask &= ~bit;
     } else {
         if (m_phaseExists[iphase]) {
             m_phaseExistsCheck++;
             m_phaseExists[iphase] = false;
         }
         m_phaseIsStable[iphase] = false;
+        m_phaseMissingMask |= bit;
+        m_phaseUnstableMask |= bit;
     }
+    updatePhaseCheckReactions();
 }
 
 int InterfaceKinetics::phaseExistence(const size_t iphase) const
@@ -838,10 +964,28 @@ void InterfaceKinetics::setPhaseStability(const size_t iphase, const int isStabl
     if (iphase >= m_thermo.size()) {
         throw CanteraError("InterfaceKinetics:setPhaseStability", "out of bounds");
     }
+    uint64_t bit = uint64_t(1) << iphase;
     if (isStable) {
         m_phaseIsStable[iphase] = true;
+        m_phaseUnstableMask &= ~bit;
     } else {
         m_phaseIsStable[iphase] = false;
+        m_phaseUnstableMask |= bit;
+    }
+    updatePhaseCheckReactions();
+}
+
+void InterfaceKinetics::updatePhaseCheckReactions()
+{
+    m_phaseCheckRxns.clear();
+    uint64_t mask = m_phaseMissingMask | m_phaseUnstableMask;
+    if (mask == 0) {
+        return;
+    }
+    for (size_t j = 0; j < nReactions(); j++) {
+        if ((m_rxnPhaseIsReactant[j] | m_rxnPhaseIsProduct[j]) & mask) {
+            m_phaseCheckRxns.push_back(j);
+        }
     }
 }
 
@@ -33,6 +33,7 @@ solveSP::solveSP(ImplicitSurfChem* surfChemPtr, int bulkFunc) :
     m_rtol(1.0E-4),
     m_maxstep(1000),
     m_maxTotSpecies(0),
+    m_analyticJac(bulkFunc != BULK_DEPOSITION),
     m_ioflag(0)
 {
     m_numSurfPhases = 0;
@@ -62,6 +63,22 @@ solveSP::solveSP(ImplicitSurfChem* surfChemPtr, int bulkFunc) :
     // We rely on ordering to figure things out
     m_numBulkPhasesSS = 0;
 
+    // The analytic Jacobian only accounts for the dependence of each
+    // InterfaceKinetics object on its own surface phase, and only for mass
+    // action rate expressions
+    for (size_t n = 0; n < m_objects.size(); n++) {
+        if (m_objects[n]->hasChargeTransferReactions()) {
+            m_analyticJac = false;
+        }
+        for (size_t iph = 0; iph < m_objects[n]->nPhases(); iph++) {
+            for (size_t isp = 0; isp < m_numSurfPhases; isp++) {
+                if (isp != n && &m_objects[n]->thermo(iph) == m_ptrsSurfPhase[isp]) {
+                    m_analyticJac = false;
+                }
+            }
+        }
+    }
+
     if (bulkFunc == BULK_DEPOSITION) {
         m_neq = m_numTotSurfSpecies + m_numTotBulkSpeciesSS;
     } else {
@@ -450,6 +467,44 @@ void solveSP::resjac_eval(DenseMatrix& jac,
     size_t kColIndex = 0;
     // Calculate the residual
     fun_eval(resid, CSoln, CSolnOld, do_time, deltaT);
+
+    // The analytic Jacobian can be used unless the rates of progress are being
+    // modified to account for phases which don't exist
+    bool analytic = m_analyticJac;
+    for (size_t isp = 0; isp < m_numSurfPhases && analytic; isp++) {
+        for (size_t iph = 0; iph < m_objects[isp]->nPhases(); iph++) {
+            if (!m_objects[isp]->phaseExistence(iph)) {
+                analytic = false;
+            }
+        }
+    }
+    if (analytic) {
+        jac.zero();
+        size_t kindexSP = 0;
+        for (size_t isp = 0; isp < m_numSurfPhases; isp++) {
+            size_t nsp = m_nSpeciesSurfPhase[isp];
+            InterfaceKinetics* kinPtr = m_objects[isp];
+            size_t surfIndex = kinPtr->surfacePhaseIndex();
+            size_t kstart = kinPtr->kineticsSpeciesIndex(0, surfIndex);
+            kinPtr->getNetProductionRatesSurfaceJacobian(m_dwdot);
+            for (size_t k = 0; k < nsp; k++) {
+                for (size_t j = 0; j < nsp; j++) {
+                    jac(kindexSP + k, kindexSP + j) = - m_dwdot(kstart + k, j);
+                }
+                if (do_time) {
+                    jac(kindexSP + k, kindexSP + k) += 1.0 / deltaT;
+                }
+            }
+            // Site conservation equation replacing the largest species
+            size_t kspecial = kindexSP + m_spSurfLarge[isp];
+            for (size_t j = 0; j < nsp; j++) {
+                jac(kspecial, kindexSP + j) = -1.0;
+            }
+            kindexSP += nsp;
+        }
+        return;
+    }
+
     // Now we will look over the columns perturbing each unknown.
     for (size_t jsp = 0; jsp < m_numSurfPhases; jsp++) {
         size_t nsp = m_nSpeciesSurfPhase[jsp];
@@ -293,7 +293,10 @@ int BandMatrix::solve(doublereal* b, size_t nrhs, size_t ldb)
     long int nl = static_cast<long int>(nSubDiagonals());
     long int smu = nu + nl;
     double** a = m_lu_col_ptrs.data();
-    bandGBTRS(a, static_cast<long int>(nColumns()), smu, nl, m_ipiv->data.data(), b);
+    for (size_t i = 0; i < nrhs; i++) {
+        bandGBTRS(a, static_cast<long int>(nColumns()), smu, nl,
+                  m_ipiv->data.data(), b + i * ldb);
+    }
     m_info = 0;
 #endif
 
@@ -0,0 +1,404 @@
+//! @file BlockTridiagMatrix.cpp
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/numerics/BlockTridiagMatrix.h"
+#include "cantera/base/ctexceptions.h"
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace
+{
+
+//! LU factorization with partial pivoting of the dense n x n column-major
+//! matrix *a*. Returns zero on success, or one plus the index of the first
+//! zero pivot.
+size_t luFactor(double* a, size_t n, size_t* ipiv)
+{
+    for (size_t k = 0; k < n; k++) {
+        double* ak = a + k*n;
+        size_t p = k;
+        for (size_t i = k + 1; i < n; i++) {
+            if (fabs(ak[i]) > fabs(ak[p])) {
+                p = i;
+            }
+        }
+        ipiv[k] = p;
+        if (ak[p] == 0.0) {
+            return k + 1;
+        }
+        if (p != k) {
+            for (size_t j = 0; j < n; j++) {
+                std::swap(a[j*n + k], a[j*n + p]);
+            }
+        }
+        double rpiv = 1.0 / ak[k];
+        for (size_t i = k + 1; i < n; i++) {
+            ak[i] *= rpiv;
+        }
+        for (size_t j = k + 1; j < n; j++) {
+            double* aj = a + j*n;
+            double akj = aj[k];
+            if (akj != 0.0) {
+                for (size_t i = k + 1; i < n; i++) {
+                    aj[i] -= ak[i] * akj;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+//! Solve a system with *nrhs* right hand sides stored in the columns of the
+//! n x nrhs array *b*, using the factorization computed by luFactor()
+void luSolve(const double* a, size_t n, const size_t* ipiv, double* b,
+             size_t nrhs)
+{
+    for (size_t m = 0; m < nrhs; m++) {
+        double* bm = b + m*n;
+        for (size_t k = 0; k < n; k++) {
+            if (ipiv[k] != k) {
+                std::swap(bm[k], bm[ipiv[k]]);
+            }
+        }
+        for (size_t k = 0; k < n; k++) {
+            double bk = bm[k];
+            if (bk != 0.0) {
+                const double* ak = a + k*n;
+                for (size_t i = k + 1; i < n; i++) {
+                    bm[i] -= ak[i] * bk;
+                }
+            }
+        }
+        for (size_t k = n; k-- > 0;) {
+            const double* ak = a + k*n;
+            bm[k] /= ak[k];
+            double bk = bm[k];
+            if (bk != 0.0) {
+                for (size_t i = 0; i < k; i++) {
+                    bm[i] -= ak[i] * bk;
+                }
+            }
+        }
+    }
+}
+
+//! Compute c += alpha*a*b, where *a* is an m x l matrix, and *b* is an l x n
+//! matrix. All matrices are stored in column-major order.
+void multiplyAdd(const double* a, const double* b, double* c,
+                 size_t m, size_t l, size_t n, double alpha)
+{
+    for (size_t j = 0; j < n; j++) {
+        double* cj = c + j*m;
+        for (size_t k = 0; k < l; k++) {
+            double bkj = alpha * b[j*l + k];
+            if (bkj != 0.0) {
+                const double* ak = a + k*m;
+                for (size_t i = 0; i < m; i++) {
+                    cj[i] += ak[i] * bkj;
+                }
+            }
+        }
+    }
+}
+
+//! Compute c -= a*b, where *a* is an m x l matrix which is expected to be
+//! sparse, and *b* is an l x n matrix. All matrices are stored in
+//! column-major order, with leading dimensions *m*, *ldb* and *ldc*,
+//! respectively. Only the nonzero elements of each column of *a* are used,
+//! which is much faster than multiplyAdd() for the off-diagonal blocks of
+//! typical Jacobians.
+void sparseMultiplySubtract(const double* a, const double* b, double* c,
+                            size_t m, size_t l, size_t n, size_t ldb,
+                            size_t ldc,
+                            std::vector<std::pair<size_t, double>>& nonzeros)
+{
+    for (size_t k = 0; k < l; k++) {
+        const double* ak = a + k*m;
+        nonzeros.clear();
+        for (size_t i = 0; i < m; i++) {
+            if (ak[i] != 0.0) {
+                nonzeros.emplace_back(i, ak[i]);
+            }
+        }
+        if (nonzeros.empty()) {
+            continue;
+        }
+        for (size_t j = 0; j < n; j++) {
+            double bkj = b[j*ldb + k];
+            if (bkj != 0.0) {
+                double* cj = c + j*ldc;
+                for (const auto& nz : nonzeros) {
+                    cj[nz.first] -= nz.second * bkj;
+                }
+            }
+        }
+    }
+}
+
+//! Copy the m x n column-major matrix *a* into the matrix *c*, which has
+//! leading dimension *ldc*
+void copyBlock(const double* a, size_t m, size_t n, double* c, size_t ldc)
+{
+    for (size_t j = 0; j < n; j++) {
+        std::copy(a + j*m, a + (j+1)*m, c + j*ldc);
+    }
+}
+
+} // end unnamed namespace
+
+BlockTridiagMatrix::BlockTridiagMatrix() :
+    m_n(0),
+    m_diagonalOnly(false),
+    m_factored(false),
+    m_info(0),
+    m_zero(0.0)
+{
+    m_start.push_back(0);
+    m_groups.push_back(0);
+}
+
+BlockTridiagMatrix::BlockTridiagMatrix(const std::vector<size_t>& blockSizes,
+                                       bool diagonalOnly) :
+    m_n(0),
+    m_diagonalOnly(false),
+    m_factored(false),
+    m_info(0),
+    m_zero(0.0)
+{
+    resize(blockSizes, diagonalOnly);
+}
+
+void BlockTridiagMatrix::resize(const std::vector<size_t>& blockSizes,
+                                bool diagonalOnly)
+{
+    size_t nb = blockSizes.size();
+    m_diagonalOnly = diagonalOnly;
+    m_size = blockSizes;
+    m_start.assign(nb + 1, 0);
+    m_diagLoc.assign(nb, 0);
+    m_lowerLoc.assign(nb, 0);
+    m_upperLoc.assign(nb, 0);
+    m_block.clear();
+    size_t nd = 0, nl = 0, nu = 0;
+    for (size_t k = 0; k < nb; k++) {
+        size_t n = m_size[k];
+        m_start[k+1] = m_start[k] + n;
+        m_block.insert(m_block.end(), n, k);
+        m_diagLoc[k] = nd;
+        nd += n * n;
+        if (m_diagonalOnly) {
+            continue;
+        }
+        if (k > 0) {
+            m_lowerLoc[k] = nl;
+            nl += n * m_size[k-1];
+        }
+        if (k + 1 < nb) {
+            m_upperLoc[k] = nu;
+            nu += n * m_size[k+1];
+        }
+    }
+    m_n = m_start[nb];
+    m_diag.assign(nd, 0.0);
+    m_lower.assign(nl, 0.0);
+    m_upper.assign(nu, 0.0);
+    m_lu.clear();
+    m_lu.reserve(nd);
+    m_gain.clear();
+    m_gain.reserve(nu);
+    m_groups.assign(1, 0);
+    m_ipiv.assign(m_n, 0);
+    m_factored = false;
+    m_info = 0;
+}
+
+void BlockTridiagMatrix::zero()
+{
+    std::fill(m_diag.begin(), m_diag.end(), 0.0);
+    std::fill(m_lower.begin(), m_lower.end(), 0.0);
+    std::fill(m_upper.begin(), m_upper.end(), 0.0);
+    m_factored = false;
+}
+
+doublereal& BlockTridiagMatrix::value(size_t i, size_t j)
+{
+    m_factored = false;
+    size_t bi = m_block[i];
+    size_t bj = m_block[j];
+    size_t ni = m_size[bi];
+    size_t il = i - m_start[bi];
+    size_t jl = j - m_start[bj];
+    if (bi == bj) {
+        return m_diag[m_diagLoc[bi] + jl*ni + il];
+    } else if (m_diagonalOnly) {
+        // off-diagonal blocks are not stored
+    } else if (bj + 1 == bi) {
+        return m_lower[m_lowerLoc[bi] + jl*ni + il];
+    } else if (bi + 1 == bj) {
+        return m_upper[m_upperLoc[bi] + jl*ni + il];
+    }
+    m_zero = 0.0;
+    return m_zero;
+}
+
+doublereal BlockTridiagMatrix::value(size_t i, size_t j) const
+{
+    size_t bi = m_block[i];
+    size_t bj = m_block[j];
+    size_t ni = m_size[bi];
+    size_t il = i - m_start[bi];
+    size_t jl = j - m_start[bj];
+    if (bi == bj) {
+        return m_diag[m_diagLoc[bi] + jl*ni + il];
+    } else if (m_diagonalOnly) {
+        // off-diagonal blocks are not stored
+    } else if (bj + 1 == bi) {
+        return m_lower[m_lowerLoc[bi] + jl*ni + il];
+    } else if (bi + 1 == bj) {
+        return m_upper[m_upperLoc[bi] + jl*ni + il];
+    }
+    return 0.0;
+}
+
+void BlockTridiagMatrix::mult(const doublereal* b, doublereal* prod) const
+{
+    std::fill(prod, prod + m_n, 0.0);
+    size_t nb = nBlocks();
+    for (size_t k = 0; k < nb; k++) {
+        size_t n = m_size[k];
+        double* pk = prod + m_start[k];
+        multiplyAdd(m_diag.data() + m_diagLoc[k], b + m_start[k], pk,
+                    n, n, 1, 1.0);
+        if (m_diagonalOnly) {
+            continue;
+        }
+        if (k > 0) {
+            multiplyAdd(m_lower.data() + m_lowerLoc[k], b + m_start[k-1], pk,
+                        n, m_size[k-1], 1, 1.0);
+        }
+        if (k + 1 < nb) {
+            multiplyAdd(m_upper.data() + m_upperLoc[k], b + m_start[k+1], pk,
+                        n, m_size[k+1], 1, 1.0);
+        }
+    }
+}
+
+int BlockTridiagMatrix::factor()
+{
+    m_lu.clear();
+    m_gain.clear();
+    m_groups.assign(1, 0);
+    m_luLoc.clear();
+    m_gainLoc.clear();
+    m_info = 0;
+    size_t nb = nBlocks();
+    size_t a = 0; // first block of the current group
+    while (a < nb) {
+        size_t b = a; // last block of the current group
+        size_t r0 = m_start[a];
+        size_t* ipiv = m_ipiv.data() + r0;
+        size_t loc = m_lu.size();
+        size_t info = 0;
+        while (true) {
+            size_t n = m_start[b+1] - r0;
+            m_lu.resize(loc);
+            m_lu.resize(loc + n*n, 0.0);
+            double* lu = m_lu.data() + loc;
+            for (size_t p = a; p <= b; p++) {
+                double* lup = lu + (m_start[p] - r0) * (n + 1);
+                copyBlock(m_diag.data() + m_diagLoc[p], m_size[p], m_size[p],
+                          lup, n);
+                if (p > a) {
+                    copyBlock(m_lower.data() + m_lowerLoc[p], m_size[p],
+                              m_size[p-1], lup - m_size[p-1] * n, n);
+                }
+                if (p < b) {
+                    copyBlock(m_upper.data() + m_upperLoc[p], m_size[p],
+                              m_size[p+1], lup + m_size[p] * n, n);
+                }
+            }
+            if (a > 0 && !m_diagonalOnly) {
+                // Subtract L_a times the rows of the gain of the previous
+                // group which belong to its last block
+                size_t nprev = r0 - m_start[m_groups[m_groups.size() - 2]];
+                sparseMultiplySubtract(m_lower.data() + m_lowerLoc[a],
+                    m_gain.data() + m_gainLoc.back() + nprev - m_size[a-1],
+                    lu, m_size[a], m_size[a-1], m_size[a], nprev, n,
+                    m_nonzeros);
+            }
+            size_t status = luFactor(lu, n, ipiv);
+            if (status == 0) {
+                break;
+            }
+            if (b == a) {
+                info = status;
+            }
+            if (m_diagonalOnly || b + 1 == nb) {
+                m_info = static_cast<int>(r0 + info);
+                throw CanteraError("BlockTridiagMatrix::factor",
+                    "Factorization failed: zero pivot in diagonal block {} "
+                    "(matrix row {}).", a, m_info - 1);
+            }
+            // Merge the next block into the current group and try again
+            b++;
+        }
+        m_luLoc.push_back(loc);
+        m_gainLoc.push_back(m_gain.size());
+        if (b + 1 < nb && !m_diagonalOnly) {
+            size_t n = m_start[b+1] - r0;
+            size_t gloc = m_gain.size();
+            m_gain.resize(gloc + n * m_size[b+1], 0.0);
+            double* gain = m_gain.data() + gloc;
+            copyBlock(m_upper.data() + m_upperLoc[b], m_size[b], m_size[b+1],
+                      gain + m_start[b] - r0, n);
+            luSolve(m_lu.data() + loc, n, ipiv, gain, m_size[b+1]);
+        }
+        a = b + 1;
+        m_groups.push_back(a);
+    }
+    m_factored = true;
+    return m_info;
+}
+
+int BlockTridiagMatrix::solve(const doublereal* const b, doublereal* const x)
+{
+    if (x != b) {
+        std::copy(b, b + m_n, x);
+    }
+    return solve(x);
+}
+
+int BlockTridiagMatrix::solve(doublereal* b)
+{
+    if (!m_factored) {
+        factor();
+    }
+    size_t ng = nFactorBlocks();
+    for (size_t g = 0; g < ng; g++) {
+        size_t a = m_groups[g];
+        size_t r0 = m_start[a];
+        size_t n = m_start[m_groups[g+1]] - r0;
+        if (a > 0 && !m_diagonalOnly) {
+            multiplyAdd(m_lower.data() + m_lowerLoc[a], b + m_start[a-1],
+                        b + r0, m_size[a], m_size[a-1], 1, -1.0);
+        }
+        luSolve(m_lu.data() + m_luLoc[g], n, m_ipiv.data() + r0, b + r0, 1);
+    }
+    if (m_diagonalOnly || ng == 0) {
+        return 0;
+    }
+    for (size_t g = ng - 1; g-- > 0;) {
+        size_t r0 = m_start[m_groups[g]];
+        size_t next = m_groups[g+1];
+        multiplyAdd(m_gain.data() + m_gainLoc[g], b + m_start[next], b + r0,
+                    m_start[next] - r0, m_size[next], 1, -1.0);
+    }
+    return 0;
+}
+
+}
@@ -212,6 +212,74 @@ int solve(DenseMatrix& A, DenseMatrix& b)
     return solve(A, b.ptrColumn(0), b.nColumns(), b.nRows());
 }
 
+int factor(DenseMatrix& A)
+{
+    if (A.nColumns() != A.nRows()) {
+        throw CanteraError("factor(DenseMatrix& A)",
+                           "Can only factor a square matrix");
+    }
+    int info = 0;
+    #if CT_USE_LAPACK
+        ct_dgetrf(A.nRows(), A.nColumns(), A.ptrColumn(0),
+                  A.nRows(), &A.ipiv()[0], info);
+    #else
+        MappedMatrix Am(&A(0,0), A.nRows(), A.nColumns());
+        Eigen::PartialPivLU<Eigen::MatrixXd> lu(Am);
+        Am = lu.matrixLU();
+        for (size_t i = 0; i < A.nRows(); i++) {
+            A.ipiv()[i] = lu.permutationP().indices()[i];
+            if (Am(i,i) == 0.0 && info == 0) {
+                info = static_cast<int>(i) + 1;
+            }
+        }
+    #endif
+    if (info > 0) {
+        if (A.m_printLevel) {
+            writelogf("factor(DenseMatrix& A): DGETRF returned INFO = %d. U(i,i) is exactly zero.\n", info);
+        }
+        if (!A.m_useReturnErrorCode) {
+            throw CanteraError("factor(DenseMatrix& A)",
+                               "DGETRF returned INFO = {}. U(i,i) is exactly "
+                               "zero. The matrix is singular.", info);
+        }
+    } else if (info < 0) {
+        throw CanteraError("factor(DenseMatrix& A)",
+                           "DGETRF returned INFO = {}. The argument i has an "
+                           "illegal value", info);
+    }
+    return info;
+}
+
+int solveFactored(DenseMatrix& A, double* b, size_t nrhs, size_t ldb)
+{
+    int info = 0;
+    if (ldb == 0) {
+        ldb = A.nColumns();
+    }
+    #if CT_USE_LAPACK
+        ct_dgetrs(ctlapack::NoTranspose, A.nRows(), nrhs, A.ptrColumn(0),
+                  A.nRows(), &A.ipiv()[0], b, ldb, info);
+        if (info != 0) {
+            throw CanteraError("solveFactored(DenseMatrix& A, double* b)",
+                               "DGETRS returned INFO = {}", info);
+        }
+    #else
+        MappedMatrix Am(&A(0,0), A.nRows(), A.nColumns());
+        Eigen::PermutationMatrix<Eigen::Dynamic> P(A.nRows());
+        for (size_t i = 0; i < A.nRows(); i++) {
+            P.indices()[i] = A.ipiv()[i];
+        }
+        for (size_t i = 0; i < nrhs; i++) {
+            MappedVector bm(b + ldb*i, A.nColumns());
+            Eigen::VectorXd x = P * bm;
+            Am.triangularView<Eigen::UnitLower>().solveInPlace(x);
+            Am.triangularView<Eigen::Upper>().solveInPlace(x);
+            bm = x;
+        }
+    #endif
+    return info;
+}
+
 void multiply(const DenseMatrix& A, const double* const b, double* const prod)
 {
     A.mult(b, prod);
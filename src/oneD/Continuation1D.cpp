@@ -0,0 +1,514 @@
+//! @file Continuation1D.cpp
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/oneD/Continuation1D.h"
+#include "cantera/oneD/MultiJac.h"
+#include "cantera/oneD/MultiNewton.h"
+#include "cantera/oneD/Inlet1D.h"
+#include "cantera/oneD/StFlow.h"
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace
+{
+//! Maximum number of damping steps in each corrector iteration
+const size_t NDAMP = 7;
+
+//! Reduction of the damping coefficient between damping steps
+const double DampFactor = sqrt(2.0);
+}
+
+Continuation1D::Continuation1D(Sim1D& sim, function<void(double)> setParameter,
+                               double p0)
+    : m_sim(sim)
+    , m_setParameter(setParameter)
+    , m_p(p0)
+    , m_pscale(p0 != 0.0 ? fabs(p0) : 1.0)
+    , m_ds(0.1 * m_pscale)
+    , m_dsMin(1e-8)
+    , m_dsMax(BigNumber)
+    , m_direction(1.0)
+    , m_arclength(false)
+    , m_refine(false)
+    , m_maxIter(20)
+    , m_p0(p0)
+    , m_tangent_p(1.0)
+    , m_weight_p(1.0)
+    , m_nSteps(0)
+    , m_nFailed(0)
+    , m_nIter(0)
+    , m_nJacEvals(0)
+    , m_nTurning(0)
+{
+    if (sim.linearSolver() == "jfnk") {
+        throw CanteraError("Continuation1D::Continuation1D", "Continuation "
+            "requires the full Jacobian, which is not available when using "
+            "the Jacobian-free linear solver.");
+    }
+    // Use the Jacobian from the last solve, unless it has been replaced
+    // because the grid changed
+    m_jacValid = (sim.OneDim::jacobian().nEvals() > 0);
+    m_setParameter(m_p);
+}
+
+void Continuation1D::setStepSize(double ds, double dsMin, double dsMax)
+{
+    if (ds == 0.0 || dsMin <= 0.0 || dsMax < dsMin) {
+        throw CanteraError("Continuation1D::setStepSize",
+            "Invalid step sizes: ds = {}, dsMin = {}, dsMax = {}",
+            ds, dsMin, dsMax);
+    }
+    m_direction = (ds > 0) ? 1.0 : -1.0;
+    m_ds = std::min(std::max(fabs(ds), dsMin), dsMax);
+    m_dsMin = dsMin;
+    m_dsMax = dsMax;
+    m_tangent.clear();
+}
+
+void Continuation1D::applyParameter(double p)
+{
+    m_p = p;
+    m_setParameter(p);
+}
+
+void Continuation1D::evalJacobian()
+{
+    m_sim.evalSSJacobian();
+    m_nJacEvals++;
+    m_jacValid = true;
+}
+
+void Continuation1D::solveJacobian(double* b)
+{
+    m_sim.OneDim::jacobian().solve(b, b);
+}
+
+void Continuation1D::evalParameterDerivative()
+{
+    size_t n = m_sim.size();
+    m_f.resize(n);
+    m_fp.resize(n);
+    m_sim.getResidual(0.0, m_f.data());
+    double p = m_p;
+    double dp = sqrt(std::numeric_limits<double>::epsilon())
+                * std::max(fabs(p), m_pscale);
+    m_setParameter(p + dp);
+    m_sim.getResidual(0.0, m_fp.data());
+    m_setParameter(p);
+    for (size_t i = 0; i < n; i++) {
+        m_fp[i] = (m_fp[i] - m_f[i]) / dp;
+    }
+}
+
+vector_fp Continuation1D::turningPointSensitivities(size_t nIter)
+{
+    if (nIter == 0) {
+        throw CanteraError("Continuation1D::turningPointSensitivities",
+                           "At least one iteration is required.");
+    }
+    size_t n = m_sim.size();
+    vector_fp phi(n, 1.0), b(n);
+    for (size_t k = 0; k < nIter; k++) {
+        m_sim.solveAdjoint(phi.data(), b.data(), 1, k == 0);
+        double norm = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            norm += b[i] * b[i];
+        }
+        norm = sqrt(norm);
+        for (size_t i = 0; i < n; i++) {
+            phi[i] = b[i] / norm;
+        }
+    }
+
+    evalParameterDerivative();
+    double phi_Fp = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        phi_Fp += phi[i] * m_fp[i];
+    }
+    Array2D prod = m_sim.reactionDerivativeProducts(phi.data(), 1);
+    vector_fp sens(prod.nColumns());
+    for (size_t i = 0; i < sens.size(); i++) {
+        sens[i] = -prod(0, i) / phi_Fp;
+    }
+    return sens;
+}
+
+void Continuation1D::computeScales()
+{
+    size_t n = m_sim.size();
+    const double* x = m_sim.solution();
+    m_scale.resize(n);
+    m_weight.resize(n);
+    for (size_t i = 0; i < m_sim.nDomains(); i++) {
+        Domain1D& d = m_sim.domain(i);
+        size_t nc = d.nComponents();
+        size_t loc = d.loc();
+        for (size_t k = 0; k < nc; k++) {
+            // Components which are negligible everywhere, such as trace
+            // species, should not dominate the inner product
+            double xmax = std::max(d.atol(k), 1e-6);
+            for (size_t j = 0; j < d.nPoints(); j++) {
+                xmax = std::max(xmax, fabs(x[loc + nc*j + k]));
+            }
+            for (size_t j = 0; j < d.nPoints(); j++) {
+                m_scale[loc + nc*j + k] = xmax;
+            }
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        m_weight[i] = m_pscale * m_pscale / (n * m_scale[i] * m_scale[i]);
+    }
+    m_weight_p = 1.0;
+}
+
+void Continuation1D::computeTangent()
+{
+    size_t n = m_sim.size();
+    evalParameterDerivative();
+    m_b.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        m_b[i] = -m_fp[i];
+    }
+    solveJacobian(m_b.data());
+
+    if (!m_arclength) {
+        // dx/dp
+        m_tangent = m_b;
+        m_tangent_p = 1.0;
+        return;
+    }
+
+    // Normalize the tangent (dx/dp, 1) to unit length
+    double norm = m_weight_p;
+    for (size_t i = 0; i < n; i++) {
+        norm += m_weight[i] * m_b[i] * m_b[i];
+    }
+    norm = sqrt(norm);
+
+    // Keep the orientation of the previous tangent, if it is available for the
+    // current grid. Otherwise, continue in the direction in which the
+    // parameter was changing.
+    double sign = m_direction;
+    if (m_tangent.size() == n) {
+        double dot = m_weight_p * m_tangent_p / norm;
+        for (size_t i = 0; i < n; i++) {
+            dot += m_weight[i] * m_tangent[i] * m_b[i] / norm;
+        }
+        sign = (dot >= 0) ? 1.0 : -1.0;
+    }
+    double tangent_p = sign / norm;
+    if (m_nSteps > 0 && tangent_p * m_tangent_p < 0) {
+        m_nTurning++;
+    }
+    m_tangent_p = tangent_p;
+    m_tangent.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        m_tangent[i] = m_b[i] * tangent_p;
+    }
+    m_direction = (tangent_p >= 0) ? 1.0 : -1.0;
+}
+
+double Continuation1D::newtonStep(const double* x, double* dx, double& dp)
+{
+    size_t n = m_sim.size();
+    dp = 0.0;
+    if (m_arclength) {
+        evalParameterDerivative();
+    } else {
+        m_f.resize(n);
+        m_sim.getResidual(0.0, m_f.data());
+    }
+    for (size_t i = 0; i < n; i++) {
+        dx[i] = -m_f[i];
+    }
+    solveJacobian(dx);
+
+    if (m_arclength) {
+        // Bordered system: the Newton step is dx = a + dp*b, where J*a = -F
+        // and J*b = -F_p, and dp is found from the linearized arclength
+        // constraint
+        m_b.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            m_b[i] = -m_fp[i];
+        }
+        solveJacobian(m_b.data());
+        double g = m_tangent_p * (m_p - m_p0) - m_ds;
+        double ta = 0.0;
+        double tb = m_tangent_p;
+        for (size_t i = 0; i < n; i++) {
+            g += m_weight[i] * m_tangent[i] * (x[i] - m_x0[i]);
+            ta += m_weight[i] * m_tangent[i] * dx[i];
+            tb += m_weight[i] * m_tangent[i] * m_b[i];
+        }
+        dp = (-g - ta) / tb;
+        for (size_t i = 0; i < n; i++) {
+            dx[i] += dp * m_b[i];
+        }
+    }
+    double s = m_sim.newton().norm2(x, dx, m_sim);
+    if (m_arclength) {
+        // Include the parameter in the convergence criterion
+        s = std::max(s, fabs(dp) / (1e-5 * m_pscale));
+    }
+    return s;
+}
+
+int Continuation1D::correct(int loglevel)
+{
+    size_t n = m_sim.size();
+    MultiNewton& newton = m_sim.newton();
+    vector_fp x0(m_sim.solution(), m_sim.solution() + n);
+    vector_fp x1(n);
+    m_dx.resize(n);
+    m_dx1.resize(n);
+    double p0 = m_p;
+    double dp, dp1;
+    double s0 = newtonStep(x0.data(), m_dx.data(), dp);
+    bool newJac = false; // Jacobian evaluated at the current iterate
+    bool jacUpdated = false; // Jacobian evaluated during this corrector
+
+    // Damped Newton iterations, using the same criteria as
+    // MultiNewton::dampStep
+    for (size_t iter = 0; iter < m_maxIter; iter++) {
+        if (s0 < 1.0) {
+            // The remaining step is within the tolerances
+            for (size_t i = 0; i < n; i++) {
+                x1[i] = x0[i] + m_dx[i];
+            }
+            m_sim.setSolution(x1.data());
+            applyParameter(p0 + dp);
+            return static_cast<int>(iter);
+        }
+
+        double fbound = newton.boundStep(x0.data(), m_dx.data(), m_sim,
+                                         loglevel-1);
+        double damp = 1.0;
+        double s1 = BigNumber;
+        size_t m;
+        for (m = 0; m < NDAMP && fbound > 1e-10; m++) {
+            double ff = fbound * damp;
+            for (size_t i = 0; i < n; i++) {
+                x1[i] = x0[i] + ff * m_dx[i];
+            }
+            m_sim.setSolution(x1.data());
+            applyParameter(p0 + ff * dp);
+            s1 = newtonStep(x1.data(), m_dx1.data(), dp1);
+            if (s1 < 1.0 || s1 < s0) {
+                break;
+            }
+            damp /= DampFactor;
+        }
+        if (loglevel > 1) {
+            writelog("    corrector iteration {}: log10(s) = {:8.3f}, "
+                     "damping = {:8.3g}, p = {:12.6g}\n",
+                     iter + 1, log10(s1), fbound * damp, m_p);
+        }
+
+        if (fbound <= 1e-10 || m == NDAMP) {
+            // No damping coefficient was found. Re-evaluate the Jacobian at
+            // the current iterate and try again, unless it was just
+            // evaluated.
+            m_sim.setSolution(x0.data());
+            applyParameter(p0);
+            if (newJac) {
+                debuglog("    corrector failed\n", loglevel);
+                return -1;
+            }
+            debuglog("    re-evaluating the Jacobian\n", loglevel);
+            evalJacobian();
+            newJac = true;
+            jacUpdated = true;
+            s0 = newtonStep(x0.data(), m_dx.data(), dp);
+            continue;
+        }
+
+        m_nIter++;
+        bool slow = (damp < 1.0 || fbound < 1.0 || s1 > 0.5 * s0);
+        x0.swap(x1);
+        m_dx.swap(m_dx1);
+        p0 = m_p;
+        dp = dp1;
+        s0 = s1;
+        newJac = false;
+        if (slow && !jacUpdated && s0 >= 1.0) {
+            // Convergence with the Jacobian from a previous step is slow, so
+            // evaluate it at the current iterate
+            debuglog("    re-evaluating the Jacobian\n", loglevel);
+            evalJacobian();
+            newJac = true;
+            jacUpdated = true;
+            s0 = newtonStep(x0.data(), m_dx.data(), dp);
+        }
+    }
+    debuglog("    corrector did not converge\n", loglevel);
+    return -1;
+}
+
+int Continuation1D::step(int loglevel)
+{
+    size_t n = m_sim.size();
+    m_x0.assign(m_sim.solution(), m_sim.solution() + n);
+    m_p0 = m_p;
+    if (!m_jacValid || m_sim.OneDim::jacobian().nEvals() == 0) {
+        evalJacobian();
+    }
+    computeScales();
+    computeTangent();
+
+    vector_fp x(n);
+    while (true) {
+        double dp;
+        if (m_arclength) {
+            dp = m_ds * m_tangent_p;
+            for (size_t i = 0; i < n; i++) {
+                x[i] = m_x0[i] + m_ds * m_tangent[i];
+            }
+        } else {
+            dp = m_direction * m_ds;
+            for (size_t i = 0; i < n; i++) {
+                x[i] = m_x0[i] + dp * m_tangent[i];
+            }
+        }
+        // Keep the predicted solution within the bounds of each component
+        for (size_t i = 0; i < m_sim.nDomains(); i++) {
+            Domain1D& d = m_sim.domain(i);
+            size_t nc = d.nComponents();
+            for (size_t j = 0; j < d.nPoints(); j++) {
+                for (size_t k = 0; k < nc; k++) {
+                    double& xk = x[d.loc() + nc*j + k];
+                    xk = clip(xk, d.lowerBound(k), d.upperBound(k));
+                }
+            }
+        }
+        m_sim.setSolution(x.data());
+        applyParameter(m_p0 + dp);
+        if (loglevel > 0) {
+            writelog("Continuation step {}: p = {:12.6g}, ds = {:10.4g}\n",
+                     m_nSteps + 1, m_p, m_ds);
+        }
+
+        int iter = correct(loglevel);
+        if (iter >= 0) {
+            if (iter <= 3) {
+                m_ds = std::min(1.5 * m_ds, m_dsMax);
+            }
+            break;
+        }
+
+        // Restore the last solution and retry with a smaller step
+        m_nFailed++;
+        m_sim.setSolution(m_x0.data());
+        applyParameter(m_p0);
+        if (m_ds <= m_dsMin) {
+            debuglog("Continuation failed at the minimum step size\n",
+                     loglevel);
+            return -1;
+        }
+        m_ds = std::max(0.5 * m_ds, m_dsMin);
+        debuglog(fmt::format("Corrector failed; reducing step size to {}\n",
+                             m_ds), loglevel);
+    }
+    m_nSteps++;
+
+    if (m_refine) {
+        m_sim.refine(loglevel - 1);
+        if (m_sim.size() != n) {
+            // Converge the solution on the new grid, for which a new Jacobian
+            // is needed
+            m_sim.solve(loglevel - 1, true);
+            m_jacValid = false;
+        }
+    }
+    return 0;
+}
+
+size_t Continuation1D::advance(double pEnd, size_t maxSteps, int loglevel)
+{
+    size_t nsteps = 0;
+    if (!m_arclength || m_tangent.empty()) {
+        m_direction = (pEnd >= m_p) ? 1.0 : -1.0;
+    }
+    while (nsteps < maxSteps && m_p != pEnd) {
+        double dsave = m_ds;
+        bool last = false;
+        if (!m_arclength && m_ds >= fabs(pEnd - m_p)) {
+            m_ds = fabs(pEnd - m_p);
+            last = true;
+        }
+        double p0 = m_p;
+        if (step(loglevel) < 0) {
+            break;
+        }
+        nsteps++;
+        if (last) {
+            // keep the step size from before it was shortened
+            m_ds = std::max(dsave, m_ds);
+            if (m_p == pEnd) {
+                break;
+            }
+        }
+        if ((m_p - pEnd) * (p0 - pEnd) <= 0) {
+            break;
+        }
+    }
+    return nsteps;
+}
+
+// Parameter functions
+
+function<void(double)> Continuation1D::massFlowRate(Inlet1D& inlet)
+{
+    return [&inlet](double mdot) {
+        inlet.setMdot(mdot);
+    };
+}
+
+function<void(double)> Continuation1D::compositionBlend(Inlet1D& inlet,
+    const vector_fp& X0, const vector_fp& X1)
+{
+    if (X0.size() != X1.size()) {
+        throw CanteraError("Continuation1D::compositionBlend",
+            "Compositions have different sizes ({} and {})",
+            X0.size(), X1.size());
+    }
+    vector_fp X(X0.size());
+    return [&inlet, X0, X1, X](double p) mutable {
+        for (size_t k = 0; k < X.size(); k++) {
+            X[k] = (1 - p) * X0[k] + p * X1[k];
+        }
+        inlet.setMoleFractions(X.data());
+    };
+}
+
+function<void(double)> Continuation1D::pressure(StFlow& flow)
+{
+    return [&flow](double p) {
+        flow.setPressure(p);
+    };
+}
+
+function<void(double)> Continuation1D::domainWidth(StFlow& flow)
+{
+    vector_fp z;
+    return [&flow, z](double width) mutable {
+        size_t np = flow.nPoints();
+        double z0 = flow.grid(0);
+        double factor = width / (flow.grid(np - 1) - z0);
+        z.resize(np);
+        for (size_t j = 0; j < np; j++) {
+            z[j] = z0 + (flow.grid(j) - z0) * factor;
+        }
+        FreeFlame* free = dynamic_cast<FreeFlame*>(&flow);
+        if (free) {
+            free->m_zfixed = z0 + (free->m_zfixed - z0) * factor;
+        }
+        flow.setupGrid(np, z.data());
+    };
+}
+
+}
@@ -0,0 +1,475 @@
+//! @file FlameSweep.cpp
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/oneD/FlameSweep.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/kinetics/KineticsFactory.h"
+#include "cantera/transport/TransportFactory.h"
+#include "cantera/base/ctml.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace Cantera
+{
+
+FlameSweep::FlameSweep(IdealGasPhase& gas, const string& transportModel,
+                       const string& flameType)
+    : m_gas(gas)
+    , m_transportModel(transportModel)
+    , m_free(true)
+    , m_next(0)
+{
+    if (flameType == "counterflow") {
+        m_free = false;
+    } else if (flameType != "free") {
+        throw CanteraError("FlameSweep::FlameSweep",
+                           "Unknown flame type '{}'", flameType);
+    }
+}
+
+void FlameSweep::setInitialGrid(const vector_fp& z)
+{
+    if (z.size() < 2) {
+        throw CanteraError("FlameSweep::setInitialGrid",
+                           "The grid must have at least two points");
+    }
+    m_grid = z;
+}
+
+void FlameSweep::addCase(const vector_fp& parameters)
+{
+    if (!m_results.empty() &&
+        parameters.size() != m_results[0].parameters.size()) {
+        throw CanteraError("FlameSweep::addCase", "Expected {} parameters, "
+            "got {}", m_results[0].parameters.size(), parameters.size());
+    }
+    Result r;
+    r.parameters = parameters;
+    r.converged = false;
+    r.seeded = false;
+    r.flameSpeed = r.maxTemperature = r.zfixed = r.tfixed =
+        numeric_limits<double>::quiet_NaN();
+    m_results.push_back(r);
+    m_done.push_back(false);
+}
+
+size_t FlameSweep::nFailed() const
+{
+    size_t n = 0;
+    for (size_t i = 0; i < m_results.size(); i++) {
+        if (m_done[i] && !m_results[i].converged) {
+            n++;
+        }
+    }
+    return n;
+}
+
+size_t FlameSweep::nInitialGuess() const
+{
+    size_t n = 0;
+    for (auto& r : m_results) {
+        if (r.converged && !r.seeded) {
+            n++;
+        }
+    }
+    return n;
+}
+
+unique_ptr<FlameSweep::Flame> FlameSweep::newFlame() const
+{
+    unique_ptr<Flame> f(new Flame());
+    unique_ptr<ThermoPhase> phase(newPhase(m_gas.xml()));
+    f->gas.reset(dynamic_cast<IdealGasPhase*>(phase.get()));
+    if (!f->gas) {
+        throw CanteraError("FlameSweep::newFlame",
+                           "The phase must be an IdealGasPhase");
+    }
+    phase.release();
+    f->kinetics.reset(newKineticsMgr(f->gas->xml(), {f->gas.get()}));
+    f->transport.reset(newTransportMgr(m_transportModel, f->gas.get()));
+
+    f->inlet.reset(new Inlet1D());
+    if (m_free) {
+        f->flow.reset(new FreeFlame(f->gas.get()));
+        f->right.reset(new Outlet1D());
+    } else {
+        f->flow.reset(new AxiStagnFlow(f->gas.get()));
+        f->right.reset(new Inlet1D());
+    }
+    f->flow->setupGrid(m_grid.size(), m_grid.data());
+    f->flow->setKinetics(*f->kinetics);
+    f->flow->setTransport(*f->transport);
+    f->flow->setPressure(m_gas.pressure());
+    f->flow->solveEnergyEqn();
+
+    vector<Domain1D*> domains { f->inlet.get(), f->flow.get(),
+                                f->right.get() };
+    f->sim.reset(new Sim1D(domains));
+    if (m_setup) {
+        m_setup(*f);
+    }
+    return f;
+}
+
+void FlameSweep::run(size_t nThreads, bool refine, int loglevel)
+{
+    if (!m_setParameters) {
+        throw CanteraError("FlameSweep::run",
+                           "No parameter function has been set");
+    }
+    if (m_grid.empty()) {
+        throw CanteraError("FlameSweep::run", "No initial grid has been set");
+    }
+
+    // Parameters are scaled by their range over all cases to compute the
+    // distance between cases
+    size_t nParams = m_results.empty() ? 0 : m_results[0].parameters.size();
+    m_paramScale.assign(nParams, 0.0);
+    for (size_t k = 0; k < nParams; k++) {
+        double pmin = m_results[0].parameters[k];
+        double pmax = pmin;
+        for (auto& r : m_results) {
+            pmin = std::min(pmin, r.parameters[k]);
+            pmax = std::max(pmax, r.parameters[k]);
+        }
+        m_paramScale[k] = (pmax > pmin) ? pmax - pmin : 1.0;
+    }
+
+    size_t nPending = std::count(m_done.begin(), m_done.end(), false);
+    if (nPending == 0) {
+        return;
+    }
+    if (nThreads == 0) {
+        nThreads = std::max(thread::hardware_concurrency(), 1u);
+    }
+    nThreads = std::min(nThreads, nPending);
+
+    // Each thread needs its own flame. The flames are created here, before
+    // any threads are started.
+    vector<unique_ptr<Flame>> flames;
+    for (size_t i = 0; i < nThreads; i++) {
+        flames.push_back(newFlame());
+    }
+    m_componentNames.clear();
+    for (size_t n = 0; n < flames[0]->flow->nComponents(); n++) {
+        m_componentNames.push_back(flames[0]->flow->componentName(n));
+    }
+
+    m_next = 0;
+    vector<exception_ptr> errors(nThreads);
+    vector<thread> threads;
+    for (size_t i = 0; i < nThreads; i++) {
+        threads.emplace_back([&, i]() {
+            try {
+                solveCases(*flames[i], refine, loglevel);
+            } catch (...) {
+                errors[i] = current_exception();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (auto& err : errors) {
+        if (err) {
+            rethrow_exception(err);
+        }
+    }
+}
+
+void FlameSweep::solveCases(Flame& flame, bool refine, int loglevel)
+{
+    while (true) {
+        size_t i;
+        Result seed;
+        bool haveSeed = false;
+        Result r;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            while (m_next < m_done.size() && m_done[m_next]) {
+                m_next++;
+            }
+            if (m_next == m_done.size()) {
+                return;
+            }
+            i = m_next++;
+            r = m_results[i];
+            size_t j = closestCase(i);
+            if (j != npos) {
+                seed = m_results[j];
+                haveSeed = true;
+            }
+        }
+
+        r.converged = false;
+        if (haveSeed) {
+            try {
+                setSeed(flame, i, seed);
+                flame.sim->solve(loglevel - 1, refine);
+                r.converged = true;
+                r.seeded = true;
+            } catch (CanteraError& err) {
+                if (loglevel > 0) {
+                    lock_guard<mutex> lock(m_mutex);
+                    writelog("Case {} did not converge from the neighboring "
+                             "solution:\n{}\n", i, err.what());
+                }
+            }
+        }
+        if (!r.converged) {
+            try {
+                setInitialGuess(flame, i);
+                flame.sim->solve(loglevel - 1, refine);
+                r.converged = true;
+                r.seeded = false;
+            } catch (CanteraError& err) {
+                if (loglevel > 0) {
+                    lock_guard<mutex> lock(m_mutex);
+                    writelog("Case {} did not converge:\n{}\n", i, err.what());
+                }
+            }
+        }
+        if (r.converged) {
+            storeResult(flame, r);
+        }
+
+        lock_guard<mutex> lock(m_mutex);
+        m_results[i] = r;
+        m_done[i] = true;
+        if (loglevel > 0 && r.converged) {
+            writelog("Case {} converged ({} points, {}).\n", i,
+                     r.grid.size(), r.seeded ? "seeded" : "initial guess");
+        }
+    }
+}
+
+size_t FlameSweep::closestCase(size_t i) const
+{
+    size_t jmin = npos;
+    double dmin = numeric_limits<double>::max();
+    const vector_fp& p = m_results[i].parameters;
+    for (size_t j = 0; j < m_results.size(); j++) {
+        if (!m_done[j] || !m_results[j].converged) {
+            continue;
+        }
+        double d = 0.0;
+        for (size_t k = 0; k < p.size(); k++) {
+            d += pow((m_results[j].parameters[k] - p[k]) / m_paramScale[k], 2);
+        }
+        if (d < dmin) {
+            dmin = d;
+            jmin = j;
+        }
+    }
+    return jmin;
+}
+
+void FlameSweep::setInitialGuess(Flame& flame, size_t i)
+{
+    flame.flow->setupGrid(m_grid.size(), m_grid.data());
+    flame.sim->resize();
+    m_setParameters(flame, m_results[i].parameters);
+    flame.sim->getInitialSoln();
+    if (m_setGuess) {
+        m_setGuess(flame);
+    } else if (m_free) {
+        freeFlameGuess(flame);
+    } else {
+        counterflowGuess(flame);
+    }
+}
+
+void FlameSweep::setSeed(Flame& flame, size_t i, const Result& seed)
+{
+    StFlow& flow = *flame.flow;
+    flow.setupGrid(seed.grid.size(), seed.grid.data());
+    flame.sim->resize();
+    m_setParameters(flame, m_results[i].parameters);
+    if (m_free) {
+        // The flame speed of the neighboring solution is the best estimate of
+        // the mass flux for this case
+        vector_fp Y(flame.gas->nSpecies());
+        for (size_t k = 0; k < Y.size(); k++) {
+            Y[k] = flame.inlet->massFraction(k);
+        }
+        flame.gas->setState_TPY(flame.inlet->temperature(), flow.pressure(),
+                                Y.data());
+        flame.inlet->setMdot(flame.gas->density() * seed.flameSpeed);
+    }
+    flame.sim->getInitialSoln();
+
+    // Interpolate the neighboring solution onto the grid, which may have
+    // been modified by the parameter function
+    size_t nc = flow.nComponents();
+    size_t np = seed.grid.size();
+    double z0 = seed.grid[0];
+    double z1 = seed.grid[np - 1];
+    vector_fp pos(np), values(np);
+    for (size_t j = 0; j < np; j++) {
+        pos[j] = (seed.grid[j] - z0) / (z1 - z0);
+    }
+    pos[0] = 0.0;
+    pos[np - 1] = 1.0;
+    for (size_t n = 0; n < nc; n++) {
+        for (size_t j = 0; j < np; j++) {
+            values[j] = seed.solution[j * nc + n];
+        }
+        flame.sim->setProfile(flow.domainIndex(), n, pos, values);
+    }
+
+    if (m_free) {
+        FreeFlame& free = dynamic_cast<FreeFlame&>(flow);
+        if (flow.zmin() == z0 && flow.zmax() == z1) {
+            free.m_zfixed = seed.zfixed;
+        } else {
+            free.m_zfixed = flow.zmin() + (seed.zfixed - z0) / (z1 - z0) *
+                            (flow.zmax() - flow.zmin());
+        }
+        free.m_tfixed = seed.tfixed;
+    }
+}
+
+void FlameSweep::storeResult(Flame& flame, Result& r) const
+{
+    StFlow& flow = *flame.flow;
+    size_t nc = flow.nComponents();
+    size_t np = flow.nPoints();
+    const double* x = flame.sim->solution() + flame.sim->start(
+        flow.domainIndex());
+    r.grid = flow.grid();
+    r.solution.assign(x, x + nc * np);
+    r.flameSpeed = x[c_offset_U];
+    r.maxTemperature = 0.0;
+    for (size_t j = 0; j < np; j++) {
+        r.maxTemperature = std::max(r.maxTemperature, x[j * nc + c_offset_T]);
+    }
+    if (m_free) {
+        FreeFlame& free = dynamic_cast<FreeFlame&>(flow);
+        r.zfixed = free.m_zfixed;
+        r.tfixed = free.m_tfixed;
+    } else {
+        r.zfixed = r.tfixed = numeric_limits<double>::quiet_NaN();
+    }
+
+    r.xml = make_shared<XML_Node>("simulation");
+    Domain1D* d = flame.sim->left();
+    while (d) {
+        d->save(*r.xml, flame.sim->solution());
+        d = d->right();
+    }
+}
+
+void FlameSweep::freeFlameGuess(Flame& flame)
+{
+    IdealGasPhase& gas = *flame.gas;
+    StFlow& flow = *flame.flow;
+    Sim1D& sim = *flame.sim;
+    size_t nsp = gas.nSpecies();
+
+    // Unburned state, and adiabatic equilibrium state
+    vector_fp yin(nsp), yout(nsp);
+    for (size_t k = 0; k < nsp; k++) {
+        yin[k] = flame.inlet->massFraction(k);
+    }
+    double Tin = flame.inlet->temperature();
+    gas.setState_TPY(Tin, flow.pressure(), yin.data());
+    double rho_in = gas.density();
+    gas.equilibrate("HP");
+    gas.getMassFractions(yout.data());
+    double rho_out = gas.density();
+    double Tad = gas.temperature();
+
+    double mdot = flame.inlet->mdot();
+    if (mdot <= 0.0) {
+        mdot = 0.3 * rho_in;
+        flame.inlet->setMdot(mdot);
+        sim.getInitialSoln();
+    }
+
+    vector_fp locs {0.0, 0.3, 0.7, 1.0};
+    vector_fp value {mdot / rho_in, mdot / rho_in, mdot / rho_out,
+                     mdot / rho_out};
+    sim.setInitialGuess("u", locs, value);
+    value = {Tin, Tin, Tad, Tad};
+    sim.setInitialGuess("T", locs, value);
+    for (size_t k = 0; k < nsp; k++) {
+        value = {yin[k], yin[k], yout[k], yout[k]};
+        sim.setInitialGuess(gas.speciesName(k), locs, value);
+    }
+    sim.setFixedTemperature(0.5 * (Tin + Tad));
+}
+
+void FlameSweep::counterflowGuess(Flame& flame)
+{
+    IdealGasPhase& gas = *flame.gas;
+    StFlow& flow = *flame.flow;
+    Sim1D& sim = *flame.sim;
+    Inlet1D& fuel = *flame.inlet;
+    Bdry1D& oxidizer = *flame.right;
+    size_t dom = flow.domainIndex();
+
+    vector_fp yf(gas.nSpecies()), yo(gas.nSpecies());
+    for (size_t k = 0; k < gas.nSpecies(); k++) {
+        yf[k] = fuel.massFraction(k);
+        yo[k] = oxidizer.massFraction(k);
+    }
+    gas.setState_TPY(fuel.temperature(), flow.pressure(), yf.data());
+    double uf = fuel.mdot() / gas.density();
+    gas.setState_TPY(oxidizer.temperature(), flow.pressure(), yo.data());
+    double uo = - oxidizer.mdot() / gas.density();
+
+    vector_fp pos {0.0, 1.0};
+    sim.setProfile(dom, c_offset_U, pos, {uf, uo});
+    sim.setProfile(dom, c_offset_T, pos,
+                   {fuel.temperature(), oxidizer.temperature()});
+    for (size_t k = 0; k < gas.nSpecies(); k++) {
+        sim.setProfile(dom, c_offset_Y + k, pos, {yf[k], yo[k]});
+    }
+}
+
+void FlameSweep::save(const string& fname, const string& prefix) const
+{
+    time_t aclock;
+    ::time(&aclock);
+    struct tm* newtime = localtime(&aclock);
+
+    XML_Node root("ctml");
+    ifstream fin(fname);
+    if (fin) {
+        root.build(fin, fname);
+        fin.close();
+    }
+    for (size_t i = 0; i < m_results.size(); i++) {
+        const Result& r = m_results[i];
+        if (!r.converged) {
+            continue;
+        }
+        string id = prefix + std::to_string(i);
+        // Remove existing solution with the same id
+        XML_Node* same_ID = root.findID(id);
+        if (same_ID) {
+            same_ID->parent()->removeChild(same_ID);
+        }
+        XML_Node& sim = root.addChild(*r.xml);
+        sim.addAttribute("id", id);
+        addString(sim, "timestamp", asctime(newtime));
+        string desc = "parameters:";
+        for (double p : r.parameters) {
+            desc += fmt::format(" {}", p);
+        }
+        addString(sim, "description", desc);
+    }
+    ofstream s(fname);
+    if (!s) {
+        throw CanteraError("FlameSweep::save", "could not open file " + fname);
+    }
+    root.write(s);
+}
+
+}
@@ -4,7 +4,7 @@
 // at http://www.cantera.org/license.txt for license and copyright information.
 
 #include "cantera/oneD/MultiJac.h"
-#include <ctime>
+#include <chrono>
 
 using namespace std;
 
@@ -12,11 +12,18 @@ namespace Cantera
 {
 
 MultiJac::MultiJac(OneDim& r)
-    : BandMatrix(r.size(),r.bandwidth(),r.bandwidth())
 {
     m_size = r.size();
     m_points = r.points();
     m_resid = &r;
+    m_blockTridiag = (r.linearSolver() != "banded");
+    if (m_blockTridiag) {
+        // For the Jacobian-free Newton-Krylov solver, only the diagonal
+        // blocks are needed for the preconditioner
+        resizeBlocks(r.linearSolver() == "jfnk");
+    } else {
+        m_band.resize(m_size, r.bandwidth(), r.bandwidth());
+    }
     m_r1.resize(m_size);
     m_ssdiag.resize(m_size);
     m_mask.resize(m_size);
@@ -27,6 +34,24 @@ MultiJac::MultiJac(OneDim& r)
     m_rtol = 1.0e-5;
 }
 
+void MultiJac::resizeBlocks(bool diagonalOnly)
+{
+    std::vector<size_t> blockSizes(m_points);
+    for (size_t j = 0; j < m_points; j++) {
+        blockSizes[j] = m_resid->nVars(j);
+    }
+    m_blocks.resize(blockSizes, diagonalOnly);
+}
+
+void MultiJac::storeOffDiagonalBlocks()
+{
+    if (diagonalOnly()) {
+        resizeBlocks(false);
+        m_rowValid.clear();
+        m_age = 100000;
+    }
+}
+
 void MultiJac::updateTransient(doublereal rdt, integer* mask)
 {
     for (size_t n = 0; n < m_size; n++) {
@@ -43,12 +68,28 @@ void MultiJac::incrementDiagonal(int j, doublereal d)
 void MultiJac::eval(doublereal* x0, doublereal* resid0, doublereal rdt)
 {
     m_nevals++;
-    clock_t t0 = clock();
-    bfill(0.0);
+    auto t0 = std::chrono::steady_clock::now();
+    // If rows were copied from the Jacobian on the previous grid, only the
+    // remaining rows are evaluated
+    bool partial = !m_rowValid.empty();
+    if (!partial) {
+        if (m_blockTridiag) {
+            m_blocks.zero();
+        } else {
+            m_band.bfill(0.0);
+        }
+    }
     size_t ipt=0;
+    bool blockDiagonal = diagonalOnly();
 
     for (size_t j = 0; j < m_points; j++) {
         size_t nv = m_resid->nVars(j);
+        if (partial && m_rowValid[j] && (j == 0 || m_rowValid[j-1]) &&
+            (j + 1 == m_points || m_rowValid[j+1])) {
+            // no rows affected by the components at this point are needed
+            ipt += nv;
+            continue;
+        }
         for (size_t n = 0; n < nv; n++) {
             // perturb x(n); preserve sign(x(n))
             double xsave = x0[ipt];
@@ -67,7 +108,10 @@ void MultiJac::eval(doublereal* x0, doublereal* resid0, doublereal rdt)
 
             // compute nth column of Jacobian
             for (size_t i = j - 1; i != j+2; i++) {
-                if (i != npos && i < m_points) {
+                if (blockDiagonal && i != j) {
+                    continue;
+                }
+                if (i != npos && i < m_points && !(partial && m_rowValid[i])) {
                     size_t mv = m_resid->nVars(i);
                     size_t iloc = m_resid->loc(i);
                     for (size_t m = 0; m < mv; m++) {
@@ -80,12 +124,119 @@ void MultiJac::eval(doublereal* x0, doublereal* resid0, doublereal rdt)
         }
     }
 
-    for (size_t n = 0; n < m_size; n++) {
-        m_ssdiag[n] = value(n,n);
+    for (size_t j = 0; j < m_points; j++) {
+        if (partial && m_rowValid[j]) {
+            continue;
+        }
+        size_t iloc = m_resid->loc(j);
+        for (size_t n = iloc; n < iloc + m_resid->nVars(j); n++) {
+            m_ssdiag[n] = value(n,n);
+        }
+    }
+    m_rowValid.clear();
+
+    if (diagonalOnly()) {
+        // The diagonal blocks are singular if a variable only appears in
+        // the equations of the neighboring points, such as the pressure
+        // eigenvalue at the first point of a counterflow flame. The full
+        // block-tridiagonal Jacobian is then used as the preconditioner.
+        try {
+            m_blocks.factor();
+        } catch (CanteraError&) {
+            storeOffDiagonalBlocks();
+            m_nevals--;
+            eval(x0, resid0, rdt);
+            return;
+        }
     }
 
-    m_elapsed += double(clock() - t0)/CLOCKS_PER_SEC;
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    m_elapsed += dt.count();
+    if (m_resid->profiler().enabled()) {
+        m_resid->profiler().add(Profile1D::Jacobian, dt.count());
+    }
     m_age = 0;
 }
 
+size_t MultiJac::transfer(const MultiJac& old, const vector<size_t>& oldPoint,
+                          const vector<size_t>& oldLoc)
+{
+    m_rowValid.assign(m_points, false);
+    size_t nValid = 0;
+    for (size_t j = 0; j < m_points; j++) {
+        // The residual at point j depends on the solution at points j-1, j,
+        // and j+1, which must be the same points as before refinement
+        size_t q = oldPoint[j];
+        if (q == npos || (j == 0) != (q == 0) ||
+            (j + 1 == m_points) != (q + 1 == old.m_points)) {
+            continue;
+        }
+        if ((j > 0 && oldPoint[j-1] != q - 1) ||
+            (j + 1 < m_points && oldPoint[j+1] != q + 1)) {
+            continue;
+        }
+        size_t nv = m_resid->nVars(j);
+        size_t iloc = m_resid->loc(j);
+        size_t iold = oldLoc[q];
+        for (size_t k = j - 1; k != j + 2; k++) {
+            if (k == npos || k >= m_points) {
+                continue;
+            }
+            size_t kloc = m_resid->loc(k);
+            size_t kold = oldLoc[oldPoint[k]];
+            for (size_t n = 0; n < m_resid->nVars(k); n++) {
+                for (size_t m = 0; m < nv; m++) {
+                    value(iloc + m, kloc + n) = old.value(iold + m, kold + n);
+                }
+            }
+        }
+        for (size_t m = 0; m < nv; m++) {
+            m_ssdiag[iloc + m] = old.m_ssdiag[iold + m];
+            value(iloc + m, iloc + m) = m_ssdiag[iloc + m];
+        }
+        m_rowValid[j] = true;
+        nValid++;
+    }
+    if (nValid == 0) {
+        m_rowValid.clear();
+    }
+    return nValid;
+}
+
+void MultiJac::mult(const doublereal* b, doublereal* prod) const
+{
+    if (m_blockTridiag) {
+        m_blocks.mult(b, prod);
+    } else {
+        m_band.mult(b, prod);
+    }
+}
+
+int MultiJac::solve(const doublereal* const b, doublereal* const x)
+{
+    Profile1D& profiler = m_resid->profiler();
+    if (m_blockTridiag) {
+        if (!m_blocks.factored()) {
+            Profile1D::Timer timer(profiler, Profile1D::Factor);
+            m_blocks.factor();
+        }
+        Profile1D::Timer timer(profiler, Profile1D::Solve);
+        return m_blocks.solve(b, x);
+    }
+    if (!m_band.factored()) {
+        Profile1D::Timer timer(profiler, Profile1D::Factor);
+        m_band.factor();
+    }
+    Profile1D::Timer timer(profiler, Profile1D::Solve);
+    return m_band.solve(b, x);
+}
+
+int MultiJac::info() const
+{
+    if (m_blockTridiag) {
+        return m_blocks.info();
+    }
+    return m_band.info();
+}
+
 } // namespace
@@ -6,7 +6,7 @@
 #include "cantera/oneD/MultiNewton.h"
 #include "cantera/base/utilities.h"
 
-#include <ctime>
+#include <chrono>
 
 using namespace std;
 
@@ -122,17 +122,31 @@ doublereal norm_square(const doublereal* x,
     return sum;
 }
 
+//! Euclidean norm of the vector *x* of length *n*
+double euclidNorm(const double* x, size_t n)
+{
+    return sqrt(std::inner_product(x, x + n, x, 0.0));
+}
+
 } // end unnamed-namespace
 
 
 // constants
 const doublereal DampFactor = sqrt(2.0);
 const size_t NDAMP = 7;
+const double SqrtEps = sqrt(std::numeric_limits<double>::epsilon());
 
 // ---------------- MultiNewton methods ----------------
 
 MultiNewton::MultiNewton(int sz)
-    : m_maxAge(5)
+    : m_jacobianFree(false)
+    , m_krylovTol(1e-4)
+    , m_maxKrylovIter(200)
+    , m_krylovRestart(30)
+    , m_nKrylovIter(0)
+    , m_nKrylovFail(0)
+    , m_krylovSlow(false)
+    , m_maxAge(5)
 {
     m_n = sz;
     m_elapsed = 0.0;
@@ -146,6 +160,18 @@ void MultiNewton::resize(size_t sz)
     m_stp1.resize(m_n);
 }
 
+void MultiNewton::setKrylovOptions(double rtol, size_t maxIter, size_t restart)
+{
+    if (rtol <= 0.0 || maxIter == 0 || restart == 0) {
+        throw CanteraError("MultiNewton::setKrylovOptions",
+            "Invalid options: rtol = {}, maxIter = {}, restart = {}",
+            rtol, maxIter, restart);
+    }
+    m_krylovTol = rtol;
+    m_maxKrylovIter = maxIter;
+    m_krylovRestart = restart;
+}
+
 doublereal MultiNewton::norm2(const doublereal* x,
                               const doublereal* step, OneDim& r) const
 {
@@ -167,8 +193,17 @@ void MultiNewton::step(doublereal* x, doublereal* step,
         step[n] = -step[n];
     }
 
+    if (m_jacobianFree) {
+        krylovSolve(x, step, r, jac, loglevel);
+    } else {
+        solveJacobian(step, r, jac);
+    }
+}
+
+void MultiNewton::solveJacobian(doublereal* b, OneDim& r, MultiJac& jac)
+{
     try {
-        jac.solve(step, step);
+        jac.solve(b, b);
     } catch (CanteraError&) {
         int iok = jac.info() - 1;
         if (iok >= 0) {
@@ -193,6 +228,197 @@ void MultiNewton::step(doublereal* x, doublereal* step,
     }
 }
 
+void MultiNewton::jacobianProduct(const doublereal* x, const doublereal* v,
+                                  doublereal* Jv, OneDim& r)
+{
+    // The perturbation of each component of x is at most the one used by
+    // MultiJac to compute the columns of the Jacobian. Scaling the
+    // perturbation by the norm of v instead gives perturbations below the
+    // round-off error of most components when v is poorly scaled.
+    double vmax = 0.0;
+    for (size_t i = 0; i < m_n; i++) {
+        vmax = std::max(vmax, fabs(v[i]) / (1e-5 * fabs(x[i]) + SqrtEps));
+    }
+    if (vmax == 0.0) {
+        std::fill(Jv, Jv + m_n, 0.0);
+        return;
+    }
+    double eps = 1.0 / vmax;
+    for (size_t i = 0; i < m_n; i++) {
+        m_xp[i] = x[i] + eps*v[i];
+    }
+    r.eval(npos, m_xp.data(), m_fp.data());
+    for (size_t i = 0; i < m_n; i++) {
+        Jv[i] = (m_fp[i] - m_fx[i]) / eps;
+    }
+}
+
+void MultiNewton::preconditionedProduct(const doublereal* x,
+    const doublereal* v, doublereal* w, OneDim& r, MultiJac& jac)
+{
+    for (size_t i = 0; i < m_n; i++) {
+        m_z[i] = m_ewt[i] * v[i];
+    }
+    jacobianProduct(x, m_z.data(), w, r);
+    solveJacobian(w, r, jac);
+    for (size_t i = 0; i < m_n; i++) {
+        w[i] /= m_ewt[i];
+    }
+}
+
+void MultiNewton::krylovSolve(const doublereal* x, doublereal* b, OneDim& r,
+                              MultiJac& jac, int loglevel)
+{
+    size_t n = m_n;
+    size_t m = std::min(m_krylovRestart, m_maxKrylovIter);
+    size_t ldh = m + 1; // leading dimension of the Hessenberg matrix
+    m_fx.resize(n);
+    m_xp.resize(n);
+    m_fp.resize(n);
+    m_z.resize(n);
+    m_w.resize(n);
+    m_rhs.resize(n);
+    m_ewt.resize(n);
+    m_s.assign(n, 0.0);
+    m_krylovSlow = false;
+    m_krylov.resize(n * (m + 1));
+    m_hess.resize(ldh * m);
+    m_cs.resize(m);
+    m_sn.resize(m);
+    m_g.resize(m + 1);
+
+    // On input, b is the negative of the residual at x
+    for (size_t i = 0; i < n; i++) {
+        m_fx[i] = -b[i];
+    }
+
+    // Error weights of the solution components, as used by norm2()
+    for (size_t d = 0; d < r.nDomains(); d++) {
+        Domain1D& dom = r.domain(d);
+        size_t nv = dom.nComponents();
+        size_t np = dom.nPoints();
+        const double* xd = x + dom.loc();
+        double* ewt = m_ewt.data() + dom.loc();
+        for (size_t k = 0; k < nv; k++) {
+            double esum = 0.0;
+            for (size_t j = 0; j < np; j++) {
+                esum += fabs(xd[nv*j + k]);
+            }
+            for (size_t j = 0; j < np; j++) {
+                ewt[nv*j + k] = dom.rtol(k)*esum/np + dom.atol(k);
+            }
+        }
+    }
+
+    // The right hand side of the scaled, preconditioned system is the Newton
+    // step computed with the preconditioner
+    solveJacobian(b, r, jac);
+    for (size_t i = 0; i < n; i++) {
+        m_rhs[i] = b[i] / m_ewt[i];
+    }
+    double bnorm = euclidNorm(m_rhs.data(), n);
+    if (bnorm == 0.0) {
+        return;
+    }
+    double tol = m_krylovTol * bnorm;
+    double* V = m_krylov.data();
+
+    // The initial guess for the step is zero, so the initial linear residual
+    // is the right hand side
+    std::copy(m_rhs.begin(), m_rhs.end(), V);
+    double beta = bnorm;
+    size_t iter = 0;
+    bool converged = false;
+    while (true) {
+        scale(V, V + n, V, 1.0 / beta);
+        std::fill(m_g.begin(), m_g.end(), 0.0);
+        m_g[0] = beta;
+
+        // Arnoldi iteration, using the modified Gram-Schmidt process
+        size_t k = 0;
+        while (k < m && iter < m_maxKrylovIter) {
+            double* vk = V + k*n;
+            double* vnext = V + (k+1)*n;
+            double* h = &m_hess[k*ldh];
+            preconditionedProduct(x, vk, vnext, r, jac);
+            for (size_t i = 0; i <= k; i++) {
+                double* vi = V + i*n;
+                h[i] = std::inner_product(vi, vi + n, vnext, 0.0);
+                for (size_t j = 0; j < n; j++) {
+                    vnext[j] -= h[i] * vi[j];
+                }
+            }
+            h[k+1] = euclidNorm(vnext, n);
+            if (h[k+1] != 0.0) {
+                scale(vnext, vnext + n, vnext, 1.0 / h[k+1]);
+            }
+
+            // Apply the previous Givens rotations to the new column, and
+            // compute the rotation which eliminates h[k+1]
+            for (size_t i = 0; i < k; i++) {
+                double t = m_cs[i]*h[i] + m_sn[i]*h[i+1];
+                h[i+1] = -m_sn[i]*h[i] + m_cs[i]*h[i+1];
+                h[i] = t;
+            }
+            double d = hypot(h[k], h[k+1]);
+            m_cs[k] = (d != 0.0) ? h[k] / d : 1.0;
+            m_sn[k] = (d != 0.0) ? h[k+1] / d : 0.0;
+            h[k] = d;
+            h[k+1] = 0.0;
+            m_g[k+1] = -m_sn[k] * m_g[k];
+            m_g[k] *= m_cs[k];
+            k++;
+            iter++;
+            if (fabs(m_g[k]) <= tol) {
+                converged = true;
+                break;
+            }
+        }
+
+        // Solve the triangular least-squares system for the coefficients of
+        // the basis vectors (stored in m_g), and update the scaled step
+        for (size_t i = k; i-- > 0;) {
+            double y = m_g[i];
+            for (size_t j = i + 1; j < k; j++) {
+                y -= m_hess[j*ldh + i] * m_g[j];
+            }
+            m_g[i] = (m_hess[i*ldh + i] != 0.0) ? y / m_hess[i*ldh + i] : 0.0;
+        }
+        for (size_t i = 0; i < k; i++) {
+            double* vi = V + i*n;
+            for (size_t j = 0; j < n; j++) {
+                m_s[j] += m_g[i] * vi[j];
+            }
+        }
+        if (converged || iter >= m_maxKrylovIter) {
+            break;
+        }
+
+        // Restart, using the linear residual of the current step
+        preconditionedProduct(x, m_s.data(), m_w.data(), r, jac);
+        for (size_t j = 0; j < n; j++) {
+            V[j] = m_rhs[j] - m_w[j];
+        }
+        beta = euclidNorm(V, n);
+        if (beta <= tol) {
+            converged = true;
+            break;
+        }
+    }
+
+    m_nKrylovIter += iter;
+    m_krylovSlow = (iter > m);
+    if (!converged) {
+        m_nKrylovFail++;
+        if (loglevel > 0) {
+            writelog("\nGMRES did not converge in {} iterations.\n", iter);
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        b[i] = m_ewt[i] * m_s[i];
+    }
+}
+
 doublereal MultiNewton::boundStep(const doublereal* x0,
                                   const doublereal* step0, const OneDim& r, int loglevel)
 {
@@ -289,7 +515,7 @@ int MultiNewton::dampStep(const doublereal* x0, const doublereal* step0,
 int MultiNewton::solve(doublereal* x0, doublereal* x1,
                        OneDim& r, MultiJac& jac, int loglevel)
 {
-    clock_t t0 = clock();
+    auto t0 = std::chrono::steady_clock::now();
     int m = 0;
     bool forceNewJac = false;
     doublereal s1=1.e30;
@@ -300,6 +526,7 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
     doublereal rdt = r.rdt();
     int j0 = jac.nEvals();
     int nJacReeval = 0;
+    size_t nKrylovFail = m_nKrylovFail;
 
     while (true) {
         // Check whether the Jacobian should be re-evaluated.
@@ -319,6 +546,17 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
 
         // compute the undamped Newton step
         step(&m_x[0], &m_stp[0], r, jac, loglevel-1);
+        if (m_jacobianFree && m_krylovSlow && jac.age() > 0) {
+            // An old preconditioner makes GMRES slow instead of making the
+            // Newton iteration fail, so it is replaced as soon as GMRES
+            // needs to be restarted. The step is recomputed if GMRES did
+            // not converge.
+            forceNewJac = true;
+            if (m_nKrylovFail > nKrylovFail) {
+                nKrylovFail = m_nKrylovFail;
+                continue;
+            }
+        }
 
         // increment the Jacobian age
         jac.incrementAge();
@@ -372,7 +610,8 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
     if (m > 0 && jac.nEvals() == j0) {
         m = 100;
     }
-    m_elapsed += (clock() - t0)/(1.0*CLOCKS_PER_SEC);
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    m_elapsed += dt.count();
     return m;
 }
 
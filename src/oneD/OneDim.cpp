@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include <ctime>
+#include <chrono>
 
 using namespace std;
 
@@ -19,11 +20,13 @@ namespace Cantera
 OneDim::OneDim()
     : m_tmin(1.0e-16), m_tmax(1e8), m_tfactor(0.5),
       m_rdt(0.0), m_jac_ok(false),
-      m_bw(0), m_size(0),
+      m_bw(0), m_size(0), m_linearSolver("banded"),
       m_init(false), m_pts(0), m_solve_time(0.0),
       m_ss_jac_age(20), m_ts_jac_age(20),
       m_interrupt(0), m_time_step_callback(0),
       m_nsteps(0), m_nsteps_max(500),
+      m_transientMethod("backward-euler"), m_transientErrorTol(1000.0),
+      m_hn(0.0), m_hnm1(0.0), m_nhist(0),
       m_nevals(0), m_evaltime(0.0)
 {
     m_newt.reset(new MultiNewton(1));
@@ -32,11 +35,13 @@ OneDim::OneDim()
 OneDim::OneDim(vector<Domain1D*> domains) :
     m_tmin(1.0e-16), m_tmax(1e8), m_tfactor(0.5),
     m_rdt(0.0), m_jac_ok(false),
-    m_bw(0), m_size(0),
+    m_bw(0), m_size(0), m_linearSolver("banded"),
     m_init(false), m_solve_time(0.0),
     m_ss_jac_age(20), m_ts_jac_age(20),
     m_interrupt(0), m_time_step_callback(0),
     m_nsteps(0), m_nsteps_max(500),
+    m_transientMethod("backward-euler"), m_transientErrorTol(1000.0),
+    m_hn(0.0), m_hnm1(0.0), m_nhist(0),
     m_nevals(0), m_evaltime(0.0)
 {
     // create a Newton iterator, and add each domain.
@@ -95,6 +100,7 @@ void OneDim::addDomain(Domain1D* d)
     // add it also to the global domain list, and set its container and position
     m_dom.push_back(d);
     d->setContainer(this, m_dom.size()-1);
+    d->profiler().enable(m_profiler.enabled());
     resize();
 }
 
@@ -117,6 +123,35 @@ void OneDim::setJacAge(int ss_age, int ts_age)
     }
 }
 
+void OneDim::setLinearSolver(const std::string& type)
+{
+    if (type != "banded" && type != "block-tridiagonal" && type != "jfnk") {
+        throw CanteraError("OneDim::setLinearSolver",
+                           "Unknown linear solver type '{}'", type);
+    }
+    m_linearSolver = type;
+    m_newt->setJacobianFree(type == "jfnk");
+    if (m_jac) {
+        // replace the Jacobian evaluator with one using the new storage
+        saveStats();
+        m_jac.reset(new MultiJac(*this));
+        m_jac_ok = false;
+        for (size_t i = 0; i < nDomains(); i++) {
+            m_dom[i]->setJac(m_jac.get());
+        }
+    }
+}
+
+void OneDim::setTransientMethod(const std::string& method)
+{
+    if (method != "backward-euler" && method != "bdf2") {
+        throw CanteraError("OneDim::setTransientMethod",
+                           "Unknown time integration method '{}'", method);
+    }
+    m_transientMethod = method;
+    m_nhist = 0;
+}
+
 void OneDim::writeStats(int printTime)
 {
     saveStats();
@@ -148,6 +183,16 @@ void OneDim::saveStats()
             m_evaltime = 0.0;
             m_timeSteps.push_back(m_nsteps);
             m_nsteps = 0;
+
+            GridProfile1D grid;
+            grid.points = m_pts;
+            grid.solver = m_profiler;
+            m_profiler.clear();
+            for (auto dom : m_dom) {
+                grid.domains.push_back(dom->profiler());
+                dom->profiler().clear();
+            }
+            m_profileStats.push_back(grid);
         }
     }
 }
@@ -163,13 +208,78 @@ void OneDim::clearStats()
     m_nevals = 0;
     m_evaltime = 0.0;
     m_nsteps = 0;
+    m_profileStats.clear();
+    m_profiler.clear();
+    for (auto dom : m_dom) {
+        dom->profiler().clear();
+    }
+}
+
+void OneDim::enableProfiling(bool enable)
+{
+    m_profiler.enable(enable);
+    for (auto dom : m_dom) {
+        dom->profiler().enable(enable);
+    }
+}
+
+string OneDim::profileJSON()
+{
+    saveStats();
+    // Totals over all grids, including times which are not saved because
+    // no Jacobian has been evaluated on the current grid
+    GridProfile1D total;
+    total.points = m_pts;
+    total.solver = m_profiler;
+    for (auto dom : m_dom) {
+        total.domains.push_back(dom->profiler());
+    }
+    auto gridJSON = [this](const GridProfile1D& grid, const string& indent) {
+        string s = fmt::format("{}  \"solver\": {},\n", indent,
+                               grid.solver.toJSON());
+        s += fmt::format("{}  \"domains\": [", indent);
+        for (size_t n = 0; n < grid.domains.size(); n++) {
+            s += fmt::format("{}\n{}    {{\"id\": \"{}\", \"tasks\": {}}}",
+                             (n == 0) ? "" : ",", indent, m_dom[n]->id(),
+                             grid.domains[n].toJSON());
+        }
+        return s + fmt::format("\n{}  ]", indent);
+    };
+
+    string s = "{\n  \"grids\": [";
+    for (size_t i = 0; i < m_profileStats.size(); i++) {
+        const GridProfile1D& grid = m_profileStats[i];
+        s += fmt::format("{}\n    {{\n      \"points\": {},\n"
+            "      \"timesteps\": {},\n      \"residual-evaluations\": {},\n"
+            "      \"jacobian-evaluations\": {},\n",
+            (i == 0) ? "" : ",", grid.points, m_timeSteps[i], m_funcEvals[i],
+            m_jacEvals[i]);
+        s += gridJSON(grid, "    ") + "\n    }";
+        total.solver += grid.solver;
+        for (size_t n = 0; n < m_dom.size(); n++) {
+            total.domains[n] += grid.domains[n];
+        }
+    }
+    s += "\n  ],\n  \"total\": {\n";
+    return s + gridJSON(total, "  ") + "\n  }\n}\n";
+}
+
+void OneDim::writeProfile(const string& filename)
+{
+    ofstream out(filename);
+    if (!out) {
+        throw CanteraError("OneDim::writeProfile",
+                           "Could not open file '{}' for writing", filename);
+    }
+    out << profileJSON();
 }
 
 void OneDim::resize()
 {
     m_bw = 0;
+    vector<size_t> oldLoc;
+    oldLoc.swap(m_loc);
     m_nvars.clear();
-    m_loc.clear();
     size_t lc = 0;
 
     // save the statistics for the last grid
@@ -211,9 +321,22 @@ void OneDim::resize()
 
     m_newt->resize(size());
     m_mask.resize(size());
-
-    // delete the current Jacobian evaluator and create a new one
-    m_jac.reset(new MultiJac(*this));
+    m_nhist = 0;
+
+    // replace the current Jacobian evaluator with a new one, keeping the
+    // parts of the current Jacobian which are unaffected by grid refinement
+    // if it is recent enough to be used by the steady-state solver
+    unique_ptr<MultiJac> jac(new MultiJac(*this));
+    if (m_jac && m_linearSolver == "jfnk" && !m_jac->diagonalOnly()) {
+        // the diagonal blocks were found to be singular on the previous grid
+        jac->storeOffDiagonalBlocks();
+    }
+    if (m_oldPoints.size() == m_pts && m_jac && m_jac->nEvals() > 0 &&
+        m_jac->age() <= m_ss_jac_age) {
+        jac->transfer(*m_jac, m_oldPoints, oldLoc);
+    }
+    m_oldPoints.clear();
+    m_jac = std::move(jac);
     m_jac_ok = false;
 
     for (size_t i = 0; i < nDomains(); i++) {
@@ -257,7 +380,7 @@ Domain1D* OneDim::pointDomain(size_t i)
 
 void OneDim::eval(size_t j, double* x, double* r, doublereal rdt, int count)
 {
-    clock_t t0 = clock();
+    auto t0 = std::chrono::steady_clock::now();
     if (m_interrupt) {
         m_interrupt->eval(m_nevals);
     }
@@ -271,18 +394,24 @@ void OneDim::eval(size_t j, double* x, double* r, doublereal rdt, int count)
 
     // iterate over the bulk domains first
     for (const auto& d : m_bulk) {
+        Profile1D::Timer timer(d->profiler(), Profile1D::Residual);
         d->eval(j, x, r, m_mask.data(), rdt);
     }
 
     // then over the connector domains
     for (const auto& d : m_connect) {
+        Profile1D::Timer timer(d->profiler(), Profile1D::Residual);
         d->eval(j, x, r, m_mask.data(), rdt);
     }
 
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    if (j == npos && m_profiler.enabled()) {
+        m_profiler.add(Profile1D::Residual, dt.count());
+    }
+
     // increment counter and time
     if (count) {
-        clock_t t1 = clock();
-        m_evaltime += double(t1 - t0)/CLOCKS_PER_SEC;
+        m_evaltime += dt.count();
         m_nevals++;
     }
 }
@@ -354,8 +483,17 @@ doublereal OneDim::timeStep(int nsteps, doublereal dt, doublereal* x,
     debuglog("\n\n step    size (s)    log10(ss) \n", loglevel);
     debuglog("===============================\n", loglevel);
 
+    bool bdf2 = (m_transientMethod == "bdf2");
+    if (bdf2 && (m_xn.size() != m_size || !std::equal(x, x + m_size,
+                                                      m_xn.begin()))) {
+        // The solution was changed since the last time step, so the solution
+        // history can't be used
+        m_nhist = 0;
+    }
+
     int n = 0;
     int successiveFailures = 0;
+    bool failed = false;
 
     while (n < nsteps) {
         if (loglevel > 0) {
@@ -364,20 +502,79 @@ doublereal OneDim::timeStep(int nsteps, doublereal dt, doublereal* x,
         }
 
         // set up for time stepping with stepsize dt
-        initTimeInteg(dt,x);
+        if (bdf2 && m_nhist > 0) {
+            // The variable-step BDF2 formula is written as a backward Euler
+            // step from an extrapolated solution with a reduced step size
+            double w = dt / m_hn;
+            double c = (1 + 2*w) / (1 + w);
+            m_xhat.resize(m_size);
+            for (size_t i = 0; i < m_size; i++) {
+                m_xhat[i] = ((1 + w) * x[i] - w * w / (1 + w) * m_xnm1[i]) / c;
+            }
+            initTimeInteg(dt / c, m_xhat.data());
+        } else {
+            initTimeInteg(dt,x);
+        }
 
         // solve the transient problem
-        int m = solve(x, r, loglevel-1);
+        int m;
+        if (bdf2 && m_nhist > 0) {
+            // Start the Newton iterations from the extrapolation of the
+            // previous solutions, limited to the bounds of each component
+            bdf2Predict(dt, x, m_xpred);
+            for (size_t i = 0; i < m_size; i++) {
+                m_xpred[i] -= x[i];
+            }
+            double f = m_newt->boundStep(x, m_xpred.data(), *this, 0);
+            for (size_t i = 0; i < m_size; i++) {
+                m_xpred[i] = x[i] + f * m_xpred[i];
+            }
+            m = solve(m_xpred.data(), r, loglevel-1);
+        } else {
+            m = solve(x, r, loglevel-1);
+        }
+
+        // estimate the local error of a BDF2 step, and reject the step if it
+        // is too large
+        double err = -1.0;
+        if (m >= 0 && bdf2 && m_nhist > 1) {
+            err = bdf2Error(dt, x, r);
+            if (err > 1.0) {
+                debuglog(fmt::format("...local error too large ({:.3g})\n",
+                                     err), loglevel);
+                dt *= std::max(0.2, 0.9 * pow(err, -1.0/3.0));
+                failed = true;
+                if (dt < m_tmin) {
+                    throw CanteraError("OneDim::timeStep",
+                                       "Time integration failed.");
+                }
+                continue;
+            }
+        }
 
         // successful time step. Copy the new solution in r to
         // the current solution in x.
         if (m >= 0) {
             successiveFailures = 0;
+            failed = false;
             m_nsteps++;
             n += 1;
             debuglog("\n", loglevel);
+            if (bdf2) {
+                // update the solution history
+                m_xnm2.swap(m_xnm1);
+                m_xnm1.assign(x, x + m_size);
+                m_hnm1 = m_hn;
+                m_hn = dt;
+                m_nhist = std::min<size_t>(m_nhist + 1, 2);
+            }
             copy(r, r + m_size, x);
-            if (m == 100) {
+            if (err >= 0.0) {
+                // step size based on the local error estimate, which is not
+                // increased directly after a failed step
+                dt *= std::min(failed ? 1.0 : 2.0,
+                               0.9 * pow(std::max(err, 1e-3), -1.0/3.0));
+            } else if (m == 100) {
                 dt *= 1.5;
             }
             if (m_time_step_callback) {
@@ -394,6 +591,11 @@ doublereal OneDim::timeStep(int nsteps, doublereal dt, doublereal* x,
             // No solution could be found with this time step.
             // Decrease the stepsize and try again.
             debuglog("...failure.\n", loglevel);
+            failed = true;
+            // A failed Newton iteration indicates that the solution is not
+            // changing smoothly, so the history is not used for extrapolation
+            // and the next step is a backward Euler step
+            m_nhist = 0;
             if (successiveFailures > 2) {
                 //debuglog("Resetting negative species concentrations.\n", loglevel);
                 resetBadValues(x);
@@ -408,11 +610,58 @@ doublereal OneDim::timeStep(int nsteps, doublereal dt, doublereal* x,
         }
     }
 
+    if (bdf2) {
+        m_xn.assign(x, x + m_size);
+    }
+
     // return the value of the last stepsize, which may be smaller
     // than the initial stepsize
     return dt;
 }
 
+double OneDim::bdf2Error(double dt, const double* x, const double* xnew)
+{
+    // The local error of the BDF2 step is proportional to the difference
+    // between the solution and the prediction
+    bdf2Predict(dt, x, m_xpred);
+    double H1 = dt + m_hn;
+    double H2 = H1 + m_hnm1;
+    double K = dt * H1 / (dt * H1 + H2 * (2 * dt + m_hn));
+    m_xhat.resize(m_size);
+    for (size_t i = 0; i < m_size; i++) {
+        if (m_mask[i]) {
+            m_xhat[i] = K * (xnew[i] - m_xpred[i]);
+        } else {
+            m_xhat[i] = 0.0;
+        }
+    }
+    return m_newt->norm2(xnew, m_xhat.data(), *this) / m_transientErrorTol;
+}
+
+void OneDim::bdf2Predict(double dt, const double* x, vector_fp& xpred)
+{
+    xpred.resize(m_size);
+    if (m_nhist == 1) {
+        // linear extrapolation
+        double w = dt / m_hn;
+        for (size_t i = 0; i < m_size; i++) {
+            xpred[i] = (1 + w) * x[i] - w * m_xnm1[i];
+        }
+        return;
+    }
+
+    // Quadratic extrapolation through the last three solutions, at times
+    // relative to the current time
+    double t1 = -m_hn;
+    double t2 = -m_hn - m_hnm1;
+    double c0 = (dt - t1) * (dt - t2) / (t1 * t2);
+    double c1 = dt * (dt - t2) / (t1 * (t1 - t2));
+    double c2 = dt * (dt - t1) / (t2 * (t2 - t1));
+    for (size_t i = 0; i < m_size; i++) {
+        xpred[i] = c0 * x[i] + c1 * m_xnm1[i] + c2 * m_xnm2[i];
+    }
+}
+
 void OneDim::resetBadValues(double* x)
 {
     for (auto dom : m_dom) {
@@ -0,0 +1,85 @@
+//! @file Profile1D.cpp
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/oneD/Profile1D.h"
+#include "cantera/base/ctexceptions.h"
+#include "cantera/base/fmt.h"
+
+using namespace std;
+
+namespace Cantera
+{
+
+Profile1D::Profile1D()
+    : m_enabled(false)
+{
+    clear();
+}
+
+string Profile1D::taskName(Task task)
+{
+    switch (task) {
+    case ThermoUpdate:
+        return "thermo";
+    case TransportUpdate:
+        return "transport";
+    case DiffusiveFluxes:
+        return "fluxes";
+    case Kinetics:
+        return "kinetics";
+    case Residual:
+        return "residual";
+    case Jacobian:
+        return "jacobian";
+    case Factor:
+        return "factor";
+    case Solve:
+        return "solve";
+    default:
+        throw CanteraError("Profile1D::taskName", "Unknown task {}", task);
+    }
+}
+
+void Profile1D::clear()
+{
+    for (size_t n = 0; n < nTasks; n++) {
+        m_elapsed[n] = 0.0;
+        m_calls[n] = 0;
+        m_points[n] = 0;
+    }
+}
+
+Profile1D& Profile1D::operator+=(const Profile1D& other)
+{
+    for (size_t n = 0; n < nTasks; n++) {
+        m_elapsed[n] += other.m_elapsed[n];
+        m_calls[n] += other.m_calls[n];
+        m_points[n] += other.m_points[n];
+    }
+    return *this;
+}
+
+string Profile1D::toJSON() const
+{
+    string s = "{";
+    for (size_t n = 0; n < nTasks; n++) {
+        if (m_calls[n] == 0) {
+            continue;
+        }
+        if (s.size() > 1) {
+            s += ", ";
+        }
+        s += fmt::format("\"{}\": {{\"calls\": {}, \"seconds\": {:.6e}",
+                         taskName(static_cast<Task>(n)), m_calls[n],
+                         m_elapsed[n]);
+        if (m_points[n]) {
+            s += fmt::format(", \"points\": {}", m_points[n]);
+        }
+        s += "}";
+    }
+    return s + "}";
+}
+
+}
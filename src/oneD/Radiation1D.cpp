@@ -0,0 +1,77 @@
+//! @file Radiation1D.cpp
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/oneD/Radiation1D.h"
+#include "cantera/thermo/ThermoPhase.h"
+
+namespace Cantera
+{
+
+namespace
+{
+//! Polynomial coefficients of the Planck mean absorption coefficients of H2O
+//! and CO2 [1/m/atm] in powers of 1000/T
+const double c_H2O[6] = {-0.23093, -1.12390, 9.41530, -2.99880, 0.51382,
+                         -1.86840e-5};
+const double c_CO2[6] = {18.741, -121.310, 273.500, -194.050, 56.310,
+                         -5.8169};
+}
+
+OpticallyThinRadiation::OpticallyThinRadiation()
+    : m_kCO2(npos)
+    , m_kH2O(npos)
+    , m_wtCO2(0.0)
+    , m_wtH2O(0.0)
+{
+}
+
+void OpticallyThinRadiation::setThermo(const ThermoPhase& thermo)
+{
+    m_kCO2 = thermo.speciesIndex("CO2");
+    m_kH2O = thermo.speciesIndex("H2O");
+    if (m_kCO2 != npos) {
+        m_wtCO2 = thermo.molecularWeight(m_kCO2);
+    }
+    if (m_kH2O != npos) {
+        m_wtH2O = thermo.molecularWeight(m_kH2O);
+    }
+}
+
+void OpticallyThinRadiation::getHeatLoss(size_t nPoints, const double* T,
+    const double* Y, size_t ldY, const double* wtm, double pressure,
+    double epsLeft, double epsRight, size_t j0, size_t j1, double* qdot)
+{
+    double TL2 = T[0] * T[0];
+    double TR2 = T[nPoints-1] * T[nPoints-1];
+    double boundaryRad = StefanBoltz * (epsLeft * TL2 * TL2 +
+                                        epsRight * TR2 * TR2);
+    // partial pressures are in atm, and the polynomials give the absorption
+    // coefficients at 1 atm
+    double P_atm = pressure / OneAtm;
+    bool doH2O = (m_kH2O != npos);
+    bool doCO2 = (m_kCO2 != npos);
+    for (size_t j = j0; j < j1; j++) {
+        double tau = 1000.0 / T[j];
+        double k_P = 0.0;
+        if (doH2O) {
+            double k_H2O = c_H2O[5];
+            for (int n = 4; n >= 0; n--) {
+                k_H2O = k_H2O * tau + c_H2O[n];
+            }
+            k_P += P_atm * wtm[j] * Y[j*ldY + m_kH2O] / m_wtH2O * k_H2O;
+        }
+        if (doCO2) {
+            double k_CO2 = c_CO2[5];
+            for (int n = 4; n >= 0; n--) {
+                k_CO2 = k_CO2 * tau + c_CO2[n];
+            }
+            k_P += P_atm * wtm[j] * Y[j*ldY + m_kCO2] / m_wtCO2 * k_CO2;
+        }
+        double T2 = T[j] * T[j];
+        qdot[j] = 2.0 * k_P * (2.0 * StefanBoltz * T2 * T2 - boundaryRad);
+    }
+}
+
+}
@@ -18,9 +18,54 @@ using namespace std;
 namespace Cantera
 {
 
+namespace
+{
+//! Derivative at point *k* of the monotone piecewise cubic Hermite
+//! interpolant (Fritsch & Carlson) through the *n* points (z, f), where the
+//! function values are stored with the given stride.
+double pchipSlope(const double* z, const double* f, size_t stride, size_t n,
+                  size_t k)
+{
+    auto delta = [&](size_t i) {
+        return (f[(i+1)*stride] - f[i*stride]) / (z[i+1] - z[i]);
+    };
+    if (n == 2) {
+        return delta(0);
+    }
+    if (k == 0 || k == n - 1) {
+        // shape-preserving three-point formula at the ends
+        size_t i0 = (k == 0) ? 0 : n - 2;
+        size_t i1 = (k == 0) ? 1 : n - 3;
+        double h0 = z[i0+1] - z[i0];
+        double h1 = z[i1+1] - z[i1];
+        double d0 = delta(i0);
+        double d1 = delta(i1);
+        double s = ((2*h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+        if (s * d0 <= 0.0) {
+            return 0.0;
+        } else if (d0 * d1 < 0.0 && std::abs(s) > 3 * std::abs(d0)) {
+            return 3 * d0;
+        }
+        return s;
+    }
+    double d0 = delta(k-1);
+    double d1 = delta(k);
+    if (d0 * d1 <= 0.0) {
+        return 0.0;
+    }
+    // weighted harmonic mean of the adjacent slopes
+    double h0 = z[k] - z[k-1];
+    double h1 = z[k+1] - z[k];
+    double w0 = 2*h1 + h0;
+    double w1 = h1 + 2*h0;
+    return (w0 + w1) / (w0 / d0 + w1 / d1);
+}
+}
+
 Sim1D::Sim1D(vector<Domain1D*>& domains) :
     OneDim(domains),
-    m_steady_callback(0)
+    m_steady_callback(0),
+    m_adjointBandwidth(0)
 {
     // resize the internal solution vector and the work array, and perform
     // domain-specific initialization of the solution vector.
@@ -32,6 +77,7 @@ Sim1D::Sim1D(vector<Domain1D*>& domains) :
     // set some defaults
     m_tstep = 1.0e-5;
     m_steps = { 10 };
+    m_incrementalRefine = false;
 }
 
 void Sim1D::setInitialGuess(const std::string& component, vector_fp& locs, vector_fp& vals)
@@ -343,6 +389,9 @@ int Sim1D::refine(int loglevel)
     int ianalyze, np = 0;
     vector_fp znew, xnew;
     std::vector<size_t> dsize;
+    // index of each new grid point in the current grid, or npos
+    std::vector<size_t> oldPoints;
+    size_t oldStart = 0;
 
     m_xlast_ss = m_x;
     m_grid_last_ss.clear();
@@ -374,6 +423,7 @@ int Sim1D::refine(int loglevel)
             if (r.keepPoint(m)) {
                 // add the current grid point to the new grid
                 znew.push_back(d.grid(m));
+                oldPoints.push_back(oldStart + m);
 
                 // do the same for the solution at this point
                 for (size_t i = 0; i < comp; i++) {
@@ -387,12 +437,21 @@ int Sim1D::refine(int loglevel)
                     // add new point at midpoint
                     double zmid = 0.5*(d.grid(m) + d.grid(m+1));
                     znew.push_back(zmid);
+                    oldPoints.push_back(npos);
                     np++;
 
-                    // for each component, linearly interpolate
-                    // the solution to this point
+                    // for each component, interpolate the solution to this
+                    // point, either linearly or using the monotone cubic
+                    // interpolant, which does not introduce new extrema
+                    double h = d.grid(m+1) - d.grid(m);
                     for (size_t i = 0; i < comp; i++) {
                         double xmid = 0.5*(value(n, i, m) + value(n, i, m+1));
+                        if (m_incrementalRefine) {
+                            const double* f = &m_x[start(n) + d.index(i, 0)];
+                            xmid += h / 8.0 * (
+                                pchipSlope(d.grid().data(), f, comp, npnow, m) -
+                                pchipSlope(d.grid().data(), f, comp, npnow, m+1));
+                        }
                         xnew.push_back(xmid);
                     }
                 }
@@ -403,6 +462,18 @@ int Sim1D::refine(int loglevel)
             }
         }
         dsize.push_back(znew.size() - nstart);
+        oldStart += npnow;
+    }
+
+    // If no points were added or removed, keep the current grid, which also
+    // keeps the Jacobian, so that it can be reused by a subsequent solve
+    size_t npoints = 0;
+    for (size_t n = 0; n < nDomains(); n++) {
+        npoints += domain(n).nPoints();
+    }
+    if (np == 0 && znew.size() == npoints) {
+        finalize();
+        return 0;
     }
 
     // At this point, the new grid znew and the new solution vector xnew have
@@ -419,6 +490,9 @@ int Sim1D::refine(int loglevel)
 
     // Replace the current solution vector with the new one
     m_x = xnew;
+    if (m_incrementalRefine) {
+        m_oldPoints = oldPoints;
+    }
     resize();
     finalize();
     return np;
@@ -580,26 +654,126 @@ void Sim1D::evalSSJacobian()
 
 void Sim1D::solveAdjoint(const double* b, double* lambda)
 {
+    solveAdjoint(b, lambda, 1);
+}
+
+void Sim1D::solveAdjoint(const double* b, double* lambda, size_t nrhs,
+                         bool newJacobian)
+{
+    if (linearSolver() == "jfnk") {
+        throw CanteraError("Sim1D::solveAdjoint", "The adjoint problem "
+            "requires the full Jacobian, which is not available when using "
+            "the Jacobian-free linear solver.");
+    }
+    size_t bw = bandwidth();
+    vector_fp grid;
     for (auto& D : m_dom) {
-        D->forceFullUpdate(true);
+        grid.insert(grid.end(), D->grid().begin(), D->grid().end());
     }
-    evalSSJacobian();
+    if (!newJacobian) {
+        if (m_adjointSoln.empty()) {
+            throw CanteraError("Sim1D::solveAdjoint", "No factored Jacobian "
+                "is available.");
+        } else if (grid != m_adjointGrid) {
+            throw CanteraError("Sim1D::solveAdjoint", "The grid has changed "
+                "since the Jacobian was factored.");
+        } else if (bw != m_adjointBandwidth) {
+            throw CanteraError("Sim1D::solveAdjoint", "The bandwidth has "
+                "changed since the Jacobian was factored ({} != {}).", bw,
+                m_adjointBandwidth);
+        } else if (m_x != m_adjointSoln) {
+            throw CanteraError("Sim1D::solveAdjoint", "The solution has "
+                "changed since the Jacobian was factored.");
+        }
+    } else {
+        for (auto& D : m_dom) {
+            D->forceFullUpdate(true);
+        }
+        evalSSJacobian();
+        for (auto& D : m_dom) {
+            D->forceFullUpdate(false);
+        }
+
+        // Form J^T
+        m_adjointJac.resize(size(), bw, bw);
+        for (size_t i = 0; i < size(); i++) {
+            size_t j1 = (i > bw) ? i - bw : 0;
+            size_t j2 = (i + bw >= size()) ? size() - 1: i + bw;
+            for (size_t j = j1; j <= j2; j++) {
+                m_adjointJac(j,i) = m_jac->value(i,j);
+            }
+        }
+        m_adjointGrid = grid;
+        m_adjointBandwidth = bw;
+        m_adjointSoln = m_x;
+    }
+
+    copy(b, b + nrhs * size(), lambda);
+    m_adjointJac.solve(lambda, nrhs, size());
+}
+
+Array2D Sim1D::reactionDerivativeProducts(const double* lambda, size_t nrhs)
+{
+    Kinetics* kin = 0;
     for (auto& D : m_dom) {
-        D->forceFullUpdate(false);
+        StFlow* flow = dynamic_cast<StFlow*>(D);
+        if (!flow) {
+            continue;
+        } else if (kin && &flow->kinetics() != kin) {
+            throw CanteraError("Sim1D::reactionDerivativeProducts", "All flow "
+                "domains must use the same Kinetics object.");
+        }
+        kin = &flow->kinetics();
+    }
+    if (!kin) {
+        throw CanteraError("Sim1D::reactionDerivativeProducts",
+                           "No flow domain found.");
     }
 
-    // Form J^T
-    size_t bw = bandwidth();
-    BandMatrix Jt(size(), bw, bw);
-    for (size_t i = 0; i < size(); i++) {
-        size_t j1 = (i > bw) ? i - bw : 0;
-        size_t j2 = (i + bw >= size()) ? size() - 1: i + bw;
-        for (size_t j = j1; j <= j2; j++) {
-            Jt(j,i) = m_jac->value(i,j);
+    Array2D prod(nrhs, kin->nReactions(), 0.0);
+    for (auto& D : m_dom) {
+        StFlow* flow = dynamic_cast<StFlow*>(D);
+        if (flow) {
+            flow->addReactionDerivativeProducts(m_x.data(), lambda, nrhs,
+                                                size(), prod);
+        }
+    }
+    return prod;
+}
+
+Array2D Sim1D::reactionSensitivities(const vector<vector_fp>& dgdx)
+{
+    size_t n = size();
+    size_t nrhs = dgdx.size();
+    vector_fp b(n * nrhs), lambda(n * nrhs);
+    for (size_t r = 0; r < nrhs; r++) {
+        if (dgdx[r].size() != n) {
+            throw CanteraError("Sim1D::reactionSensitivities", "Derivative {}"
+                " has length {}, but the solution has length {}.",
+                r, dgdx[r].size(), n);
         }
+        copy(dgdx[r].begin(), dgdx[r].end(), b.begin() + r * n);
     }
+    solveAdjoint(b.data(), lambda.data(), nrhs);
 
-    Jt.solve(b, lambda);
+    // dg/dp = -lambda^T df/dp, since g does not depend on the multipliers
+    Array2D sens = reactionDerivativeProducts(lambda.data(), nrhs);
+    for (auto& s : sens.data()) {
+        s = -s;
+    }
+    return sens;
+}
+
+vector_fp Sim1D::componentDerivative(size_t dom, size_t n, size_t j) const
+{
+    const Domain1D& D = domain(dom);
+    if (n >= D.nComponents() || j >= D.nPoints()) {
+        throw CanteraError("Sim1D::componentDerivative", "Component {} at "
+            "point {} is outside of domain {}.", n, j, dom);
+    }
+    vector_fp dgdx(size(), 0.0);
+    dgdx[D.loc() + D.index(n, j)] = 1.0;
+    return dgdx;
 }
 
 void Sim1D::resize()
@@ -607,6 +781,8 @@ void Sim1D::resize()
     OneDim::resize();
     m_x.resize(size(), 0.0);
     m_xnew.resize(size(), 0.0);
+    m_adjointJac = BandMatrix();
+    m_adjointSoln.clear();
 }
 
 }
@@ -26,7 +26,12 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     m_do_multicomponent(false),
     m_do_radiation(false),
     m_kExcessLeft(0),
-    m_kExcessRight(0)
+    m_kExcessRight(0),
+    m_jacobianCache(true),
+    m_perturbedPoint(npos),
+    m_savedRho(0.0),
+    m_savedWtm(0.0),
+    m_savedCp(0.0)
 {
     m_type = cFlowType;
     m_points = points;
@@ -62,6 +67,8 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     m_wdot.resize(m_nsp,m_points, 0.0);
     m_ybar.resize(m_nsp);
     m_qdotRadiation.resize(m_points, 0.0);
+    m_savedWdot.resize(m_nsp);
+    m_savedFlux.resize(2*m_nsp);
 
     //-------------- default solution bounds --------------------
     setBounds(0, -1e20, 1e20); // no bounds on u
@@ -86,16 +93,12 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     }
     setupGrid(m_points, gr.data());
     setID("stagnation flow");
-
-    // Find indices for radiating species
-    m_kRadiating.resize(2, npos);
-    m_kRadiating[0] = m_thermo->speciesIndex("CO2");
-    m_kRadiating[1] = m_thermo->speciesIndex("H2O");
 }
 
 void StFlow::resize(size_t ncomponents, size_t points)
 {
     Domain1D::resize(ncomponents, points);
+    m_perturbedPoint = npos;
     m_rho.resize(m_points, 0.0);
     m_wtm.resize(m_points, 0.0);
     m_cp.resize(m_points, 0.0);
@@ -111,6 +114,7 @@ void StFlow::resize(size_t ncomponents, size_t points)
     m_wdot.resize(m_nsp,m_points, 0.0);
     m_do_energy.resize(m_points,false);
     m_qdotRadiation.resize(m_points, 0.0);
+    m_Tgrid.resize(m_points);
     m_fixedtemp.resize(m_points);
 
     m_dz.resize(m_points-1);
@@ -235,7 +239,27 @@ void StFlow::eval(size_t jg, doublereal* xg,
         jmax = std::min(jpt+1,m_points-1);
     }
 
-    updateProperties(jg, x, jmin, jmax);
+    // The properties at the point perturbed in the previous evaluation of the
+    // Jacobian are left in place for use by the boundary domains, and are
+    // only restored now.
+    if (m_perturbedPoint != npos) {
+        restorePoint(m_perturbedPoint);
+        m_perturbedPoint = npos;
+    }
+
+    if (jg == npos || m_force_full_update || !m_jacobianCache) {
+        updateProperties(jg, x, jmin, jmax);
+        evalResidual(x, rsd, diag, rdt, jmin, jmax);
+        return;
+    }
+
+    // Evaluating the Jacobian. Only the properties depending on the perturbed
+    // point need to be updated, if it is in this domain. The properties at
+    // all other points are unchanged since the last full evaluation.
+    if (jg >= firstPoint() && jg <= lastPoint()) {
+        m_perturbedPoint = jg - firstPoint();
+        updatePerturbedPoint(x, m_perturbedPoint);
+    }
     evalResidual(x, rsd, diag, rdt, jmin, jmax);
 }
 
@@ -245,10 +269,15 @@ void StFlow::updateProperties(size_t jg, double* x, size_t jmin, size_t jmax)
     size_t j0 = std::max<size_t>(jmin, 1) - 1;
     size_t j1 = std::min(jmax+1,m_points-1);
 
-    updateThermo(x, j0, j1);
+    {
+        Profile1D::Timer timer(m_profiler, Profile1D::ThermoUpdate, j1 - j0 + 1);
+        updateThermo(x, j0, j1);
+    }
     if (jg == npos || m_force_full_update) {
         // update transport properties only if a Jacobian is not being
         // evaluated, or if specifically requested
+        Profile1D::Timer timer(m_profiler, Profile1D::TransportUpdate,
+                               j1 - j0 + 1);
         updateTransport(x, j0, j1);
     }
     if (jg == npos) {
@@ -260,7 +289,63 @@ void StFlow::updateProperties(size_t jg, double* x, size_t jmin, size_t jmax)
 
     // update the species diffusive mass fluxes whether or not a
     // Jacobian is being evaluated
-    updateDiffFluxes(x, j0, j1);
+    {
+        Profile1D::Timer timer(m_profiler, Profile1D::DiffusiveFluxes);
+        updateDiffFluxes(x, j0, j1);
+    }
+
+    // net production rates are only needed at interior points
+    size_t jlo = std::max<size_t>(jmin, 1);
+    size_t jhi = std::min(jmax, m_points - 2);
+    Profile1D::Timer timer(m_profiler, Profile1D::Kinetics,
+                           (jhi >= jlo) ? jhi - jlo + 1 : 0);
+    for (size_t j = jlo; j <= jhi; j++) {
+        getWdot(x, j);
+    }
+}
+
+void StFlow::updatePerturbedPoint(double* x, size_t j)
+{
+    // intervals adjacent to point j are j0 to j1-1
+    size_t j0 = std::max<size_t>(j, 1) - 1;
+    size_t j1 = std::min(j + 1, m_points - 1);
+
+    m_savedRho = m_rho[j];
+    m_savedWtm = m_wtm[j];
+    m_savedCp = m_cp[j];
+    copy(&m_wdot(0, j), &m_wdot(0, j) + m_nsp, m_savedWdot.begin());
+    for (size_t i = j0; i < j1; i++) {
+        copy(&m_flux(0, i), &m_flux(0, i) + m_nsp,
+             m_savedFlux.begin() + (i - j0) * m_nsp);
+    }
+
+    {
+        Profile1D::Timer timer(m_profiler, Profile1D::ThermoUpdate, 1);
+        updateThermo(x, j, j);
+    }
+    {
+        Profile1D::Timer timer(m_profiler, Profile1D::DiffusiveFluxes);
+        updateDiffFluxes(x, j0, j1);
+    }
+    if (j > 0 && j < m_points - 1) {
+        Profile1D::Timer timer(m_profiler, Profile1D::Kinetics, 1);
+        getWdot(x, j);
+    }
+}
+
+void StFlow::restorePoint(size_t j)
+{
+    size_t j0 = std::max<size_t>(j, 1) - 1;
+    size_t j1 = std::min(j + 1, m_points - 1);
+
+    m_rho[j] = m_savedRho;
+    m_wtm[j] = m_savedWtm;
+    m_cp[j] = m_savedCp;
+    copy(m_savedWdot.begin(), m_savedWdot.end(), &m_wdot(0, j));
+    for (size_t i = j0; i < j1; i++) {
+        copy(m_savedFlux.begin() + (i - j0) * m_nsp,
+             m_savedFlux.begin() + (i - j0 + 1) * m_nsp, &m_flux(0, i));
+    }
 }
 
 void StFlow::evalResidual(double* x, double* rsd, int* diag,
@@ -271,69 +356,16 @@ void StFlow::evalResidual(double* x, double* rsd, int* diag,
     // grid points
     //----------------------------------------------------
 
-    // calculation of qdotRadiation
-
-    // The simple radiation model used was established by Y. Liu and B. Rogg [Y.
-    // Liu and B. Rogg, Modelling of thermally radiating diffusion flames with
-    // detailed chemistry and transport, EUROTHERM Seminars, 17:114-127, 1991].
-    // This model uses the optically thin limit and the gray-gas approximation
-    // to simply calculate a volume specified heat flux out of the Planck
-    // absorption coefficients, the boundary emissivities and the temperature.
-    // The model considers only CO2 and H2O as radiating species. Polynomial
-    // lines calculate the species Planck coefficients for H2O and CO2. The data
-    // for the lines is taken from the RADCAL program [Grosshandler, W. L.,
-    // RADCAL: A Narrow-Band Model for Radiation Calculations in a Combustion
-    // Environment, NIST technical note 1402, 1993]. The coefficients for the
-    // polynomials are taken from [http://www.sandia.gov/TNF/radiation.html].
-
+    // radiative heat loss, which is computed for all points in one call to
+    // the radiation model
     if (m_do_radiation) {
-        // variable definitions for the Planck absorption coefficient and the
-        // radiation calculation:
-        doublereal k_P_ref = 1.0*OneAtm;
-
-        // polynomial coefficients:
-        const doublereal c_H2O[6] = {-0.23093, -1.12390, 9.41530, -2.99880,
-                                     0.51382, -1.86840e-5};
-        const doublereal c_CO2[6] = {18.741, -121.310, 273.500, -194.050,
-                                     56.310, -5.8169};
-
-        // calculation of the two boundary values
-        double boundary_Rad_left = m_epsilon_left * StefanBoltz * pow(T(x, 0), 4);
-        double boundary_Rad_right = m_epsilon_right * StefanBoltz * pow(T(x, m_points - 1), 4);
-
-        // loop over all grid points
-        for (size_t j = jmin; j < jmax; j++) {
-            // helping variable for the calculation
-            double radiative_heat_loss = 0;
-
-            // calculation of the mean Planck absorption coefficient
-            double k_P = 0;
-            // absorption coefficient for H2O
-            if (m_kRadiating[1] != npos) {
-                double k_P_H2O = 0;
-                for (size_t n = 0; n <= 5; n++) {
-                    k_P_H2O += c_H2O[n] * pow(1000 / T(x, j), (double) n);
-                }
-                k_P_H2O /= k_P_ref;
-                k_P += m_press * X(x, m_kRadiating[1], j) * k_P_H2O;
-            }
-            // absorption coefficient for CO2
-            if (m_kRadiating[0] != npos) {
-                double k_P_CO2 = 0;
-                for (size_t n = 0; n <= 5; n++) {
-                    k_P_CO2 += c_CO2[n] * pow(1000 / T(x, j), (double) n);
-                }
-                k_P_CO2 /= k_P_ref;
-                k_P += m_press * X(x, m_kRadiating[0], j) * k_P_CO2;
-            }
-
-            // calculation of the radiative heat loss term
-            radiative_heat_loss = 2 * k_P *(2 * StefanBoltz * pow(T(x, j), 4)
-            - boundary_Rad_left - boundary_Rad_right);
-
-            // set the radiative heat loss vector
-            m_qdotRadiation[j] = radiative_heat_loss;
+        for (size_t j = 0; j < m_points; j++) {
+            m_Tgrid[j] = T(x, j);
         }
+        m_radiation->getHeatLoss(m_points, m_Tgrid.data(),
+            x + index(c_offset_Y, 0), m_nv, m_wtm.data(), m_press,
+            m_epsilon_left, m_epsilon_right, jmin, jmax,
+            m_qdotRadiation.data());
     }
 
     for (size_t j = jmin; j <= jmax; j++) {
@@ -402,16 +434,28 @@ void StFlow::evalResidual(double* x, double* rsd, int* diag,
             //   \rho dY_k/dt + \rho u dY_k/dz + dJ_k/dz
             //   = M_k\omega_k
             //-------------------------------------------------
-            getWdot(x,j);
+            // The mass fractions, fluxes, and production rates of all
+            // species at one point are contiguous
+            size_t jloc = (u(x,j) > 0.0 ? j : j + 1);
+            const double* Yj = x + index(c_offset_Y, j);
+            const double* Yup = x + index(c_offset_Y, jloc);
+            const double* Yup_m = x + index(c_offset_Y, jloc - 1);
+            const double* Yprev = m_slast.data() + index(c_offset_Y, j);
+            const double* flux_j = &m_flux(0, j);
+            const double* flux_m = &m_flux(0, j-1);
+            const double* wdot_j = &m_wdot(0, j);
+            double* rsdY = rsd + index(c_offset_Y, j);
+            int* diagY = diag + index(c_offset_Y, j);
+            double rho_u_j = rho_u(x,j);
+            double dz_up = m_dz[jloc-1];
+            double dz_c = z(j+1) - z(j-1);
+            double rho_j = m_rho[j];
             for (size_t k = 0; k < m_nsp; k++) {
-                double convec = rho_u(x,j)*dYdz(x,k,j);
-                double diffus = 2.0*(m_flux(k,j) - m_flux(k,j-1))
-                                / (z(j+1) - z(j-1));
-                rsd[index(c_offset_Y + k, j)]
-                = (m_wt[k]*(wdot(k,j))
-                   - convec - diffus)/m_rho[j]
-                  - rdt*(Y(x,k,j) - Y_prev(k,j));
-                diag[index(c_offset_Y + k, j)] = 1;
+                double convec = rho_u_j*((Yup[k] - Yup_m[k])/dz_up);
+                double diffus = 2.0*(flux_j[k] - flux_m[k]) / dz_c;
+                rsdY[k] = (m_wt[k]*wdot_j[k] - convec - diffus)/rho_j
+                          - rdt*(Yj[k] - Yprev[k]);
+                diagY[k] = 1;
             }
 
             //-----------------------------------------------
@@ -431,8 +475,8 @@ void StFlow::evalResidual(double* x, double* rsd, int* diag,
                 double sum = 0.0;
                 double sum2 = 0.0;
                 for (size_t k = 0; k < m_nsp; k++) {
-                    double flxk = 0.5*(m_flux(k,j-1) + m_flux(k,j));
-                    sum += wdot(k,j)*h_RT[k];
+                    double flxk = 0.5*(flux_m[k] + flux_j[k]);
+                    sum += wdot_j[k]*h_RT[k];
                     sum2 += flxk*cp_R[k]/m_wt[k];
                 }
                 sum *= GasConstant * T(x,j);
@@ -457,6 +501,37 @@ void StFlow::evalResidual(double* x, double* rsd, int* diag,
     }
 }
 
+void StFlow::addReactionDerivativeProducts(const double* xg,
+    const double* lambda, size_t nrhs, size_t ld, Array2D& prod)
+{
+    const double* x = xg + loc();
+    size_t nr = m_kin->nReactions();
+    vector_fp q(nr), z(m_nsp), dz(nr);
+    for (size_t j = 1; j < m_points - 1; j++) {
+        setGas(x, j);
+        m_kin->getNetRatesOfProgress(q.data());
+        double rho = m_thermo->density();
+        double rho_cp = rho * m_thermo->cp_mass();
+        double RT = GasConstant * T(x, j);
+        const vector_fp& h_RT = m_thermo->enthalpy_RT_ref();
+        for (size_t r = 0; r < nrhs; r++) {
+            const double* L = lambda + r * ld + loc();
+            // d(rsd_Y)/d(wdot_k) = W_k/rho and d(rsd_T)/d(wdot_k) =
+            // -h_k/(rho*cp), combined into one species property so that the
+            // sum over species is done by getReactionDelta
+            double L_T = m_do_energy[j] ? L[index(c_offset_T, j)] : 0.0;
+            for (size_t k = 0; k < m_nsp; k++) {
+                z[k] = L[index(c_offset_Y + k, j)] * m_wt[k] / rho
+                       - L_T * RT * h_RT[k] / rho_cp;
+            }
+            m_kin->getReactionDelta(z.data(), dz.data());
+            for (size_t i = 0; i < nr; i++) {
+                prod(r, i) += q[i] * dz[i];
+            }
+        }
+    }
+}
+
 void StFlow::updateTransport(doublereal* x, size_t j0, size_t j1)
 {
      if (m_do_multicomponent) {
@@ -834,6 +909,23 @@ void StFlow::solveEnergyEqn(size_t j)
     }
 }
 
+void StFlow::enableRadiation(bool doRadiation)
+{
+    if (doRadiation && !m_radiation) {
+        setRadiationModel(make_shared<OpticallyThinRadiation>());
+    }
+    m_do_radiation = doRadiation;
+}
+
+void StFlow::setRadiationModel(shared_ptr<Radiation1D> model)
+{
+    m_radiation = model;
+    if (m_radiation && m_thermo) {
+        m_radiation->setThermo(*m_thermo);
+    }
+    m_do_radiation = bool(m_radiation);
+}
+
 void StFlow::setBoundaryEmissivities(doublereal e_left, doublereal e_right)
 {
     if (e_left < 0 || e_left > 1) {
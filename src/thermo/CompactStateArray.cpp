@@ -0,0 +1,158 @@
+/**
+ * @file CompactStateArray.cpp
+ * Definitions for reduced-precision storage of many phase states (see class
+ * \link Cantera::CompactStateArray CompactStateArray\endlink).
+ */
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/thermo/CompactStateArray.h"
+#include "cantera/thermo/Phase.h"
+#include "cantera/base/ctexceptions.h"
+
+namespace Cantera
+{
+
+namespace {
+
+//! Largest value of the scaled integers
+const double maxScaled = 65535.0;
+
+}
+
+CompactStateArray::CompactStateArray(const Phase& phase, size_t n,
+                                     Precision prec) :
+    m_size(0),
+    m_stateSize(phase.nSpecies() + 2),
+    m_prec(prec),
+    m_lower(m_stateSize, 0.0),
+    m_upper(m_stateSize, 1.0),
+    m_work(m_stateSize)
+{
+    m_upper[0] = 1.0e4;
+    m_upper[1] = 1.0e3;
+    updateScales();
+    resize(n);
+}
+
+void CompactStateArray::resize(size_t n)
+{
+    m_size = n;
+    if (m_prec == Precision::Float32) {
+        m_float.resize(n * m_stateSize);
+    } else {
+        m_scaled.resize(n * m_stateSize);
+    }
+}
+
+void CompactStateArray::setRange(size_t m, double lower, double upper)
+{
+    if (m >= m_stateSize) {
+        throw IndexError("CompactStateArray::setRange", "state vector", m,
+                         m_stateSize - 1);
+    } else if (!(lower <= upper)) {
+        throw CanteraError("CompactStateArray::setRange",
+            "Invalid range [{}, {}] for component {}", lower, upper, m);
+    }
+    m_lower[m] = lower;
+    m_upper[m] = upper;
+    updateScales();
+}
+
+void CompactStateArray::fitRanges(size_t n, const double* states)
+{
+    if (n == 0) {
+        return;
+    }
+    std::copy(states, states + m_stateSize, m_lower.begin());
+    std::copy(states, states + m_stateSize, m_upper.begin());
+    for (size_t i = 1; i < n; i++) {
+        const double* s = states + i * m_stateSize;
+        for (size_t m = 0; m < m_stateSize; m++) {
+            m_lower[m] = std::min(m_lower[m], s[m]);
+            m_upper[m] = std::max(m_upper[m], s[m]);
+        }
+    }
+    updateScales();
+}
+
+void CompactStateArray::updateScales()
+{
+    m_scale.resize(m_stateSize);
+    m_invScale.resize(m_stateSize);
+    for (size_t m = 0; m < m_stateSize; m++) {
+        m_scale[m] = (m_upper[m] - m_lower[m]) / maxScaled;
+        // A component with an empty range is always stored as zero
+        m_invScale[m] = (m_scale[m] > 0.0) ? 1.0 / m_scale[m] : 0.0;
+    }
+}
+
+void CompactStateArray::checkEntries(const std::string& method, size_t i0,
+                                     size_t n) const
+{
+    if (i0 + n > m_size) {
+        throw IndexError("CompactStateArray::" + method, "states", i0 + n - 1,
+                         m_size - 1);
+    }
+}
+
+void CompactStateArray::save(size_t i, const Phase& phase)
+{
+    phase.saveState(m_stateSize, m_work.data());
+    setStates(i, 1, m_work.data());
+}
+
+void CompactStateArray::restore(size_t i, Phase& phase) const
+{
+    getStates(i, 1, m_work.data());
+    phase.setState_TRY(m_work[0], m_work[1], &m_work[2]);
+}
+
+void CompactStateArray::setStates(size_t i0, size_t n, const double* states)
+{
+    checkEntries("setStates", i0, n);
+    size_t nm = n * m_stateSize;
+    if (m_prec == Precision::Float32) {
+        float* out = m_float.data() + i0 * m_stateSize;
+        for (size_t j = 0; j < nm; j++) {
+            out[j] = static_cast<float>(states[j]);
+        }
+        return;
+    }
+    const double* lower = m_lower.data();
+    const double* invScale = m_invScale.data();
+    for (size_t i = 0; i < n; i++) {
+        const double* s = states + i * m_stateSize;
+        uint16_t* out = m_scaled.data() + (i0 + i) * m_stateSize;
+        for (size_t m = 0; m < m_stateSize; m++) {
+            double q = (s[m] - lower[m]) * invScale[m];
+            q = std::min(std::max(q, 0.0), maxScaled);
+            out[m] = static_cast<uint16_t>(q + 0.5);
+        }
+    }
+}
+
+void CompactStateArray::getStates(size_t i0, size_t n, double* states) const
+{
+    checkEntries("getStates", i0, n);
+    size_t nm = n * m_stateSize;
+    if (m_prec == Precision::Float32) {
+        const float* in = m_float.data() + i0 * m_stateSize;
+        for (size_t j = 0; j < nm; j++) {
+            states[j] = in[j];
+        }
+        return;
+    }
+    const double* lower = m_lower.data();
+    const double* scale = m_scale.data();
+    for (size_t i = 0; i < n; i++) {
+        double* s = states + i * m_stateSize;
+        const uint16_t* in = m_scaled.data() + (i0 + i) * m_stateSize;
+        for (size_t m = 0; m < m_stateSize; m++) {
+            s[m] = lower[m] + scale[m] * in[m];
+        }
+    }
+}
+
+}
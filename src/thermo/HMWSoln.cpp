@@ -36,6 +36,8 @@ HMWSoln::HMWSoln() :
     m_A_Debye(1.172576), // units = sqrt(kg/gmol)
     m_waterSS(0),
     m_molalitiesAreCropped(false),
+    m_interactionsChanged(true),
+    m_molarCharge(0.0),
     IMS_X_o_cutoff_(0.2),
     IMS_cCut_(0.05),
     IMS_slopegCut_(0.0),
@@ -74,6 +76,8 @@ HMWSoln::HMWSoln(const std::string& inputFile, const std::string& id_) :
     m_A_Debye(1.172576), // units = sqrt(kg/gmol)
     m_waterSS(0),
     m_molalitiesAreCropped(false),
+    m_interactionsChanged(true),
+    m_molarCharge(0.0),
     IMS_X_o_cutoff_(0.2),
     IMS_cCut_(0.05),
     IMS_slopegCut_(0.0),
@@ -109,6 +113,8 @@ HMWSoln::HMWSoln(XML_Node& phaseRoot, const std::string& id_) :
     m_A_Debye(1.172576), // units = sqrt(kg/gmol)
     m_waterSS(0),
     m_molalitiesAreCropped(false),
+    m_interactionsChanged(true),
+    m_molarCharge(0.0),
     IMS_X_o_cutoff_(0.2),
     IMS_cCut_(0.05),
     IMS_slopegCut_(0.0),
@@ -475,6 +481,7 @@ void HMWSoln::setBinarySalt(const std::string& sp1, const std::string& sp2,
     }
     m_Alpha1MX_ij[c] = alpha1;
     m_Alpha2MX_ij[c] = alpha2;
+    m_interactionsChanged = true;
 }
 
 void HMWSoln::setTheta(const std::string& sp1, const std::string& sp2,
@@ -498,6 +505,7 @@ void HMWSoln::setTheta(const std::string& sp1, const std::string& sp2,
     for (size_t n = 0; n < nParams; n++) {
         m_Theta_ij_coeff(n, c) = theta[n];
     }
+    m_interactionsChanged = true;
 }
 
 void HMWSoln::setPsi(const std::string& sp1, const std::string& sp2,
@@ -515,7 +523,7 @@ void HMWSoln::setPsi(const std::string& sp1, const std::string& sp2,
     }
 
     if (!charge(k1) || !charge(k2) || !charge(k3) ||
-        std::abs(sign(charge(k1) + sign(charge(k2)) + sign(charge(k3)))) != 1) {
+        std::abs(sign(charge(k1)) + sign(charge(k2)) + sign(charge(k3))) != 1) {
         throw CanteraError("HMWSoln::setPsi", "All species must be ions and"
             " must include at least one cation and one anion, but given species"
             " (charges) were: {} ({}), {} ({}), and {} ({}).",
@@ -534,6 +542,7 @@ void HMWSoln::setPsi(const std::string& sp1, const std::string& sp2,
         }
         m_Psi_ijk[c] = psi[0];
     }
+    m_interactionsChanged = true;
 }
 
 void HMWSoln::setLambda(const std::string& sp1, const std::string& sp2,
@@ -561,6 +570,7 @@ void HMWSoln::setLambda(const std::string& sp1, const std::string& sp2,
         m_Lambda_nj_coeff(n, c) = lambda[n];
     }
     m_Lambda_nj(k1, k2) = lambda[0];
+    m_interactionsChanged = true;
 }
 
 void HMWSoln::setMunnn(const std::string& sp, size_t nParams, double* munnn)
@@ -579,6 +589,7 @@ void HMWSoln::setMunnn(const std::string& sp, size_t nParams, double* munnn)
         m_Mu_nnn_coeff(n, k) = munnn[n];
     }
     m_Mu_nnn[k] = munnn[0];
+    m_interactionsChanged = true;
 }
 
 void HMWSoln::setZeta(const std::string& sp1, const std::string& sp2,
@@ -622,6 +633,7 @@ void HMWSoln::setZeta(const std::string& sp1, const std::string& sp2,
         m_Psi_ijk_coeff(n, c) = psi[n];
     }
     m_Psi_ijk[c] = psi[0];
+    m_interactionsChanged = true;
 }
 
 void HMWSoln::setPitzerTempModel(const std::string& model)
@@ -1072,37 +1084,13 @@ void HMWSoln::initLengths()
     m_g2func_IJ.resize(maxCounterIJlen, 0.0);
     m_hfunc_IJ.resize(maxCounterIJlen, 0.0);
     m_h2func_IJ.resize(maxCounterIJlen, 0.0);
-    m_BMX_IJ.resize(maxCounterIJlen, 0.0);
-    m_BMX_IJ_L.resize(maxCounterIJlen, 0.0);
-    m_BMX_IJ_LL.resize(maxCounterIJlen, 0.0);
-    m_BMX_IJ_P.resize(maxCounterIJlen, 0.0);
-    m_BprimeMX_IJ.resize(maxCounterIJlen, 0.0);
-    m_BprimeMX_IJ_L.resize(maxCounterIJlen, 0.0);
-    m_BprimeMX_IJ_LL.resize(maxCounterIJlen, 0.0);
-    m_BprimeMX_IJ_P.resize(maxCounterIJlen, 0.0);
-    m_BphiMX_IJ.resize(maxCounterIJlen, 0.0);
-    m_BphiMX_IJ_L.resize(maxCounterIJlen, 0.0);
-    m_BphiMX_IJ_LL.resize(maxCounterIJlen, 0.0);
-    m_BphiMX_IJ_P.resize(maxCounterIJlen, 0.0);
-    m_Phi_IJ.resize(maxCounterIJlen, 0.0);
-    m_Phi_IJ_L.resize(maxCounterIJlen, 0.0);
-    m_Phi_IJ_LL.resize(maxCounterIJlen, 0.0);
-    m_Phi_IJ_P.resize(maxCounterIJlen, 0.0);
-    m_Phiprime_IJ.resize(maxCounterIJlen, 0.0);
-    m_PhiPhi_IJ.resize(maxCounterIJlen, 0.0);
-    m_PhiPhi_IJ_L.resize(maxCounterIJlen, 0.0);
-    m_PhiPhi_IJ_LL.resize(maxCounterIJlen, 0.0);
-    m_PhiPhi_IJ_P.resize(maxCounterIJlen, 0.0);
-    m_CMX_IJ.resize(maxCounterIJlen, 0.0);
-    m_CMX_IJ_L.resize(maxCounterIJlen, 0.0);
-    m_CMX_IJ_LL.resize(maxCounterIJlen, 0.0);
-    m_CMX_IJ_P.resize(maxCounterIJlen, 0.0);
 
     m_gamma_tmp.resize(m_kk, 0.0);
     IMS_lnActCoeffMolal_.resize(m_kk, 0.0);
     CROP_speciesCropped_.resize(m_kk, 0);
 
     counterIJ_setup();
+    m_interactionsChanged = true;
 }
 
 void HMWSoln::s_update_lnMolalityActCoeff() const
@@ -1649,6 +1637,10 @@ void HMWSoln::calcMCCutoffParams_()
 
 void HMWSoln::s_updatePitzer_CoeffWRTemp(int doDerivs) const
 {
+    if (m_interactionsChanged) {
+        setupInteractions();
+    }
+
     double T = temperature();
     const double twoT = 2.0 * T;
     const double invT = 1.0 / T;
@@ -1664,233 +1656,161 @@ void HMWSoln::s_updatePitzer_CoeffWRTemp(int doDerivs) const
         tinv = 1.0/T - 1.0/m_TempPitzerRef;
     }
 
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            const double* beta0MX_coeff = m_Beta0MX_ij_coeff.ptrColumn(counterIJ);
-            const double* beta1MX_coeff = m_Beta1MX_ij_coeff.ptrColumn(counterIJ);
-            const double* beta2MX_coeff = m_Beta2MX_ij_coeff.ptrColumn(counterIJ);
-            const double* CphiMX_coeff = m_CphiMX_ij_coeff.ptrColumn(counterIJ);
-            const double* Theta_coeff = m_Theta_ij_coeff.ptrColumn(counterIJ);
-
-            switch (m_formPitzerTemp) {
-            case PITZER_TEMP_CONSTANT:
-                break;
-            case PITZER_TEMP_LINEAR:
-
-                m_Beta0MX_ij[counterIJ] = beta0MX_coeff[0]
-                                          + beta0MX_coeff[1]*tlin;
-                m_Beta0MX_ij_L[counterIJ] = beta0MX_coeff[1];
-                m_Beta0MX_ij_LL[counterIJ] = 0.0;
-                m_Beta1MX_ij[counterIJ] = beta1MX_coeff[0]
-                                            + beta1MX_coeff[1]*tlin;
-                m_Beta1MX_ij_L[counterIJ] = beta1MX_coeff[1];
-                m_Beta1MX_ij_LL[counterIJ] = 0.0;
-                m_Beta2MX_ij[counterIJ] = beta2MX_coeff[0]
-                                             + beta2MX_coeff[1]*tlin;
-                m_Beta2MX_ij_L[counterIJ] = beta2MX_coeff[1];
-                m_Beta2MX_ij_LL[counterIJ] = 0.0;
-                m_CphiMX_ij[counterIJ] = CphiMX_coeff[0]
-                                             + CphiMX_coeff[1]*tlin;
-                m_CphiMX_ij_L[counterIJ] = CphiMX_coeff[1];
-                m_CphiMX_ij_LL[counterIJ] = 0.0;
-                m_Theta_ij[counterIJ] = Theta_coeff[0] + Theta_coeff[1]*tlin;
-                m_Theta_ij_L[counterIJ] = Theta_coeff[1];
-                m_Theta_ij_LL[counterIJ] = 0.0;
-                break;
+    // Evaluate a parameter and its first and second temperature derivatives
+    // from its vector of coefficients. The derivatives are zero for the
+    // constant temperature model.
+    auto update = [&](const double* coeff, double& value, double& value_L,
+                      double& value_LL) {
+        switch (m_formPitzerTemp) {
+        case PITZER_TEMP_CONSTANT:
+            value = coeff[0];
+            break;
+        case PITZER_TEMP_LINEAR:
+            value = coeff[0] + coeff[1]*tlin;
+            value_L = coeff[1];
+            value_LL = 0.0;
+            break;
+        case PITZER_TEMP_COMPLEX1:
+            value = coeff[0]
+                    + coeff[1]*tlin
+                    + coeff[2]*tquad
+                    + coeff[3]*tinv
+                    + coeff[4]*tln;
+            value_L = coeff[1]
+                      + coeff[2]*twoT
+                      - coeff[3]*invT2
+                      + coeff[4]*invT;
+            value_LL = coeff[2]*2.0
+                       + coeff[3]*twoinvT3
+                       - coeff[4]*invT2;
+            break;
+        }
+    };
+
+    for (const auto& p : m_pairsMX) {
+        size_t c = p.counterIJ;
+        update(m_Beta0MX_ij_coeff.ptrColumn(c), m_Beta0MX_ij[c],
+               m_Beta0MX_ij_L[c], m_Beta0MX_ij_LL[c]);
+        update(m_Beta1MX_ij_coeff.ptrColumn(c), m_Beta1MX_ij[c],
+               m_Beta1MX_ij_L[c], m_Beta1MX_ij_LL[c]);
+        update(m_Beta2MX_ij_coeff.ptrColumn(c), m_Beta2MX_ij[c],
+               m_Beta2MX_ij_L[c], m_Beta2MX_ij_LL[c]);
+        update(m_CphiMX_ij_coeff.ptrColumn(c), m_CphiMX_ij[c],
+               m_CphiMX_ij_L[c], m_CphiMX_ij_LL[c]);
+    }
+
+    for (const auto& p : m_pairsLike) {
+        size_t c = p.counterIJ;
+        update(m_Theta_ij_coeff.ptrColumn(c), m_Theta_ij[c],
+               m_Theta_ij_L[c], m_Theta_ij_LL[c]);
+    }
+
+    // Lambda interactions and Mu_nnn
+    for (const auto& p : m_pairsLambda) {
+        update(m_Lambda_nj_coeff.ptrColumn(p.counterIJ), m_Lambda_nj(p.i, p.j),
+               m_Lambda_nj_L(p.i, p.j), m_Lambda_nj_LL(p.i, p.j));
+    }
+    for (size_t k : m_neutralsMu) {
+        update(m_Mu_nnn_coeff.ptrColumn(k), m_Mu_nnn[k], m_Mu_nnn_L[k],
+               m_Mu_nnn_LL[k]);
+    }
+
+    size_t kk2 = m_kk * m_kk;
+    for (const auto& t : m_triplets) {
+        update(m_Psi_ijk_coeff.ptrColumn(t.n), m_Psi_ijk[t.n],
+               m_Psi_ijk_L[t.n], m_Psi_ijk_LL[t.n]);
+        if (charge(t.i) != 0.0) {
+            // Psi is stored for all permutations of the three ions. Zeta is
+            // stored only once, with the neutral species first.
+            for (size_t n : {t.i * kk2 + t.k * m_kk + t.j,
+                             t.j * kk2 + t.i * m_kk + t.k,
+                             t.j * kk2 + t.k * m_kk + t.i,
+                             t.k * kk2 + t.i * m_kk + t.j,
+                             t.k * kk2 + t.j * m_kk + t.i}) {
+                m_Psi_ijk[n] = m_Psi_ijk[t.n];
+                m_Psi_ijk_L[n] = m_Psi_ijk_L[t.n];
+                m_Psi_ijk_LL[n] = m_Psi_ijk_LL[t.n];
+            }
+        }
+    }
+}
 
-            case PITZER_TEMP_COMPLEX1:
-                m_Beta0MX_ij[counterIJ] = beta0MX_coeff[0]
-                                          + beta0MX_coeff[1]*tlin
-                                          + beta0MX_coeff[2]*tquad
-                                          + beta0MX_coeff[3]*tinv
-                                          + beta0MX_coeff[4]*tln;
-                m_Beta1MX_ij[counterIJ] = beta1MX_coeff[0]
-                                          + beta1MX_coeff[1]*tlin
-                                          + beta1MX_coeff[2]*tquad
-                                          + beta1MX_coeff[3]*tinv
-                                          + beta1MX_coeff[4]*tln;
-                m_Beta2MX_ij[counterIJ] = beta2MX_coeff[0]
-                                          + beta2MX_coeff[1]*tlin
-                                          + beta2MX_coeff[2]*tquad
-                                          + beta2MX_coeff[3]*tinv
-                                          + beta2MX_coeff[4]*tln;
-                m_CphiMX_ij[counterIJ] = CphiMX_coeff[0]
-                                         + CphiMX_coeff[1]*tlin
-                                         + CphiMX_coeff[2]*tquad
-                                         + CphiMX_coeff[3]*tinv
-                                         + CphiMX_coeff[4]*tln;
-                m_Theta_ij[counterIJ] = Theta_coeff[0]
-                                        + Theta_coeff[1]*tlin
-                                        + Theta_coeff[2]*tquad
-                                        + Theta_coeff[3]*tinv
-                                        + Theta_coeff[4]*tln;
-                m_Beta0MX_ij_L[counterIJ] = beta0MX_coeff[1]
-                                             + beta0MX_coeff[2]*twoT
-                                             - beta0MX_coeff[3]*invT2
-                                             + beta0MX_coeff[4]*invT;
-                m_Beta1MX_ij_L[counterIJ] = beta1MX_coeff[1]
-                                             + beta1MX_coeff[2]*twoT
-                                             - beta1MX_coeff[3]*invT2
-                                             + beta1MX_coeff[4]*invT;
-                m_Beta2MX_ij_L[counterIJ] = beta2MX_coeff[1]
-                                             + beta2MX_coeff[2]*twoT
-                                             - beta2MX_coeff[3]*invT2
-                                             + beta2MX_coeff[4]*invT;
-                m_CphiMX_ij_L[counterIJ] = CphiMX_coeff[1]
-                                            + CphiMX_coeff[2]*twoT
-                                            - CphiMX_coeff[3]*invT2
-                                            + CphiMX_coeff[4]*invT;
-                m_Theta_ij_L[counterIJ] = Theta_coeff[1]
-                                            + Theta_coeff[2]*twoT
-                                            - Theta_coeff[3]*invT2
-                                            + Theta_coeff[4]*invT;
-                doDerivs = 2;
-                if (doDerivs > 1) {
-                    m_Beta0MX_ij_LL[counterIJ] =
-                        + beta0MX_coeff[2]*2.0
-                        + beta0MX_coeff[3]*twoinvT3
-                        - beta0MX_coeff[4]*invT2;
-                    m_Beta1MX_ij_LL[counterIJ] =
-                        + beta1MX_coeff[2]*2.0
-                        + beta1MX_coeff[3]*twoinvT3
-                        - beta1MX_coeff[4]*invT2;
-                    m_Beta2MX_ij_LL[counterIJ] =
-                        + beta2MX_coeff[2]*2.0
-                        + beta2MX_coeff[3]*twoinvT3
-                        - beta2MX_coeff[4]*invT2;
-                    m_CphiMX_ij_LL[counterIJ] =
-                        + CphiMX_coeff[2]*2.0
-                        + CphiMX_coeff[3]*twoinvT3
-                        - CphiMX_coeff[4]*invT2;
-                    m_Theta_ij_LL[counterIJ] =
-                        + Theta_coeff[2]*2.0
-                        + Theta_coeff[3]*twoinvT3
-                        - Theta_coeff[4]*invT2;
+void HMWSoln::setupInteractions() const
+{
+    // Check if any of the temperature coefficients of an interaction is
+    // nonzero
+    auto nonzero = [](const Array2D& coeffs, size_t n) {
+        for (size_t m = 0; m < coeffs.nRows(); m++) {
+            if (coeffs(m, n) != 0.0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    m_pairsMX.clear();
+    m_pairsLike.clear();
+    m_pairsLambda.clear();
+    m_triplets.clear();
+    m_neutralsMu.clear();
+    for (size_t i = 1; i < m_kk; i++) {
+        for (size_t j = i+1; j < m_kk; j++) {
+            size_t c = m_CounterIJ[m_kk*i + j];
+            if (charge(i)*charge(j) < 0) {
+                if (nonzero(m_Beta0MX_ij_coeff, c) ||
+                    nonzero(m_Beta1MX_ij_coeff, c) ||
+                    nonzero(m_Beta2MX_ij_coeff, c) ||
+                    nonzero(m_CphiMX_ij_coeff, c)) {
+                    if (charge(i) > 0) {
+                        m_pairsMX.push_back({i, j, c});
+                    } else {
+                        m_pairsMX.push_back({j, i, c});
+                    }
+                }
+            } else if (charge(i)*charge(j) > 0) {
+                // E-theta is zero only for ions with the same charge
+                if (nonzero(m_Theta_ij_coeff, c) ||
+                    fabs(charge(i)) != fabs(charge(j))) {
+                    m_pairsLike.push_back({i, j, c});
                 }
-                break;
             }
         }
     }
 
-    // Lambda interactions and Mu_nnn
-    // i must be neutral for this term to be nonzero. We take advantage of this
-    // here to lower the operation count.
+    size_t kk2 = m_kk * m_kk;
     for (size_t i = 1; i < m_kk; i++) {
         if (charge(i) == 0.0) {
             for (size_t j = 1; j < m_kk; j++) {
-                size_t n = i * m_kk + j;
-                const double* Lambda_coeff = m_Lambda_nj_coeff.ptrColumn(n);
-                switch (m_formPitzerTemp) {
-                case PITZER_TEMP_CONSTANT:
-                    m_Lambda_nj(i,j) = Lambda_coeff[0];
-                    break;
-                case PITZER_TEMP_LINEAR:
-                    m_Lambda_nj(i,j) = Lambda_coeff[0] + Lambda_coeff[1]*tlin;
-                    m_Lambda_nj_L(i,j) = Lambda_coeff[1];
-                    m_Lambda_nj_LL(i,j) = 0.0;
-                    break;
-                case PITZER_TEMP_COMPLEX1:
-                    m_Lambda_nj(i,j) = Lambda_coeff[0]
-                                       + Lambda_coeff[1]*tlin
-                                       + Lambda_coeff[2]*tquad
-                                       + Lambda_coeff[3]*tinv
-                                       + Lambda_coeff[4]*tln;
-
-                    m_Lambda_nj_L(i,j) = Lambda_coeff[1]
-                                         + Lambda_coeff[2]*twoT
-                                         - Lambda_coeff[3]*invT2
-                                         + Lambda_coeff[4]*invT;
-
-                    m_Lambda_nj_LL(i,j) =
-                        Lambda_coeff[2]*2.0
-                        + Lambda_coeff[3]*twoinvT3
-                        - Lambda_coeff[4]*invT2;
+                if (nonzero(m_Lambda_nj_coeff, i * m_kk + j)) {
+                    m_pairsLambda.push_back({i, j, i * m_kk + j});
                 }
-
-                if (j == i) {
-                    const double* Mu_coeff = m_Mu_nnn_coeff.ptrColumn(i);
-                    switch (m_formPitzerTemp) {
-                    case PITZER_TEMP_CONSTANT:
-                        m_Mu_nnn[i] = Mu_coeff[0];
-                        break;
-                    case PITZER_TEMP_LINEAR:
-                        m_Mu_nnn[i] = Mu_coeff[0] + Mu_coeff[1]*tlin;
-                        m_Mu_nnn_L[i] = Mu_coeff[1];
-                        m_Mu_nnn_LL[i] = 0.0;
-                        break;
-                    case PITZER_TEMP_COMPLEX1:
-                        m_Mu_nnn[i] = Mu_coeff[0]
-                                      + Mu_coeff[1]*tlin
-                                      + Mu_coeff[2]*tquad
-                                      + Mu_coeff[3]*tinv
-                                      + Mu_coeff[4]*tln;
-                        m_Mu_nnn_L[i] = Mu_coeff[1]
-                                        + Mu_coeff[2]*twoT
-                                        - Mu_coeff[3]*invT2
-                                        + Mu_coeff[4]*invT;
-                        m_Mu_nnn_LL[i] =
-                            Mu_coeff[2]*2.0
-                            + Mu_coeff[3]*twoinvT3
-                            - Mu_coeff[4]*invT2;
+                if (charge(j) > 0) {
+                    for (size_t k = 1; k < m_kk; k++) {
+                        size_t n = i * kk2 + j * m_kk + k;
+                        if (charge(k) < 0 && nonzero(m_Psi_ijk_coeff, n)) {
+                            m_triplets.push_back({i, j, k, n});
+                        }
+                    }
+                }
+            }
+            if (nonzero(m_Mu_nnn_coeff, i)) {
+                m_neutralsMu.push_back(i);
+            }
+        } else {
+            for (size_t j = i+1; j < m_kk; j++) {
+                if (charge(i)*charge(j) <= 0) {
+                    continue;
+                }
+                for (size_t k = 1; k < m_kk; k++) {
+                    size_t n = i * kk2 + j * m_kk + k;
+                    if (charge(i)*charge(k) < 0 && nonzero(m_Psi_ijk_coeff, n)) {
+                        m_triplets.push_back({i, j, k, n});
                     }
                 }
             }
         }
     }
-
-    switch(m_formPitzerTemp) {
-    case PITZER_TEMP_CONSTANT:
-      for (size_t i = 1; i < m_kk; i++) {
-          for (size_t j = 1; j < m_kk; j++) {
-              for (size_t k = 1; k < m_kk; k++) {
-                  size_t n = i * m_kk *m_kk + j * m_kk + k;
-                  const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
-                  m_Psi_ijk[n] = Psi_coeff[0];
-              }
-          }
-      }
-      break;
-    case PITZER_TEMP_LINEAR:
-      for (size_t i = 1; i < m_kk; i++) {
-          for (size_t j = 1; j < m_kk; j++) {
-              for (size_t k = 1; k < m_kk; k++) {
-                  size_t n = i * m_kk *m_kk + j * m_kk + k;
-                  const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
-                  m_Psi_ijk[n] = Psi_coeff[0] + Psi_coeff[1]*tlin;
-                  m_Psi_ijk_L[n] = Psi_coeff[1];
-                  m_Psi_ijk_LL[n] = 0.0;
-              }
-          }
-      }
-      break;
-    case PITZER_TEMP_COMPLEX1:
-      for (size_t i = 1; i < m_kk; i++) {
-          for (size_t j = 1; j < m_kk; j++) {
-              for (size_t k = 1; k < m_kk; k++) {
-                  size_t n = i * m_kk *m_kk + j * m_kk + k;
-                  const double* Psi_coeff = m_Psi_ijk_coeff.ptrColumn(n);
-                  m_Psi_ijk[n] = Psi_coeff[0]
-                                 + Psi_coeff[1]*tlin
-                                 + Psi_coeff[2]*tquad
-                                 + Psi_coeff[3]*tinv
-                                 + Psi_coeff[4]*tln;
-                  m_Psi_ijk_L[n] = Psi_coeff[1]
-                                   + Psi_coeff[2]*twoT
-                                   - Psi_coeff[3]*invT2
-                                   + Psi_coeff[4]*invT;
-                  m_Psi_ijk_LL[n] =
-                      Psi_coeff[2]*2.0
-                      + Psi_coeff[3]*twoinvT3
-                      - Psi_coeff[4]*invT2;
-              }
-          }
-      }
-      break;
-    }
+    m_interactionsChanged = false;
 }
 
 void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
@@ -1898,13 +1818,6 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     // Use the CROPPED molality of the species in solution.
     const vector_fp& molality = m_molalitiesCropped;
 
-    // These are data inputs about the Pitzer correlation. They come from the
-    // input file for the Pitzer model.
-    vector_fp& gamma_Unscaled = m_gamma_tmp;
-
-    // Local variables defined by Coltrin
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-
     // Molality based ionic strength of the solution
     double Is = 0.0;
 
@@ -1916,9 +1829,6 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     // with zero charge.
     double molalitysumUncropped = 0.0;
 
-    // Make sure the counter variables are setup
-    counterIJ_setup();
-
     // ---------- Calculate common sums over solutes ---------------------
     for (size_t n = 1; n < m_kk; n++) {
         // ionic strength
@@ -1929,452 +1839,49 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     }
     Is *= 0.5;
 
-    // Store the ionic molality in the object for reference.
+    // Store the ionic molality and the molar charge in the object, for use in
+    // the derivative routines.
     m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
+    m_molarCharge = molarcharge;
+    double sqrtIs = sqrt(Is);
 
     // The following call to calc_lambdas() calculates all 16 elements of the
     // elambda and elambda1 arrays, given the value of the ionic strength (Is)
     calc_lambdas(Is);
 
-    // Step 2: Find the coefficients E-theta and E-thetaprime for all
-    // combinations of positive unlike charges up to 4
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-        }
-    }
-
     // calculate g(x) and hfunc(x) for each cation-anion pair MX. In the
     // original literature, hfunc, was called gprime. However, it's not the
-    // derivative of g(x), so I renamed it.
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // Only loop over oppositely charge species
-            if (charge(i)*charge(j) < 0) {
-                // x is a reduced function variable
-                double x1 = sqrtIs * m_Alpha1MX_ij[counterIJ];
-                if (x1 > 1.0E-100) {
-                    m_gfunc_IJ[counterIJ] = 2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    m_hfunc_IJ[counterIJ] = -2.0 *
-                                       (1.0-(1.0 + x1 + 0.5 * x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    m_gfunc_IJ[counterIJ] = 0.0;
-                    m_hfunc_IJ[counterIJ] = 0.0;
-                }
-
-                if (m_Beta2MX_ij[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * m_Alpha2MX_ij[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        m_g2func_IJ[counterIJ] = 2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        m_h2func_IJ[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        m_g2func_IJ[counterIJ] = 0.0;
-                        m_h2func_IJ[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                m_gfunc_IJ[counterIJ] = 0.0;
-                m_hfunc_IJ[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // SUBSECTION TO CALCULATE BMX, BprimeMX, BphiMX
-    // Agrees with Pitzer, Eq. (49), (51), (55)
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive and the
-            // other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_BMX_IJ[counterIJ] = m_Beta0MX_ij[counterIJ]
-                                  + m_Beta1MX_ij[counterIJ] * m_gfunc_IJ[counterIJ]
-                                  + m_Beta2MX_ij[counterIJ] * m_g2func_IJ[counterIJ];
-
-                if (Is > 1.0E-150) {
-                    m_BprimeMX_IJ[counterIJ] = (m_Beta1MX_ij[counterIJ] * m_hfunc_IJ[counterIJ]/Is +
-                                           m_Beta2MX_ij[counterIJ] * m_h2func_IJ[counterIJ]/Is);
-                } else {
-                    m_BprimeMX_IJ[counterIJ] = 0.0;
-                }
-                m_BphiMX_IJ[counterIJ] = m_BMX_IJ[counterIJ] + Is*m_BprimeMX_IJ[counterIJ];
-            } else {
-                m_BMX_IJ[counterIJ] = 0.0;
-                m_BprimeMX_IJ[counterIJ] = 0.0;
-                m_BphiMX_IJ[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // SUBSECTION TO CALCULATE CMX
-    // Agrees with Pitzer, Eq. (53).
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_CMX_IJ[counterIJ] = m_CphiMX_ij[counterIJ]/
-                                 (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                m_CMX_IJ[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi
-    // Agrees with Pitzer, Eq. 72, 73, 74
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive and the
-            // other is negative
-            if (charge(i)*charge(j) > 0) {
-                int z1 = (int) fabs(charge(i));
-                int z2 = (int) fabs(charge(j));
-                m_Phi_IJ[counterIJ] = m_Theta_ij[counterIJ] + etheta[z1][z2];
-                m_Phiprime_IJ[counterIJ] = etheta_prime[z1][z2];
-                m_PhiPhi_IJ[counterIJ] = m_Phi_IJ[counterIJ] + Is * m_Phiprime_IJ[counterIJ];
-            } else {
-                m_Phi_IJ[counterIJ] = 0.0;
-                m_Phiprime_IJ[counterIJ] = 0.0;
-                m_PhiPhi_IJ[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // SUBSECTION FOR CALCULATION OF F
-    // Agrees with Pitzer Eqn. (65)
-    double Aphi = A_Debye_TP() / 3.0;
-    double F = -Aphi * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                 + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive and the
-            // other is negative
-            if (charge(i)*charge(j) < 0) {
-                F += molality[i]*molality[j] * m_BprimeMX_IJ[counterIJ];
-            }
-
-            // Both species have a non-zero charge, and they
-            // have the same sign
-            if (charge(i)*charge(j) > 0) {
-                F += molality[i]*molality[j] * m_Phiprime_IJ[counterIJ];
-            }
-        }
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-
-        // SUBSECTION FOR CALCULATING THE ACTCOEFF FOR CATIONS
-        // equations agree with my notes, Eqn. (118).
-        // Equations agree with Pitzer, eqn.(63)
-        if (charge(i) > 0.0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqF = charge(i)*charge(i)*F;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 += molality[j] *
-                            (2.0*m_BMX_IJ[counterIJ] + molarcharge*m_CMX_IJ[counterIJ]);
-                    if (j < m_kk-1) {
-                        // This term is the ternary interaction involving the
-                        // non-duplicate sum over double anions, j, k, with
-                        // respect to the cation, i.
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk[n];
-                            }
-                        }
-                    }
-                }
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk[n];
-
-                            // Find the counterIJ for the j,k interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += (fabs(charge(i))*
-                                           molality[j]*molality[k]*m_CMX_IJ[counterIJ2]);
-                        }
-                    }
-                }
-
-                // Handle neutral j species
-                if (charge(j) == 0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj(j,i);
-
-                    // Zeta interaction term
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta = m_Psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum5 += molality[j]*molality[k]*zeta;
-                            }
-                        }
-                    }
-                }
-            }
-
-            // Add all of the contributions up to yield the log of the solute
-            // activity coefficients (molality scale)
-            m_lnActCoeffMolal_Unscaled[i] = zsqF + sum1 + sum2 + sum3 + sum4 + sum5;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
-        }
-
-        // SUBSECTION FOR CALCULATING THE ACTCOEFF FOR ANIONS
-        // equations agree with my notes, Eqn. (119).
-        // Equations agree with Pitzer, eqn.(64)
-        if (charge(i) < 0) {
-            // species i is an anion (negative)
-            double zsqF = charge(i)*charge(i)*F;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                // For Anions, do the cation interactions.
-                if (charge(j) > 0) {
-                    sum1 += molality[j]*
-                           (2.0*m_BMX_IJ[counterIJ]+molarcharge*m_CMX_IJ[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk[n];
-                            }
-                        }
-                    }
-                }
-
-                // For Anions, do the other anion interactions.
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk[n];
-                            // Find the counterIJ for the symmetric binary interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += fabs(charge(i))*
-                                    molality[j]*molality[k]*m_CMX_IJ[counterIJ2];
-                        }
-                    }
-                }
-
-                // for Anions, do the neutral species interaction
-                if (charge(j) == 0.0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj(j,i);
-                    // Zeta interaction term
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta = m_Psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum5 += molality[j]*molality[k]*zeta;
-                            }
-                        }
-                    }
-                }
-            }
-            m_lnActCoeffMolal_Unscaled[i] = zsqF + sum1 + sum2 + sum3 + sum4 + sum5;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
+    // derivative of g(x), so I renamed it. These only depend on the ionic
+    // strength, and are shared with the derivative routines.
+    for (const auto& p : m_pairsMX) {
+        size_t counterIJ = p.counterIJ;
+        // x is a reduced function variable
+        double x1 = sqrtIs * m_Alpha1MX_ij[counterIJ];
+        if (x1 > 1.0E-100) {
+            m_gfunc_IJ[counterIJ] = 2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
+            m_hfunc_IJ[counterIJ] = -2.0 *
+                               (1.0-(1.0 + x1 + 0.5 * x1 * x1) * exp(-x1)) / (x1 * x1);
+        } else {
+            m_gfunc_IJ[counterIJ] = 0.0;
+            m_hfunc_IJ[counterIJ] = 0.0;
         }
 
-        // SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF
-        // equations agree with my notes,
-        // Equations agree with Pitzer,
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 += molality[j]*2.0*m_Lambda_nj(i,j);
-                // Zeta term -> we piggyback on the psi term
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*m_Psi_ijk[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i]* molality[i] * m_Mu_nnn[i];
-            m_lnActCoeffMolal_Unscaled[i] = sum1 + sum2 + sum3;
-            gamma_Unscaled[i] = exp(m_lnActCoeffMolal_Unscaled[i]);
+        double x2 = sqrtIs * m_Alpha2MX_ij[counterIJ];
+        if (x2 > 1.0E-100) {
+            m_g2func_IJ[counterIJ] = 2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
+            m_h2func_IJ[counterIJ] = -2.0 *
+                                (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
+        } else {
+            m_g2func_IJ[counterIJ] = 0.0;
+            m_h2func_IJ[counterIJ] = 0.0;
         }
     }
 
-    // SUBSECTION FOR CALCULATING THE OSMOTIC COEFF
-    // equations agree with my notes, Eqn. (117).
-    // Equations agree with Pitzer, eqn.(62)
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-
-    // term1 is the DH term in the osmotic coefficient expression
-    // b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer
-    //                          implementations.
-    // Is = Ionic strength on the molality scale (units of (gmol/kg))
-    // Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-    double term1 = -Aphi * pow(Is,1.5) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        // Loop Over Cations
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 += molality[j]*molality[k]*
-                            (m_BphiMX_IJ[counterIJ] + molarcharge*m_CMX_IJ[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_lnMolalityActCoeff",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between 2 cations.
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 += molality[j]*molality[k]*m_PhiPhi_IJ[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*molality[m]*m_Psi_ijk[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        // Loop Over Anions
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_lnMolalityActCoeff",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between two anions
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum3 += molality[j]*molality[k]*m_PhiPhi_IJ[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*molality[m]*m_Psi_ijk[n];
-                        }
-                    }
-                }
-            }
-        }
+    double sum_m_phi_minus_1 = s_updatePitzer_sums(
+        m_Beta0MX_ij, m_Beta1MX_ij, m_Beta2MX_ij, m_CphiMX_ij, m_Theta_ij,
+        m_Psi_ijk, m_Lambda_nj, m_Mu_nnn, A_Debye_TP() / 3.0, true,
+        m_lnActCoeffMolal_Unscaled);
 
-        // Loop Over Neutral Species
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 += molality[j]*molality[k]*m_Lambda_nj(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 += molality[j]*molality[k]*m_Lambda_nj(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 += molality[j]*molality[k]*m_Lambda_nj(j,k);
-                    } else if (k == j) {
-                        sum6 += 0.5 * molality[j]*molality[k]*m_Lambda_nj(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta = m_Psi_ijk[n];
-                            if (zeta != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta;
-                            }
-                        }
-                    }
-                }
-            }
-            sum7 += molality[j]*molality[j]*molality[j]*m_Mu_nnn[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
     // Calculate the osmotic coefficient from
     //     osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
     double osmotic_coef;
@@ -2396,6 +1903,108 @@ void HMWSoln::s_updatePitzer_lnMolalityActCoeff() const
     m_lnActCoeffMolal_Unscaled[0] = lnwateract - log(xx);
 }
 
+double HMWSoln::s_updatePitzer_sums(const vector_fp& beta0,
+    const vector_fp& beta1, const vector_fp& beta2, const vector_fp& Cphi,
+    const vector_fp& theta, const vector_fp& psi, const Array2D& lambda,
+    const vector_fp& mu, double Aphi, bool etheta, vector_fp& lnGamma) const
+{
+    const vector_fp& molality = m_molalitiesCropped;
+    double Is = m_IionicMolality;
+    double sqrtIs = sqrt(Is);
+    double molarcharge = m_molarCharge;
+    for (size_t k = 1; k < m_kk; k++) {
+        lnGamma[k] = 0.0;
+    }
+
+    // Debye-Huckel parts of F, Pitzer Eqn. (65), and of the osmotic
+    // coefficient, Pitzer Eqn. (62), where b = 1.2 sqrt(kg/gmol) is
+    // arbitrarily set in all Pitzer implementations.
+    double F = -Aphi * (sqrtIs / (1.0 + 1.2*sqrtIs)
+                 + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
+    double sum_m_phi = -Aphi * Is * sqrtIs / (1.0 + 1.2 * sqrtIs);
+
+    // Cation-anion interactions, using BMX, BprimeMX, BphiMX and CMX, from
+    // Pitzer, Eqs. (49), (51), (53) and (55). sumCMX is the sum of
+    // m_M m_X CMX over all pairs, which contributes to the activity
+    // coefficients of all ions.
+    double sumCMX = 0.0;
+    for (const auto& p : m_pairsMX) {
+        size_t c = p.counterIJ;
+        double BMX = beta0[c] + beta1[c] * m_gfunc_IJ[c]
+                     + beta2[c] * m_g2func_IJ[c];
+        double BprimeMX = 0.0;
+        if (Is > 1.0E-150) {
+            BprimeMX = (beta1[c] * m_hfunc_IJ[c] + beta2[c] * m_h2func_IJ[c]) / Is;
+        }
+        double BphiMX = BMX + Is * BprimeMX;
+        double CMX = Cphi[c] / (2.0 * sqrt(fabs(charge(p.i) * charge(p.j))));
+        double mm = molality[p.i] * molality[p.j];
+        F += mm * BprimeMX;
+        sumCMX += mm * CMX;
+        sum_m_phi += mm * (BphiMX + molarcharge * CMX);
+        lnGamma[p.i] += molality[p.j] * (2.0 * BMX + molarcharge * CMX);
+        lnGamma[p.j] += molality[p.i] * (2.0 * BMX + molarcharge * CMX);
+    }
+
+    // Interactions between ions of like sign, using Phi, Phiprime and PhiPhi
+    // from Pitzer, Eqs. (72), (73) and (74).
+    for (const auto& p : m_pairsLike) {
+        double Phi = theta[p.counterIJ];
+        double Phiprime = 0.0;
+        if (etheta) {
+            double eth, eth_prime;
+            calc_thetas(static_cast<int>(fabs(charge(p.i))),
+                        static_cast<int>(fabs(charge(p.j))), &eth, &eth_prime);
+            Phi += eth;
+            Phiprime = eth_prime;
+        }
+        double mm = molality[p.i] * molality[p.j];
+        F += mm * Phiprime;
+        sum_m_phi += mm * (Phi + Is * Phiprime);
+        lnGamma[p.i] += 2.0 * molality[p.j] * Phi;
+        lnGamma[p.j] += 2.0 * molality[p.i] * Phi;
+    }
+
+    // Ternary interactions: Psi between three ions, and Zeta between a
+    // neutral species, a cation and an anion
+    for (const auto& t : m_triplets) {
+        double psi_ijk = psi[t.n];
+        lnGamma[t.i] += molality[t.j] * molality[t.k] * psi_ijk;
+        lnGamma[t.j] += molality[t.i] * molality[t.k] * psi_ijk;
+        lnGamma[t.k] += molality[t.i] * molality[t.j] * psi_ijk;
+        sum_m_phi += molality[t.i] * molality[t.j] * molality[t.k] * psi_ijk;
+    }
+
+    // Interactions of the neutral species i with species j
+    for (const auto& p : m_pairsLambda) {
+        double lambda_ij = lambda(p.i, p.j);
+        double mm = molality[p.i] * molality[p.j];
+        lnGamma[p.i] += 2.0 * molality[p.j] * lambda_ij;
+        if (charge(p.j) != 0.0) {
+            lnGamma[p.j] += 2.0 * molality[p.i] * lambda_ij;
+            sum_m_phi += mm * lambda_ij;
+        } else if (p.j > p.i) {
+            sum_m_phi += mm * lambda_ij;
+        } else if (p.j == p.i) {
+            sum_m_phi += 0.5 * mm * lambda_ij;
+        }
+    }
+    for (size_t k : m_neutralsMu) {
+        double m2 = molality[k] * molality[k];
+        lnGamma[k] += 3.0 * m2 * mu[k];
+        sum_m_phi += m2 * molality[k] * mu[k];
+    }
+
+    // Terms in F and CMX which are common to all ions. Agrees with Pitzer,
+    // Eqs. (63) and (64).
+    for (size_t k = 1; k < m_kk; k++) {
+        if (charge(k) != 0.0) {
+            lnGamma[k] += charge(k) * charge(k) * F + fabs(charge(k)) * sumCMX;
+        }
+    }
+    return 2.0 * sum_m_phi;
+}
+
 void HMWSoln::s_update_dlnMolalityActCoeff_dT() const
 {
     static const int cacheId = m_cache.getId();
@@ -2426,1020 +2035,70 @@ void HMWSoln::s_update_dlnMolalityActCoeff_dT() const
 
 void HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT() const
 {
-    // It may be assumed that the Pitzer activity coefficient routine is called
-    // immediately preceding the calling of this routine. Therefore, some
-    // quantities do not need to be recalculated in this routine.
-
-    const vector_fp& molality = m_molalitiesCropped;
-    double* d_gamma_dT_Unscaled = m_gamma_tmp.data();
+    double sum_m_phi_minus_1 = s_updatePitzer_sums(
+        m_Beta0MX_ij_L, m_Beta1MX_ij_L, m_Beta2MX_ij_L, m_CphiMX_ij_L,
+        m_Theta_ij_L, m_Psi_ijk_L, m_Lambda_nj_L, m_Mu_nnn_L,
+        dA_DebyedT_TP() / 3.0, false, m_dlnActCoeffMolaldT_Unscaled);
 
-    // Local variables defined by Coltrin
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
+    // The derivative of the log of the water activity, which is also the
+    // derivative of the log of its activity coefficient
+    m_dlnActCoeffMolaldT_Unscaled[0] = -(m_weightSolvent/1000.0) * sum_m_phi_minus_1;
+}
 
-    // Molality based ionic strength of the solution
-    double Is = 0.0;
+void HMWSoln::s_update_d2lnMolalityActCoeff_dT2() const
+{
+    static const int cacheId = m_cache.getId();
+    CachedScalar cached = m_cache.getScalar(cacheId);
+    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
+        return;
+    }
 
-    // Molarcharge of the solution: In Pitzer's notation, this is his variable
-    // called "Z".
-    double molarcharge = 0.0;
+    // Zero the unscaled 2nd derivatives
+    m_d2lnActCoeffMolaldT2_Unscaled.assign(m_kk, 0.0);
 
-    // molalitysum is the sum of the molalities over all solutes, even those
-    // with zero charge.
-    double molalitysum = 0.0;
+    //! Calculate the unscaled 2nd derivatives
+    s_updatePitzer_d2lnMolalityActCoeff_dT2();
 
-    // Make sure the counter variables are setup
-    counterIJ_setup();
+    for (size_t k = 1; k < m_kk; k++) {
+        if (CROP_speciesCropped_[k] == 2) {
+            m_d2lnActCoeffMolaldT2_Unscaled[k] = 0.0;
+        }
+    }
 
-    // ---------- Calculate common sums over solutes ---------------------
-    for (size_t n = 1; n < m_kk; n++) {
-        // ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        // total molar charge
-        molarcharge += fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
+    if (CROP_speciesCropped_[0]) {
+        m_d2lnActCoeffMolaldT2_Unscaled[0] = 0.0;
     }
-    Is *= 0.5;
 
-    // Store the ionic molality in the object for reference.
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
+    // Scale the 2nd derivatives
+    s_updateScaling_pHScaling_dT2();
+}
 
-    // The following call to calc_lambdas() calculates all 16 elements of the
-    // elambda and elambda1 arrays, given the value of the ionic strength (Is)
-    calc_lambdas(Is);
+void HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2() const
+{
+    double sum_m_phi_minus_1 = s_updatePitzer_sums(
+        m_Beta0MX_ij_LL, m_Beta1MX_ij_LL, m_Beta2MX_ij_LL, m_CphiMX_ij_LL,
+        m_Theta_ij_LL, m_Psi_ijk_LL, m_Lambda_nj_LL, m_Mu_nnn_LL,
+        d2A_DebyedT2_TP() / 3.0, false, m_d2lnActCoeffMolaldT2_Unscaled);
 
-    // Step 2: Find the coefficients E-theta and E-thetaprime for all
-    // combinations of positive unlike charges up to 4
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-        }
-    }
+    // The second derivative of the log of the water activity, which is also
+    // the second derivative of the log of its activity coefficient
+    m_d2lnActCoeffMolaldT2_Unscaled[0] = -(m_weightSolvent/1000.0) * sum_m_phi_minus_1;
+}
 
-    // calculate g(x) and hfunc(x) for each cation-anion pair MX
-    // In the original literature, hfunc, was called gprime. However,
-    // it's not the derivative of g(x), so I renamed it.
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
+void HMWSoln::s_update_dlnMolalityActCoeff_dP() const
+{
+    static const int cacheId = m_cache.getId();
+    CachedScalar cached = m_cache.getScalar(cacheId);
+    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
+        return;
+    }
 
-            // Only loop over oppositely charge species
-            if (charge(i)*charge(j) < 0) {
-                // x is a reduced function variable
-                double x1 = sqrtIs * m_Alpha1MX_ij[counterIJ];
-                if (x1 > 1.0E-100) {
-                    m_gfunc_IJ[counterIJ] = 2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    m_hfunc_IJ[counterIJ] = -2.0 *
-                                       (1.0-(1.0 + x1 + 0.5 * x1 *x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    m_gfunc_IJ[counterIJ] = 0.0;
-                    m_hfunc_IJ[counterIJ] = 0.0;
-                }
+    m_dlnActCoeffMolaldP_Unscaled.assign(m_kk, 0.0);
+    s_updatePitzer_dlnMolalityActCoeff_dP();
 
-                if (m_Beta2MX_ij_L[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * m_Alpha2MX_ij[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        m_g2func_IJ[counterIJ] = 2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        m_h2func_IJ[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        m_g2func_IJ[counterIJ] = 0.0;
-                        m_h2func_IJ[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                m_gfunc_IJ[counterIJ] = 0.0;
-                m_hfunc_IJ[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // SUBSECTION TO CALCULATE BMX_L, BprimeMX_L, BphiMX_L
-    // These are now temperature derivatives of the previously calculated
-    // quantities.
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_BMX_IJ_L[counterIJ] = m_Beta0MX_ij_L[counterIJ]
-                                    + m_Beta1MX_ij_L[counterIJ] * m_gfunc_IJ[counterIJ]
-                                    + m_Beta2MX_ij_L[counterIJ] * m_gfunc_IJ[counterIJ];
-                if (Is > 1.0E-150) {
-                    m_BprimeMX_IJ_L[counterIJ] = (m_Beta1MX_ij_L[counterIJ] * m_hfunc_IJ[counterIJ]/Is +
-                                             m_Beta2MX_ij_L[counterIJ] * m_h2func_IJ[counterIJ]/Is);
-                } else {
-                    m_BprimeMX_IJ_L[counterIJ] = 0.0;
-                }
-                m_BphiMX_IJ_L[counterIJ] = m_BMX_IJ_L[counterIJ] + Is*m_BprimeMX_IJ_L[counterIJ];
-            } else {
-                m_BMX_IJ_L[counterIJ] = 0.0;
-                m_BprimeMX_IJ_L[counterIJ] = 0.0;
-                m_BphiMX_IJ_L[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // --------- SUBSECTION TO CALCULATE CMX_L ----------
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_CMX_IJ_L[counterIJ] = m_CphiMX_ij_L[counterIJ]/
-                                   (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                m_CMX_IJ_L[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) > 0) {
-                m_Phi_IJ_L[counterIJ] = m_Theta_ij_L[counterIJ];
-                m_Phiprime_IJ[counterIJ] = 0.0;
-                m_PhiPhi_IJ_L[counterIJ] = m_Phi_IJ_L[counterIJ] + Is * m_Phiprime_IJ[counterIJ];
-            } else {
-                m_Phi_IJ_L[counterIJ] = 0.0;
-                m_Phiprime_IJ[counterIJ] = 0.0;
-                m_PhiPhi_IJ_L[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // ----------- SUBSECTION FOR CALCULATION OF dFdT ---------------------
-    double dA_DebyedT = dA_DebyedT_TP();
-    double dAphidT = dA_DebyedT /3.0;
-    double dFdT = -dAphidT * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                       + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0) {
-                dFdT += molality[i]*molality[j] * m_BprimeMX_IJ_L[counterIJ];
-            }
-
-            // Both species have a non-zero charge, and they
-            // have the same sign, e.g., both positive or both negative.
-            if (charge(i)*charge(j) > 0) {
-                dFdT += molality[i]*molality[j] * m_Phiprime_IJ[counterIJ];
-            }
-        }
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-        // -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR CATIONS -----
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqdFdT = charge(i)*charge(i)*dFdT;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 += molality[j]*
-                            (2.0*m_BMX_IJ_L[counterIJ] + molarcharge*m_CMX_IJ_L[counterIJ]);
-                    if (j < m_kk-1) {
-                        // This term is the ternary interaction involving the
-                        // non-duplicate sum over double anions, j, k, with
-                        // respect to the cation, i.
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk_L[n];
-                            }
-                        }
-                    }
-                }
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ_L[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk_L[n];
-
-                            // Find the counterIJ for the j,k interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += fabs(charge(i))*
-                                    molality[j]*molality[k]*m_CMX_IJ_L[counterIJ2];
-                        }
-                    }
-                }
-
-                // Handle neutral j species
-                if (charge(j) == 0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj_L(j,i);
-                }
-
-                // Zeta interaction term
-                for (size_t k = 1; k < m_kk; k++) {
-                    if (charge(k) < 0.0) {
-                        size_t izeta = j;
-                        size_t jzeta = i;
-                        n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                        double zeta_L = m_Psi_ijk_L[n];
-                        if (zeta_L != 0.0) {
-                            sum5 += molality[j]*molality[k]*zeta_L;
-                        }
-                    }
-                }
-            }
-
-            // Add all of the contributions up to yield the log of the
-            // solute activity coefficients (molality scale)
-            m_dlnActCoeffMolaldT_Unscaled[i] =
-                zsqdFdT + sum1 + sum2 + sum3 + sum4 + sum5;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-        }
-
-        // ------ SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR ANIONS ------
-        if (charge(i) < 0) {
-            // species i is an anion (negative)
-            double zsqdFdT = charge(i)*charge(i)*dFdT;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                // For Anions, do the cation interactions.
-                if (charge(j) > 0) {
-                    sum1 += molality[j]*
-                            (2.0*m_BMX_IJ_L[counterIJ] + molarcharge*m_CMX_IJ_L[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk_L[n];
-                            }
-                        }
-                    }
-                }
-
-                // For Anions, do the other anion interactions.
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ_L[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk_L[n];
-                            // Find the counterIJ for the symmetric binary interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += fabs(charge(i)) *
-                                    molality[j]*molality[k]*m_CMX_IJ_L[counterIJ2];
-                        }
-                    }
-                }
-
-                // for Anions, do the neutral species interaction
-                if (charge(j) == 0.0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj_L(j,i);
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_L = m_Psi_ijk_L[n];
-                            if (zeta_L != 0.0) {
-                                sum5 += molality[j]*molality[k]*zeta_L;
-                            }
-                        }
-                    }
-                }
-            }
-            m_dlnActCoeffMolaldT_Unscaled[i] =
-                zsqdFdT + sum1 + sum2 + sum3 + sum4 + sum5;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-        }
-
-        // SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF
-        // equations agree with my notes,
-        // Equations agree with Pitzer,
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 += molality[j]*2.0*m_Lambda_nj_L(i,j);
-                // Zeta term -> we piggyback on the psi term
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*m_Psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_L[i];
-            m_dlnActCoeffMolaldT_Unscaled[i] = sum1 + sum2 + sum3;
-            d_gamma_dT_Unscaled[i] = exp(m_dlnActCoeffMolaldT_Unscaled[i]);
-        }
-    }
-
-    // ------ SUBSECTION FOR CALCULATING THE d OSMOTIC COEFF dT ---------
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-
-    // term1 is the temperature derivative of the DH term in the osmotic
-    // coefficient expression
-    // b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer implementations.
-    // Is = Ionic strength on the molality scale (units of (gmol/kg))
-    // Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-    double term1 = -dAphidT * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        // Loop Over Cations
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum1 += molality[j]*molality[k]*
-                            (m_BphiMX_IJ_L[counterIJ] + molarcharge*m_CMX_IJ_L[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between 2 cations.
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 += molality[j]*molality[k]*m_PhiPhi_IJ_L[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*molality[m]*m_Psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        // Loop Over Anions
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dT",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between two anions
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum3 += molality[j]*molality[k]*m_PhiPhi_IJ_L[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*molality[m]*m_Psi_ijk_L[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        // Loop Over Neutral Species
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 += molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 += molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 += molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                    } else if (k == j) {
-                        sum6 += 0.5 * molality[j]*molality[k]*m_Lambda_nj_L(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_L = m_Psi_ijk_L[n];
-                            if (zeta_L != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_L;
-                            }
-                        }
-                    }
-                }
-            }
-            sum7 += molality[j]*molality[j]*molality[j]*m_Mu_nnn_L[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    // Calculate the osmotic coefficient from
-    //     osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-    double d_osmotic_coef_dT;
-    if (molalitysum > 1.0E-150) {
-        d_osmotic_coef_dT = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d_osmotic_coef_dT = 0.0;
-    }
-
-    double d_lnwateract_dT = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef_dT;
-
-    // In Cantera, we define the activity coefficient of the solvent as
-    //
-    //     act_0 = actcoeff_0 * Xmol_0
-    //
-    // We have just computed act_0. However, this routine returns
-    //     ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-    m_dlnActCoeffMolaldT_Unscaled[0] = d_lnwateract_dT;
-}
-
-void HMWSoln::s_update_d2lnMolalityActCoeff_dT2() const
-{
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
-        return;
-    }
-
-    // Zero the unscaled 2nd derivatives
-    m_d2lnActCoeffMolaldT2_Unscaled.assign(m_kk, 0.0);
-
-    //! Calculate the unscaled 2nd derivatives
-    s_updatePitzer_d2lnMolalityActCoeff_dT2();
-
-    for (size_t k = 1; k < m_kk; k++) {
-        if (CROP_speciesCropped_[k] == 2) {
-            m_d2lnActCoeffMolaldT2_Unscaled[k] = 0.0;
-        }
-    }
-
-    if (CROP_speciesCropped_[0]) {
-        m_d2lnActCoeffMolaldT2_Unscaled[0] = 0.0;
-    }
-
-    // Scale the 2nd derivatives
-    s_updateScaling_pHScaling_dT2();
-}
-
-void HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2() const
-{
-    const double* molality = m_molalitiesCropped.data();
-
-    // Local variables defined by Coltrin
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-
-    // Molality based ionic strength of the solution
-    double Is = 0.0;
-
-    // Molarcharge of the solution: In Pitzer's notation, this is his variable
-    // called "Z".
-    double molarcharge = 0.0;
-
-    // molalitysum is the sum of the molalities over all solutes, even those
-    // with zero charge.
-    double molalitysum = 0.0;
-
-    // Make sure the counter variables are setup
-    counterIJ_setup();
-
-    // ---------- Calculate common sums over solutes ---------------------
-    for (size_t n = 1; n < m_kk; n++) {
-        // ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        // total molar charge
-        molarcharge += fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
-    }
-    Is *= 0.5;
-
-    // Store the ionic molality in the object for reference.
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-
-    // The following call to calc_lambdas() calculates all 16 elements of the
-    // elambda and elambda1 arrays, given the value of the ionic strength (Is)
-    calc_lambdas(Is);
-
-    // Step 2: Find the coefficients E-theta and E-thetaprime for all
-    // combinations of positive unlike charges up to 4
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-        }
-    }
-
-    // calculate gfunc(x) and hfunc(x) for each cation-anion pair MX. In the
-    // original literature, hfunc, was called gprime. However, it's not the
-    // derivative of gfunc(x), so I renamed it.
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // Only loop over oppositely charge species
-            if (charge(i)*charge(j) < 0) {
-                // x is a reduced function variable
-                double x1 = sqrtIs * m_Alpha1MX_ij[counterIJ];
-                if (x1 > 1.0E-100) {
-                    m_gfunc_IJ[counterIJ] = 2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 *x1);
-                    m_hfunc_IJ[counterIJ] = -2.0*
-                                       (1.0-(1.0 + x1 + 0.5*x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    m_gfunc_IJ[counterIJ] = 0.0;
-                    m_hfunc_IJ[counterIJ] = 0.0;
-                }
-
-                if (m_Beta2MX_ij_LL[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * m_Alpha2MX_ij[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        m_g2func_IJ[counterIJ] = 2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        m_h2func_IJ[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        m_g2func_IJ[counterIJ] = 0.0;
-                        m_h2func_IJ[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                m_gfunc_IJ[counterIJ] = 0.0;
-                m_hfunc_IJ[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // SUBSECTION TO CALCULATE BMX_L, BprimeMX_LL, BphiMX_L
-    // These are now temperature derivatives of the previously calculated
-    // quantities.
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_BMX_IJ_LL[counterIJ] = m_Beta0MX_ij_LL[counterIJ]
-                                     + m_Beta1MX_ij_LL[counterIJ] * m_gfunc_IJ[counterIJ]
-                                     + m_Beta2MX_ij_LL[counterIJ] * m_g2func_IJ[counterIJ];
-                if (Is > 1.0E-150) {
-                    m_BprimeMX_IJ_LL[counterIJ] = (m_Beta1MX_ij_LL[counterIJ] * m_hfunc_IJ[counterIJ]/Is +
-                                              m_Beta2MX_ij_LL[counterIJ] * m_h2func_IJ[counterIJ]/Is);
-                } else {
-                    m_BprimeMX_IJ_LL[counterIJ] = 0.0;
-                }
-                m_BphiMX_IJ_LL[counterIJ] = m_BMX_IJ_LL[counterIJ] + Is*m_BprimeMX_IJ_LL[counterIJ];
-            } else {
-                m_BMX_IJ_LL[counterIJ] = 0.0;
-                m_BprimeMX_IJ_LL[counterIJ] = 0.0;
-                m_BphiMX_IJ_LL[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // --------- SUBSECTION TO CALCULATE CMX_LL ----------
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_CMX_IJ_LL[counterIJ] = m_CphiMX_ij_LL[counterIJ]/
-                                    (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                m_CMX_IJ_LL[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) > 0) {
-                m_Phi_IJ_LL[counterIJ] = m_Theta_ij_LL[counterIJ];
-                m_Phiprime_IJ[counterIJ] = 0.0;
-                m_PhiPhi_IJ_LL[counterIJ] = m_Phi_IJ_LL[counterIJ];
-            } else {
-                m_Phi_IJ_LL[counterIJ] = 0.0;
-                m_Phiprime_IJ[counterIJ] = 0.0;
-                m_PhiPhi_IJ_LL[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // ----------- SUBSECTION FOR CALCULATION OF d2FdT2 ---------------------
-    double d2AphidT2 = d2A_DebyedT2_TP() / 3.0;
-    double d2FdT2 = -d2AphidT2 * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                           + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0) {
-                d2FdT2 += molality[i]*molality[j] * m_BprimeMX_IJ_LL[counterIJ];
-            }
-
-            // Both species have a non-zero charge, and they
-            // have the same sign, e.g., both positive or both negative.
-            if (charge(i)*charge(j) > 0) {
-                d2FdT2 += molality[i]*molality[j] * m_Phiprime_IJ[counterIJ];
-            }
-        }
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-        // -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdT FOR CATIONS -----
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqd2FdT2 = charge(i)*charge(i)*d2FdT2;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 += molality[j]*
-                            (2.0*m_BMX_IJ_LL[counterIJ] + molarcharge*m_CMX_IJ_LL[counterIJ]);
-                    if (j < m_kk-1) {
-                        // This term is the ternary interaction involving the
-                        // non-duplicate sum over double anions, j, k, with
-                        // respect to the cation, i.
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk_LL[n];
-                            }
-                        }
-                    }
-                }
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ_LL[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk_LL[n];
-
-                            // Find the counterIJ for the j,k interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += fabs(charge(i)) *
-                                    molality[j]*molality[k]*m_CMX_IJ_LL[counterIJ2];
-                        }
-                    }
-                }
-
-                // Handle neutral j species
-                if (charge(j) == 0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj_LL(j,i);
-                    // Zeta interaction term
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta_LL = m_Psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum5 += molality[j]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-            // Add all of the contributions up to yield the log of the
-            // solute activity coefficients (molality scale)
-            m_d2lnActCoeffMolaldT2_Unscaled[i] =
-                zsqd2FdT2 + sum1 + sum2 + sum3 + sum4 + sum5;
-        }
-
-        // ------ SUBSECTION FOR CALCULATING THE d2ACTCOEFFdT2 FOR ANIONS ------
-        if (charge(i) < 0) {
-            // species i is an anion (negative)
-            double zsqd2FdT2 = charge(i)*charge(i)*d2FdT2;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                // For Anions, do the cation interactions.
-                if (charge(j) > 0) {
-                    sum1 += molality[j]*
-                            (2.0*m_BMX_IJ_LL[counterIJ] + molarcharge*m_CMX_IJ_LL[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk_LL[n];
-                            }
-                        }
-                    }
-                }
-
-                // For Anions, do the other anion interactions.
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ_LL[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk_LL[n];
-                            // Find the counterIJ for the symmetric binary interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += fabs(charge(i)) *
-                                    molality[j]*molality[k]*m_CMX_IJ_LL[counterIJ2];
-                        }
-                    }
-                }
-
-                // for Anions, do the neutral species interaction
-                if (charge(j) == 0.0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj_LL(j,i);
-                    // Zeta interaction term
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_LL = m_Psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum5 += molality[j]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-            m_d2lnActCoeffMolaldT2_Unscaled[i] =
-                zsqd2FdT2 + sum1 + sum2 + sum3 + sum4 + sum5;
-        }
-
-        // SUBSECTION FOR CALCULATING NEUTRAL SOLUTE ACT COEFF
-        // equations agree with my notes,
-        // Equations agree with Pitzer,
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 += molality[j]*2.0*m_Lambda_nj_LL(i,j);
-                // Zeta term -> we piggyback on the psi term
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*m_Psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_LL[i];
-            m_d2lnActCoeffMolaldT2_Unscaled[i] = sum1 + sum2 + sum3;
-        }
-    }
-
-    // ------ SUBSECTION FOR CALCULATING THE d2 OSMOTIC COEFF dT2 ---------
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-
-    // term1 is the temperature derivative of the  DH term in the osmotic
-    // coefficient expression
-    // b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer implementations.
-    // Is = Ionic strength on the molality scale (units of (gmol/kg))
-    // Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-    double term1 = -d2AphidT2 * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        // Loop Over Cations
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum1 += molality[j]*molality[k] *
-                            (m_BphiMX_IJ_LL[counterIJ] + molarcharge*m_CMX_IJ_LL[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between 2 cations.
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 += molality[j]*molality[k]*m_PhiPhi_IJ_LL[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*molality[m]*m_Psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        // Loop Over Anions
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_d2lnMolalityActCoeff_dT2",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between two anions
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 += molality[j]*molality[k]*m_PhiPhi_IJ_LL[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*molality[m]*m_Psi_ijk_LL[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        // Loop Over Neutral Species
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 += molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 += molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 += molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                    } else if (k == j) {
-                        sum6 += 0.5 * molality[j]*molality[k]*m_Lambda_nj_LL(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_LL = m_Psi_ijk_LL[n];
-                            if (zeta_LL != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_LL;
-                            }
-                        }
-                    }
-                }
-            }
-
-            sum7 += molality[j] * molality[j] * molality[j] * m_Mu_nnn_LL[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-    // Calculate the osmotic coefficient from
-    //     osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-    double d2_osmotic_coef_dT2;
-    if (molalitysum > 1.0E-150) {
-        d2_osmotic_coef_dT2 = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d2_osmotic_coef_dT2 = 0.0;
-    }
-    double d2_lnwateract_dT2 = -(m_weightSolvent/1000.0) * molalitysum * d2_osmotic_coef_dT2;
-
-    // In Cantera, we define the activity coefficient of the solvent as
-    //
-    //     act_0 = actcoeff_0 * Xmol_0
-    //
-    // We have just computed act_0. However, this routine returns
-    //     ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-    m_d2lnActCoeffMolaldT2_Unscaled[0] = d2_lnwateract_dT2;
-}
-
-void HMWSoln::s_update_dlnMolalityActCoeff_dP() const
-{
-    static const int cacheId = m_cache.getId();
-    CachedScalar cached = m_cache.getScalar(cacheId);
-    if( cached.validate(temperature(), pressure(), stateMFNumber()) ) {
-        return;
-    }
-
-    m_dlnActCoeffMolaldP_Unscaled.assign(m_kk, 0.0);
-    s_updatePitzer_dlnMolalityActCoeff_dP();
-
-    for (size_t k = 1; k < m_kk; k++) {
-        if (CROP_speciesCropped_[k] == 2) {
-            m_dlnActCoeffMolaldP_Unscaled[k] = 0.0;
+    for (size_t k = 1; k < m_kk; k++) {
+        if (CROP_speciesCropped_[k] == 2) {
+            m_dlnActCoeffMolaldP_Unscaled[k] = 0.0;
         }
     }
 
@@ -3452,487 +2111,14 @@ void HMWSoln::s_update_dlnMolalityActCoeff_dP() const
 
 void HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP() const
 {
-    const double* molality = m_molalitiesCropped.data();
-
-    // Local variables defined by Coltrin
-    double etheta[5][5], etheta_prime[5][5], sqrtIs;
-
-    // Molality based ionic strength of the solution
-    double Is = 0.0;
-
-    // Molarcharge of the solution: In Pitzer's notation, this is his variable
-    // called "Z".
-    double molarcharge = 0.0;
-
-    // molalitysum is the sum of the molalities over all solutes, even those
-    // with zero charge.
-    double molalitysum = 0.0;
-    double currTemp = temperature();
-    double currPres = pressure();
-
-    // Make sure the counter variables are setup
-    counterIJ_setup();
-
-    // ---------- Calculate common sums over solutes ---------------------
-    for (size_t n = 1; n < m_kk; n++) {
-        // ionic strength
-        Is += charge(n) * charge(n) * molality[n];
-        // total molar charge
-        molarcharge += fabs(charge(n)) * molality[n];
-        molalitysum += molality[n];
-    }
-    Is *= 0.5;
-
-    // Store the ionic molality in the object for reference.
-    m_IionicMolality = Is;
-    sqrtIs = sqrt(Is);
-
-    // The following call to calc_lambdas() calculates all 16 elements of the
-    // elambda and elambda1 arrays, given the value of the ionic strength (Is)
-    calc_lambdas(Is);
-
-    // Step 2: Find the coefficients E-theta and E-thetaprime for all
-    // combinations of positive unlike charges up to 4
-    for (int z1 = 1; z1 <=4; z1++) {
-        for (int z2 =1; z2 <=4; z2++) {
-            calc_thetas(z1, z2, &etheta[z1][z2], &etheta_prime[z1][z2]);
-        }
-    }
-
-    // calculate g(x) and hfunc(x) for each cation-anion pair MX
-    // In the original literature, hfunc, was called gprime. However,
-    // it's not the derivative of g(x), so I renamed it.
-    for (size_t i = 1; i < (m_kk - 1); i++) {
-        for (size_t j = (i+1); j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // Only loop over oppositely charge species
-            if (charge(i)*charge(j) < 0) {
-                // x is a reduced function variable
-                double x1 = sqrtIs * m_Alpha1MX_ij[counterIJ];
-                if (x1 > 1.0E-100) {
-                    m_gfunc_IJ[counterIJ] = 2.0*(1.0-(1.0 + x1) * exp(-x1)) / (x1 * x1);
-                    m_hfunc_IJ[counterIJ] = -2.0*
-                                       (1.0-(1.0 + x1 + 0.5 * x1 * x1) * exp(-x1)) / (x1 * x1);
-                } else {
-                    m_gfunc_IJ[counterIJ] = 0.0;
-                    m_hfunc_IJ[counterIJ] = 0.0;
-                }
+    double sum_m_phi_minus_1 = s_updatePitzer_sums(
+        m_Beta0MX_ij_P, m_Beta1MX_ij_P, m_Beta2MX_ij_P, m_CphiMX_ij_P,
+        m_Theta_ij_P, m_Psi_ijk_P, m_Lambda_nj_P, m_Mu_nnn_P,
+        dA_DebyedP_TP() / 3.0, false, m_dlnActCoeffMolaldP_Unscaled);
 
-                if (m_Beta2MX_ij_P[counterIJ] != 0.0) {
-                    double x2 = sqrtIs * m_Alpha2MX_ij[counterIJ];
-                    if (x2 > 1.0E-100) {
-                        m_g2func_IJ[counterIJ] = 2.0*(1.0-(1.0 + x2) * exp(-x2)) / (x2 * x2);
-                        m_h2func_IJ[counterIJ] = -2.0 *
-                                            (1.0-(1.0 + x2 + 0.5 * x2 * x2) * exp(-x2)) / (x2 * x2);
-                    } else {
-                        m_g2func_IJ[counterIJ] = 0.0;
-                        m_h2func_IJ[counterIJ] = 0.0;
-                    }
-                }
-            } else {
-                m_gfunc_IJ[counterIJ] = 0.0;
-                m_hfunc_IJ[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // SUBSECTION TO CALCULATE BMX_P, BprimeMX_P, BphiMX_P
-    // These are now temperature derivatives of the previously calculated
-    // quantities.
-    for (size_t i = 1; i < m_kk - 1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_BMX_IJ_P[counterIJ] = m_Beta0MX_ij_P[counterIJ]
-                                    + m_Beta1MX_ij_P[counterIJ] * m_gfunc_IJ[counterIJ]
-                                    + m_Beta2MX_ij_P[counterIJ] * m_g2func_IJ[counterIJ];
-                if (Is > 1.0E-150) {
-                    m_BprimeMX_IJ_P[counterIJ] = (m_Beta1MX_ij_P[counterIJ] * m_hfunc_IJ[counterIJ]/Is +
-                                             m_Beta2MX_ij_P[counterIJ] * m_h2func_IJ[counterIJ]/Is);
-                } else {
-                    m_BprimeMX_IJ_P[counterIJ] = 0.0;
-                }
-                m_BphiMX_IJ_P[counterIJ] = m_BMX_IJ_P[counterIJ] + Is*m_BprimeMX_IJ_P[counterIJ];
-            } else {
-                m_BMX_IJ_P[counterIJ] = 0.0;
-                m_BprimeMX_IJ_P[counterIJ] = 0.0;
-                m_BphiMX_IJ_P[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // --------- SUBSECTION TO CALCULATE CMX_P ----------
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0.0) {
-                m_CMX_IJ_P[counterIJ] = m_CphiMX_ij_P[counterIJ]/
-                                   (2.0* sqrt(fabs(charge(i)*charge(j))));
-            } else {
-                m_CMX_IJ_P[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // ------- SUBSECTION TO CALCULATE Phi, PhiPrime, and PhiPhi ----------
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) > 0) {
-                m_Phi_IJ_P[counterIJ] = m_Theta_ij_P[counterIJ];
-                m_Phiprime_IJ[counterIJ] = 0.0;
-                m_PhiPhi_IJ_P[counterIJ] = m_Phi_IJ_P[counterIJ] + Is * m_Phiprime_IJ[counterIJ];
-            } else {
-                m_Phi_IJ_P[counterIJ] = 0.0;
-                m_Phiprime_IJ[counterIJ] = 0.0;
-                m_PhiPhi_IJ_P[counterIJ] = 0.0;
-            }
-        }
-    }
-
-    // ----------- SUBSECTION FOR CALCULATION OF dFdT ---------------------
-    double dA_DebyedP = dA_DebyedP_TP(currTemp, currPres);
-    double dAphidP = dA_DebyedP /3.0;
-    double dFdP = -dAphidP * (sqrt(Is) / (1.0 + 1.2*sqrt(Is))
-                       + (2.0/1.2) * log(1.0+1.2*(sqrtIs)));
-    for (size_t i = 1; i < m_kk-1; i++) {
-        for (size_t j = i+1; j < m_kk; j++) {
-            // Find the counterIJ for the symmetric binary interaction
-            size_t n = m_kk*i + j;
-            size_t counterIJ = m_CounterIJ[n];
-
-            // both species have a non-zero charge, and one is positive
-            // and the other is negative
-            if (charge(i)*charge(j) < 0) {
-                dFdP += molality[i]*molality[j] * m_BprimeMX_IJ_P[counterIJ];
-            }
-
-            // Both species have a non-zero charge, and they
-            // have the same sign, e.g., both positive or both negative.
-            if (charge(i)*charge(j) > 0) {
-                dFdP += molality[i]*molality[j] * m_Phiprime_IJ[counterIJ];
-            }
-        }
-    }
-
-    for (size_t i = 1; i < m_kk; i++) {
-        // -------- SUBSECTION FOR CALCULATING THE dACTCOEFFdP FOR CATIONS -----
-        if (charge(i) > 0) {
-            // species i is the cation (positive) to calc the actcoeff
-            double zsqdFdP = charge(i)*charge(i)*dFdP;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                if (charge(j) < 0.0) {
-                    // sum over all anions
-                    sum1 += molality[j]*
-                            (2.0*m_BMX_IJ_P[counterIJ] + molarcharge*m_CMX_IJ_P[counterIJ]);
-                    if (j < m_kk-1) {
-                        // This term is the ternary interaction involving the
-                        // non-duplicate sum over double anions, j, k, with
-                        // respect to the cation, i.
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all anions
-                            if (charge(k) < 0.0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk_P[n];
-                            }
-                        }
-                    }
-                }
-
-                if (charge(j) > 0.0) {
-                    // sum over all cations
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ_P[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            // two inner sums over anions
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk_P[n];
-
-                            // Find the counterIJ for the j,k interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += fabs(charge(i)) *
-                                    molality[j]*molality[k]*m_CMX_IJ_P[counterIJ2];
-                        }
-                    }
-                }
-
-                // for Anions, do the neutral species interaction
-                if (charge(j) == 0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj_P(j,i);
-                    // Zeta interaction term
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + k;
-                            double zeta_P = m_Psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum5 += molality[j]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-
-            // Add all of the contributions up to yield the log of the
-            // solute activity coefficients (molality scale)
-            m_dlnActCoeffMolaldP_Unscaled[i] =
-                zsqdFdP + sum1 + sum2 + sum3 + sum4 + sum5;
-        }
-
-        // ------ SUBSECTION FOR CALCULATING THE dACTCOEFFdP FOR ANIONS ------
-        if (charge(i) < 0) {
-            // species i is an anion (negative)
-            double zsqdFdP = charge(i)*charge(i)*dFdP;
-            double sum1 = 0.0;
-            double sum2 = 0.0;
-            double sum3 = 0.0;
-            double sum4 = 0.0;
-            double sum5 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                // Find the counterIJ for the symmetric binary interaction
-                size_t n = m_kk*i + j;
-                size_t counterIJ = m_CounterIJ[n];
-
-                // For Anions, do the cation interactions.
-                if (charge(j) > 0) {
-                    sum1 += molality[j] *
-                            (2.0*m_BMX_IJ_P[counterIJ] + molarcharge*m_CMX_IJ_P[counterIJ]);
-                    if (j < m_kk-1) {
-                        for (size_t k = j+1; k < m_kk; k++) {
-                            // an inner sum over all cations
-                            if (charge(k) > 0) {
-                                n = k + j * m_kk + i * m_kk * m_kk;
-                                sum3 += molality[j]*molality[k]*m_Psi_ijk_P[n];
-                            }
-                        }
-                    }
-                }
-
-                // For Anions, do the other anion interactions.
-                if (charge(j) < 0.0) {
-                    //  sum over all anions
-                    if (j != i) {
-                        sum2 += molality[j]*(2.0*m_Phi_IJ_P[counterIJ]);
-                    }
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            // two inner sums over cations
-                            n = k + j * m_kk + i * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*m_Psi_ijk_P[n];
-                            // Find the counterIJ for the symmetric binary interaction
-                            n = m_kk*j + k;
-                            size_t counterIJ2 = m_CounterIJ[n];
-                            sum4 += fabs(charge(i))*
-                                    molality[j]*molality[k]*m_CMX_IJ_P[counterIJ2];
-                        }
-                    }
-                }
-
-                // for Anions, do the neutral species interaction
-                if (charge(j) == 0.0) {
-                    sum5 += molality[j]*2.0*m_Lambda_nj_P(j,i);
-                    // Zeta interaction term
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) > 0.0) {
-                            size_t izeta = j;
-                            size_t jzeta = k;
-                            size_t kzeta = i;
-                            n = izeta * m_kk * m_kk + jzeta * m_kk + kzeta;
-                            double zeta_P = m_Psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum5 += molality[j]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-            m_dlnActCoeffMolaldP_Unscaled[i] =
-                zsqdFdP + sum1 + sum2 + sum3 + sum4 + sum5;
-        }
-
-        // ------ SUBSECTION FOR CALCULATING d NEUTRAL SOLUTE ACT COEFF dP -----
-        if (charge(i) == 0.0) {
-            double sum1 = 0.0;
-            double sum3 = 0.0;
-            for (size_t j = 1; j < m_kk; j++) {
-                sum1 += molality[j]*2.0*m_Lambda_nj_P(i,j);
-                // Zeta term -> we piggyback on the psi term
-                if (charge(j) > 0.0) {
-                    for (size_t k = 1; k < m_kk; k++) {
-                        if (charge(k) < 0.0) {
-                            size_t n = k + j * m_kk + i * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*m_Psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-            double sum2 = 3.0 * molality[i] * molality[i] * m_Mu_nnn_P[i];
-            m_dlnActCoeffMolaldP_Unscaled[i] = sum1 + sum2 + sum3;
-        }
-    }
-
-    // ------ SUBSECTION FOR CALCULATING THE d OSMOTIC COEFF dP ---------
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    double sum3 = 0.0;
-    double sum4 = 0.0;
-    double sum5 = 0.0;
-    double sum6 = 0.0;
-    double sum7 = 0.0;
-
-    // term1 is the temperature derivative of the DH term in the osmotic
-    // coefficient expression
-    // b = 1.2 sqrt(kg/gmol) <- arbitrarily set in all Pitzer implementations.
-    // Is = Ionic strength on the molality scale (units of (gmol/kg))
-    // Aphi = A_Debye / 3   (units of sqrt(kg/gmol))
-    double term1 = -dAphidP * Is * sqrt(Is) / (1.0 + 1.2 * sqrt(Is));
-
-    for (size_t j = 1; j < m_kk; j++) {
-        // Loop Over Cations
-        if (charge(j) > 0.0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum1 += molality[j]*molality[k]*
-                            (m_BphiMX_IJ_P[counterIJ] + molarcharge*m_CMX_IJ_P[counterIJ]);
-                }
-            }
-
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == (m_kk-1)) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                                       "logic error 1 in Step 9 of hmw_act");
-                }
-                if (charge(k) > 0.0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between 2 cations.
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-                    sum2 += molality[j]*molality[k]*m_PhiPhi_IJ_P[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) < 0.0) {
-                            // species m is an anion
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum2 += molality[j]*molality[k]*molality[m]*m_Psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        // Loop Over Anions
-        if (charge(j) < 0) {
-            for (size_t k = j+1; k < m_kk; k++) {
-                if (j == m_kk-1) {
-                    // we should never reach this step
-                    throw CanteraError("HMWSoln::s_updatePitzer_dlnMolalityActCoeff_dP",
-                                       "logic error 2 in Step 9 of hmw_act");
-                }
-                if (charge(k) < 0) {
-                    // Find the counterIJ for the symmetric j,k binary interaction
-                    // between two anions
-                    size_t n = m_kk*j + k;
-                    size_t counterIJ = m_CounterIJ[n];
-
-                    sum3 += molality[j]*molality[k]*m_PhiPhi_IJ_P[counterIJ];
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            n = m + k * m_kk + j * m_kk * m_kk;
-                            sum3 += molality[j]*molality[k]*molality[m]*m_Psi_ijk_P[n];
-                        }
-                    }
-                }
-            }
-        }
-
-        // Loop Over Neutral Species
-        if (charge(j) == 0) {
-            for (size_t k = 1; k < m_kk; k++) {
-                if (charge(k) < 0.0) {
-                    sum4 += molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                }
-                if (charge(k) > 0.0) {
-                    sum5 += molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                }
-                if (charge(k) == 0.0) {
-                    if (k > j) {
-                        sum6 += molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                    } else if (k == j) {
-                        sum6 += 0.5 * molality[j]*molality[k]*m_Lambda_nj_P(j,k);
-                    }
-                }
-                if (charge(k) < 0.0) {
-                    size_t izeta = j;
-                    for (size_t m = 1; m < m_kk; m++) {
-                        if (charge(m) > 0.0) {
-                            size_t jzeta = m;
-                            size_t n = k + jzeta * m_kk + izeta * m_kk * m_kk;
-                            double zeta_P = m_Psi_ijk_P[n];
-                            if (zeta_P != 0.0) {
-                                sum7 += molality[izeta]*molality[jzeta]*molality[k]*zeta_P;
-                            }
-                        }
-                    }
-                }
-            }
-
-            sum7 += molality[j] * molality[j] * molality[j] * m_Mu_nnn_P[j];
-        }
-    }
-    double sum_m_phi_minus_1 = 2.0 *
-                        (term1 + sum1 + sum2 + sum3 + sum4 + sum5 + sum6 + sum7);
-
-    // Calculate the osmotic coefficient from
-    //     osmotic_coeff = 1 + dGex/d(M0noRT) / sum(molality_i)
-    double d_osmotic_coef_dP;
-    if (molalitysum > 1.0E-150) {
-        d_osmotic_coef_dP = 0.0 + (sum_m_phi_minus_1 / molalitysum);
-    } else {
-        d_osmotic_coef_dP = 0.0;
-    }
-    double d_lnwateract_dP = -(m_weightSolvent/1000.0) * molalitysum * d_osmotic_coef_dP;
-
-    // In Cantera, we define the activity coefficient of the solvent as
-    //
-    //     act_0 = actcoeff_0 * Xmol_0
-    //
-    // We have just computed act_0. However, this routine returns
-    //     ln(actcoeff[]). Therefore, we must calculate ln(actcoeff_0).
-    m_dlnActCoeffMolaldP_Unscaled[0] = d_lnwateract_dP;
+    // The derivative of the log of the water activity, which is also the
+    // derivative of the log of its activity coefficient
+    m_dlnActCoeffMolaldP_Unscaled[0] = -(m_weightSolvent/1000.0) * sum_m_phi_minus_1;
 }
 
 void HMWSoln::calc_lambdas(double is) const
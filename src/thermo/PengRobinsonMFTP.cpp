@@ -0,0 +1,1046 @@
+//! @file PengRobinsonMFTP.cpp
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/thermo/PengRobinsonMFTP.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/base/stringUtils.h"
+#include "cantera/base/ctml.h"
+
+#include <boost/math/tools/roots.hpp>
+
+#include <algorithm>
+
+using namespace std;
+namespace bmt = boost::math::tools;
+
+namespace Cantera
+{
+
+const doublereal PengRobinsonMFTP::omega_a = 4.5723552892138218E-01;
+const doublereal PengRobinsonMFTP::omega_b = 7.77960739038885E-02;
+const doublereal PengRobinsonMFTP::omega_vc = 3.07401308698703833E-01;
+
+namespace
+{
+const double Sqrt2 = 1.41421356237309504880;
+
+//! Integral of \f$ 1 / (v^2 + 2 b v - b^2) \f$ from *v* to infinity, which
+//! appears in all of the departure functions
+double logTerm(double v, double b)
+{
+    if (b <= 0.0) {
+        return 1.0 / v;
+    }
+    return log((v + (1.0 + Sqrt2) * b) / (v + (1.0 - Sqrt2) * b))
+           / (2.0 * Sqrt2 * b);
+}
+}
+
+PengRobinsonMFTP::PengRobinsonMFTP() :
+    m_b_current(0.0),
+    m_a_current(0.0),
+    m_dadT_current(0.0),
+    m_d2adT2_current(0.0),
+    m_mixStateNum(-2),
+    NSolns_(0),
+    dpdV_(0.0),
+    dpdT_(0.0)
+{
+    fill_n(m_aCoeffs, 3, 0.0);
+    fill_n(Vroot_, 3, 0.0);
+}
+
+PengRobinsonMFTP::PengRobinsonMFTP(const std::string& infile, const std::string& id_) :
+    m_b_current(0.0),
+    m_a_current(0.0),
+    m_dadT_current(0.0),
+    m_d2adT2_current(0.0),
+    m_mixStateNum(-2),
+    NSolns_(0),
+    dpdV_(0.0),
+    dpdT_(0.0)
+{
+    fill_n(m_aCoeffs, 3, 0.0);
+    fill_n(Vroot_, 3, 0.0);
+    initThermoFile(infile, id_);
+}
+
+PengRobinsonMFTP::PengRobinsonMFTP(XML_Node& phaseRefRoot, const std::string& id_) :
+    m_b_current(0.0),
+    m_a_current(0.0),
+    m_dadT_current(0.0),
+    m_d2adT2_current(0.0),
+    m_mixStateNum(-2),
+    NSolns_(0),
+    dpdV_(0.0),
+    dpdT_(0.0)
+{
+    fill_n(m_aCoeffs, 3, 0.0);
+    fill_n(Vroot_, 3, 0.0);
+    importPhase(phaseRefRoot, this);
+}
+
+void PengRobinsonMFTP::setSpeciesCoeffs(const std::string& species,
+                                        double a, double b, double w)
+{
+    size_t k = speciesIndex(species);
+    if (k == npos) {
+        throw CanteraError("PengRobinsonMFTP::setSpeciesCoeffs",
+            "Unknown species '{}'.", species);
+    }
+
+    m_a_coeffs(k, k) = a;
+    // standard mixing rule for cross-species interaction term
+    for (size_t j = 0; j < m_kk; j++) {
+        if (k == j) {
+            continue;
+        }
+        if (m_a_coeffs(j, k) == 0) {
+            double akj = sqrt(m_a_coeffs(j, j) * a);
+            m_a_coeffs(j, k) = akj;
+            m_a_coeffs(k, j) = akj;
+        }
+    }
+    b_vec_Curr_[k] = b;
+    m_acentric[k] = w;
+
+    // sqrt(a * alpha(T)) = sqrt(a) * (1 + kappa) - sqrt(a) * kappa * sqrt(T/Tc)
+    double kappa;
+    if (w <= 0.491) {
+        kappa = 0.37464 + 1.54226 * w - 0.26992 * w * w;
+    } else {
+        kappa = 0.379642 + 1.48503 * w - 0.164423 * w * w + 0.016666 * w * w * w;
+    }
+    double sqrta = sqrt(a);
+    if (a > 0.0 && b > 0.0) {
+        double Tc = a * omega_b / (b * omega_a * GasConstant);
+        m_sqrtA0[k] = sqrta * (1.0 + kappa);
+        m_sqrtA1[k] = sqrta * kappa / sqrt(Tc);
+    } else {
+        m_sqrtA0[k] = sqrta;
+        m_sqrtA1[k] = 0.0;
+    }
+    m_mixStateNum = -2;
+}
+
+void PengRobinsonMFTP::setBinaryCoeffs(const std::string& species_i,
+        const std::string& species_j, double a)
+{
+    size_t ki = speciesIndex(species_i);
+    if (ki == npos) {
+        throw CanteraError("PengRobinsonMFTP::setBinaryCoeffs",
+            "Unknown species '{}'.", species_i);
+    }
+    size_t kj = speciesIndex(species_j);
+    if (kj == npos) {
+        throw CanteraError("PengRobinsonMFTP::setBinaryCoeffs",
+            "Unknown species '{}'.", species_j);
+    }
+
+    m_a_coeffs(ki, kj) = m_a_coeffs(kj, ki) = a;
+    m_mixStateNum = -2;
+}
+
+// ------------Molar Thermodynamic Properties -------------------------
+
+doublereal PengRobinsonMFTP::enthalpy_mole() const
+{
+    _updateReferenceStateThermo();
+    doublereal h_ideal = RT() * mean_X(m_h0_RT);
+    doublereal h_nonideal = hresid();
+    return h_ideal + h_nonideal;
+}
+
+doublereal PengRobinsonMFTP::entropy_mole() const
+{
+    _updateReferenceStateThermo();
+    doublereal sr_ideal = GasConstant * (mean_X(m_s0_R)
+                                          - sum_xlogx() - std::log(pressure()/refPressure()));
+    doublereal sr_nonideal = sresid();
+    return sr_ideal + sr_nonideal;
+}
+
+doublereal PengRobinsonMFTP::cp_mole() const
+{
+    pressureDerivatives();
+    return cv_mole() - temperature() * dpdT_ * dpdT_ / dpdV_;
+}
+
+doublereal PengRobinsonMFTP::cv_mole() const
+{
+    _updateReferenceStateThermo();
+    doublereal cvref = GasConstant * (mean_X(m_cp0_R) - 1.0);
+    return cvref + temperature() * m_d2adT2_current
+           * logTerm(molarVolume(), m_b_current);
+}
+
+doublereal PengRobinsonMFTP::pressure() const
+{
+    _updateReferenceStateThermo();
+    return pressureCalc(temperature(), meanMolecularWeight() / density());
+}
+
+doublereal PengRobinsonMFTP::isothermalCompressibility() const
+{
+    pressureDerivatives();
+    return -1.0 / (molarVolume() * dpdV_);
+}
+
+doublereal PengRobinsonMFTP::thermalExpansionCoeff() const
+{
+    pressureDerivatives();
+    return -dpdT_ / (molarVolume() * dpdV_);
+}
+
+doublereal PengRobinsonMFTP::soundSpeed() const
+{
+    doublereal cv = cv_mole();
+    pressureDerivatives();
+    doublereal cp = cv - temperature() * dpdT_ * dpdT_ / dpdV_;
+    doublereal mv = molarVolume();
+    return sqrt(- cp / cv * mv * mv * dpdV_ / meanMolecularWeight());
+}
+
+void PengRobinsonMFTP::getPressureDerivatives(doublereal& dpdT,
+        doublereal& dpdV, doublereal* dpdn) const
+{
+    pressureDerivatives();
+    dpdT = dpdT_;
+    dpdV = dpdV_;
+    if (dpdn) {
+        doublereal mv = molarVolume();
+        doublereal vmb = mv - m_b_current;
+        doublereal denom = mv * mv + 2.0 * m_b_current * mv
+                           - m_b_current * m_b_current;
+        for (size_t k = 0; k < m_kk; k++) {
+            dpdn[k] = RT() / vmb + RT() * b_vec_Curr_[k] / (vmb * vmb)
+                      - 2.0 * m_aSum[k] / denom
+                      + 2.0 * m_a_current * b_vec_Curr_[k] * vmb / (denom * denom);
+        }
+    }
+}
+
+void PengRobinsonMFTP::getPropertiesBatch(size_t nStates, const double* T,
+        const double* P, const double* X, size_t ldX, double* rho, double* h,
+        double* s, double* cp, double* cv, double* c)
+{
+    vector_fp state;
+    saveState(state);
+    double Vroot[3];
+    double sumXlogX = 0.0;
+    for (size_t n = 0; n < nStates; n++) {
+        if (n == 0 || ldX != 0) {
+            Phase::setMoleFractions(X + n * ldX);
+            sumXlogX = sum_xlogx();
+        }
+        Phase::setTemperature(T[n]);
+        _updateReferenceStateThermo();
+        updateAB();
+
+        double RTn = GasConstant * T[n];
+        int nsol = solveCubic(T[n], P[n], m_a_current, m_b_current, Vroot);
+        if (nsol == 0) {
+            throw CanteraError("PengRobinsonMFTP::getPropertiesBatch",
+                "No solution of the equation of state at T = {}, P = {}",
+                T[n], P[n]);
+        }
+        double v = Vroot[0];
+        if (abs(nsol) > 1) {
+            // Use the root with the lowest Gibbs free energy
+            double gmin = BigNumber;
+            for (int i = 0; i < abs(nsol); i++) {
+                double vi = Vroot[i];
+                double g = P[n] * vi / RTn - log(P[n] * (vi - m_b_current) / RTn)
+                           - m_a_current * logTerm(vi, m_b_current) / RTn;
+                if (g < gmin) {
+                    gmin = g;
+                    v = vi;
+                }
+            }
+        }
+
+        double b = m_b_current;
+        double a = m_a_current;
+        double mmw = meanMolecularWeight();
+        double vmb = v - b;
+        double denom = v * v + 2.0 * b * v - b * b;
+        double F = logTerm(v, b);
+        if (rho) {
+            rho[n] = mmw / v;
+        }
+        if (h) {
+            h[n] = (RTn * mean_X(m_h0_RT) + (T[n] * m_dadT_current - a) * F
+                    + P[n] * v - RTn) / mmw;
+        }
+        if (s) {
+            s[n] = (GasConstant * (mean_X(m_s0_R) - sumXlogX
+                                   - log(P[n] / refPressure())
+                                   + log(P[n] * vmb / RTn))
+                    + m_dadT_current * F) / mmw;
+        }
+        if (cp || cv || c) {
+            double cvm = GasConstant * (mean_X(m_cp0_R) - 1.0)
+                         + T[n] * m_d2adT2_current * F;
+            double dpdT = GasConstant / vmb - m_dadT_current / denom;
+            double dpdV = - RTn / (vmb * vmb)
+                          + 2.0 * a * (v + b) / (denom * denom);
+            double cpm = cvm - T[n] * dpdT * dpdT / dpdV;
+            if (cp) {
+                cp[n] = cpm / mmw;
+            }
+            if (cv) {
+                cv[n] = cvm / mmw;
+            }
+            if (c) {
+                c[n] = sqrt(- cpm / cvm * v * v * dpdV / mmw);
+            }
+        }
+    }
+    restoreState(state);
+}
+
+void PengRobinsonMFTP::calcDensity()
+{
+    // Calculate the molarVolume of the solution (m**3 kmol-1)
+    const doublereal* const dtmp = moleFractdivMMW();
+    getPartialMolarVolumes(m_tmpV.data());
+    double invDens = dot(m_tmpV.begin(), m_tmpV.end(), dtmp);
+
+    // Set the density in the parent State object directly, by calling the
+    // Phase::setDensity() function.
+    Phase::setDensity(1.0/invDens);
+}
+
+void PengRobinsonMFTP::setTemperature(const doublereal temp)
+{
+    Phase::setTemperature(temp);
+    _updateReferenceStateThermo();
+    updateAB();
+}
+
+void PengRobinsonMFTP::compositionChanged()
+{
+    MixtureFugacityTP::compositionChanged();
+    updateAB();
+}
+
+void PengRobinsonMFTP::getActivityConcentrations(doublereal* c) const
+{
+    getActivityCoefficients(c);
+    for (size_t k = 0; k < m_kk; k++) {
+        c[k] *= moleFraction(k)*pressure()/RT();
+    }
+}
+
+doublereal PengRobinsonMFTP::standardConcentration(size_t k) const
+{
+    getStandardVolumes(m_tmpV.data());
+    return 1.0 / m_tmpV[k];
+}
+
+void PengRobinsonMFTP::getActivityCoefficients(doublereal* ac) const
+{
+    doublereal mv = molarVolume();
+    doublereal vmb = mv - m_b_current;
+    doublereal pres = pressure();
+    doublereal zm1 = pres * mv / RT() - 1.0;
+    doublereal lnzmB = log(pres * vmb / RT());
+    doublereal F = logTerm(mv, m_b_current) / RT();
+
+    for (size_t k = 0; k < m_kk; k++) {
+        doublereal bRatio = b_vec_Curr_[k] / m_b_current;
+        ac[k] = exp(bRatio * zm1 - lnzmB
+                    - (2.0 * m_aSum[k] - m_a_current * bRatio) * F);
+    }
+}
+
+// ---- Partial Molar Properties of the Solution -----------------
+
+void PengRobinsonMFTP::getChemPotentials_RT(doublereal* muRT) const
+{
+    getChemPotentials(muRT);
+    for (size_t k = 0; k < m_kk; k++) {
+        muRT[k] *= 1.0 / RT();
+    }
+}
+
+void PengRobinsonMFTP::getChemPotentials(doublereal* mu) const
+{
+    getGibbs_ref(mu);
+    doublereal mv = molarVolume();
+    doublereal vmb = mv - m_b_current;
+    doublereal pres = pressure();
+    doublereal zm1 = pres * mv / RT() - 1.0;
+    doublereal lnzmB = log(pres * vmb / RT());
+    doublereal lnP = log(pres / refPressure());
+    doublereal F = logTerm(mv, m_b_current) / RT();
+
+    for (size_t k = 0; k < m_kk; k++) {
+        double xx = std::max(SmallNumber, moleFraction(k));
+        doublereal bRatio = b_vec_Curr_[k] / m_b_current;
+        doublereal lnPhi = bRatio * zm1 - lnzmB
+                           - (2.0 * m_aSum[k] - m_a_current * bRatio) * F;
+        mu[k] += RT() * (log(xx) + lnP + lnPhi);
+    }
+}
+
+void PengRobinsonMFTP::getPartialMolarEnthalpies(doublereal* hbar) const
+{
+    // First we get the reference state contributions
+    getEnthalpy_RT_ref(hbar);
+    scale(hbar, hbar+m_kk, hbar, RT());
+
+    // The partial molar internal energy at constant T and V, plus the
+    // correction to constant T and P
+    getPartialMolarVolumes(m_partialMolarVolumes.data());
+    doublereal TKelvin = temperature();
+    doublereal mv = molarVolume();
+    doublereal denom = mv * mv + 2.0 * m_b_current * mv
+                       - m_b_current * m_b_current;
+    doublereal F = logTerm(mv, m_b_current);
+    doublereal fac = (TKelvin * m_dadT_current - m_a_current) * (mv / denom - F)
+                     / m_b_current;
+    for (size_t k = 0; k < m_kk; k++) {
+        hbar[k] += - RT() + 2.0 * (TKelvin * m_daSumdT[k] - m_aSum[k]) * F
+                   + fac * b_vec_Curr_[k]
+                   + TKelvin * dpdT_ * m_partialMolarVolumes[k];
+    }
+}
+
+void PengRobinsonMFTP::getPartialMolarEntropies(doublereal* sbar) const
+{
+    getPartialMolarEnthalpies(sbar);
+    getChemPotentials(m_tmpV.data());
+    for (size_t k = 0; k < m_kk; k++) {
+        sbar[k] = (sbar[k] - m_tmpV[k]) / temperature();
+    }
+}
+
+void PengRobinsonMFTP::getPartialMolarIntEnergies(doublereal* ubar) const
+{
+    getPartialMolarEnthalpies(ubar);
+    doublereal pres = pressure();
+    for (size_t k = 0; k < m_kk; k++) {
+        ubar[k] -= pres * m_partialMolarVolumes[k];
+    }
+}
+
+void PengRobinsonMFTP::getPartialMolarCp(doublereal* cpbar) const
+{
+    getCp_R(cpbar);
+    scale(cpbar, cpbar+m_kk, cpbar, GasConstant);
+}
+
+void PengRobinsonMFTP::getPartialMolarVolumes(doublereal* vbar) const
+{
+    doublereal dpdT, dpdV;
+    getPressureDerivatives(dpdT, dpdV, dpdni_.data());
+    for (size_t k = 0; k < m_kk; k++) {
+        vbar[k] = - dpdni_[k] / dpdV;
+    }
+}
+
+doublereal PengRobinsonMFTP::critTemperature() const
+{
+    double pc, tc, vc;
+    calcCriticalConditions(pc, tc, vc);
+    return tc;
+}
+
+doublereal PengRobinsonMFTP::critPressure() const
+{
+    double pc, tc, vc;
+    calcCriticalConditions(pc, tc, vc);
+    return pc;
+}
+
+doublereal PengRobinsonMFTP::critVolume() const
+{
+    double pc, tc, vc;
+    calcCriticalConditions(pc, tc, vc);
+    return vc;
+}
+
+doublereal PengRobinsonMFTP::critCompressibility() const
+{
+    double pc, tc, vc;
+    calcCriticalConditions(pc, tc, vc);
+    return pc*vc/tc/GasConstant;
+}
+
+doublereal PengRobinsonMFTP::critDensity() const
+{
+    double pc, tc, vc;
+    calcCriticalConditions(pc, tc, vc);
+    double mmw = meanMolecularWeight();
+    return mmw / vc;
+}
+
+void PengRobinsonMFTP::setToEquilState(const doublereal* mu_RT)
+{
+    double tmp, tmp2;
+    _updateReferenceStateThermo();
+    getGibbs_RT_ref(m_tmpV.data());
+
+    // Within the method, we protect against inf results if the exponent is too
+    // high.
+    //
+    // If it is too low, we set the partial pressure to zero. This capability is
+    // needed by the elemental potential method.
+    doublereal pres = 0.0;
+    double m_p0 = refPressure();
+    for (size_t k = 0; k < m_kk; k++) {
+        tmp = -m_tmpV[k] + mu_RT[k];
+        if (tmp < -600.) {
+            m_pp[k] = 0.0;
+        } else if (tmp > 500.0) {
+            tmp2 = tmp / 500.;
+            tmp2 *= tmp2;
+            m_pp[k] = m_p0 * exp(500.) * tmp2;
+        } else {
+            m_pp[k] = m_p0 * exp(tmp);
+        }
+        pres += m_pp[k];
+    }
+    // set state
+    setState_PX(pres, &m_pp[0]);
+}
+
+bool PengRobinsonMFTP::addSpecies(shared_ptr<Species> spec)
+{
+    bool added = MixtureFugacityTP::addSpecies(spec);
+    if (added) {
+        // Keep the parameters of the species which were already added
+        Array2D a_coeffs(m_kk, m_kk, 0.0);
+        for (size_t i = 0; i + 1 < m_kk; i++) {
+            for (size_t j = 0; j + 1 < m_kk; j++) {
+                a_coeffs(i, j) = m_a_coeffs(i, j);
+            }
+        }
+        m_a_coeffs = a_coeffs;
+
+        b_vec_Curr_.push_back(0.0);
+        m_acentric.push_back(0.0);
+        m_sqrtA0.push_back(0.0);
+        m_sqrtA1.push_back(0.0);
+        m_sumA0.push_back(0.0);
+        m_sumA1.push_back(0.0);
+        m_aSum.push_back(0.0);
+        m_daSumdT.push_back(0.0);
+
+        m_pp.push_back(0.0);
+        m_tmpV.push_back(0.0);
+        m_partialMolarVolumes.push_back(0.0);
+        dpdni_.push_back(0.0);
+        m_mixStateNum = -2;
+    }
+    return added;
+}
+
+void PengRobinsonMFTP::initThermoXML(XML_Node& phaseNode, const std::string& id)
+{
+    if (phaseNode.hasChild("thermo")) {
+        XML_Node& thermoNode = phaseNode.child("thermo");
+        std::string model = thermoNode["model"];
+        if (model != "PengRobinson" && model != "PengRobinsonMFTP") {
+            throw CanteraError("PengRobinsonMFTP::initThermoXML",
+                               "Unknown thermo model : " + model);
+        }
+
+        // Go get all of the coefficients and factors in the
+        // activityCoefficients XML block
+        if (thermoNode.hasChild("activityCoefficients")) {
+            XML_Node& acNode = thermoNode.child("activityCoefficients");
+
+            // Loop through the children getting multiple instances of
+            // parameters
+            for (size_t i = 0; i < acNode.nChildren(); i++) {
+                XML_Node& xmlACChild = acNode.child(i);
+                if (caseInsensitiveEquals(xmlACChild.name(), "purefluidparameters")) {
+                    readXMLPureFluid(xmlACChild);
+                } else if (caseInsensitiveEquals(xmlACChild.name(), "crossfluidparameters")) {
+                    readXMLCrossFluid(xmlACChild);
+                }
+            }
+        }
+    }
+
+    MixtureFugacityTP::initThermoXML(phaseNode, id);
+}
+
+void PengRobinsonMFTP::readXMLPureFluid(XML_Node& pureFluidParam)
+{
+    string xname = pureFluidParam.name();
+    if (xname != "pureFluidParameters") {
+        throw CanteraError("PengRobinsonMFTP::readXMLPureFluid",
+                           "Incorrect name for processing this routine: " + xname);
+    }
+
+    double a = 0.0;
+    double b = 0.0;
+    double w = 0.0;
+    for (size_t iChild = 0; iChild < pureFluidParam.nChildren(); iChild++) {
+        XML_Node& xmlChild = pureFluidParam.child(iChild);
+        string nodeName = toLowerCopy(xmlChild.name());
+
+        if (nodeName == "a_coeff") {
+            vector_fp vParams;
+            string iModel = toLowerCopy(xmlChild.attrib("model"));
+            getFloatArray(xmlChild, vParams, true, "Pascal-m6/kmol2", "a_coeff");
+
+            // The temperature dependence is given by the acentric factor, so
+            // the linear form is only accepted without a temperature term
+            if (iModel == "constant" && vParams.size() == 1) {
+                a = vParams[0];
+            } else if (iModel == "linear_a" && vParams.size() == 2
+                       && vParams[1] == 0.0) {
+                a = vParams[0];
+            } else {
+                throw CanteraError("PengRobinsonMFTP::readXMLPureFluid",
+                    "unknown model or incorrect number of parameters");
+            }
+        } else if (nodeName == "b_coeff") {
+            b = getFloatCurrent(xmlChild, "toSI");
+        } else if (nodeName == "acentric_factor") {
+            w = getFloatCurrent(xmlChild, "");
+        }
+    }
+    setSpeciesCoeffs(pureFluidParam.attrib("species"), a, b, w);
+}
+
+void PengRobinsonMFTP::readXMLCrossFluid(XML_Node& CrossFluidParam)
+{
+    string xname = CrossFluidParam.name();
+    if (xname != "crossFluidParameters") {
+        throw CanteraError("PengRobinsonMFTP::readXMLCrossFluid",
+                           "Incorrect name for processing this routine: " + xname);
+    }
+
+    string iName = CrossFluidParam.attrib("species1");
+    string jName = CrossFluidParam.attrib("species2");
+
+    size_t num = CrossFluidParam.nChildren();
+    for (size_t iChild = 0; iChild < num; iChild++) {
+        XML_Node& xmlChild = CrossFluidParam.child(iChild);
+        string nodeName = toLowerCopy(xmlChild.name());
+
+        if (nodeName == "a_coeff") {
+            vector_fp vParams;
+            getFloatArray(xmlChild, vParams, true, "Pascal-m6/kmol2", "a_coeff");
+            string iModel = toLowerCopy(xmlChild.attrib("model"));
+            if (iModel == "constant" && vParams.size() == 1) {
+                setBinaryCoeffs(iName, jName, vParams[0]);
+            } else if (iModel == "linear_a" && vParams.size() == 2
+                       && vParams[1] == 0.0) {
+                setBinaryCoeffs(iName, jName, vParams[0]);
+            } else {
+                throw CanteraError("PengRobinsonMFTP::readXMLCrossFluid",
+                    "unknown model ({}) or wrong number of parameters ({})",
+                    iModel, vParams.size());
+            }
+        }
+    }
+}
+
+doublereal PengRobinsonMFTP::sresid() const
+{
+    doublereal molarV = meanMolecularWeight() / density();
+    doublereal zz = z();
+    double sresid_mol_R = log(zz * (1.0 - m_b_current / molarV));
+    return GasConstant * sresid_mol_R
+           + m_dadT_current * logTerm(molarV, m_b_current);
+}
+
+doublereal PengRobinsonMFTP::hresid() const
+{
+    doublereal molarV = meanMolecularWeight() / density();
+    doublereal zz = z();
+    doublereal T = temperature();
+    doublereal fac = T * m_dadT_current - m_a_current;
+    return GasConstant * T * (zz - 1.0) + fac * logTerm(molarV, m_b_current);
+}
+
+doublereal PengRobinsonMFTP::liquidVolEst(doublereal TKelvin, doublereal& presGuess) const
+{
+    double v = m_b_current * 1.1;
+    double atmp;
+    double btmp;
+    calculateAB(TKelvin, atmp, btmp);
+    doublereal pres = std::max(psatEst(TKelvin), presGuess);
+    double Vroot[3];
+    bool foundLiq = false;
+    int m = 0;
+    while (m < 100 && !foundLiq) {
+        int nsol = solveCubic(TKelvin, pres, atmp, btmp, Vroot);
+        if (nsol == 1 || nsol == 2) {
+            double pc = critPressure();
+            if (pres > pc) {
+                foundLiq = true;
+            }
+            pres *= 1.04;
+        } else {
+            foundLiq = true;
+        }
+    }
+
+    if (foundLiq) {
+        v = Vroot[0];
+        presGuess = pres;
+    } else {
+        v = -1.0;
+    }
+    return v;
+}
+
+doublereal PengRobinsonMFTP::densityCalc(doublereal TKelvin, doublereal presPa, int phaseRequested, doublereal rhoguess)
+{
+    // It's necessary to set the temperature so that m_a_current is set correctly.
+    setTemperature(TKelvin);
+    double tcrit = critTemperature();
+    doublereal mmw = meanMolecularWeight();
+    if (rhoguess == -1.0) {
+        if (phaseRequested != FLUID_GAS) {
+            if (TKelvin > tcrit) {
+                rhoguess = presPa * mmw / (GasConstant * TKelvin);
+            } else {
+                if (phaseRequested == FLUID_GAS || phaseRequested == FLUID_SUPERCRIT) {
+                    rhoguess = presPa * mmw / (GasConstant * TKelvin);
+                } else if (phaseRequested >= FLUID_LIQUID_0) {
+                    double lqvol = liquidVolEst(TKelvin, presPa);
+                    rhoguess = mmw / lqvol;
+                }
+            }
+        } else {
+            // Assume the Gas phase initial guess, if nothing is specified to
+            // the routine
+            rhoguess = presPa * mmw / (GasConstant * TKelvin);
+        }
+    }
+
+    doublereal volguess = mmw / rhoguess;
+    NSolns_ = solveCubic(TKelvin, presPa, m_a_current, m_b_current, Vroot_);
+
+    doublereal molarVolLast = Vroot_[0];
+    if (NSolns_ >= 2) {
+        if (phaseRequested >= FLUID_LIQUID_0) {
+            molarVolLast = Vroot_[0];
+        } else if (phaseRequested == FLUID_GAS || phaseRequested == FLUID_SUPERCRIT) {
+            molarVolLast = Vroot_[NSolns_ - 1];
+        } else {
+            if (volguess > Vroot_[1]) {
+                molarVolLast = Vroot_[NSolns_ - 1];
+            } else {
+                molarVolLast = Vroot_[0];
+            }
+        }
+    } else if (NSolns_ == 1) {
+        if (phaseRequested == FLUID_GAS || phaseRequested == FLUID_SUPERCRIT || phaseRequested == FLUID_UNDEFINED) {
+            molarVolLast = Vroot_[0];
+        } else {
+            return -2.0;
+        }
+    } else if (NSolns_ == -1) {
+        if (phaseRequested >= FLUID_LIQUID_0 || phaseRequested == FLUID_UNDEFINED || phaseRequested == FLUID_SUPERCRIT) {
+            molarVolLast = Vroot_[0];
+        } else if (TKelvin > tcrit) {
+            molarVolLast = Vroot_[0];
+        } else {
+            return -2.0;
+        }
+    } else {
+        molarVolLast = Vroot_[0];
+        return -1.0;
+    }
+    return mmw / molarVolLast;
+}
+
+doublereal PengRobinsonMFTP::densSpinodalLiquid() const
+{
+    double Vroot[3];
+    double T = temperature();
+    int nsol = solveCubic(T, pressure(), m_a_current, m_b_current, Vroot);
+    if (nsol != 3) {
+        return critDensity();
+    }
+
+    auto resid = [this, T](double v) {
+        double pp;
+        return dpdVCalc(T, v, pp);
+    };
+
+    boost::uintmax_t maxiter = 100;
+    std::pair<double, double> vv = bmt::toms748_solve(
+        resid, Vroot[0], Vroot[1], bmt::eps_tolerance<double>(48), maxiter);
+
+    doublereal mmw = meanMolecularWeight();
+    return mmw / (0.5 * (vv.first + vv.second));
+}
+
+doublereal PengRobinsonMFTP::densSpinodalGas() const
+{
+    double Vroot[3];
+    double T = temperature();
+    int nsol = solveCubic(T, pressure(), m_a_current, m_b_current, Vroot);
+    if (nsol != 3) {
+        return critDensity();
+    }
+
+    auto resid = [this, T](double v) {
+        double pp;
+        return dpdVCalc(T, v, pp);
+    };
+
+    boost::uintmax_t maxiter = 100;
+    std::pair<double, double> vv = bmt::toms748_solve(
+        resid, Vroot[1], Vroot[2], bmt::eps_tolerance<double>(48), maxiter);
+
+    doublereal mmw = meanMolecularWeight();
+    return mmw / (0.5 * (vv.first + vv.second));
+}
+
+doublereal PengRobinsonMFTP::pressureCalc(doublereal TKelvin, doublereal molarVol) const
+{
+    double denom = molarVol * molarVol + 2.0 * m_b_current * molarVol
+                   - m_b_current * m_b_current;
+    return GasConstant * TKelvin / (molarVol - m_b_current)
+           - m_a_current / denom;
+}
+
+doublereal PengRobinsonMFTP::dpdVCalc(doublereal TKelvin, doublereal molarVol, doublereal& presCalc) const
+{
+    doublereal vmb = molarVol - m_b_current;
+    doublereal denom = molarVol * molarVol + 2.0 * m_b_current * molarVol
+                       - m_b_current * m_b_current;
+    presCalc = GasConstant * TKelvin / vmb - m_a_current / denom;
+    return - GasConstant * TKelvin / (vmb * vmb)
+           + 2.0 * m_a_current * (molarVol + m_b_current) / (denom * denom);
+}
+
+void PengRobinsonMFTP::pressureDerivatives() const
+{
+    doublereal TKelvin = temperature();
+    doublereal mv = molarVolume();
+    doublereal pres;
+
+    dpdV_ = dpdVCalc(TKelvin, mv, pres);
+    doublereal denom = mv * mv + 2.0 * m_b_current * mv
+                       - m_b_current * m_b_current;
+    dpdT_ = GasConstant / (mv - m_b_current) - m_dadT_current / denom;
+}
+
+void PengRobinsonMFTP::updateMixingExpressions()
+{
+    updateAB();
+}
+
+void PengRobinsonMFTP::updateAB()
+{
+    if (m_mixStateNum == -2) {
+        // The species parameters changed. Find the pairs of species whose
+        // "a" parameter differs from the default mixing rule.
+        m_binaryPairs.clear();
+        m_binaryDelta.clear();
+        for (size_t j = 0; j < m_kk; j++) {
+            for (size_t i = 0; i < j; i++) {
+                double aDefault = sqrt(m_a_coeffs(i, i) * m_a_coeffs(j, j));
+                if (aDefault > 0.0 && m_a_coeffs(i, j) != aDefault) {
+                    m_binaryPairs.emplace_back(i, j);
+                    m_binaryDelta.push_back(m_a_coeffs(i, j) / aDefault - 1.0);
+                }
+            }
+        }
+    }
+
+    if (m_mixStateNum != stateMFNumber()) {
+        // Sums which depend only on the composition. With the default mixing
+        // rule, the sums over the second species are the same for all
+        // species, and the pairs with explicit binary parameters are added as
+        // corrections.
+        const double* x = moleFractions_.data();
+        double sum0 = dot(m_sqrtA0.begin(), m_sqrtA0.end(), x);
+        double sum1 = dot(m_sqrtA1.begin(), m_sqrtA1.end(), x);
+        fill(m_sumA0.begin(), m_sumA0.end(), sum0);
+        fill(m_sumA1.begin(), m_sumA1.end(), sum1);
+        for (size_t n = 0; n < m_binaryPairs.size(); n++) {
+            size_t i = m_binaryPairs[n].first;
+            size_t j = m_binaryPairs[n].second;
+            double d = m_binaryDelta[n];
+            m_sumA0[i] += d * x[j] * m_sqrtA0[j];
+            m_sumA1[i] += d * x[j] * m_sqrtA1[j];
+            m_sumA0[j] += d * x[i] * m_sqrtA0[i];
+            m_sumA1[j] += d * x[i] * m_sqrtA1[i];
+        }
+        m_b_current = 0.0;
+        fill_n(m_aCoeffs, 3, 0.0);
+        for (size_t k = 0; k < m_kk; k++) {
+            m_b_current += x[k] * b_vec_Curr_[k];
+            m_aCoeffs[0] += x[k] * m_sqrtA0[k] * m_sumA0[k];
+            m_aCoeffs[1] += x[k] * m_sqrtA1[k] * m_sumA0[k];
+            m_aCoeffs[2] += x[k] * m_sqrtA1[k] * m_sumA1[k];
+        }
+        m_mixStateNum = stateMFNumber();
+    }
+
+    double temp = temperature();
+    double sqt = sqrt(temp);
+    for (size_t k = 0; k < m_kk; k++) {
+        double sk = m_sqrtA0[k] - m_sqrtA1[k] * sqt;
+        double sumk = m_sumA0[k] - m_sumA1[k] * sqt;
+        m_aSum[k] = sk * sumk;
+        m_daSumdT[k] = - (m_sqrtA1[k] * sumk + sk * m_sumA1[k]) / (2.0 * sqt);
+    }
+    m_a_current = m_aCoeffs[0] - 2.0 * m_aCoeffs[1] * sqt + m_aCoeffs[2] * temp;
+    m_dadT_current = m_aCoeffs[2] - m_aCoeffs[1] / sqt;
+    m_d2adT2_current = m_aCoeffs[1] / (2.0 * temp * sqt);
+}
+
+void PengRobinsonMFTP::calculateAB(doublereal temp, doublereal& aCalc, doublereal& bCalc) const
+{
+    // uses the mixing sums computed by updateAB() for the current composition
+    bCalc = m_b_current;
+    aCalc = m_aCoeffs[0] - 2.0 * m_aCoeffs[1] * sqrt(temp) + m_aCoeffs[2] * temp;
+}
+
+doublereal PengRobinsonMFTP::da_dt() const
+{
+    return m_dadT_current;
+}
+
+doublereal PengRobinsonMFTP::d2a_dt2() const
+{
+    return m_d2adT2_current;
+}
+
+void PengRobinsonMFTP::calcCriticalConditions(doublereal& pc, doublereal& tc,
+                                              doublereal& vc) const
+{
+    if (m_b_current <= 0.0) {
+        tc = 1000000.;
+        pc = 1.0E13;
+        vc = omega_vc * GasConstant * tc / pc;
+        return;
+    }
+    if (m_aCoeffs[0] <= 0.0) {
+        tc = 0.0;
+        pc = 0.0;
+        vc = 2.0 * m_b_current;
+        return;
+    }
+
+    // At the critical point, a(Tc) = omega_a / omega_b * b * R * Tc, which is
+    // a quadratic equation in sqrt(Tc). The root is written in a form which
+    // is also valid when the "a" parameter does not depend on temperature.
+    double q = omega_a * m_b_current * GasConstant / omega_b - m_aCoeffs[2];
+    double disc = m_aCoeffs[1] * m_aCoeffs[1] + q * m_aCoeffs[0];
+    double den = m_aCoeffs[1] + sqrt(std::max(disc, 0.0));
+    if (den <= 0.0) {
+        throw CanteraError("PengRobinsonMFTP::calcCriticalConditions",
+                           "no critical temperature");
+    }
+    double sqrttc = m_aCoeffs[0] / den;
+    tc = sqrttc * sqrttc;
+    pc = omega_b * GasConstant * tc / m_b_current;
+    vc = omega_vc * GasConstant * tc / pc;
+}
+
+int PengRobinsonMFTP::solveCubic(double TKelvin, double pres, doublereal a,
+                                 doublereal b, doublereal Vroot[3]) const
+{
+    Vroot[0] = 0.0;
+    Vroot[1] = 0.0;
+    Vroot[2] = 0.0;
+    if (TKelvin <= 0.0) {
+        throw CanteraError("PengRobinsonMFTP::solveCubic()", "neg temperature");
+    }
+
+    // Coefficients of the cubic in the compressibility factor,
+    // Z**3 + p2 Z**2 + p1 Z + p0 = 0
+    double RTc = GasConstant * TKelvin;
+    double A = a * pres / (RTc * RTc);
+    double B = b * pres / RTc;
+    double p2 = - (1.0 - B);
+    double p1 = A - 3.0 * B * B - 2.0 * B;
+    double p0 = - (A * B - B * B - B * B * B);
+
+    // Center of the cubic, the square of the half-distance between its
+    // turning points, and the value at the center
+    double xN = - p2 / 3.0;
+    double delta2 = (p2 * p2 - 3.0 * p1) / 9.0;
+    double yN = 2.0 * p2 * p2 * p2 / 27.0 - p2 * p1 / 3.0 + p0;
+    double desc = yN * yN - 4.0 * delta2 * delta2 * delta2;
+
+    double Z[3];
+    int nRoots;
+    if (desc > 0.0) {
+        // One real root
+        double tmpD = sqrt(desc);
+        Z[0] = xN + cbrt(0.5 * (- yN + tmpD)) + cbrt(0.5 * (- yN - tmpD));
+        nRoots = 1;
+    } else if (delta2 <= 0.0) {
+        // Triple root
+        Z[0] = xN;
+        nRoots = 1;
+    } else {
+        // Three real roots, of which two may coincide
+        double delta = sqrt(delta2);
+        double arg = std::max(-1.0, std::min(1.0, - yN / (2.0 * delta2 * delta)));
+        double theta = acos(arg) / 3.0;
+        double oo = 2. * Pi / 3.;
+        Z[0] = xN + 2.0 * delta * cos(theta + oo);
+        Z[1] = xN + 2.0 * delta * cos(theta + 2.0 * oo);
+        Z[2] = xN + 2.0 * delta * cos(theta);
+        sort(Z, Z + 3);
+        nRoots = 3;
+        if (desc == 0.0) {
+            if (Z[1] - Z[0] < Z[2] - Z[1]) {
+                Z[1] = Z[2];
+            }
+            nRoots = 2;
+        }
+    }
+
+    // Polish the roots with Newton's method, and keep only the roots with a
+    // molar volume larger than b
+    int nSolnValues = 0;
+    for (int i = 0; i < nRoots; i++) {
+        double zz = Z[i];
+        for (int n = 0; n < 10; n++) {
+            double res = ((zz + p2) * zz + p1) * zz + p0;
+            double dresdZ = (3.0 * zz + 2.0 * p2) * zz + p1;
+            if (dresdZ == 0.0) {
+                break;
+            }
+            double del = - res / dresdZ;
+            zz += del;
+            if (fabs(del) <= 1.0E-15 * fabs(zz)) {
+                break;
+            }
+        }
+        if (zz > B) {
+            Vroot[nSolnValues++] = zz * RTc / pres;
+        }
+    }
+
+    if (nSolnValues == 1) {
+        // Determine whether the single root is on the liquid or the gas
+        // branch, based on the critical conditions for a temperature
+        // independent "a" parameter
+        double tc = a * omega_b / (b * omega_a * GasConstant);
+        double pc = omega_b * GasConstant * tc / b;
+        double vc = omega_vc * GasConstant * tc / pc;
+        if (TKelvin > tc) {
+            if (Vroot[0] < vc) {
+                nSolnValues = -1;
+            }
+        } else {
+            if (Vroot[0] < xN * RTc / pres) {
+                nSolnValues = -1;
+            }
+        }
+    }
+    return nSolnValues;
+}
+
+}
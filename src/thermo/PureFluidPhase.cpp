@@ -156,6 +156,15 @@ tpx::Substance& PureFluidPhase::TPX_Substance()
     return *m_sub;
 }
 
+void PureFluidPhase::useTable(shared_ptr<const tpx::SubstanceTable> table)
+{
+    if (!m_sub) {
+        throw CanteraError("PureFluidPhase::useTable",
+                           "initThermo() must be called first");
+    }
+    m_sub->useTable(table);
+}
+
 void PureFluidPhase::getPartialMolarEnthalpies(doublereal* hbar) const
 {
     hbar[0] = enthalpy_mole();
@@ -26,6 +26,9 @@ RedlichKwongMFTP::RedlichKwongMFTP() :
     m_formTempParam(0),
     m_b_current(0.0),
     m_a_current(0.0),
+    m_a0_current(0.0),
+    m_dadT_current(0.0),
+    m_mixStateNum(-2),
     NSolns_(0),
     dpdV_(0.0),
     dpdT_(0.0)
@@ -37,6 +40,9 @@ RedlichKwongMFTP::RedlichKwongMFTP(const std::string& infile, const std::string&
     m_formTempParam(0),
     m_b_current(0.0),
     m_a_current(0.0),
+    m_a0_current(0.0),
+    m_dadT_current(0.0),
+    m_mixStateNum(-2),
     NSolns_(0),
     dpdV_(0.0),
     dpdT_(0.0)
@@ -49,6 +55,9 @@ RedlichKwongMFTP::RedlichKwongMFTP(XML_Node& phaseRefRoot, const std::string& id
     m_formTempParam(0),
     m_b_current(0.0),
     m_a_current(0.0),
+    m_a0_current(0.0),
+    m_dadT_current(0.0),
+    m_mixStateNum(-2),
     NSolns_(0),
     dpdV_(0.0),
     dpdT_(0.0)
@@ -88,8 +97,8 @@ void RedlichKwongMFTP::setSpeciesCoeffs(const std::string& species,
             a_coeff_vec(1, k + m_kk * j) = a1kj;
         }
     }
-    a_coeff_vec.getRow(0, a_vec_Curr_.data());
     b_vec_Curr_[k] = b;
+    m_mixStateNum = -2;
 }
 
 void RedlichKwongMFTP::setBinaryCoeffs(const std::string& species_i,
@@ -113,7 +122,7 @@ void RedlichKwongMFTP::setBinaryCoeffs(const std::string& species_i,
     size_t counter2 = kj + m_kk * ki;
     a_coeff_vec(0, counter1) = a_coeff_vec(0, counter2) = a0;
     a_coeff_vec(1, counter1) = a_coeff_vec(1, counter2) = a1;
-    a_vec_Curr_[counter1] = a_vec_Curr_[counter2] = a0;
+    m_mixStateNum = -2;
 }
 
 // ------------Molar Thermodynamic Properties -------------------------
@@ -222,20 +231,13 @@ void RedlichKwongMFTP::getActivityCoefficients(doublereal* ac) const
     doublereal vpb = mv + m_b_current;
     doublereal vmb = mv - m_b_current;
 
-    for (size_t k = 0; k < m_kk; k++) {
-        m_pp[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_pp[k] += moleFractions_[i] * a_vec_Curr_[counter];
-        }
-    }
     doublereal pres = pressure();
 
     for (size_t k = 0; k < m_kk; k++) {
         ac[k] = (- RT() * log(pres * mv / RT())
                  + RT() * log(mv / vmb)
                  + RT() * b_vec_Curr_[k] / vmb
-                 - 2.0 * m_pp[k] / (m_b_current * sqt) * log(vpb/mv)
+                 - 2.0 * m_aSum[k] / (m_b_current * sqt) * log(vpb/mv)
                  + m_a_current * b_vec_Curr_[k] / (m_b_current * m_b_current * sqt) * log(vpb/mv)
                  - m_a_current / (m_b_current * sqt) * (b_vec_Curr_[k]/vpb)
                 );
@@ -268,13 +270,6 @@ void RedlichKwongMFTP::getChemPotentials(doublereal* mu) const
     doublereal vpb = mv + m_b_current;
     doublereal vmb = mv - m_b_current;
 
-    for (size_t k = 0; k < m_kk; k++) {
-        m_pp[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_pp[k] += moleFractions_[i] * a_vec_Curr_[counter];
-        }
-    }
     doublereal pres = pressure();
     doublereal refP = refPressure();
 
@@ -282,7 +277,7 @@ void RedlichKwongMFTP::getChemPotentials(doublereal* mu) const
         mu[k] += (RT() * log(pres/refP) - RT() * log(pres * mv / RT())
                   + RT() * log(mv / vmb)
                   + RT() * b_vec_Curr_[k] / vmb
-                  - 2.0 * m_pp[k] / (m_b_current * sqt) * log(vpb/mv)
+                  - 2.0 * m_aSum[k] / (m_b_current * sqt) * log(vpb/mv)
                   + m_a_current * b_vec_Curr_[k] / (m_b_current * m_b_current * sqt) * log(vpb/mv)
                   - m_a_current / (m_b_current * sqt) * (b_vec_Curr_[k]/vpb)
                  );
@@ -302,25 +297,14 @@ void RedlichKwongMFTP::getPartialMolarEnthalpies(doublereal* hbar) const
     doublereal vpb = mv + m_b_current;
     doublereal vmb = mv - m_b_current;
     for (size_t k = 0; k < m_kk; k++) {
-        m_pp[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_pp[k] += moleFractions_[i] * a_vec_Curr_[counter];
-        }
-    }
-    for (size_t k = 0; k < m_kk; k++) {
-        dpdni_[k] = RT()/vmb + RT() * b_vec_Curr_[k] / (vmb * vmb) - 2.0 * m_pp[k] / (sqt * mv * vpb)
+        dpdni_[k] = RT()/vmb + RT() * b_vec_Curr_[k] / (vmb * vmb) - 2.0 * m_aSum[k] / (sqt * mv * vpb)
                     + m_a_current * b_vec_Curr_[k]/(sqt * mv * vpb * vpb);
     }
     doublereal dadt = da_dt();
     doublereal fac = TKelvin * dadt - 3.0 * m_a_current / 2.0;
 
     for (size_t k = 0; k < m_kk; k++) {
-        m_tmpV[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_tmpV[k] += 2.0 * moleFractions_[i] * TKelvin * a_coeff_vec(1,counter) - 3.0 * moleFractions_[i] * a_vec_Curr_[counter];
-        }
+        m_tmpV[k] = 2.0 * TKelvin * m_aSum1[k] - 3.0 * m_aSum[k];
     }
 
     pressureDerivatives();
@@ -347,21 +331,6 @@ void RedlichKwongMFTP::getPartialMolarEntropies(doublereal* sbar) const
         doublereal xx = std::max(SmallNumber, moleFraction(k));
         sbar[k] += GasConstant * (- log(xx));
     }
-    for (size_t k = 0; k < m_kk; k++) {
-        m_pp[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_pp[k] += moleFractions_[i] * a_vec_Curr_[counter];
-        }
-    }
-    for (size_t k = 0; k < m_kk; k++) {
-        m_tmpV[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_tmpV[k] += moleFractions_[i] * a_coeff_vec(1,counter);
-        }
-    }
-
     doublereal dadt = da_dt();
     doublereal fac = dadt - m_a_current / (2.0 * TKelvin);
     doublereal vmb = mv - m_b_current;
@@ -371,8 +340,8 @@ void RedlichKwongMFTP::getPartialMolarEntropies(doublereal* sbar) const
                    + GasConstant
                    + GasConstant * log(mv/vmb)
                    + GasConstant * b_vec_Curr_[k]/vmb
-                   + m_pp[k]/(m_b_current * TKelvin * sqt) * log(vpb/mv)
-                   - 2.0 * m_tmpV[k]/(m_b_current * sqt) * log(vpb/mv)
+                   + m_aSum[k]/(m_b_current * TKelvin * sqt) * log(vpb/mv)
+                   - 2.0 * m_aSum1[k]/(m_b_current * sqt) * log(vpb/mv)
                    + b_vec_Curr_[k] / (m_b_current * m_b_current * sqt) * log(vpb/mv) * fac
                    - 1.0 / (m_b_current * sqt) * b_vec_Curr_[k] / vpb * fac
                   );
@@ -399,33 +368,18 @@ void RedlichKwongMFTP::getPartialMolarCp(doublereal* cpbar) const
 
 void RedlichKwongMFTP::getPartialMolarVolumes(doublereal* vbar) const
 {
-    for (size_t k = 0; k < m_kk; k++) {
-        m_pp[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_pp[k] += moleFractions_[i] * a_vec_Curr_[counter];
-        }
-    }
-    for (size_t k = 0; k < m_kk; k++) {
-        m_tmpV[k] = 0.0;
-        for (size_t i = 0; i < m_kk; i++) {
-            size_t counter = k + m_kk*i;
-            m_tmpV[k] += moleFractions_[i] * a_coeff_vec(1,counter);
-        }
-    }
-
     doublereal sqt = sqrt(temperature());
     doublereal mv = molarVolume();
     doublereal vmb = mv - m_b_current;
     doublereal vpb = mv + m_b_current;
+    doublereal denom = (pressure() + RT() * m_b_current/(vmb * vmb) - m_a_current / (sqt * vpb * vpb)
+                       );
     for (size_t k = 0; k < m_kk; k++) {
         doublereal num = (RT() + RT() * m_b_current/ vmb + RT() * b_vec_Curr_[k] / vmb
                           + RT() * m_b_current * b_vec_Curr_[k] /(vmb * vmb)
-                          - 2.0 * m_pp[k] / (sqt * vpb)
+                          - 2.0 * m_aSum[k] / (sqt * vpb)
                           + m_a_current * b_vec_Curr_[k] / (sqt * vpb * vpb)
                          );
-        doublereal denom = (pressure() + RT() * m_b_current/(vmb * vmb) - m_a_current / (sqt * vpb * vpb)
-                           );
         vbar[k] = num / denom;
     }
 }
@@ -433,80 +387,40 @@ void RedlichKwongMFTP::getPartialMolarVolumes(doublereal* vbar) const
 doublereal RedlichKwongMFTP::critTemperature() const
 {
     double pc, tc, vc;
-    double a0 = 0.0;
-    double aT = 0.0;
-    for (size_t i = 0; i < m_kk; i++) {
-        for (size_t j = 0; j <m_kk; j++) {
-            size_t counter = i + m_kk * j;
-            a0 += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(0, counter);
-            aT += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(1, counter);
-        }
-    }
-    calcCriticalConditions(m_a_current, m_b_current, a0, aT, pc, tc, vc);
+    calcCriticalConditions(m_a_current, m_b_current, m_a0_current,
+                           m_dadT_current, pc, tc, vc);
     return tc;
 }
 
 doublereal RedlichKwongMFTP::critPressure() const
 {
     double pc, tc, vc;
-    double a0 = 0.0;
-    double aT = 0.0;
-    for (size_t i = 0; i < m_kk; i++) {
-        for (size_t j = 0; j <m_kk; j++) {
-            size_t counter = i + m_kk * j;
-            a0 += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(0, counter);
-            aT += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(1, counter);
-        }
-    }
-    calcCriticalConditions(m_a_current, m_b_current, a0, aT, pc, tc, vc);
+    calcCriticalConditions(m_a_current, m_b_current, m_a0_current,
+                           m_dadT_current, pc, tc, vc);
     return pc;
 }
 
 doublereal RedlichKwongMFTP::critVolume() const
 {
     double pc, tc, vc;
-    double a0 = 0.0;
-    double aT = 0.0;
-    for (size_t i = 0; i < m_kk; i++) {
-        for (size_t j = 0; j <m_kk; j++) {
-            size_t counter = i + m_kk * j;
-            a0 += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(0, counter);
-            aT += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(1, counter);
-        }
-    }
-    calcCriticalConditions(m_a_current, m_b_current, a0, aT, pc, tc, vc);
+    calcCriticalConditions(m_a_current, m_b_current, m_a0_current,
+                           m_dadT_current, pc, tc, vc);
     return vc;
 }
 
 doublereal RedlichKwongMFTP::critCompressibility() const
 {
     double pc, tc, vc;
-    double a0 = 0.0;
-    double aT = 0.0;
-    for (size_t i = 0; i < m_kk; i++) {
-        for (size_t j = 0; j <m_kk; j++) {
-            size_t counter = i + m_kk * j;
-            a0 += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(0, counter);
-            aT += moleFractions_[i] * moleFractions_[j] * a_coeff_vec(1, counter);
-        }
-    }
-    calcCriticalConditions(m_a_current, m_b_current, a0, aT, pc, tc, vc);
+    calcCriticalConditions(m_a_current, m_b_current, m_a0_current,
+                           m_dadT_current, pc, tc, vc);
     return pc*vc/tc/GasConstant;
 }
 
 doublereal RedlichKwongMFTP::critDensity() const
 {
     double pc, tc, vc;
-    double a0 = 0.0;
-    double aT = 0.0;
-    for (size_t i = 0; i < m_kk; i++) {
-        for (size_t j = 0; j <m_kk; j++) {
-            size_t counter = i + m_kk * j;
-            a0 += moleFractions_[i] * moleFractions_[j] *a_coeff_vec(0, counter);
-            aT += moleFractions_[i] * moleFractions_[j] *a_coeff_vec(1, counter);
-        }
-    }
-    calcCriticalConditions(m_a_current, m_b_current, a0, aT, pc, tc, vc);
+    calcCriticalConditions(m_a_current, m_b_current, m_a0_current,
+                           m_dadT_current, pc, tc, vc);
     double mmw = meanMolecularWeight();
     return mmw / vc;
 }
@@ -545,12 +459,14 @@ bool RedlichKwongMFTP::addSpecies(shared_ptr<Species> spec)
 {
     bool added = MixtureFugacityTP::addSpecies(spec);
     if (added) {
-        a_vec_Curr_.resize(m_kk * m_kk, 0.0);
         b_vec_Curr_.push_back(0.0);
 
         a_coeff_vec.resize(2, m_kk * m_kk, 0.0);
 
         m_pp.push_back(0.0);
+        m_aSum0.push_back(0.0);
+        m_aSum1.push_back(0.0);
+        m_aSum.push_back(0.0);
         m_tmpV.push_back(0.0);
         m_partialMolarVolumes.push_back(0.0);
         dpdni_.push_back(0.0);
@@ -755,7 +671,13 @@ doublereal RedlichKwongMFTP::densityCalc(doublereal TKelvin, doublereal presPa,
     }
 
     doublereal volguess = mmw / rhoguess;
-    NSolns_ = NicholsSolve(TKelvin, presPa, m_a_current, m_b_current, Vroot_);
+    // Start from the molar volume of the previous state if the cubic has a
+    // single real root, and fall back to the analytical solution otherwise
+    NSolns_ = NewtonSolve(TKelvin, presPa, m_a_current, m_b_current, volguess,
+                          Vroot_);
+    if (NSolns_ == 0) {
+        NSolns_ = NicholsSolve(TKelvin, presPa, m_a_current, m_b_current, Vroot_);
+    }
 
     doublereal molarVolLast = Vroot_[0];
     if (NSolns_ >= 2) {
@@ -878,63 +800,53 @@ void RedlichKwongMFTP::updateMixingExpressions()
 
 void RedlichKwongMFTP::updateAB()
 {
-    double temp = temperature();
-    if (m_formTempParam == 1) {
-        for (size_t i = 0; i < m_kk; i++) {
-            for (size_t j = 0; j < m_kk; j++) {
-                size_t counter = i * m_kk + j;
-                a_vec_Curr_[counter] = a_coeff_vec(0,counter) + a_coeff_vec(1,counter) * temp;
+    if (m_mixStateNum != stateMFNumber()) {
+        // The sums over the pairwise "a" coefficients depend only on the
+        // composition, and are evaluated once for each composition. The "a"
+        // matrix is symmetric, so the sums can be taken along its columns.
+        m_b_current = 0.0;
+        m_a0_current = 0.0;
+        m_dadT_current = 0.0;
+        for (size_t k = 0; k < m_kk; k++) {
+            const double* a = a_coeff_vec.ptrColumn(m_kk * k);
+            double sum0 = 0.0;
+            double sum1 = 0.0;
+            if (m_formTempParam == 1) {
+                for (size_t i = 0; i < m_kk; i++) {
+                    sum0 += moleFractions_[i] * a[2*i];
+                    sum1 += moleFractions_[i] * a[2*i+1];
+                }
+            } else {
+                for (size_t i = 0; i < m_kk; i++) {
+                    sum0 += moleFractions_[i] * a[2*i];
+                }
             }
+            m_aSum0[k] = sum0;
+            m_aSum1[k] = sum1;
+            m_b_current += moleFractions_[k] * b_vec_Curr_[k];
+            m_a0_current += moleFractions_[k] * sum0;
+            m_dadT_current += moleFractions_[k] * sum1;
         }
+        m_mixStateNum = stateMFNumber();
     }
 
-    m_b_current = 0.0;
-    m_a_current = 0.0;
-    for (size_t i = 0; i < m_kk; i++) {
-        m_b_current += moleFractions_[i] * b_vec_Curr_[i];
-        for (size_t j = 0; j < m_kk; j++) {
-            m_a_current += a_vec_Curr_[i * m_kk + j] * moleFractions_[i] * moleFractions_[j];
-        }
+    double temp = temperature();
+    for (size_t k = 0; k < m_kk; k++) {
+        m_aSum[k] = m_aSum0[k] + m_aSum1[k] * temp;
     }
+    m_a_current = m_a0_current + m_dadT_current * temp;
 }
 
 void RedlichKwongMFTP::calculateAB(doublereal temp, doublereal& aCalc, doublereal& bCalc) const
 {
-    bCalc = 0.0;
-    aCalc = 0.0;
-    if (m_formTempParam == 1) {
-        for (size_t i = 0; i < m_kk; i++) {
-            bCalc += moleFractions_[i] * b_vec_Curr_[i];
-            for (size_t j = 0; j < m_kk; j++) {
-                size_t counter = i * m_kk + j;
-                doublereal a_vec_Curr = a_coeff_vec(0,counter) + a_coeff_vec(1,counter) * temp;
-                aCalc += a_vec_Curr * moleFractions_[i] * moleFractions_[j];
-            }
-        }
-    } else {
-        for (size_t i = 0; i < m_kk; i++) {
-            bCalc += moleFractions_[i] * b_vec_Curr_[i];
-            for (size_t j = 0; j < m_kk; j++) {
-                size_t counter = i * m_kk + j;
-                doublereal a_vec_Curr = a_coeff_vec(0,counter);
-                aCalc += a_vec_Curr * moleFractions_[i] * moleFractions_[j];
-            }
-        }
-    }
+    // uses the mixing sums computed by updateAB() for the current composition
+    bCalc = m_b_current;
+    aCalc = m_a0_current + m_dadT_current * temp;
 }
 
 doublereal RedlichKwongMFTP::da_dt() const
 {
-    doublereal dadT = 0.0;
-    if (m_formTempParam == 1) {
-        for (size_t i = 0; i < m_kk; i++) {
-            for (size_t j = 0; j < m_kk; j++) {
-                size_t counter = i * m_kk + j;
-                dadT+= a_coeff_vec(1,counter) * moleFractions_[i] * moleFractions_[j];
-            }
-        }
-    }
-    return dadT;
+    return m_dadT_current;
 }
 
 void RedlichKwongMFTP::calcCriticalConditions(doublereal a, doublereal b, doublereal a0_coeff, doublereal aT_coeff,
@@ -1180,4 +1092,77 @@ int RedlichKwongMFTP::NicholsSolve(double TKelvin, double pres, doublereal a, do
     return nSolnValues;
 }
 
+int RedlichKwongMFTP::NewtonSolve(double TKelvin, double pres, doublereal a,
+                                  doublereal b, doublereal Vguess,
+                                  doublereal Vroot[3]) const
+{
+    if (TKelvin <= 0.0 || !(Vguess > b)) {
+        return 0;
+    }
+
+    // Coefficients of the cubic polynomial, as in NicholsSolve()
+    doublereal an = 1.0;
+    doublereal bn = - GasConstant * TKelvin / pres;
+    doublereal sqt = sqrt(TKelvin);
+    doublereal cn = - (GasConstant * TKelvin * b / pres - a/(pres * sqt) + b * b);
+    doublereal dn = - (a * b / (pres * sqt));
+
+    // The nearly ideal gas case is handled by a separate iteration in
+    // NicholsSolve()
+    doublereal ratio1 = 3.0 * an * cn / (bn * bn);
+    doublereal ratio2 = pres * b / (GasConstant * TKelvin);
+    doublereal ratio3 = a / (GasConstant * sqt) * pres / (GasConstant * TKelvin);
+    if (fabs(ratio1) < 1.0E-7 && fabs(ratio2) < 1.0E-5 && fabs(ratio3) < 1.0E-5) {
+        return 0;
+    }
+
+    // Only use Newton's method if there is exactly one real root
+    doublereal xN = - bn /(3 * an);
+    doublereal delta2 = (bn * bn - 3 * an * cn) / (9 * an * an);
+    doublereal delta = (delta2 > 0.0) ? sqrt(delta2) : 0.0;
+    doublereal h = 2.0 * an * delta * delta2;
+    doublereal yN = 2.0 * bn * bn * bn / (27.0 * an * an) - bn * cn / (3.0 * an) + dn;
+    doublereal desc = yN * yN - 4. * an * an * delta2 * delta2 * delta2;
+    if (desc <= 0.0 || fabs(fabs(h) - fabs(yN)) < 1.0E-10) {
+        return 0;
+    }
+
+    double v = Vguess;
+    bool converged = false;
+    for (int n = 0; n < 20; n++) {
+        double res = ((an * v + bn) * v + cn) * v + dn;
+        double dresdV = (3.0 * an * v + 2.0 * bn) * v + cn;
+        // The coefficients of the cubic are small, so only a convergence
+        // test relative to the size of the Newton step is meaningful
+        if (fabs(res) <= 1.0E-14 * fabs(dresdV) * fabs(v)) {
+            converged = true;
+            break;
+        }
+        double del = - res / dresdV;
+        v += del;
+        if (fabs(del) / (fabs(v) + fabs(del)) < 1.0E-14) {
+            converged = true;
+            break;
+        }
+    }
+    if (!converged || !(v > 0.0)) {
+        return 0;
+    }
+
+    Vroot[0] = v;
+    Vroot[1] = 0.0;
+    Vroot[2] = 0.0;
+
+    // Classify the root as in NicholsSolve()
+    double tmp = a * omega_b / (b * omega_a * GasConstant);
+    double tc = pow(tmp, 2./3.);
+    double pc = omega_b * GasConstant * tc / b;
+    double vc = omega_vc * GasConstant * tc / pc;
+    if (TKelvin > tc) {
+        return (v < vc) ? -1 : 1;
+    } else {
+        return (v < xN) ? -1 : 1;
+    }
+}
+
 }
@@ -24,6 +24,7 @@
 #include "cantera/thermo/PhaseCombo_Interaction.h"
 #include "cantera/thermo/PureFluidPhase.h"
 #include "cantera/thermo/RedlichKwongMFTP.h"
+#include "cantera/thermo/PengRobinsonMFTP.h"
 #include "cantera/thermo/ConstDensityThermo.h"
 #include "cantera/thermo/SurfPhase.h"
 #include "cantera/thermo/EdgePhase.h"
@@ -76,6 +77,8 @@ ThermoFactory::ThermoFactory()
     reg("Redlich-Kister", []() { return new RedlichKisterVPSSTP(); });
     reg("RedlichKwong", []() { return new RedlichKwongMFTP(); });
     m_synonyms["RedlichKwongMFTP"] = "RedlichKwong";
+    reg("PengRobinson", []() { return new PengRobinsonMFTP(); });
+    m_synonyms["PengRobinsonMFTP"] = "PengRobinson";
     reg("MaskellSolidSolnPhase", []() { return new MaskellSolidSolnPhase(); });
 }
 
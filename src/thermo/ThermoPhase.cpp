@@ -30,7 +30,10 @@ ThermoPhase::ThermoPhase() :
     m_hasElementPotentials(false),
     m_chargeNeutralityNecessary(false),
     m_ssConvention(cSS_CONVENTION_TEMPERATURE),
-    m_tlast(0.0)
+    m_tlast(0.0),
+    m_nTempSolves(0),
+    m_nTempEvals(0),
+    m_nTempFailures(0)
 {
 }
 
@@ -200,6 +203,47 @@ void ThermoPhase::setState_conditional_TP(doublereal t, doublereal p, bool set_p
     }
 }
 
+bool ThermoPhase::solveTemperature(double target, double rtol, bool doV,
+                                   bool doS, int maxIter)
+{
+    m_nTempSolves++;
+    double p = (doV) ? 0.0 : pressure();
+    double Tinit = temperature();
+    double T = Tinit;
+    try {
+        for (int n = 0; n < maxIter; n++) {
+            m_nTempEvals++;
+            double f, dfdT;
+            if (doS) {
+                f = entropy_mass();
+                dfdT = ((doV) ? cv_mass() : cp_mass()) / T;
+            } else if (doV) {
+                f = intEnergy_mass();
+                dfdT = cv_mass();
+            } else {
+                f = enthalpy_mass();
+                dfdT = cp_mass();
+            }
+            double dT = (target - f) / dfdT;
+            if (!(dfdT > 0.0) || !std::isfinite(dT)) {
+                break;
+            }
+            dT = clip(dT, -0.5 * T, T);
+            T += dT;
+            setState_conditional_TP(T, p, !doV);
+            if (fabs(dT) <= rtol * T) {
+                return true;
+            }
+        }
+    } catch (CanteraError&) {
+        // The iteration left the range of temperatures where the phase can
+        // be evaluated, e.g. below the triple point of a pure fluid
+    }
+    m_nTempFailures++;
+    setState_conditional_TP(Tinit, p, !doV);
+    return false;
+}
+
 void ThermoPhase::setState_HPorUV(double Htarget, double p,
                                   double rtol, bool doUV)
 {
@@ -221,6 +265,9 @@ void ThermoPhase::setState_HPorUV(double Htarget, double p,
         }
         setPressure(p);
     }
+    if (solveTemperature(Htarget, rtol, doUV, false)) {
+        return;
+    }
     double Tmax = maxTemp() + 0.1;
     double Tmin = minTemp() - 0.1;
 
@@ -420,6 +467,9 @@ void ThermoPhase::setState_SPorSV(double Starget, double p,
         }
         setPressure(p);
     }
+    if (solveTemperature(Starget, rtol, doSV, true)) {
+        return;
+    }
     double Tmax = maxTemp() + 0.1;
     double Tmin = minTemp() - 0.1;
 
@@ -687,7 +737,8 @@ void ThermoPhase::invalidateCache() {
 
 void ThermoPhase::equilibrate(const std::string& XY, const std::string& solver,
                               double rtol, int max_steps, int max_iter,
-                              int estimate_equil, int log_level)
+                              int estimate_equil, int log_level,
+                              EquilState* warm_start)
 {
     if (solver == "auto" || solver == "element_potential") {
         vector_fp initial_state;
@@ -698,18 +749,28 @@ void ThermoPhase::equilibrate(const std::string& XY, const std::string& solver,
             E.options.maxIterations = max_steps;
             E.options.relTolerance = rtol;
             bool use_element_potentials = (estimate_equil == 0);
+            if (warm_start && warm_start->valid) {
+                E.setSolverState(*warm_start);
+                E.options.contin = true;
+            }
             int ret = E.equilibrate(*this, XY.c_str(), use_element_potentials, log_level-1);
             if (ret < 0) {
                 throw CanteraError("ThermoPhase::equilibrate",
                     "ChemEquil solver failed. Return code: {}", ret);
             }
             setElementPotentials(E.elementPotentials());
+            if (warm_start) {
+                *warm_start = E.solverState();
+            }
             debuglog("ChemEquil solver succeeded\n", log_level);
             return;
         } catch (std::exception& err) {
             debuglog("ChemEquil solver failed.\n", log_level);
             debuglog(err.what(), log_level);
             restoreState(initial_state);
+            if (warm_start) {
+                warm_start->valid = false;
+            }
             if (solver == "auto") {
             } else {
                 throw;
@@ -313,13 +313,28 @@ doublereal WaterPropsIAPWS::psat(doublereal temperature, int waterState)
 {
     static int method = 1;
     doublereal densLiq = -1.0, densGas = -1.0, delGRT = 0.0;
-    doublereal dp, pcorr;
+    doublereal dp, pcorr, p;
     if (temperature >= T_c) {
         densGas = density(temperature, P_c, WATER_SUPERCRIT);
         setState_TR(temperature, densGas);
         return P_c;
     }
-    doublereal p = psat_est(temperature);
+    if (m_table && m_table->saturation(temperature, p, densLiq, densGas)) {
+        // Polish the tabulated density so that the state is consistent with
+        // the saturation pressure. This takes one or two Newton iterations.
+        if (waterState == WATER_LIQUID) {
+            densLiq = density(temperature, p, WATER_LIQUID, densLiq);
+        } else if (waterState == WATER_GAS) {
+            densGas = density(temperature, p, WATER_GAS, densGas);
+        } else {
+            throw CanteraError("WaterPropsIAPWS::psat",
+                               "unknown water state input: {}", waterState);
+        }
+        if (densLiq > 0.0 && densGas > 0.0) {
+            return p;
+        }
+    }
+    p = psat_est(temperature);
     for (int i = 0; i < 30; i++) {
         if (method == 1) {
             corr(temperature, p, densLiq, densGas, delGRT);
@@ -566,6 +581,15 @@ doublereal WaterPropsIAPWS::densSpinodalSteam() const
     return dens_new;
 }
 
+void WaterPropsIAPWS::useTable(shared_ptr<const WaterPropsIAPWSTable> table)
+{
+    m_table = table;
+    m_phi.setTable(table.get());
+    if (tau > 0.0) {
+        m_phi.tdpolycalc(tau, delta);
+    }
+}
+
 void WaterPropsIAPWS::setState_TR(doublereal temperature, doublereal rho)
 {
     calcDim(temperature, rho);
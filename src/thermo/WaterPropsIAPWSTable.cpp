@@ -0,0 +1,386 @@
+/**
+ * @file WaterPropsIAPWSTable.cpp
+ * Definitions for a tabulated approximation to the residual Helmholtz free
+ * energy of water (see class \link Cantera::WaterPropsIAPWSTable
+ * WaterPropsIAPWSTable\endlink).
+ */
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/thermo/WaterPropsIAPWSTable.h"
+#include "cantera/thermo/WaterPropsIAPWS.h"
+#include "cantera/base/ctexceptions.h"
+
+namespace Cantera
+{
+
+namespace {
+
+//! Critical temperature (kelvin) and density (kg m-3) of the formulation
+const double T_c = 647.096;
+const double Rho_c = 322.;
+
+//! Step used for the finite difference estimates of the third derivatives
+const double fdStep = 1.0e-5;
+
+//! Smallest reduced density at which the exact formulation is evaluated
+const double minDelta = 1.0e-12;
+
+//! Points, in the unit cell, at which the interpolant is checked: the center,
+//! where the error in the values is largest, and the 2x2 Gauss points, near
+//! which the errors in the derivatives are largest.
+const double gaussLo = 0.5 - 0.5 / std::sqrt(3.0);
+const double gaussHi = 0.5 + 0.5 / std::sqrt(3.0);
+const double checkU[5] = {0.5, gaussLo, gaussLo, gaussHi, gaussHi};
+const double checkV[5] = {0.5, gaussLo, gaussHi, gaussLo, gaussHi};
+
+//! Upper limit, in reduced density, of the vapor part of the table
+const double vaporDelta = 0.2;
+
+//! Scale of the logarithmic density coordinate in the vapor part
+const double vaporScale = 1.0e-5;
+
+//! Cubic Hermite basis functions on an interval of length *h*
+/*!
+ * H[0] and H[2] multiply the values at the two ends of the interval, and
+ * H[1] and H[3] multiply the derivatives. D[] contains the derivatives of
+ * H[] with respect to the unscaled variable.
+ */
+inline void hermite(double x, double h, double* H, double* D)
+{
+    double x2 = x * x;
+    double xm = 1.0 - x;
+    H[0] = (1.0 + 2.0 * x) * xm * xm;
+    H[1] = h * x * xm * xm;
+    H[2] = x2 * (3.0 - 2.0 * x);
+    H[3] = h * x2 * (x - 1.0);
+    D[0] = -6.0 * x * xm / h;
+    D[1] = xm * (1.0 - 3.0 * x);
+    D[2] = 6.0 * x * xm / h;
+    D[3] = x * (3.0 * x - 2.0);
+}
+
+}
+
+WaterPropsIAPWSTable::WaterPropsIAPWSTable(double rtol, double Tmin,
+        double Tmax, double rhoMax, size_t nTau, size_t nDense, size_t nVapor,
+        size_t nSat) :
+    m_rtol(rtol),
+    m_satTmin(Tmin),
+    m_satdT(0.0),
+    m_satTmax(Tmin)
+{
+    if (rtol <= 0.0 || Tmin <= 0.0 || Tmax <= Tmin ||
+        rhoMax <= vaporDelta * Rho_c) {
+        throw CanteraError("WaterPropsIAPWSTable::WaterPropsIAPWSTable",
+            "Invalid table range or tolerance: rtol = {}, T = [{}, {}], "
+            "rhoMax = {}", rtol, Tmin, Tmax, rhoMax);
+    }
+    if (nTau < 2 || nDense < 2 || nVapor < 2) {
+        throw CanteraError("WaterPropsIAPWSTable::WaterPropsIAPWSTable",
+            "At least two grid points are needed in each direction");
+    }
+    for (Patch* patch : {&m_vapor, &m_dense}) {
+        patch->tauMin = T_c / Tmax;
+        patch->nTau = nTau;
+        patch->dtau = (T_c / Tmin - patch->tauMin) / (nTau - 1);
+    }
+    buildPatch(m_vapor, 0.0, vaporDelta, vaporScale, nVapor);
+    buildPatch(m_dense, vaporDelta, rhoMax / Rho_c, 0.0, nDense);
+    if (nSat >= 2) {
+        buildSaturation(nSat);
+    }
+}
+
+void WaterPropsIAPWSTable::buildPatch(Patch& patch, double deltaMin,
+    double deltaMax, double deltaScale, size_t nY)
+{
+    patch.deltaScale = deltaScale;
+    patch.nY = nY;
+    if (deltaScale > 0.0) {
+        patch.yMin = log1p(deltaMin / deltaScale);
+        patch.dy = (log1p(deltaMax / deltaScale) - patch.yMin) / (nY - 1);
+    } else {
+        patch.yMin = deltaMin;
+        patch.dy = (deltaMax - deltaMin) / (nY - 1);
+    }
+
+    patch.nodes.resize(patch.nTau * nY);
+    for (size_t i = 0; i < patch.nTau; i++) {
+        double tau = patch.tauMin + i * patch.dtau;
+        for (size_t j = 0; j < nY; j++) {
+            double y = patch.yMin + j * patch.dy;
+            if (deltaScale > 0.0) {
+                double delta = deltaScale * expm1(y);
+                exactNode(tau, delta, delta + deltaScale,
+                          patch.nodes[i * nY + j]);
+            } else {
+                exactNode(tau, y, 1.0, patch.nodes[i * nY + j]);
+            }
+        }
+    }
+
+    patch.valid.assign((patch.nTau - 1) * (nY - 1), 0);
+    for (size_t i = 0; i + 1 < patch.nTau; i++) {
+        double tau = patch.tauMin + i * patch.dtau;
+        for (size_t j = 0; j + 1 < nY; j++) {
+            double y = patch.yMin + j * patch.dy;
+            bool ok = true;
+            for (size_t k = 0; k < 5 && ok; k++) {
+                ok = checkPoint(patch, i, j, tau + checkU[k] * patch.dtau,
+                                y + checkV[k] * patch.dy);
+            }
+            patch.valid[i * (nY - 1) + j] = ok;
+        }
+    }
+}
+
+void WaterPropsIAPWSTable::exactNode(double tau, double delta, double jac,
+                                     Node& node) const
+{
+    // Some terms of the exact derivatives can't be evaluated at zero
+    // density, so the nodes there use the limiting values.
+    delta = std::max(delta, minDelta);
+    WaterPropsIAPWSphi phi;
+    phi.tdpolycalc(tau, delta);
+    double phiR_d = phi.phiR_d();
+    double phiR_t = phi.phiR_t();
+    double phiR_dt = phi.phiR_dt();
+    node.f[0][0] = phi.phiR();
+    node.f[0][1] = phiR_t;
+    node.f[0][2] = phiR_d * jac;
+    node.f[0][3] = phiR_dt * jac;
+    node.f[1][0] = phiR_d;
+    node.f[1][1] = phiR_dt;
+    node.f[1][2] = phi.phiR_dd() * jac;
+    node.f[2][0] = phiR_t;
+    node.f[2][1] = phi.phiR_tt();
+    node.f[2][2] = phiR_dt * jac;
+
+    // The mixed third derivatives are not available analytically
+    phi.tdpolycalc(tau + fdStep, delta);
+    double dd_p = phi.phiR_dd();
+    phi.tdpolycalc(tau - fdStep, delta);
+    double dd_m = phi.phiR_dd();
+    node.f[1][3] = (dd_p - dd_m) / (2.0 * fdStep) * jac;
+    double step = fdStep * std::min(jac, 1.0);
+    double deltaLow = std::max(delta - step, minDelta);
+    phi.tdpolycalc(tau, delta + step);
+    double tt_p = phi.phiR_tt();
+    phi.tdpolycalc(tau, deltaLow);
+    double tt_m = phi.phiR_tt();
+    node.f[2][3] = (tt_p - tt_m) / (delta + step - deltaLow) * jac;
+}
+
+bool WaterPropsIAPWSTable::checkPoint(const Patch& patch, size_t i, size_t j,
+                                      double tau, double y) const
+{
+    double delta = (patch.deltaScale > 0.0) ? patch.deltaScale * expm1(y) : y;
+    double tab[6];
+    interpolate(patch, i, j, tau, y, tab);
+
+    delta = std::max(delta, minDelta);
+    WaterPropsIAPWSphi phi;
+    phi.tdpolycalc(tau, delta);
+    double ex[6] = {phi.phiR(), phi.phiR_d(), phi.phiR_dd(), phi.phiR_t(),
+                    phi.phiR_tt(), phi.phiR_dt()};
+    double phi0_tt = phi.phi0_tt();
+
+    // The errors are only sampled at a few points of each cell, so they are
+    // compared to half of the tolerance.
+    double tol = 0.5 * m_rtol;
+
+    // Relative error in the density at constant (T, P), and in dp/drho
+    double dpdrhoEx = 1.0 + 2.0 * delta * ex[1] + delta * delta * ex[2];
+    double dpdrhoTab = 1.0 + 2.0 * delta * tab[1] + delta * delta * tab[2];
+    if (!(delta * fabs(tab[1] - ex[1]) <= tol * fabs(dpdrhoEx)) ||
+        !(fabs(dpdrhoTab - dpdrhoEx) <= tol * fabs(dpdrhoEx))) {
+        return false;
+    }
+
+    // Absolute errors in g/RT, h/RT and s/R
+    if (!(fabs(tab[0] - ex[0]) <= tol) ||
+        !(tau * fabs(tab[3] - ex[3]) <= tol)) {
+        return false;
+    }
+
+    // Relative errors in cv and cp
+    double cvEx = -tau * tau * (phi0_tt + ex[4]);
+    double cvTab = -tau * tau * (phi0_tt + tab[4]);
+    if (!(fabs(cvTab - cvEx) <= tol * fabs(cvEx))) {
+        return false;
+    }
+    double numEx = 1.0 + delta * ex[1] - delta * tau * ex[5];
+    double numTab = 1.0 + delta * tab[1] - delta * tau * tab[5];
+    double cpEx = cvEx + numEx * numEx / dpdrhoEx;
+    double cpTab = cvTab + numTab * numTab / dpdrhoTab;
+    return fabs(cpTab - cpEx) <= tol * fabs(cpEx);
+}
+
+void WaterPropsIAPWSTable::interpolate(const Patch& patch, size_t i, size_t j,
+                                       double tau, double y,
+                                       double* phiR) const
+{
+    double Hu[4], Du[4], Hv[4], Dv[4];
+    hermite((tau - patch.tauMin) / patch.dtau - i, patch.dtau, Hu, Du);
+    hermite((y - patch.yMin) / patch.dy - j, patch.dy, Hv, Dv);
+
+    double val[3] = {0.0, 0.0, 0.0};
+    double dt[3] = {0.0, 0.0, 0.0};
+    double dy[3] = {0.0, 0.0, 0.0};
+    for (size_t p = 0; p < 2; p++) {
+        for (size_t q = 0; q < 2; q++) {
+            const Node& node = patch.nodes[(i + p) * patch.nY + j + q];
+            double hu0 = Hu[2*p], hu1 = Hu[2*p+1];
+            double du0 = Du[2*p], du1 = Du[2*p+1];
+            double hv0 = Hv[2*q], hv1 = Hv[2*q+1];
+            double dv0 = Dv[2*q], dv1 = Dv[2*q+1];
+            for (size_t k = 0; k < 3; k++) {
+                const double* f = node.f[k];
+                val[k] += (f[0] * hu0 + f[1] * hu1) * hv0
+                        + (f[2] * hu0 + f[3] * hu1) * hv1;
+                dt[k] += (f[0] * du0 + f[1] * du1) * hv0
+                       + (f[2] * du0 + f[3] * du1) * hv1;
+                dy[k] += (f[0] * hu0 + f[1] * hu1) * dv0
+                       + (f[2] * hu0 + f[3] * hu1) * dv1;
+            }
+        }
+    }
+
+    // Derivative of y with respect to delta
+    double dydd = 1.0;
+    if (patch.deltaScale > 0.0) {
+        dydd = exp(-y) / patch.deltaScale;
+    }
+    phiR[0] = val[0];
+    phiR[1] = val[1];
+    phiR[2] = dy[1] * dydd;
+    phiR[3] = val[2];
+    phiR[4] = dt[2];
+    phiR[5] = dt[1];
+}
+
+bool WaterPropsIAPWSTable::evalPatch(const Patch& patch, double tau,
+                                     double delta, double* phiR) const
+{
+    double y = (patch.deltaScale > 0.0) ? log1p(delta / patch.deltaScale)
+                                        : delta;
+    double xi = (tau - patch.tauMin) / patch.dtau;
+    double eta = (y - patch.yMin) / patch.dy;
+    if (!(xi >= 0.0 && eta >= 0.0 && xi <= patch.nTau - 1 &&
+          eta <= patch.nY - 1)) {
+        return false;
+    }
+    size_t i = std::min(static_cast<size_t>(xi), patch.nTau - 2);
+    size_t j = std::min(static_cast<size_t>(eta), patch.nY - 2);
+    if (!patch.valid[i * (patch.nY - 1) + j]) {
+        return false;
+    }
+    interpolate(patch, i, j, tau, y, phiR);
+    return true;
+}
+
+bool WaterPropsIAPWSTable::evalResidual(double tau, double delta,
+                                        double* phiR) const
+{
+    if (delta < vaporDelta) {
+        return evalPatch(m_vapor, tau, delta, phiR);
+    }
+    return evalPatch(m_dense, tau, delta, phiR);
+}
+
+double WaterPropsIAPWSTable::validFraction() const
+{
+    size_t nValid = 0;
+    for (const Patch* patch : {&m_vapor, &m_dense}) {
+        for (char v : patch->valid) {
+            nValid += v;
+        }
+    }
+    return nValid / double(m_vapor.valid.size() + m_dense.valid.size());
+}
+
+void WaterPropsIAPWSTable::buildSaturation(size_t nSat)
+{
+    // Exact saturation states at the nodes. The table ends before the
+    // critical point, where the saturated densities have infinite slopes.
+    WaterPropsIAPWS water;
+    m_satdT = (T_c - 1.0 - m_satTmin) / (nSat - 1);
+    auto exactSat = [&](double T, std::array<double, 6>& y) {
+        double p = water.psat(T, WATER_GAS);
+        double sGas = water.entropy();
+        double vGas = water.molarVolume();
+        y[2] = water.density();
+        double dpdTGas = water.coeffThermExp() / water.isothermalCompressibility();
+        double dpdrhoGas = water.dpdrho();
+        water.psat(T, WATER_LIQUID);
+        y[1] = water.density();
+        double dpdTLiq = water.coeffThermExp() / water.isothermalCompressibility();
+        double dpdrhoLiq = water.dpdrho();
+
+        // Clapeyron equation for the slope of the saturation curve
+        double dpsatdT = (sGas - water.entropy()) / (vGas - water.molarVolume());
+        y[0] = log(p);
+        y[3] = dpsatdT / p;
+        y[4] = (dpsatdT - dpdTLiq) / dpdrhoLiq;
+        y[5] = (dpsatdT - dpdTGas) / dpdrhoGas;
+    };
+
+    m_sat.clear();
+    std::array<double, 6> node, mid;
+    try {
+        exactSat(m_satTmin, node);
+    } catch (CanteraError&) {
+        return;
+    }
+    m_sat.push_back(node);
+    for (size_t k = 1; k < nSat; k++) {
+        double T = m_satTmin + k * m_satdT;
+        try {
+            exactSat(T, node);
+            exactSat(T - 0.5 * m_satdT, mid);
+        } catch (CanteraError&) {
+            break;
+        }
+        m_sat.push_back(node);
+        double y[3];
+        interpolateSat(k - 1, T - 0.5 * m_satdT, y);
+        if (fabs(y[0] - mid[0]) > m_rtol ||
+            fabs(y[1] - mid[1]) > m_rtol * mid[1] ||
+            fabs(y[2] - mid[2]) > m_rtol * mid[2]) {
+            m_sat.pop_back();
+            break;
+        }
+    }
+    m_satTmax = m_satTmin + (m_sat.size() - 1) * m_satdT;
+}
+
+void WaterPropsIAPWSTable::interpolateSat(size_t k, double T, double* y) const
+{
+    double H[4], D[4];
+    hermite((T - m_satTmin) / m_satdT - k, m_satdT, H, D);
+    const std::array<double, 6>& a = m_sat[k];
+    const std::array<double, 6>& b = m_sat[k+1];
+    for (size_t n = 0; n < 3; n++) {
+        y[n] = a[n] * H[0] + a[n+3] * H[1] + b[n] * H[2] + b[n+3] * H[3];
+    }
+}
+
+bool WaterPropsIAPWSTable::saturation(double T, double& psat, double& rhoLiq,
+                                      double& rhoGas) const
+{
+    if (m_sat.size() < 2 || !(T >= m_satTmin && T <= m_satTmax)) {
+        return false;
+    }
+    size_t k = std::min(static_cast<size_t>((T - m_satTmin) / m_satdT),
+                        m_sat.size() - 2);
+    double y[3];
+    interpolateSat(k, T, y);
+    psat = exp(y[0]);
+    rhoLiq = y[1];
+    rhoGas = y[2];
+    return true;
+}
+
+}
@@ -9,6 +9,7 @@
 // at http://www.cantera.org/license.txt for license and copyright information.
 
 #include "cantera/thermo/WaterPropsIAPWSphi.h"
+#include "cantera/thermo/WaterPropsIAPWSTable.h"
 #include "cantera/base/global.h"
 
 #include <cmath>
@@ -354,7 +355,9 @@ static const doublereal Bbetai[2] = {
 WaterPropsIAPWSphi::WaterPropsIAPWSphi() :
     TAUsave(-1.0),
     TAUsqrt(-1.0),
-    DELTAsave(-1.0)
+    DELTAsave(-1.0),
+    m_table(0),
+    m_useTab(false)
 {
     for (int i = 0; i < 52; i++) {
         TAUp[i] = 1.0;
@@ -364,8 +367,24 @@ WaterPropsIAPWSphi::WaterPropsIAPWSphi() :
     }
 }
 
+void WaterPropsIAPWSphi::setTable(const WaterPropsIAPWSTable* table)
+{
+    m_table = table;
+    m_useTab = false;
+    TAUsave = -1.0;
+    DELTAsave = -1.0;
+}
+
 void WaterPropsIAPWSphi::tdpolycalc(doublereal tau, doublereal delta)
 {
+    if (m_table) {
+        m_useTab = m_table->evalResidual(tau, delta, m_tabPhiR);
+        if (m_useTab) {
+            TAUsave = tau;
+            DELTAsave = delta;
+            return;
+        }
+    }
     if ((tau != TAUsave) || 1) {
         TAUsave = tau;
         TAUsqrt = sqrt(tau);
@@ -399,6 +418,9 @@ doublereal WaterPropsIAPWSphi::phi0() const
 
 doublereal WaterPropsIAPWSphi::phiR() const
 {
+    if (m_useTab) {
+        return m_tabPhiR[0];
+    }
     doublereal tau = TAUsave;
     doublereal delta = DELTAsave;
     int i, j;
@@ -453,6 +475,9 @@ doublereal WaterPropsIAPWSphi::phi(doublereal tau, doublereal delta)
 
 doublereal WaterPropsIAPWSphi::phiR_d() const
 {
+    if (m_useTab) {
+        return m_tabPhiR[1];
+    }
     doublereal tau = TAUsave;
     doublereal delta = DELTAsave;
     int i, j;
@@ -532,6 +557,9 @@ doublereal WaterPropsIAPWSphi::pressureM_rhoRT(doublereal tau, doublereal delta)
 
 doublereal WaterPropsIAPWSphi::phiR_dd() const
 {
+    if (m_useTab) {
+        return m_tabPhiR[2];
+    }
     doublereal tau = TAUsave;
     doublereal delta = DELTAsave;
     int i, j;
@@ -657,6 +685,9 @@ doublereal WaterPropsIAPWSphi::phi0_t() const
 
 doublereal WaterPropsIAPWSphi::phiR_t() const
 {
+    if (m_useTab) {
+        return m_tabPhiR[3];
+    }
     doublereal tau = TAUsave;
     doublereal delta = DELTAsave;
     int i, j;
@@ -728,6 +759,9 @@ doublereal WaterPropsIAPWSphi::phi0_tt() const
 
 doublereal WaterPropsIAPWSphi::phiR_tt() const
 {
+    if (m_useTab) {
+        return m_tabPhiR[4];
+    }
     doublereal tau = TAUsave;
     doublereal delta = DELTAsave;
     int i, j;
@@ -801,6 +835,9 @@ doublereal WaterPropsIAPWSphi::phi0_dt() const
 
 doublereal WaterPropsIAPWSphi::phiR_dt() const
 {
+    if (m_useTab) {
+        return m_tabPhiR[5];
+    }
     doublereal tau = TAUsave;
     doublereal delta = DELTAsave;
     int i, j;
@@ -8,6 +8,7 @@
 // at http://www.cantera.org/license.txt for license and copyright information.
 
 #include "cantera/tpx/Sub.h"
+#include "cantera/tpx/SubTable.h"
 #include "cantera/base/stringUtils.h"
 #include "cantera/base/global.h"
 
@@ -30,6 +31,9 @@ Substance::Substance() :
     Pst(Undef),
     m_energy_offset(0.0),
     m_entropy_offset(0.0),
+    m_tabT(Undef),
+    m_tabRho(Undef),
+    m_tabValid(false),
     kbr(0)
 {
 }
@@ -43,17 +47,21 @@ void Substance::setStdState(double h0, double s0, double t0, double p0)
     double soff = s0 - ss;
     m_entropy_offset += soff;
     m_energy_offset += hoff;
+    m_tabT = Undef;
 }
 
 double Substance::P()
 {
-    return TwoPhase() ? Ps() : Pp();
+    return TwoPhase() ? Ps() : vprop(propertyFlag::P);
 }
 
 const double DeltaT = 0.000001;
 
 double Substance::cv()
 {
+    if (m_table && !TwoPhase() && tabulated()) {
+        return m_tab[4];
+    }
     double Tsave = T, dt = 1.e-4*T;
     double x0 = x();
     double T1 = std::max(Tmin(), Tsave - dt);
@@ -93,6 +101,8 @@ double Substance::cp()
     if (TwoPhase()) {
         // In the two-phase region, cp is infinite
         return std::numeric_limits<double>::infinity();
+    } else if (m_table && tabulated()) {
+        return m_tab[4] + T * m_tab[1] * m_tab[1] / (Rho * Rho * m_tab[2]);
     }
 
     Set(PropertyPair::TP, T1, p0);
@@ -131,6 +141,8 @@ double Substance::thermalExpansionCoeff()
         // In the two-phase region, the thermal expansion coefficient is
         // infinite
         return std::numeric_limits<double>::infinity();
+    } else if (m_table && tabulated()) {
+        return m_tab[1] / (Rho * m_tab[2]);
     }
 
     Set(PropertyPair::TP, T1, p0);
@@ -165,6 +177,8 @@ double Substance::isothermalCompressibility()
     if (TwoPhase()) {
         // In the two-phase region, the isothermal compressibility is infinite
         return std::numeric_limits<double>::infinity();
+    } else if (m_table && tabulated()) {
+        return 1.0 / (Rho * m_tab[2]);
     }
 
     double v0 = v();
@@ -328,6 +342,11 @@ void Substance::Set(PropertyPair::type XY, double x0, double y0)
             }
         } else {
             set_T(x0);
+            if (m_table) {
+                // Supercritical isotherms are monotonic, so the tabulated
+                // Newton iteration converges from the ideal gas density
+                set_Rho(y0*MolWt()/(GasConstant*x0));
+            }
         }
         set_xy(propertyFlag::T, propertyFlag::P,
                x0, y0, TolAbsT, TolAbsP, TolRel, TolRel);
@@ -398,6 +417,17 @@ void Substance::Set(PropertyPair::type XY, double x0, double y0)
     }
 }
 
+void Substance::useTable(std::shared_ptr<const SubstanceTable> table)
+{
+    if (table && table->name() != m_name) {
+        throw CanteraError("Substance::useTable", "Table for '{}' can't be "
+                           "used for '{}'", table->name(), m_name);
+    }
+    m_table = table;
+    m_tabT = Undef;
+    Tslast = Undef;
+}
+
 //------------------ Protected and Private Functions -------------------
 
 void Substance::set_Rho(double r0)
@@ -441,6 +471,10 @@ double Substance::Ps()
 void Substance::update_sat()
 {
     if ((T != Tslast) && (T < Tcrit())) {
+        if (m_table && m_table->saturation(T, Pst, Rhf, Rhv)) {
+            Tslast = T;
+            return;
+        }
         double Rho_save = Rho;
         double pp = Psat();
         double lps = log(pp);
@@ -455,7 +489,7 @@ void Substance::update_sat()
             set_TPp(T,pp);
             Rhf = Rho; // sat liquid density
 
-            double gf = hp() - T*sp();
+            double gf = vprop(propertyFlag::H) - T*vprop(propertyFlag::S);
             if (i==0) {
                 Rho = pp*MolWt()/(GasConstant*T); // trial value = ideal gas
             } else {
@@ -464,7 +498,7 @@ void Substance::update_sat()
             set_TPp(T,pp);
 
             Rhv = Rho; // sat vapor density
-            double gv = hp() - T*sp();
+            double gv = vprop(propertyFlag::H) - T*vprop(propertyFlag::S);
             double dg = gv - gf;
             if (Rhv > Rhf) {
                 std::swap(Rhv, Rhf);
@@ -508,6 +542,22 @@ void Substance::update_sat()
 
 double Substance::vprop(propertyFlag::type ijob)
 {
+    if (m_table && tabulated()) {
+        switch (ijob) {
+        case propertyFlag::H:
+            return m_tab[3] + m_tab[0]/Rho;
+        case propertyFlag::S:
+            return m_tab[6];
+        case propertyFlag::U:
+            return m_tab[3];
+        case propertyFlag::V:
+            return vp();
+        case propertyFlag::P:
+            return m_tab[0];
+        default:
+            throw CanteraError("Substance::vprop", "invalid job index");
+        }
+    }
     switch (ijob) {
     case propertyFlag::H:
         return hp();
@@ -560,6 +610,13 @@ int Substance::Lever(int itp, double sat, double val, propertyFlag::type ifunc)
         double vv = (1.0 - xx)/Rhf + xx/Rhv;
         set_v(vv);
         return 1;
+    } else if (m_table) {
+        // Leave the state at the saturated phase next to the solution, which
+        // is a good starting point for the tabulated Newton iteration
+        if (val > Valg) {
+            Set(PropertyPair::TX, T, 1.0);
+        }
+        return 0;
     } else {
         T = Tsave;
         Rho = Rhosave;
@@ -595,6 +652,10 @@ void Substance::set_xy(propertyFlag::type ifx, propertyFlag::type ify,
         t_here = t_save;
     }
 
+    if (m_table && set_xy_tabulated(ifx, ify, X, Y, atx, aty, rtx, rty)) {
+        return;
+    }
+
     double Xa = fabs(X);
     double Ya = fabs(Y);
     while (true) {
@@ -657,6 +718,14 @@ void Substance::set_xy(propertyFlag::type ifx, propertyFlag::type ify,
         }
         Set(PropertyPair::TV, t_here, v_here);
         LoopCount++;
+        if (m_table && LoopCount > 10 && fabs(dt) < m_table->rtol()*t_here
+            && fabs(dv) < m_table->rtol()*v_here) {
+            // The tabulated properties can be discontinuous by up to the
+            // tolerance of the table where a valid cell borders one that is
+            // evaluated exactly. A solution that falls within such a gap can
+            // only be found to within the accuracy of the table.
+            break;
+        }
         if (LoopCount > 200) {
             std::string msg = fmt::format("No convergence. {} = {}, {} = {}",
                 propertySymbols[ifx], X, propertySymbols[ify], Y);
@@ -732,7 +801,7 @@ void Substance::set_TPp(double Temp, double Pressure)
     v_here = vp();
 
     // loop
-    while (P_here = Pp(),
+    while (P_here = vprop(propertyFlag::P),
             fabs(Pressure - P_here) >= ErrP* Pressure || LoopCount == 0) {
         if (P_here < 0.0) {
             BracketSlope(Pressure);
@@ -742,7 +811,7 @@ void Substance::set_TPp(double Temp, double Pressure)
                 dv *= -1.0;
             }
             Set(PropertyPair::TV, Temp, v_here+dv);
-            double dpdv = (Pp() - P_here)/dv;
+            double dpdv = (vprop(propertyFlag::P) - P_here)/dv;
             if (dpdv > 0.0) {
                 BracketSlope(Pressure);
             } else {
@@ -803,4 +872,115 @@ void Substance::set_TPp(double Temp, double Pressure)
     }
     Set(PropertyPair::TV, Temp,v_here);
 }
+
+bool Substance::tabulated()
+{
+    if (T != m_tabT || Rho != m_tabRho) {
+        m_tabT = T;
+        m_tabRho = Rho;
+        m_tabValid = m_table->eval(T, Rho, m_tab);
+        if (m_tabValid) {
+            m_tab[3] += m_energy_offset;
+            m_tab[6] += m_entropy_offset;
+        }
+    }
+    return m_tabValid;
+}
+
+void Substance::tabulatedProp(propertyFlag::type ijob, double* f)
+{
+    switch (ijob) {
+    case propertyFlag::H:
+        f[0] = m_tab[3] + m_tab[0]/Rho;
+        f[1] = T*(m_tab[4] + m_tab[1]/Rho);
+        f[2] = Rho*m_tab[5] + m_tab[2] - m_tab[0]/Rho;
+        break;
+    case propertyFlag::S:
+        f[0] = m_tab[6];
+        f[1] = T*m_tab[7];
+        f[2] = Rho*m_tab[8];
+        break;
+    case propertyFlag::U:
+        f[0] = m_tab[3];
+        f[1] = T*m_tab[4];
+        f[2] = Rho*m_tab[5];
+        break;
+    case propertyFlag::V:
+        f[0] = 1.0/Rho;
+        f[1] = 0.0;
+        f[2] = -1.0/Rho;
+        break;
+    case propertyFlag::P:
+        f[0] = m_tab[0];
+        f[1] = T*m_tab[1];
+        f[2] = Rho*m_tab[2];
+        break;
+    case propertyFlag::T:
+        f[0] = T;
+        f[1] = T;
+        f[2] = 0.0;
+        break;
+    default:
+        throw CanteraError("Substance::tabulatedProp", "invalid job index");
+    }
+}
+
+bool Substance::set_xy_tabulated(propertyFlag::type ifx,
+                                 propertyFlag::type ify, double X, double Y,
+                                 double atx, double aty, double rtx, double rty)
+{
+    double Tsave = T;
+    double Rhosave = Rho;
+    double Xa = fabs(X);
+    double Ya = fabs(Y);
+    propertyFlag::type flags[2] = {ifx, ify};
+    double targets[2] = {X, Y};
+    for (int n = 0; n < 50; n++) {
+        if (!tabulated()) {
+            break;
+        }
+        double f[2][3], err[2];
+        tabulatedProp(ifx, f[0]);
+        tabulatedProp(ify, f[1]);
+        if ((fabs(X - f[0][0]) < atx + rtx*Xa) &&
+            (fabs(Y - f[1][0]) < aty + rty*Ya)) {
+            // A solution inside the dome is metastable, and the two-phase
+            // state is found by the general method
+            if (T >= Tcrit() || !TwoPhase()) {
+                return true;
+            }
+            break;
+        }
+
+        // Temperatures, volumes, and the pressures of vapor-like states are
+        // matched on a logarithmic scale, where they are nearly linear in the
+        // independent variables ln(T) and ln(rho).
+        for (size_t k = 0; k < 2; k++) {
+            bool logScale = (flags[k] == propertyFlag::T ||
+                             flags[k] == propertyFlag::V ||
+                             (flags[k] == propertyFlag::P &&
+                              Rho < 1.0/Vcrit() && f[k][0] > 0.0));
+            if (logScale && targets[k] > 0.0) {
+                err[k] = log(targets[k]/f[k][0]);
+                f[k][1] /= f[k][0];
+                f[k][2] /= f[k][0];
+            } else {
+                err[k] = targets[k] - f[k][0];
+            }
+        }
+
+        double det = f[0][1]*f[1][2] - f[0][2]*f[1][1];
+        if (det == 0.0) {
+            break;
+        }
+        double dlnT = (err[0]*f[1][2] - err[1]*f[0][2])/det;
+        double dlnRho = (err[1]*f[0][1] - err[0]*f[1][1])/det;
+        double scale = std::max({1.0, fabs(dlnT)/0.1, fabs(dlnRho)/1.0});
+        T = clip(T*exp(dlnT/scale), Tmin(), Tmax());
+        Rho *= exp(dlnRho/scale);
+    }
+    T = Tsave;
+    Rho = Rhosave;
+    return false;
+}
 }
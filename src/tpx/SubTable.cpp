@@ -0,0 +1,437 @@
+//! @file SubTable.cpp
+
+// This file is part of Cantera. See License.txt in the top-level directory or
+// at http://www.cantera.org/license.txt for license and copyright information.
+
+#include "cantera/tpx/SubTable.h"
+#include "cantera/base/ct_defs.h"
+
+using namespace Cantera;
+
+namespace tpx
+{
+
+namespace {
+
+//! Step, in ln(T) and ln(rho), of the finite differences used for the
+//! derivatives at the nodes
+const double nodeStep = 1.0e-4;
+
+//! Relative step of the finite differences used for the exact first
+//! derivatives when the table is checked
+const double fdStep = 1.0e-5;
+
+//! Range of the tabulated densities, relative to the critical density and to
+//! the density of the saturated liquid at the lowest temperature
+const double minRelDensity = 1.0e-6;
+const double maxRelDensity = 1.1;
+
+//! Density scale of the density coordinate, relative to the critical density
+const double densityScale = 0.25;
+
+//! Points, in the unit cell, at which the interpolant is checked: the center,
+//! where the error in the values is largest, and the 2x2 Gauss points, near
+//! which the errors in the derivatives are largest.
+const double gaussLo = 0.5 - 0.5 / std::sqrt(3.0);
+const double gaussHi = 0.5 + 0.5 / std::sqrt(3.0);
+const double checkU[5] = {0.5, gaussLo, gaussLo, gaussHi, gaussHi};
+const double checkV[5] = {0.5, gaussLo, gaussHi, gaussLo, gaussHi};
+
+//! Cubic Hermite basis functions on an interval of length *h*
+/*!
+ * H[0] and H[2] multiply the values at the two ends of the interval, and
+ * H[1] and H[3] multiply the derivatives. D[] contains the derivatives of
+ * H[] with respect to the unscaled variable.
+ */
+inline void hermite(double x, double h, double* H, double* D)
+{
+    double x2 = x * x;
+    double xm = 1.0 - x;
+    H[0] = (1.0 + 2.0 * x) * xm * xm;
+    H[1] = h * x * xm * xm;
+    H[2] = x2 * (3.0 - 2.0 * x);
+    H[3] = h * x2 * (x - 1.0);
+    D[0] = -6.0 * x * xm / h;
+    D[1] = xm * (1.0 - 3.0 * x);
+    D[2] = 6.0 * x * xm / h;
+    D[3] = x * (3.0 * x - 2.0);
+}
+
+}
+
+SubstanceTable::SubstanceTable(Substance& sub, double rtol, size_t nT,
+                               size_t nRho, size_t nSat) :
+    m_name(sub.name()),
+    m_rtol(rtol),
+    m_R(GasConstant / sub.MolWt()),
+    m_rhos(densityScale / sub.Vcrit()),
+    m_xmin(log(sub.Tmin())),
+    m_dx(0.0),
+    m_ymin(0.0),
+    m_dy(0.0),
+    m_nT(nT),
+    m_nRho(nRho),
+    m_satTmin(sub.Tmin()),
+    m_satdT(0.0),
+    m_satTmax(sub.Tmin())
+{
+    if (rtol <= 0.0) {
+        throw CanteraError("SubstanceTable::SubstanceTable",
+                           "Invalid tolerance: {}", rtol);
+    }
+    if (nT < 2 || nRho < 2) {
+        throw CanteraError("SubstanceTable::SubstanceTable",
+            "At least two grid points are needed in each direction");
+    }
+
+    // The table is built with the exact equation of state, and the state of
+    // the substance is restored afterwards
+    double Tsave = sub.T;
+    double Rhosave = sub.Rho;
+    std::shared_ptr<const SubstanceTable> tableSave = sub.m_table;
+    sub.m_table.reset();
+    auto restore = [&]() {
+        sub.T = Tsave;
+        sub.Rho = Rhosave;
+        sub.Tslast = Undef;
+        sub.m_table = tableSave;
+        sub.m_tabT = Undef;
+    };
+
+    try {
+        // The densest states are those of the compressed liquid at the
+        // lowest temperature
+        double rhoMax = 3.0 / sub.Vcrit();
+        if (sub.Tmin() < sub.Tcrit()) {
+            sub.T = sub.Tmin();
+            rhoMax = maxRelDensity * sub.ldens();
+        }
+        double rMin = minRelDensity / (sub.Vcrit() * m_rhos);
+        double rMax = rhoMax / m_rhos;
+        m_dx = (log(sub.Tmax()) - m_xmin) / (nT - 1);
+        m_ymin = rMin + log(rMin);
+        m_dy = (rMax + log(rMax) - m_ymin) / (nRho - 1);
+
+        m_nodes.resize(nT * nRho);
+        for (size_t i = 0; i < nT; i++) {
+            for (size_t j = 0; j < nRho; j++) {
+                exactNode(sub, m_xmin + i * m_dx, m_ymin + j * m_dy,
+                          m_nodes[i * nRho + j]);
+            }
+        }
+
+        m_valid.assign((nT - 1) * (nRho - 1), 0);
+        for (size_t i = 0; i + 1 < nT; i++) {
+            for (size_t j = 0; j + 1 < nRho; j++) {
+                bool ok = true;
+                for (size_t k = 0; k < 5 && ok; k++) {
+                    ok = checkPoint(sub, i, j, checkU[k], checkV[k]);
+                }
+                m_valid[i * (nRho - 1) + j] = ok;
+            }
+        }
+
+        if (nSat >= 2 && sub.Tmin() < sub.Tcrit()) {
+            buildSaturation(sub, nSat);
+        }
+    } catch (...) {
+        restore();
+        throw;
+    }
+    restore();
+}
+
+double SubstanceTable::density(double y) const
+{
+    // Solve r + ln(r) = y for the reduced density r, using Newton's method
+    // on q = ln(r). The function is convex, so the iterates decrease
+    // monotonically from q = y.
+    double q = y;
+    for (int n = 0; n < 100; n++) {
+        double r = exp(q);
+        double dq = (r + q - y) / (r + 1.0);
+        q -= dq;
+        if (fabs(dq) < 1.0e-15 * std::max(1.0, fabs(q))) {
+            break;
+        }
+    }
+    return m_rhos * exp(q);
+}
+
+void SubstanceTable::exactState(Substance& sub, double T, double rho,
+                                double* f) const
+{
+    sub.T = T;
+    sub.Rho = rho;
+    f[0] = sub.Pp() / (rho * m_R * T);
+    f[1] = sub.up() - sub.m_energy_offset;
+    f[2] = sub.sp() - sub.m_entropy_offset;
+}
+
+void SubstanceTable::exactNode(Substance& sub, double x, double y,
+                               Node& node) const
+{
+    double rho = density(y);
+    double T = exp(x);
+    double f[3][3][3];
+    for (int p = -1; p <= 1; p++) {
+        for (int q = -1; q <= 1; q++) {
+            exactState(sub, T * exp(p * nodeStep), rho * exp(q * nodeStep),
+                       f[p+1][q+1]);
+        }
+    }
+
+    // Derivative of ln(rho) with respect to y
+    double jac = 1.0 / (1.0 + rho / m_rhos);
+    for (size_t k = 0; k < 3; k++) {
+        node.f[k][0] = f[1][1][k];
+        node.f[k][1] = (f[2][1][k] - f[0][1][k]) / (2.0 * nodeStep);
+        node.f[k][2] = (f[1][2][k] - f[1][0][k]) / (2.0 * nodeStep) * jac;
+        node.f[k][3] = (f[2][2][k] - f[2][0][k] - f[0][2][k] + f[0][0][k])
+                       / (4.0 * nodeStep * nodeStep) * jac;
+    }
+}
+
+void SubstanceTable::interpolate(size_t i, size_t j, double a, double b,
+                                 double (&f)[3][3]) const
+{
+    double Hx[4], Dx[4], Hy[4], Dy[4];
+    hermite(a, m_dx, Hx, Dx);
+    hermite(b, m_dy, Hy, Dy);
+    for (size_t k = 0; k < 3; k++) {
+        f[k][0] = f[k][1] = f[k][2] = 0.0;
+    }
+    for (size_t p = 0; p < 2; p++) {
+        for (size_t q = 0; q < 2; q++) {
+            const Node& node = m_nodes[(i + p) * m_nRho + j + q];
+            double hx0 = Hx[2*p], hx1 = Hx[2*p+1];
+            double dx0 = Dx[2*p], dx1 = Dx[2*p+1];
+            double hy0 = Hy[2*q], hy1 = Hy[2*q+1];
+            double dy0 = Dy[2*q], dy1 = Dy[2*q+1];
+            for (size_t k = 0; k < 3; k++) {
+                const double* c = node.f[k];
+                f[k][0] += (c[0] * hx0 + c[1] * hx1) * hy0
+                         + (c[2] * hx0 + c[3] * hx1) * hy1;
+                f[k][1] += (c[0] * dx0 + c[1] * dx1) * hy0
+                         + (c[2] * dx0 + c[3] * dx1) * hy1;
+                f[k][2] += (c[0] * hx0 + c[1] * hx1) * dy0
+                         + (c[2] * hx0 + c[3] * hx1) * dy1;
+            }
+        }
+    }
+}
+
+void SubstanceTable::convert(double T, double rho, const double (&f)[3][3],
+                             double* props) const
+{
+    // Derivative of y with respect to rho
+    double dydrho = 1.0 / m_rhos + 1.0 / rho;
+    double Z = f[0][0];
+    props[0] = Z * rho * m_R * T;
+    props[1] = rho * m_R * (Z + f[0][1]);
+    props[2] = m_R * T * (Z + rho * dydrho * f[0][2]);
+    for (size_t k = 1; k < 3; k++) {
+        props[3*k] = f[k][0];
+        props[3*k+1] = f[k][1] / T;
+        props[3*k+2] = f[k][2] * dydrho;
+    }
+}
+
+bool SubstanceTable::checkPoint(Substance& sub, size_t i, size_t j, double a,
+                                double b) const
+{
+    double T = exp(m_xmin + (i + a) * m_dx);
+    double rho = density(m_ymin + (j + b) * m_dy);
+    double f[3][3], tab[9];
+    interpolate(i, j, a, b, f);
+    convert(T, rho, f, tab);
+
+    double ex[3], exTp[3], exTm[3], exRp[3], exRm[3];
+    exactState(sub, T, rho, ex);
+    exactState(sub, T * (1.0 + fdStep), rho, exTp);
+    exactState(sub, T * (1.0 - fdStep), rho, exTm);
+    exactState(sub, T, rho * (1.0 + fdStep), exRp);
+    exactState(sub, T, rho * (1.0 - fdStep), exRm);
+    double RT = m_R * T;
+    double P = ex[0] * rho * RT;
+    double dPdT = (exTp[0] * (1.0 + fdStep) - exTm[0] * (1.0 - fdStep))
+                  * rho * RT / (2.0 * fdStep * T);
+    double dPdrho = (exRp[0] * (1.0 + fdStep) - exRm[0] * (1.0 - fdStep))
+                    * RT / (2.0 * fdStep);
+    double cv = (exTp[1] - exTm[1]) / (2.0 * fdStep * T);
+    if (!(dPdrho > 0.0) || !(tab[2] > 0.0)) {
+        return false;
+    }
+
+    // The errors are only sampled at a few points of each cell, so they are
+    // compared to half of the tolerance.
+    double tol = 0.5 * m_rtol;
+    // Relative error in the density at constant (T, P)
+    double dP = tab[0] - P;
+    if (!(fabs(dP) <= tol * rho * dPdrho)) {
+        return false;
+    }
+
+    // Absolute errors in u/RT, h/RT and s/R
+    double du = tab[3] - ex[1];
+    if (!(fabs(du) <= tol * RT) || !(fabs(du + dP / rho) <= tol * RT) ||
+        !(fabs(tab[6] - ex[2]) <= tol * m_R)) {
+        return false;
+    }
+
+    // Relative errors in cv and cp
+    if (!(fabs(tab[4] - cv) <= tol * fabs(cv))) {
+        return false;
+    }
+    double cpEx = cv + T * dPdT * dPdT / (rho * rho * dPdrho);
+    double cpTab = tab[4] + T * tab[1] * tab[1] / (rho * rho * tab[2]);
+    return fabs(cpTab - cpEx) <= tol * fabs(cpEx);
+}
+
+bool SubstanceTable::eval(double T, double rho, double* props) const
+{
+    double r = rho / m_rhos;
+    double a = (log(T) - m_xmin) / m_dx;
+    double b = (r + log(r) - m_ymin) / m_dy;
+    if (!(a >= 0.0 && b >= 0.0 && a <= m_nT - 1 && b <= m_nRho - 1)) {
+        return false;
+    }
+    size_t i = std::min(static_cast<size_t>(a), m_nT - 2);
+    size_t j = std::min(static_cast<size_t>(b), m_nRho - 2);
+    if (!m_valid[i * (m_nRho - 1) + j]) {
+        return false;
+    }
+    double f[3][3];
+    interpolate(i, j, a - i, b - j, f);
+    convert(T, rho, f, props);
+    return true;
+}
+
+double SubstanceTable::validFraction() const
+{
+    size_t nValid = 0;
+    for (char v : m_valid) {
+        nValid += v;
+    }
+    return nValid / double(m_valid.size());
+}
+
+void SubstanceTable::exactSaturation(Substance& sub, double T,
+                                     std::array<double, 6>& y) const
+{
+    sub.T = T;
+    sub.Tslast = Undef;
+    sub.update_sat();
+    double p = sub.Pst;
+    double rhoLiq = sub.Rhf;
+    double rhoGas = sub.Rhv;
+
+    // Clapeyron equation for the slope of the saturation curve
+    double fLiq[3], fGas[3];
+    exactState(sub, T, rhoLiq, fLiq);
+    exactState(sub, T, rhoGas, fGas);
+    double dpsatdT = (fGas[2] - fLiq[2]) / (1.0 / rhoGas - 1.0 / rhoLiq);
+
+    // Slopes of the saturated densities, from dP = dpsat along the curve
+    auto slope = [&](double rho) {
+        double fp[3], fm[3];
+        exactState(sub, T * (1.0 + fdStep), rho, fp);
+        exactState(sub, T * (1.0 - fdStep), rho, fm);
+        double dPdT = (fp[0] * (1.0 + fdStep) - fm[0] * (1.0 - fdStep))
+                      * rho * m_R * T / (2.0 * fdStep * T);
+        exactState(sub, T, rho * (1.0 + fdStep), fp);
+        exactState(sub, T, rho * (1.0 - fdStep), fm);
+        double dPdrho = (fp[0] * (1.0 + fdStep) - fm[0] * (1.0 - fdStep))
+                        * m_R * T / (2.0 * fdStep);
+        return (dpsatdT - dPdT) / dPdrho;
+    };
+    y[0] = log(p);
+    y[1] = rhoLiq;
+    y[2] = rhoGas;
+    y[3] = dpsatdT / p;
+    y[4] = slope(rhoLiq);
+    y[5] = slope(rhoGas);
+}
+
+void SubstanceTable::buildSaturation(Substance& sub, size_t nSat)
+{
+    // Exact saturation states at the nodes and at the midpoints of the
+    // intervals. The table ends before the critical point, where the
+    // saturated densities have infinite slopes.
+    double Tmin = sub.Tmin();
+    double dT = (0.999 * sub.Tcrit() - Tmin) / (nSat - 1);
+    std::vector<std::array<double, 6>> nodes(nSat), mids(nSat - 1);
+    std::vector<char> ok(nSat, 0);
+    for (size_t k = 0; k < nSat; k++) {
+        try {
+            exactSaturation(sub, Tmin + k * dT, nodes[k]);
+            if (k > 0) {
+                exactSaturation(sub, Tmin + (k - 0.5) * dT, mids[k-1]);
+            }
+            ok[k] = 1;
+        } catch (CanteraError&) {
+        }
+    }
+
+    // The saturation table is the longest run of consecutive intervals
+    // which meet the tolerance at their midpoints. The exact solution may
+    // fail at some temperatures, for example for fluids with a very low
+    // vapor pressure at Tmin.
+    m_satdT = dT;
+    size_t bestStart = 0, bestLength = 0, start = 0;
+    for (size_t k = 1; k < nSat; k++) {
+        bool good = ok[k-1] && ok[k];
+        if (good) {
+            m_sat.assign(nodes.begin() + k - 1, nodes.begin() + k + 1);
+            m_satTmin = Tmin + (k - 1) * dT;
+            double y[3];
+            const std::array<double, 6>& mid = mids[k-1];
+            interpolateSat(0, Tmin + (k - 0.5) * dT, y);
+            good = fabs(y[0] - mid[0]) <= m_rtol &&
+                   fabs(y[1] - mid[1]) <= m_rtol * mid[1] &&
+                   fabs(y[2] - mid[2]) <= m_rtol * mid[2];
+        }
+        if (!good) {
+            start = k;
+        } else if (k - start > bestLength) {
+            bestStart = start;
+            bestLength = k - start;
+        }
+    }
+    m_sat.clear();
+    m_satTmin = Tmin + bestStart * dT;
+    m_satTmax = m_satTmin + bestLength * dT;
+    if (bestLength) {
+        m_sat.assign(nodes.begin() + bestStart,
+                     nodes.begin() + bestStart + bestLength + 1);
+    }
+}
+
+void SubstanceTable::interpolateSat(size_t k, double T, double* y) const
+{
+    double H[4], D[4];
+    hermite((T - m_satTmin) / m_satdT - k, m_satdT, H, D);
+    const std::array<double, 6>& a = m_sat[k];
+    const std::array<double, 6>& b = m_sat[k+1];
+    for (size_t n = 0; n < 3; n++) {
+        y[n] = a[n] * H[0] + a[n+3] * H[1] + b[n] * H[2] + b[n+3] * H[3];
+    }
+}
+
+bool SubstanceTable::saturation(double T, double& psat, double& rhoLiq,
+                                double& rhoGas) const
+{
+    if (m_sat.size() < 2 || !(T >= m_satTmin && T <= m_satTmax)) {
+        return false;
+    }
+    size_t k = std::min(static_cast<size_t>((T - m_satTmin) / m_satdT),
+                        m_sat.size() - 2);
+    double y[3];
+    interpolateSat(k, T, y);
+    psat = exp(y[0]);
+    rhoLiq = y[1];
+    rhoGas = y[2];
+    return true;
+}
+
+}
@@ -16,9 +16,11 @@ namespace Cantera
 DustyGasTransport::DustyGasTransport(thermo_t* thermo) :
     Transport(thermo),
     m_temp(-1.0),
+    m_pres(-1.0),
     m_gradP(0.0),
     m_knudsen_ok(false),
     m_bulk_ok(false),
+    m_multidiff_ok(false),
     m_porosity(0.0),
     m_tortuosity(1.0),
     m_pore_radius(0.0),
@@ -55,6 +57,9 @@ void DustyGasTransport::initialize(ThermoPhase* phase, Transport* gastr)
     // set flags all false
     m_knudsen_ok = false;
     m_bulk_ok = false;
+    m_multidiff_ok = false;
+    m_temp = -1.0;
+    m_pres = -1.0;
 
     m_spwork.resize(m_nsp);
     m_spwork2.resize(m_nsp);
@@ -145,10 +150,6 @@ void DustyGasTransport::getMolarFluxes(const doublereal* const state1,
     m_thermo->setState_TPX(tbar, pbar, cbar);
     updateMultiDiffCoeffs();
 
-    // Multiply m_multidiff and gradc together and store the result in fluxes[]
-    multiply(m_multidiff, gradc, fluxes);
-    divide_each(cbar, cbar + m_nsp, m_dk.begin());
-
     // if no permeability has been specified, use result for
     // close-packed spheres
     double b = 0.0;
@@ -161,11 +162,21 @@ void DustyGasTransport::getMolarFluxes(const doublereal* const state1,
         b = m_perm;
     }
     b *= gradp / m_gastran->viscosity();
-    scale(cbar, cbar + m_nsp, cbar, b);
 
-    // Multiply m_multidiff with cbar and add it to fluxes
-    increment(m_multidiff, cbar, fluxes);
-    scale(fluxes, fluxes + m_nsp, fluxes, -1.0);
+    // Solve H * fluxes = -(gradc + b * cbar / D^knud) with the factored H
+    for (size_t k = 0; k < m_nsp; k++) {
+        fluxes[k] = -(gradc[k] + b * cbar[k] / m_dk[k]);
+    }
+    solveFactored(m_multidiff, fluxes);
+}
+
+void DustyGasTransport::getMolarFluxesBatch(size_t n, const double* states1,
+        const double* states2, const double* delta, double* fluxes)
+{
+    for (size_t i = 0; i < n; i++) {
+        getMolarFluxes(states1 + i * (m_nsp + 2), states2 + i * (m_nsp + 2),
+                       delta[i], fluxes + i * m_nsp);
+    }
 }
 
 void DustyGasTransport::updateMultiDiffCoeffs()
@@ -175,24 +186,30 @@ void DustyGasTransport::updateMultiDiffCoeffs()
 
     // update the mole fractions
     updateTransport_C();
+    if (m_multidiff_ok && m_bulk_ok && m_knudsen_ok) {
+        return;
+    }
     eval_H_matrix();
 
-    // invert H
-    int ierr = invert(m_multidiff);
+    // factor H
+    int ierr = factor(m_multidiff);
     if (ierr != 0) {
         throw CanteraError("DustyGasTransport::updateMultiDiffCoeffs",
-                           "invert returned ierr = {}", ierr);
+                           "factor returned ierr = {}", ierr);
     }
+    m_multidiff_ok = true;
 }
 
 void DustyGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* const d)
 {
     updateMultiDiffCoeffs();
-    for (size_t i = 0; i < m_nsp; i++) {
-        for (size_t j = 0; j < m_nsp; j++) {
-            d[ld*j + i] = m_multidiff(i,j);
+    // The multicomponent diffusion coefficients are the inverse of H
+    for (size_t j = 0; j < m_nsp; j++) {
+        for (size_t i = 0; i < m_nsp; i++) {
+            d[ld*j + i] = (i == j) ? 1.0 : 0.0;
         }
     }
+    solveFactored(m_multidiff, d, m_nsp, ld);
 }
 
 void DustyGasTransport::updateTransport_T()
@@ -207,15 +224,22 @@ void DustyGasTransport::updateTransport_T()
 
 void DustyGasTransport::updateTransport_C()
 {
-    m_thermo->getMoleFractions(m_x.data());
-
-    // add an offset to avoid a pure species condition
-    // (check - this may be unnecessary)
+    // diffusion coeffs depend on Pressure
+    bool changed = (m_pres != m_thermo->pressure());
+    m_pres = m_thermo->pressure();
     for (size_t k = 0; k < m_nsp; k++) {
-        m_x[k] = std::max(Tiny, m_x[k]);
+        // add an offset to avoid a pure species condition
+        // (check - this may be unnecessary)
+        double x = std::max(Tiny, m_thermo->moleFraction(k));
+        if (x != m_x[k]) {
+            m_x[k] = x;
+            changed = true;
+        }
+    }
+    if (changed) {
+        m_bulk_ok = false;
+        m_multidiff_ok = false;
     }
-    // diffusion coeffs depend on Pressure
-    m_bulk_ok = false;
 }
 
 void DustyGasTransport::setPorosity(doublereal porosity)
@@ -27,79 +27,195 @@ using namespace std;
 namespace Cantera
 {
 
+namespace
+{
+
+//! Viscosity [Pa-s] of the methane reference fluid of the Ely-Hanley method
+//! at the temperature *T0* [K]
+double methaneViscosity(double T0)
+{
+    double t = cbrt(T0);
+    double t2 = t*t;
+    return 1e-7*(2.90774e6/T0 - 3.31287e6/t2 + 1.60810e6/t - 4.33190e5
+                 + 7.06248e4*t - 7.11662e3*t2 + 4.32517e2*T0
+                 - 1.44591e1*T0*t + 2.03712e-1*T0*t2);
+}
+
+}
+
 HighPressureGasTransport::HighPressureGasTransport(thermo_t* thermo)
 : MultiTransport(thermo)
+, m_mix_state(-1)
+, m_Tc_mix(0.0)
+, m_Pc_mix(0.0)
+, m_ksi(0.0)
+, m_FQ_ratio(1.0)
 {
 }
 
+void HighPressureGasTransport::init(thermo_t* thermo, int mode, int log_level)
+{
+    MultiTransport::init(thermo, mode, log_level);
+
+    // Pure species critical properties, evaluated by setting the composition
+    // of the phase to each of the pure species in turn
+    m_Tcrit.resize(m_nsp);
+    m_Pcrit.resize(m_nsp);
+    m_Vcrit.resize(m_nsp);
+    m_Zcrit.resize(m_nsp);
+    for (size_t i = 0; i < m_nsp; i++) {
+        m_Tcrit[i] = Tcrit_i(i);
+        m_Pcrit[i] = Pcrit_i(i);
+        m_Vcrit[i] = Vcrit_i(i);
+        m_Zcrit[i] = Zcrit_i(i);
+    }
+
+    // Constants of the polarity and quantum corrections of the Lucas method.
+    // SCD Note:  This assumes the species of interest (He, H2, and D2) have
+    //   been named in this specific way.  They are perhaps the most obvious
+    //   names, but it would of course be preferred to have a more general
+    //   approach, here.
+    m_mu_r.resize(m_nsp);
+    m_FP_polar.resize(m_nsp);
+    m_quantumQ.assign(m_nsp, 0.0);
+    for (size_t i = 0; i < m_nsp; i++) {
+        m_mu_r[i] = 52.46*100000*m_dipole(i,i)*m_dipole(i,i)
+            *m_Pcrit[i]/(m_Tcrit[i]*m_Tcrit[i]);
+        m_FP_polar[i] = 30.55*pow(0.292 - m_Zcrit[i], 1.72);
+        std::string name = m_thermo->speciesName(i);
+        if (name == "He") {
+            m_quantumQ[i] = 1.38;
+        } else if (name == "H2") {
+            m_quantumQ[i] = 0.76;
+        } else if (name == "D2") {
+            m_quantumQ[i] = 0.52;
+        }
+    }
+
+    m_sqrt_mw_inv.resize(m_nsp, m_nsp);
+    for (size_t i = 0; i < m_nsp; i++) {
+        for (size_t j = 0; j < m_nsp; j++) {
+            m_sqrt_mw_inv(i,j) = sqrt((m_mw[i] + m_mw[j])/(2*m_mw[i]*m_mw[j]));
+        }
+    }
+
+    m_X.resize(m_nsp);
+    m_L_i.resize(m_nsp);
+    m_h_cbrt.resize(m_nsp);
+    m_f_root4.resize(m_nsp);
+    m_mix_state = -1;
+}
+
+void HighPressureGasTransport::updateMixingRules()
+{
+    if (m_mix_state == m_thermo->stateMFNumber()) {
+        return;
+    }
+    m_mix_state = m_thermo->stateMFNumber();
+    m_thermo->getMoleFractions(m_X.data());
+
+    // Mole-fraction-weighted mixture critical properties used by the Lucas
+    // method
+    double Tc_mix = 0.;
+    double Pc_mix_n = 0.;
+    double Pc_mix_d = 0.;
+    double MW_H = m_mw[0];
+    double MW_L = m_mw[0];
+    double x_H = m_X[0];
+    for (size_t i = 0; i < m_nsp; i++) {
+        Tc_mix += m_Tcrit[i]*m_X[i];
+        Pc_mix_n += m_X[i]*m_Zcrit[i]; //numerator
+        Pc_mix_d += m_X[i]*m_Vcrit[i]; //denominator
+
+        // Need to calculate ratio of heaviest to lightest species:
+        if (m_mw[i] > MW_H) {
+            MW_H = m_mw[i];
+            x_H = m_X[i];
+        } else if (m_mw[i] < MW_L) {
+            MW_L = m_mw[i];
+        }
+    }
+    m_Tc_mix = Tc_mix;
+    m_Pc_mix = GasConstant*Tc_mix*Pc_mix_n/Pc_mix_d;
+    double MW_mix = m_thermo->meanMolecularWeight();
+    m_ksi = pow(GasConstant*Tc_mix*3.6277*pow(10.0,53.0)/(pow(MW_mix,3)
+                *pow(m_Pc_mix,4)),1.0/6.0);
+
+    double ratio = MW_H/MW_L;
+    m_FQ_ratio = 1.0;
+    if (ratio > 9 && x_H > 0.05 && x_H < 0.7) {
+        m_FQ_ratio = 1 - 0.01*pow(ratio,0.87);
+    }
+}
+
 double HighPressureGasTransport::thermalConductivity()
 {
     //  Method of Ely and Hanley:
     update_T();
-    doublereal Lprime_m = 0.0;
+    updateMixingRules();
     const doublereal c1 = 1./16.04;
-    size_t nsp = m_thermo->nSpecies();
-    vector_fp molefracs(nsp);
-    m_thermo->getMoleFractions(&molefracs[0]);
-    vector_fp cp_0_R(nsp);
-    m_thermo->getCp_R_ref(&cp_0_R[0]);
-
-    vector_fp L_i(nsp);
-    vector_fp f_i(nsp);
-    vector_fp h_i(nsp);
-    vector_fp V_k(nsp);
-
-    m_thermo -> getPartialMolarVolumes(&V_k[0]);
-    doublereal L_i_min = BigNumber;
+    const vector_fp& molefracs = m_X;
+    double* cp_0_R = m_spwork1.data();
+    double* V_k = m_spwork2.data();
+    m_thermo->getCp_R_ref(cp_0_R);
+    m_thermo->getPartialMolarVolumes(V_k);
 
     for (size_t i = 0; i < m_nsp; i++) {
-        doublereal Tc_i = Tcrit_i(i);
-        doublereal Vc_i = Vcrit_i(i);
-        doublereal T_r = m_thermo->temperature()/Tc_i;
+        doublereal Tc_i = m_Tcrit[i];
+        doublereal Vc_i = m_Vcrit[i];
+        doublereal T_r = m_temp/Tc_i;
         doublereal V_r = V_k[i]/Vc_i;
         doublereal T_p = std::min(T_r,2.0);
         doublereal V_p = std::max(0.5,std::min(V_r,2.0));
+        doublereal log_T_p = log(T_p);
 
         // Calculate variables for density-independent component:
         doublereal theta_p = 1.0 + (m_w_ac[i] - 0.011)*(0.56553
-            - 0.86276*log(T_p) - 0.69852/T_p);
+            - 0.86276*log_T_p - 0.69852/T_p);
         doublereal phi_p = (1.0 + (m_w_ac[i] - 0.011)*(0.38560
-            - 1.1617*log(T_p)))*0.288/Zcrit_i(i);
+            - 1.1617*log_T_p))*0.288/m_Zcrit[i];
         doublereal f_fac = Tc_i*theta_p/190.4;
         doublereal h_fac = 1000*Vc_i*phi_p/99.2;
-        doublereal T_0 = m_temp/f_fac;
-        doublereal mu_0 = 1e-7*(2.90774e6/T_0 - 3.31287e6*pow(T_0,-2./3.)
-            + 1.60810e6*pow(T_0,-1./3.) - 4.33190e5 + 7.06248e4*pow(T_0,1./3.)
-            - 7.11662e3*pow(T_0,2./3.) + 4.32517e2*T_0 - 1.44591e1*pow(T_0,4./3.)
-            + 2.03712e-1*pow(T_0,5./3.));
+        doublereal mu_0 = methaneViscosity(m_temp/f_fac);
         doublereal H = sqrt(f_fac*16.04/m_mw[i])*pow(h_fac,-2./3.);
         doublereal mu_i = mu_0*H*m_mw[i]*c1;
-        L_i[i] = mu_i*1.32*GasConstant*(cp_0_R[i] - 2.5)/m_mw[i];
-        L_i_min = min(L_i_min,L_i[i]);
+        m_L_i[i] = mu_i*1.32*GasConstant*(cp_0_R[i] - 2.5)/m_mw[i];
+
         // Calculate variables for density-dependent component:
-        doublereal theta_s = 1 + (m_w_ac[i] - 0.011)*(0.09057 - 0.86276*log(T_p)
+        doublereal theta_s = 1 + (m_w_ac[i] - 0.011)*(0.09057 - 0.86276*log_T_p
             + (0.31664 - 0.46568/T_p)*(V_p - 0.5));
         doublereal phi_s = (1 + (m_w_ac[i] - 0.011)*(0.39490*(V_p - 1.02355)
-            - 0.93281*(V_p - 0.75464)*log(T_p)))*0.288/Zcrit_i(i);
-        f_i[i] = Tc_i*theta_s/190.4;
-        h_i[i] = 1000*Vc_i*phi_s/99.2;
+            - 0.93281*(V_p - 0.75464)*log_T_p))*0.288/m_Zcrit[i];
+        doublereal f_i = Tc_i*theta_s/190.4;
+        doublereal h_i = 1000*Vc_i*phi_s/99.2;
+        m_f_root4[i] = sqrt(sqrt(f_i));
+        m_h_cbrt[i] = cbrt(h_i);
     }
 
+    // Mixing rules. The pair terms are symmetric, and the combining rules are
+    // evaluated with the roots computed above:
+    //     f_ij = sqrt(f_i*f_j),
+    //     h_ij = ((h_i^(1/3) + h_j^(1/3))/2)^3
+    doublereal Lprime_m = 0.0;
     doublereal h_m = 0;
     doublereal f_m = 0;
     doublereal mw_m = 0;
     for (size_t i = 0; i < m_nsp; i++) {
-        for (size_t j = 0; j < m_nsp; j++) {
+        for (size_t j = i; j < m_nsp; j++) {
+            doublereal xx = (i == j) ? molefracs[i]*molefracs[i]
+                                     : 2*molefracs[i]*molefracs[j];
             // Density-independent component:
-            doublereal L_ij = 2*L_i[i]*L_i[j]/(L_i[i] + L_i[j] + Tiny);
-            Lprime_m += molefracs[i]*molefracs[j]*L_ij;
+            doublereal L_ij = 2*m_L_i[i]*m_L_i[j]/(m_L_i[i] + m_L_i[j] + Tiny);
+            Lprime_m += xx*L_ij;
             // Additional variables for density-dependent component:
-            doublereal f_ij = sqrt(f_i[i]*f_i[j]);
-            doublereal h_ij = 0.125*pow(pow(h_i[i],1./3.) + pow(h_i[j],1./3.),3.);
-            doublereal mw_ij_inv = (m_mw[i] + m_mw[j])/(2*m_mw[i]*m_mw[j]);
-            f_m += molefracs[i]*molefracs[j]*f_ij*h_ij;
-            h_m += molefracs[i]*molefracs[j]*h_ij;
-            mw_m += molefracs[i]*molefracs[j]*sqrt(mw_ij_inv*f_ij)*pow(h_ij,-4./3.);
+            doublereal f_ij_root = m_f_root4[i]*m_f_root4[j];
+            doublereal f_ij = f_ij_root*f_ij_root;
+            doublereal h_ij_cbrt = 0.5*(m_h_cbrt[i] + m_h_cbrt[j]);
+            doublereal h_ij_cbrt2 = h_ij_cbrt*h_ij_cbrt;
+            doublereal h_ij = h_ij_cbrt2*h_ij_cbrt;
+            f_m += xx*f_ij*h_ij;
+            h_m += xx*h_ij;
+            mw_m += xx*m_sqrt_mw_inv(i,j)*f_ij_root/(h_ij_cbrt2*h_ij_cbrt2);
         }
     }
 
@@ -108,10 +224,7 @@ double HighPressureGasTransport::thermalConductivity()
 
     doublereal rho_0 = 16.04*h_m/(1000*m_thermo->molarVolume());
     doublereal T_0 = m_temp/f_m;
-    doublereal mu_0 = 1e-7*(2.90774e6/T_0 - 3.31287e6*pow(T_0,-2./3.)
-                + 1.60810e6*pow(T_0,-1./3.) - 4.33190e5 + 7.06248e4
-                *pow(T_0,1./3.) - 7.11662e3*pow(T_0,2./3.) + 4.32517e2*T_0
-                - 1.44591e1*pow(T_0,4./3.) + 2.03712e-1*pow(T_0,5./3.));
+    doublereal mu_0 = methaneViscosity(T_0);
     doublereal L_1m = 1944*mu_0;
     doublereal L_2m = (-2.5276e-4 + 3.3433e-4*pow(1.12 - log(T_0/1.680e2),2))*rho_0;
     doublereal L_3m = exp(-7.19771 + 85.67822/T_0)*(exp((12.47183
@@ -136,60 +249,59 @@ void HighPressureGasTransport::getThermalDiffCoeffs(doublereal* const dt)
 
 void HighPressureGasTransport::getBinaryDiffCoeffs(const size_t ld, doublereal* const d)
 {
-    vector_fp PcP(5);
-    size_t nsp = m_thermo->nSpecies();
-    vector_fp molefracs(nsp);
-    m_thermo->getMoleFractions(&molefracs[0]);
-
     update_T();
+    updateMixingRules();
     // Evaluate the binary diffusion coefficients from the polynomial fits.
     // This should perhaps be preceded by a check to see whether any of T, P, or
     //   C have changed.
     //if (!m_bindiff_ok) {
     updateDiff_T();
     //}
-    if (ld < nsp) {
+    if (ld < m_nsp) {
         throw CanteraError("HighPressureTransport::getBinaryDiffCoeffs()", "ld is too small");
     }
-    doublereal rp = 1.0/m_thermo->pressure();
-    for (size_t i = 0; i < nsp; i++) {
-        for (size_t j = 0; j < nsp; j++) {
-            // Add an offset to avoid a condition where x_i and x_j both equal
-            // zero (this would lead to Pr_ij = Inf):
-            doublereal x_i = std::max(Tiny, molefracs[i]);
-            doublereal x_j = std::max(Tiny, molefracs[j]);
-
-            // Weight mole fractions of i and j so that X_i + X_j = 1.0:
-            x_i = x_i/(x_i + x_j);
-            x_j = x_j/(x_i + x_j);
-
-            //Calculate Tr and Pr based on mole-fraction-weighted crit constants:
-            double Tr_ij = m_temp/(x_i*Tcrit_i(i) + x_j*Tcrit_i(j));
-            double Pr_ij = m_thermo->pressure()/(x_i*Pcrit_i(i) + x_j*Pcrit_i(j));
-
-            double P_corr_ij;
-            if (Pr_ij < 0.1) {
-                // If pressure is low enough, no correction is needed:
-                P_corr_ij = 1;
-            }else {
-                // Otherwise, calculate the parameters for Takahashi correlation
-                // by interpolating on Pr_ij:
-                P_corr_ij = setPcorr(Pr_ij, Tr_ij);
-
-                // If the reduced temperature is too low, the correction factor
-                // P_corr_ij will be < 0:
-                if (P_corr_ij<0) {
-                    P_corr_ij = Tiny;
-                }
-            }
-
+    doublereal P = m_thermo->pressure();
+    doublereal rp = 1.0/P;
+    for (size_t i = 0; i < m_nsp; i++) {
+        for (size_t j = 0; j < m_nsp; j++) {
             // Multiply the standard low-pressure binary diffusion coefficient
             // (m_bdiff) by the Takahashi correction factor P_corr_ij:
-            d[ld*j + i] = P_corr_ij*rp * m_bdiff(i,j);
+            d[ld*j + i] = Pcorr_ij(i, j, P)*rp * m_bdiff(i,j);
         }
     }
 }
 
+double HighPressureGasTransport::Pcorr_ij(size_t i, size_t j, double P)
+{
+    // Add an offset to avoid a condition where x_i and x_j both equal
+    // zero (this would lead to Pr_ij = Inf):
+    doublereal x_i = std::max(Tiny, m_X[i]);
+    doublereal x_j = std::max(Tiny, m_X[j]);
+
+    // Weight mole fractions of i and j so that X_i + X_j = 1.0:
+    x_i = x_i/(x_i + x_j);
+    x_j = x_j/(x_i + x_j);
+
+    //Calculate Tr and Pr based on mole-fraction-weighted crit constants:
+    double Tr_ij = m_temp/(x_i*m_Tcrit[i] + x_j*m_Tcrit[j]);
+    double Pr_ij = P/(x_i*m_Pcrit[i] + x_j*m_Pcrit[j]);
+
+    if (Pr_ij < 0.1) {
+        // If pressure is low enough, no correction is needed:
+        return 1;
+    }
+    // Otherwise, calculate the parameters for Takahashi correlation by
+    // interpolating on Pr_ij:
+    double P_corr_ij = setPcorr(Pr_ij, Tr_ij);
+
+    // If the reduced temperature is too low, the correction factor
+    // P_corr_ij will be < 0:
+    if (P_corr_ij<0) {
+        P_corr_ij = Tiny;
+    }
+    return P_corr_ij;
+}
+
 void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* const d)
 {
     // Not currently implemented.  m_Lmatrix inversion returns NaN.  Needs to be
@@ -208,10 +320,7 @@ void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* c
 
     // Correct the binary diffusion coefficients for high-pressure effects; this
     // is basically the same routine used in 'getBinaryDiffCoeffs,' above:
-    size_t nsp = m_thermo->nSpecies();
-    vector_fp molefracs(nsp);
-    m_thermo->getMoleFractions(&molefracs[0]);
-    update_T();
+    updateMixingRules();
     // Evaluate the binary diffusion coefficients from the polynomial fits -
     // this should perhaps be preceded by a check for changes in T, P, or C.
     updateDiff_T();
@@ -220,28 +329,10 @@ void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* c
         throw CanteraError("HighPressureTransport::getMultiDiffCoeffs()",
                            "ld is too small");
     }
+    doublereal P = m_thermo->pressure();
     for (size_t i = 0; i < m_nsp; i++) {
         for (size_t j = 0; j < m_nsp; j++) {
-            // Add an offset to avoid a condition where x_i and x_j both equal
-            //   zero (this would lead to Pr_ij = Inf):
-            doublereal x_i = std::max(Tiny, molefracs[i]);
-            doublereal x_j = std::max(Tiny, molefracs[j]);
-            x_i = x_i/(x_i+x_j);
-            x_j = x_j/(x_i+x_j);
-            double Tr_ij = m_temp/(x_i*Tcrit_i(i) + x_j*Tcrit_i(j));
-            double Pr_ij = m_thermo->pressure()/(x_i*Pcrit_i(i) + x_j*Pcrit_i(j));
-
-            double P_corr_ij;
-            if (Pr_ij < 0.1) {
-                P_corr_ij = 1;
-            }else {
-                P_corr_ij = setPcorr(Pr_ij, Tr_ij);
-                if (P_corr_ij<0) {
-                    P_corr_ij = Tiny;
-                }
-            }
-
-            m_bdiff(i,j) *= P_corr_ij;
+            m_bdiff(i,j) *= Pcorr_ij(i, j, P);
         }
     }
     m_bindiff_ok = false; // m_bdiff is overwritten by the above routine.
@@ -252,7 +343,7 @@ void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* c
     // evaluate L0000 if the temperature or concentrations have
     // changed since it was last evaluated.
     if (!m_l0000_ok) {
-        eval_L0000(molefracs.data());
+        eval_L0000(m_X.data());
     }
 
     // invert L00,00
@@ -270,7 +361,7 @@ void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* c
     for (size_t i = 0; i < m_nsp; i++) {
         for (size_t j = 0; j < m_nsp; j++) {
             double c = prefactor/m_mw[j];
-            d[ld*j + i] = c*molefracs[i]*(m_Lmatrix(i,j) - m_Lmatrix(i,i));
+            d[ld*j + i] = c*m_X[i]*(m_Lmatrix(i,j) - m_Lmatrix(i,i));
         }
     }
 }
@@ -278,76 +369,37 @@ void HighPressureGasTransport::getMultiDiffCoeffs(const size_t ld, doublereal* c
 doublereal HighPressureGasTransport::viscosity()
 {
     // Calculate the high-pressure mixture viscosity, based on the Lucas method.
-    double Tc_mix = 0.;
-    double Pc_mix_n = 0.;
-    double Pc_mix_d = 0.;
-    double MW_mix = m_thermo->meanMolecularWeight();
-    double MW_H = m_mw[0];
-    double MW_L = m_mw[0];
+    updateMixingRules();
+    const vector_fp& molefracs = m_X;
     doublereal FP_mix_o = 0;
     doublereal FQ_mix_o = 0;
     doublereal tKelvin = m_thermo->temperature();
-    double Pvp_mix = m_thermo->satPressure(tKelvin);
-    size_t nsp = m_thermo->nSpecies();
-    vector_fp molefracs(nsp);
-    m_thermo->getMoleFractions(&molefracs[0]);
 
-    double x_H = molefracs[0];
     for (size_t i = 0; i < m_nsp; i++) {
-        // Calculate pure-species critical constants and add their contribution
-        // to the mole-fraction-weighted mixture averages:
-        double Tc = Tcrit_i(i);
-        double Tr = tKelvin/Tc;
-        double Zc = Zcrit_i(i);
-        Tc_mix += Tc*molefracs[i];
-        Pc_mix_n += molefracs[i]*Zc; //numerator
-        Pc_mix_d += molefracs[i]*Vcrit_i(i); //denominator
+        double Tr = tKelvin/m_Tcrit[i];
 
-        // Need to calculate ratio of heaviest to lightest species:
-        if (m_mw[i] > MW_H) {
-            MW_H = m_mw[i];
-            x_H = molefracs[i];
-        } else if (m_mw[i] < MW_L) {
-            MW_L = m_mw[i];        }
-
-        // Calculate reduced dipole moment for polar correction term:
-        doublereal mu_ri = 52.46*100000*m_dipole(i,i)*m_dipole(i,i)
-            *Pcrit_i(i)/(Tc*Tc);
+        // Polar correction term, from the reduced dipole moment:
+        doublereal mu_ri = m_mu_r[i];
         if (mu_ri < 0.022) {
             FP_mix_o += molefracs[i];
         } else if (mu_ri < 0.075) {
-            FP_mix_o += molefracs[i]*(1. + 30.55*pow(0.292 - Zc, 1.72));
-        } else { FP_mix_o += molefracs[i]*(1. + 30.55*pow(0.292 - Zc, 1.72)
-                                    *fabs(0.96 + 0.1*(Tr - 0.7)));
+            FP_mix_o += molefracs[i]*(1. + m_FP_polar[i]);
+        } else {
+            FP_mix_o += molefracs[i]*(1. + m_FP_polar[i]
+                                      *fabs(0.96 + 0.1*(Tr - 0.7)));
         }
 
-        // Calculate contribution to quantum correction term.
-        // SCD Note:  This assumes the species of interest (He, H2, and D2) have
-        //   been named in this specific way.  They are perhaps the most obvious
-        //   names, but it would of course be preferred to have a more general
-        //   approach, here.
-        std::vector<std::string> spnames = m_thermo->speciesNames();
-        if (spnames[i] == "He") {
-            FQ_mix_o += molefracs[i]*FQ_i(1.38,Tr,m_mw[i]);
-        } else if (spnames[i] == "H2") {
-            FQ_mix_o += molefracs[i]*(FQ_i(0.76,Tr,m_mw[i]));
-        } else if (spnames[i] == "D2") {
-            FQ_mix_o += molefracs[i]*(FQ_i(0.52,Tr,m_mw[i]));
+        // Contribution to quantum correction term:
+        if (m_quantumQ[i] != 0.0) {
+            FQ_mix_o += molefracs[i]*FQ_i(m_quantumQ[i],Tr,m_mw[i]);
         } else {
             FQ_mix_o += molefracs[i];
         }
     }
 
-    double Tr_mix = tKelvin/Tc_mix;
-    double Pc_mix = GasConstant*Tc_mix*Pc_mix_n/Pc_mix_d;
-    double Pr_mix = m_thermo->pressure()/Pc_mix;
-    double ratio = MW_H/MW_L;
-    double ksi = pow(GasConstant*Tc_mix*3.6277*pow(10.0,53.0)/(pow(MW_mix,3)
-                        *pow(Pc_mix,4)),1.0/6.0);
-
-    if (ratio > 9 && x_H > 0.05 && x_H < 0.7) {
-        FQ_mix_o *= 1 - 0.01*pow(ratio,0.87);
-    }
+    double Tr_mix = tKelvin/m_Tc_mix;
+    double Pr_mix = m_thermo->pressure()/m_Pc_mix;
+    FQ_mix_o *= m_FQ_ratio;
 
     // Calculate Z1m
     double Z1m = (0.807*pow(Tr_mix,0.618) - 0.357*exp(-0.449*Tr_mix)
@@ -356,7 +408,8 @@ doublereal HighPressureGasTransport::viscosity()
     // Calculate Z2m:
     double Z2m;
     if (Tr_mix <= 1.0) {
-        if (Pr_mix < Pvp_mix/Pc_mix) {
+        double Pvp_mix = m_thermo->satPressure(tKelvin);
+        if (Pr_mix < Pvp_mix/m_Pc_mix) {
             doublereal alpha = 3.262 + 14.98*pow(Pr_mix,5.508);
             doublereal beta = 1.390 + 5.746*Pr_mix;
             Z2m = 0.600 + 0.760*pow(Pr_mix,alpha) + (0.6990*pow(Pr_mix,beta) -
@@ -389,7 +442,33 @@ doublereal HighPressureGasTransport::viscosity()
 
     // Return the viscosity:
     return Z2m*(1 + (FP_mix_o - 1)*pow(Y,-3))*(1 + (FQ_mix_o - 1)
-            *(1/Y - 0.007*pow(log(Y),4)))/(ksi*FP_mix_o*FQ_mix_o);
+            *(1/Y - 0.007*pow(log(Y),4)))/(m_ksi*FP_mix_o*FQ_mix_o);
+}
+
+void HighPressureGasTransport::getPropertiesBatch(size_t nStates,
+        const double* T, const double* P, const double* X, size_t ldX,
+        double* visc, double* cond)
+{
+    vector_fp state;
+    m_thermo->saveState(state);
+    try {
+        for (size_t n = 0; n < nStates; n++) {
+            if (n == 0 || ldX != 0) {
+                m_thermo->setMoleFractions(X + n * ldX);
+            }
+            m_thermo->setState_TP(T[n], P[n]);
+            if (visc) {
+                visc[n] = viscosity();
+            }
+            if (cond) {
+                cond[n] = thermalConductivity();
+            }
+        }
+    } catch (...) {
+        m_thermo->restoreState(state);
+        throw;
+    }
+    m_thermo->restoreState(state);
 }
 
 // Pure species critical properties - Tc, Pc, Vc, Zc:
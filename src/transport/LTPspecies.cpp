@@ -242,5 +242,121 @@ doublereal LTPspecies_ExpT::getSpeciesTransProp()
     }
     return m_prop;
 }
+void LTPspeciesArray::init(const std::vector<LTPspecies*>& props)
+{
+    *this = LTPspeciesArray();
+    m_size = props.size();
+    m_weights.assign(m_size, 1.0);
+    for (size_t k = 0; k < m_size; k++) {
+        const LTPspecies* p = props[k];
+        if (!p) {
+            m_constIndex.push_back(k);
+            m_const.push_back(0.0);
+            continue;
+        }
+        m_weights[k] = p->getMixWeight();
+        const vector_fp& c = p->coeffs();
+        switch (p->model()) {
+        case LTP_TD_CONSTANT:
+            m_constIndex.push_back(k);
+            m_const.push_back(c[0]);
+            break;
+        case LTP_TD_ARRHENIUS:
+            m_arrIndex.push_back(k);
+            m_logA.push_back(c[3]);
+            m_arrN.push_back(c[1]);
+            m_arrTact.push_back(p->property() == TP_VISCOSITY ? c[2] : -c[2]);
+            break;
+        case LTP_TD_POLY:
+            m_polyIndex.push_back(k);
+            m_nPoly = std::max(m_nPoly, c.size());
+            break;
+        case LTP_TD_EXPT:
+            m_expIndex.push_back(k);
+            m_nExp = std::max(m_nExp, c.size());
+            break;
+        default:
+            m_otherIndex.push_back(k);
+            m_other.push_back(props[k]);
+        }
+    }
+
+    size_t n = m_polyIndex.size();
+    m_poly.assign(m_nPoly * n, 0.0);
+    for (size_t j = 0; j < n; j++) {
+        const vector_fp& c = props[m_polyIndex[j]]->coeffs();
+        for (size_t i = 0; i < c.size(); i++) {
+            m_poly[i * n + j] = c[i];
+        }
+    }
+    n = m_expIndex.size();
+    m_exp.assign(m_nExp * n, 0.0);
+    for (size_t j = 0; j < n; j++) {
+        const vector_fp& c = props[m_expIndex[j]]->coeffs();
+        for (size_t i = 0; i < c.size(); i++) {
+            m_exp[i * n + j] = c[i];
+        }
+    }
+    m_work.resize(std::max({m_arrIndex.size(), m_polyIndex.size(),
+                            m_expIndex.size()}));
+}
+
+void LTPspeciesArray::getValues(double T, double* values)
+{
+    for (size_t j = 0; j < m_constIndex.size(); j++) {
+        values[m_constIndex[j]] = m_const[j];
+    }
+
+    // A T^n exp(-E/RT), with the sign of E reversed for viscosity
+    size_t n = m_arrIndex.size();
+    if (n) {
+        double logT = std::log(T);
+        for (size_t j = 0; j < n; j++) {
+            m_work[j] = std::exp(m_logA[j] + m_arrN[j] * logT
+                                 + m_arrTact[j] / T);
+        }
+        for (size_t j = 0; j < n; j++) {
+            values[m_arrIndex[j]] = m_work[j];
+        }
+    }
+
+    // f[0] + f[1] T + ... + f[N] T^N
+    n = m_polyIndex.size();
+    if (n) {
+        std::fill(m_work.begin(), m_work.begin() + n, 0.0);
+        double tempN = 1.0;
+        for (size_t i = 0; i < m_nPoly; i++) {
+            const double* c = &m_poly[i * n];
+            for (size_t j = 0; j < n; j++) {
+                m_work[j] += c[j] * tempN;
+            }
+            tempN *= T;
+        }
+        for (size_t j = 0; j < n; j++) {
+            values[m_polyIndex[j]] = m_work[j];
+        }
+    }
+
+    // f[0] exp(f[1] T + ... + f[N] T^N)
+    n = m_expIndex.size();
+    if (n) {
+        std::fill(m_work.begin(), m_work.begin() + n, 0.0);
+        double tempN = 1.0;
+        for (size_t i = 1; i < m_nExp; i++) {
+            tempN *= T;
+            const double* c = &m_exp[i * n];
+            for (size_t j = 0; j < n; j++) {
+                m_work[j] += c[j] * tempN;
+            }
+        }
+        for (size_t j = 0; j < n; j++) {
+            values[m_expIndex[j]] = m_exp[j] * std::exp(m_work[j]);
+        }
+    }
+
+    for (size_t j = 0; j < m_other.size(); j++) {
+        values[m_otherIndex[j]] = m_other[j]->getSpeciesTransProp();
+    }
+}
 
 }
@@ -174,11 +174,6 @@ doublereal LTI_Solvent::getMixTransProp(doublereal* speciesValues, doublereal* s
     for (size_t i = 0; i < nsp; i++) {
         //presume that the weighting is set to 1.0 for solvent and 0.0 for everything else.
         value += speciesValues[i] * speciesWeight[i];
-        if (i == 0) {
-            AssertTrace(speciesWeight[i] == 1.0);
-        } else {
-            AssertTrace(speciesWeight[i] == 0.0);
-        }
         for (size_t j = 0; j < nsp; j++) {
             for (size_t k = 0; k < m_Aij.size(); k++) {
                 value += molefracs[i]*molefracs[j]*(*m_Aij[k])(i,j)*pow(molefracs[i], (int) k);
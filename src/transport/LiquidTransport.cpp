@@ -49,6 +49,8 @@ LiquidTransport::LiquidTransport(thermo_t* thermo, int ndim) :
     m_diff_temp_ok(false),
     m_lambda_temp_ok(false),
     m_lambda_mix_ok(false),
+    m_vdiff_ok(false),
+    m_vdiffBasis(VB_MASSAVG),
     m_mode(-1000),
     m_debug(false)
 {
@@ -153,6 +155,28 @@ bool LiquidTransport::initLiquid(LiquidTransportParams& tr)
         ltd.hydroRadius = 0;
     }
 
+    // Flatten the temperature dependence of the species properties. The
+    // matrices are stored in the order of m_mobRatSpecies and
+    // m_selfDiffSpecies.
+    m_viscTempDep.init(m_viscTempDep_Ns);
+    m_ionCondTempDep.init(m_ionCondTempDep_Ns);
+    m_lambdaTempDep.init(m_lambdaTempDep_Ns);
+    m_radiusTempDep.init(m_radiusTempDep_Ns);
+    vector<LTPspecies*> flat(m_nsp2 * m_nsp);
+    for (size_t j = 0; j < m_nsp; j++) {
+        for (size_t k = 0; k < m_nsp2; k++) {
+            flat[k + m_nsp2 * j] = m_mobRatTempDep_Ns[k][j];
+        }
+    }
+    m_mobRatTempDep.init(flat);
+    flat.resize(m_nsp2);
+    for (size_t j = 0; j < m_nsp; j++) {
+        for (size_t k = 0; k < m_nsp; k++) {
+            flat[k + m_nsp * j] = m_selfDiffTempDep_Ns[k][j];
+        }
+    }
+    m_selfDiffTempDep.init(flat);
+
     // Get the input Species Diffusivities. Note that species diffusivities are
     // not what is needed. Rather the Stefan Boltzmann interaction parameters
     // are needed for the current model.  This section may, therefore, be
@@ -214,6 +238,7 @@ bool LiquidTransport::initLiquid(LiquidTransportParams& tr)
     m_volume_spec.resize(m_nsp, 0.0);
     m_Grad_lnAC.resize(m_nDim * m_nsp, 0.0);
     m_spwork.resize(m_nsp, 0.0);
+    m_spwork2.resize(m_nsp, 0.0);
 
     // resize the internal gradient variables
     m_Grad_X.resize(m_nDim * m_nsp, 0.0);
@@ -242,6 +267,7 @@ bool LiquidTransport::initLiquid(LiquidTransportParams& tr)
     m_lambda_mix_ok = false;
     m_diff_temp_ok = false;
     m_diff_mix_ok = false;
+    m_vdiff_ok = false;
     return true;
 }
 
@@ -249,11 +275,14 @@ doublereal LiquidTransport::viscosity()
 {
     update_T();
     update_C();
-    if (m_visc_mix_ok) {
-        return m_viscmix;
+    if (!m_visc_mix_ok) {
+        if (!m_visc_temp_ok) {
+            updateViscosity_T();
+        }
+        m_viscmix = mixProperty(*m_viscMixModel, m_viscSpecies.data(),
+                                m_viscTempDep.mixWeights().data());
+        m_visc_mix_ok = true;
     }
-    ////// LiquidTranInteraction method
-    m_viscmix = m_viscMixModel->getMixTransProp(m_viscTempDep_Ns);
     return m_viscmix;
 }
 
@@ -270,11 +299,14 @@ doublereal LiquidTransport::ionConductivity()
 {
     update_T();
     update_C();
-    if (m_ionCond_mix_ok) {
-        return m_ionCondmix;
+    if (!m_ionCond_mix_ok) {
+        if (!m_ionCond_temp_ok) {
+            updateIonConductivity_T();
+        }
+        m_ionCondmix = mixProperty(*m_ionCondMixModel, m_ionCondSpecies.data(),
+                                   m_ionCondTempDep.mixWeights().data());
+        m_ionCond_mix_ok = true;
     }
-    ////// LiquidTranInteraction method
-    m_ionCondmix = m_ionCondMixModel->getMixTransProp(m_ionCondTempDep_Ns);
     return m_ionCondmix;
 }
 
@@ -291,16 +323,22 @@ void LiquidTransport::mobilityRatio(doublereal* mobRat)
 {
     update_T();
     update_C();
-    // LiquidTranInteraction method
     if (!m_mobRat_mix_ok) {
+        if (!m_mobRat_temp_ok) {
+            updateMobilityRatio_T();
+        }
+        const vector_fp& weights = m_mobRatTempDep.mixWeights();
         for (size_t k = 0; k < m_nsp2; k++) {
             if (m_mobRatMixModel[k]) {
-                m_mobRatMix[k] = m_mobRatMixModel[k]->getMixTransProp(m_mobRatTempDep_Ns[k]);
+                m_mobRatMix[k] = mixProperty(*m_mobRatMixModel[k],
+                                             &m_mobRatSpecies(k,0),
+                                             &weights[k], m_nsp2);
                 if (m_mobRatMix[k] > 0.0) {
                     m_mobRatMix[k / m_nsp + m_nsp * (k % m_nsp)] = 1.0 / m_mobRatMix[k]; // Also must be off diagonal: k%(1+n)!=0, but then m_mobRatMixModel[k] shouldn't be initialized anyway
                 }
             }
         }
+        m_mobRat_mix_ok = true;
     }
     for (size_t k = 0; k < m_nsp2; k++) {
         mobRat[k] = m_mobRatMix[k];
@@ -325,9 +363,16 @@ void LiquidTransport::selfDiffusion(doublereal* const selfDiff)
     update_T();
     update_C();
     if (!m_selfDiff_mix_ok) {
+        if (!m_selfDiff_temp_ok) {
+            updateSelfDiffusion_T();
+        }
+        const vector_fp& weights = m_selfDiffTempDep.mixWeights();
         for (size_t k = 0; k < m_nsp; k++) {
-            m_selfDiffMix[k] = m_selfDiffMixModel[k]->getMixTransProp(m_selfDiffTempDep_Ns[k]);
+            m_selfDiffMix[k] = mixProperty(*m_selfDiffMixModel[k],
+                                           &m_selfDiffSpecies(k,0),
+                                           &weights[k], m_nsp);
         }
+        m_selfDiff_mix_ok = true;
     }
     for (size_t k = 0; k < m_nsp; k++) {
         selfDiff[k] = m_selfDiffMix[k];
@@ -361,8 +406,12 @@ doublereal LiquidTransport::thermalConductivity()
     update_T();
     update_C();
     if (!m_lambda_mix_ok) {
-        m_lambda = m_lambdaMixModel->getMixTransProp(m_lambdaTempDep_Ns);
-        m_cond_mix_ok = true;
+        if (!m_lambda_temp_ok) {
+            updateCond_T();
+        }
+        m_lambda = mixProperty(*m_lambdaMixModel, m_lambdaSpecies.data(),
+                               m_lambdaTempDep.mixWeights().data());
+        m_lambda_mix_ok = true;
     }
     return m_lambda;
 }
@@ -417,6 +466,7 @@ void LiquidTransport::set_Grad_T(const doublereal* grad_T)
     for (size_t a = 0; a < m_nDim; a++) {
         m_Grad_T[a] = grad_T[a];
     }
+    m_vdiff_ok = false;
 }
 
 void LiquidTransport::set_Grad_V(const doublereal* grad_V)
@@ -424,6 +474,7 @@ void LiquidTransport::set_Grad_V(const doublereal* grad_V)
     for (size_t a = 0; a < m_nDim; a++) {
         m_Grad_V[a] = grad_V[a];
     }
+    m_vdiff_ok = false;
 }
 
 void LiquidTransport::set_Grad_X(const doublereal* grad_X)
@@ -432,6 +483,7 @@ void LiquidTransport::set_Grad_X(const doublereal* grad_X)
     for (size_t i = 0; i < itop; i++) {
         m_Grad_X[i] = grad_X[i];
     }
+    m_vdiff_ok = false;
 }
 
 doublereal LiquidTransport::getElectricConduct()
@@ -610,6 +662,7 @@ bool LiquidTransport::update_T()
     m_selfDiff_mix_ok = false;
     m_diff_mix_ok = false;
     m_lambda_mix_ok = false; //(don't need it because a lower lvl flag is set
+    m_vdiff_ok = false;
     return true;
 }
 
@@ -659,15 +712,14 @@ bool LiquidTransport::update_C()
     m_selfDiff_mix_ok = false;
     m_diff_mix_ok = false;
     m_lambda_mix_ok = false;
+    m_vdiff_ok = false;
 
     return true;
 }
 
 void LiquidTransport::updateCond_T()
 {
-    for (size_t k = 0; k < m_nsp; k++) {
-        m_lambdaSpecies[k] = m_lambdaTempDep_Ns[k]->getSpeciesTransProp();
-    }
+    m_lambdaTempDep.getValues(m_temp, m_lambdaSpecies.data());
     m_lambda_temp_ok = true;
     m_lambda_mix_ok = false;
 }
@@ -677,6 +729,7 @@ void LiquidTransport::updateDiff_T()
     m_diffMixModel->getMatrixTransProp(m_bdiff);
     m_diff_temp_ok = true;
     m_diff_mix_ok = false;
+    m_vdiff_ok = false;
 }
 
 void LiquidTransport::updateViscosities_C()
@@ -686,9 +739,7 @@ void LiquidTransport::updateViscosities_C()
 
 void LiquidTransport::updateViscosity_T()
 {
-    for (size_t k = 0; k < m_nsp; k++) {
-        m_viscSpecies[k] = m_viscTempDep_Ns[k]->getSpeciesTransProp();
-    }
+    m_viscTempDep.getValues(m_temp, m_viscSpecies.data());
     m_visc_temp_ok = true;
     m_visc_mix_ok = false;
 }
@@ -700,9 +751,7 @@ void LiquidTransport::updateIonConductivity_C()
 
 void LiquidTransport::updateIonConductivity_T()
 {
-    for (size_t k = 0; k < m_nsp; k++) {
-        m_ionCondSpecies[k] = m_ionCondTempDep_Ns[k]->getSpeciesTransProp();
-    }
+    m_ionCondTempDep.getValues(m_temp, m_ionCondSpecies.data());
     m_ionCond_temp_ok = true;
     m_ionCond_mix_ok = false;
 }
@@ -714,11 +763,7 @@ void LiquidTransport::updateMobilityRatio_C()
 
 void LiquidTransport::updateMobilityRatio_T()
 {
-    for (size_t k = 0; k < m_nsp2; k++) {
-        for (size_t j = 0; j < m_nsp; j++) {
-            m_mobRatSpecies(k,j) = m_mobRatTempDep_Ns[k][j]->getSpeciesTransProp();
-        }
-    }
+    m_mobRatTempDep.getValues(m_temp, m_mobRatSpecies.ptrColumn(0));
     m_mobRat_temp_ok = true;
     m_mobRat_mix_ok = false;
 }
@@ -730,11 +775,7 @@ void LiquidTransport::updateSelfDiffusion_C()
 
 void LiquidTransport::updateSelfDiffusion_T()
 {
-    for (size_t k = 0; k < m_nsp2; k++) {
-        for (size_t j = 0; j < m_nsp; j++) {
-            m_selfDiffSpecies(k,j) = m_selfDiffTempDep_Ns[k][j]->getSpeciesTransProp();
-        }
-    }
+    m_selfDiffTempDep.getValues(m_temp, m_selfDiffSpecies.ptrColumn(0));
     m_selfDiff_temp_ok = true;
     m_selfDiff_mix_ok = false;
 }
@@ -746,13 +787,22 @@ void LiquidTransport::updateHydrodynamicRadius_C()
 
 void LiquidTransport::updateHydrodynamicRadius_T()
 {
-    for (size_t k = 0; k < m_nsp; k++) {
-        m_hydrodynamic_radius[k] = m_radiusTempDep_Ns[k]->getSpeciesTransProp();
-    }
+    m_radiusTempDep.getValues(m_temp, m_hydrodynamic_radius.data());
     m_radi_temp_ok = true;
     m_radi_mix_ok = false;
 }
 
+double LiquidTransport::mixProperty(LiquidTranInteraction& model,
+                                    const double* values,
+                                    const double* weights, size_t stride)
+{
+    for (size_t k = 0; k < m_nsp; k++) {
+        m_spwork[k] = values[k * stride];
+        m_spwork2[k] = weights[k * stride];
+    }
+    return model.getMixTransProp(m_spwork.data(), m_spwork2.data());
+}
+
 void LiquidTransport::update_Grad_lnAC()
 {
     for (size_t k = 0; k < m_nDim; k++) {
@@ -771,14 +821,6 @@ void LiquidTransport::update_Grad_lnAC()
 
 void LiquidTransport::stefan_maxwell_solve()
 {
-    m_B.resize(m_nsp, m_nDim, 0.0);
-    m_A.resize(m_nsp, m_nsp, 0.0);
-
-    //! grab a local copy of the molecular weights
-    const vector_fp& M = m_thermo->molecularWeights();
-    //! grad a local copy of the ion molar volume (inverse total ion concentration)
-    const doublereal vol = m_thermo->molarVolume();
-
     //! Update the temperature, concentrations and diffusion coefficients in the
     //! mixture.
     update_T();
@@ -786,6 +828,17 @@ void LiquidTransport::stefan_maxwell_solve()
     if (!m_diff_temp_ok) {
         updateDiff_T();
     }
+    if (m_vdiff_ok && m_vdiffBasis == m_velocityBasis) {
+        return;
+    }
+
+    m_B.resize(m_nsp, m_nDim, 0.0);
+    m_A.resize(m_nsp, m_nsp, 0.0);
+
+    //! grab a local copy of the molecular weights
+    const vector_fp& M = m_thermo->molecularWeights();
+    //! grad a local copy of the ion molar volume (inverse total ion concentration)
+    const doublereal vol = m_thermo->molarVolume();
 
     double T = m_thermo->temperature();
     update_Grad_lnAC();
@@ -969,6 +1022,8 @@ void LiquidTransport::stefan_maxwell_solve()
             m_flux(j,a) = concTot_ * M[j] * m_molefracs_tran[j] * m_B(j,a);
         }
     }
+    m_vdiff_ok = true;
+    m_vdiffBasis = m_velocityBasis;
 }
 
 }
@@ -131,35 +131,13 @@ void Reactor::updateState(doublereal* y)
 
     if (m_energy) {
         double U = y[2];
-        // Residual function: error in internal energy as a function of T
-        auto u_err = [this, U](double T) {
-            m_thermo->setState_TR(T, m_mass / m_vol);
-            return m_thermo->intEnergy_mass() * m_mass - U;
-        };
-
-        double T = m_thermo->temperature();
-        boost::uintmax_t maxiter = 100;
-        std::pair<double, double> TT;
-        try {
-            TT = bmt::bracket_and_solve_root(
-                u_err, T, 1.2, true, bmt::eps_tolerance<double>(48), maxiter);
-        } catch (std::exception& err) {
-            // Try full-range bisection if bracketing fails (e.g. near
-            // temperature limits for the phase's equation of state)
-            try {
-                TT = bmt::bisect(u_err, m_thermo->minTemp(), m_thermo->maxTemp(),
-                    bmt::eps_tolerance<double>(48), maxiter);
-            } catch (std::exception& err2) {
-                // Set m_thermo back to a reasonable state if root finding fails
-                m_thermo->setState_TR(T, m_mass / m_vol);
-                throw CanteraError("Reactor::updateState",
-                    "{}\nat U = {}, rho = {}", err2.what(), U, m_mass / m_vol);
-            }
+        // Newton iteration starting from the previous temperature, which
+        // usually converges with two or three evaluations of the internal
+        // energy
+        m_thermo->setDensity(m_mass / m_vol);
+        if (!m_thermo->solveTemperature(U / m_mass, 1e-14, true, false)) {
+            bracketTemperature(U);
         }
-        if (fabs(TT.first - TT.second) > 1e-7*TT.first) {
-            throw CanteraError("Reactor::updateState", "root finding failed");
-        }
-        m_thermo->setState_TR(TT.second, m_mass / m_vol);
     } else {
         m_thermo->setDensity(m_mass/m_vol);
     }
@@ -173,6 +151,39 @@ void Reactor::updateState(doublereal* y)
     m_thermo->saveState(m_state);
 }
 
+void Reactor::bracketTemperature(double U)
+{
+    // Residual function: error in internal energy as a function of T
+    auto u_err = [this, U](double T) {
+        m_thermo->setState_TR(T, m_mass / m_vol);
+        return m_thermo->intEnergy_mass() * m_mass - U;
+    };
+
+    double T = m_thermo->temperature();
+    boost::uintmax_t maxiter = 100;
+    std::pair<double, double> TT;
+    try {
+        TT = bmt::bracket_and_solve_root(
+            u_err, T, 1.2, true, bmt::eps_tolerance<double>(48), maxiter);
+    } catch (std::exception& err) {
+        // Try full-range bisection if bracketing fails (e.g. near
+        // temperature limits for the phase's equation of state)
+        try {
+            TT = bmt::bisect(u_err, m_thermo->minTemp(), m_thermo->maxTemp(),
+                bmt::eps_tolerance<double>(48), maxiter);
+        } catch (std::exception& err2) {
+            // Set m_thermo back to a reasonable state if root finding fails
+            m_thermo->setState_TR(T, m_mass / m_vol);
+            throw CanteraError("Reactor::updateState",
+                "{}\nat U = {}, rho = {}", err2.what(), U, m_mass / m_vol);
+        }
+    }
+    if (fabs(TT.first - TT.second) > 1e-7*TT.first) {
+        throw CanteraError("Reactor::updateState", "root finding failed");
+    }
+    m_thermo->setState_TR(TT.second, m_mass / m_vol);
+}
+
 void Reactor::updateSurfaceState(double* y)
 {
     size_t loc = 0;
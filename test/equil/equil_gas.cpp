@@ -3,6 +3,8 @@
 #include "cantera/thermo/ThermoFactory.h"
 #include "cantera/thermo/IdealGasPhase.h"
 #include "cantera/equil/MultiPhase.h"
+#include "cantera/equil/vcs_MultiPhaseEquil.h"
+#include "cantera/equil/ChemEquil.h"
 #include "cantera/base/global.h"
 #include "cantera/base/utilities.h"
 
@@ -219,6 +221,70 @@ TEST_F(GriMatrix, VcsNonideal_O2_N2) { check_O2_N2("vcs"); }
 TEST_F(GriMatrix, VcsNonideal_CH4_O2_N2) { check_CH4_O2_N2("vcs"); }
 TEST_F(GriMatrix, VcsNonideal_CH4_O2) { check_CH4_O2("vcs"); }
 
+TEST_F(GriEquilibriumTest, ChemEquilWarmStart)
+{
+    EquilState state;
+    IdealGasPhase cold("gri30.xml", "gri30");
+    for (int i = 0; i < 8; i++) {
+        compositionMap comp{{"CH4", 0.8 + 0.05 * i}, {"O2", 2.0}, {"N2", 7.52}};
+        gas.setState_TPX(300, OneAtm, comp);
+        cold.setState_TPX(300, OneAtm, comp);
+        double h0 = gas.enthalpy_mass();
+        save_elemental_mole_fractions();
+        gas.equilibrate("HP", "element_potential", 1e-9, 50000, 100, 0, 0,
+                        &state);
+        ASSERT_TRUE(state.valid);
+        EXPECT_EQ(i > 0, state.warmStarted);
+        if (i > 0) {
+            EXPECT_LE(state.iterations, 5);
+        }
+        EXPECT_NEAR(h0, gas.enthalpy_mass(), 1e-3);
+        check();
+
+        cold.equilibrate("HP", "element_potential");
+        EXPECT_NEAR(cold.temperature(), gas.temperature(), 1e-6);
+        EXPECT_NEAR(cold.moleFraction("CO"), gas.moleFraction("CO"), 1e-10);
+    }
+}
+
+TEST_F(GriEquilibriumTest, VcsSolverReuse)
+{
+    IdealGasPhase fresh("gri30.xml", "gri30");
+    MultiPhase mix;
+    mix.addPhase(&gas, 1.0);
+    mix.init();
+    vcs_MultiPhaseEquil* solver = nullptr;
+    for (int i = 0; i < 6; i++) {
+        // The first composition contains no carbon
+        compositionMap comp{{"CH4", 0.3 * i}, {"O2", 2.0}, {"N2", 7.52}};
+        double T = 300 + 300 * i;
+        gas.setState_TPX(T, OneAtm, comp);
+        mix.uploadMoleFractionsFromPhases();
+        mix.setState_TP(T, OneAtm);
+        save_elemental_mole_fractions();
+        mix.equilibrate("TP", "vcs");
+        check();
+        if (i == 0) {
+            solver = &mix.vcsSolver();
+        }
+        EXPECT_EQ(solver, &mix.vcsSolver());
+
+        // A new solver gives the same result
+        fresh.setState_TPX(T, OneAtm, comp);
+        fresh.equilibrate("TP", "vcs");
+        for (size_t k = 0; k < gas.nSpecies(); k++) {
+            EXPECT_NEAR(fresh.moleFraction(k), gas.moleFraction(k), 1e-10);
+        }
+    }
+
+    EXPECT_EQ(solver->totalCalls(), 6);
+    EXPECT_GT(solver->totalIterations(), 6);
+    EXPECT_GE(solver->totalBasisOptimizations(), 6);
+    EXPECT_GT(solver->totalSpeciesDeletions(), 0);
+    solver->resetCounters();
+    EXPECT_EQ(solver->totalIterations(), 0);
+}
+
 // Test for equilibrium at property pairs other than T and P, which require
 // nested iterations.
 class PropertyPairs : public GriEquilibriumTest
@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/equil/EquilTable.h"
+
+#include <fstream>
+
+using namespace Cantera;
+
+class EquilTableTest : public testing::Test
+{
+public:
+    EquilTableTest() : gas(newPhase("h2o2.xml", "ohmech")) {
+        Yfuel.resize(gas->nSpecies());
+        Yox.resize(gas->nSpecies());
+        gas->setState_TPX(300, OneAtm, "H2:1.0");
+        gas->getMassFractions(Yfuel.data());
+        gas->setState_TPX(300, OneAtm, "O2:0.21, AR:0.79");
+        gas->getMassFractions(Yox.data());
+        table.setGrid({0.0, 3e5, 6e5, 9e5}, {1e5, 3e5}, {0.005, 0.01, 0.02});
+        table.setStreams(Yfuel, Yox);
+    }
+
+    // Equilibrium state computed directly at the given conditions
+    void equilibrate(double h, double p, double Z) {
+        vector_fp Y(gas->nSpecies());
+        for (size_t k = 0; k < Y.size(); k++) {
+            Y[k] = Z * Yfuel[k] + (1.0 - Z) * Yox[k];
+        }
+        gas->setState_TPY(300, p, Y.data());
+        gas->setState_HP(h, p);
+        gas->equilibrate("HP");
+    }
+
+    std::unique_ptr<ThermoPhase> gas;
+    vector_fp Yfuel, Yox;
+    EquilTable table;
+};
+
+TEST_F(EquilTableTest, GridPoints)
+{
+    table.build(*gas, {"H2O", "OH", "H2"}, 2);
+    EXPECT_EQ(table.nFailed(), (size_t) 0);
+    ASSERT_EQ(table.nVariables(), (size_t) 7);
+    EXPECT_EQ(table.variableIndex("OH"), (size_t) 5);
+    EXPECT_EQ(table.variableIndex("O2"), npos);
+
+    EquilTableLookup lookup(table);
+    vector_fp values(table.nVariables());
+    for (double h : table.enthalpies()) {
+        for (double p : table.pressures()) {
+            for (double Z : table.mixtureFractions()) {
+                equilibrate(h, p, Z);
+                lookup.lookup(h, p, Z, values.data());
+                EXPECT_NEAR(values[0], gas->temperature(), 1e-3);
+                EXPECT_NEAR(values[1], gas->density(), 1e-6 * gas->density());
+                EXPECT_NEAR(values[4], gas->massFraction("H2O"), 1e-7);
+                EXPECT_NEAR(values[5], gas->massFraction("OH"), 1e-7);
+                EXPECT_DOUBLE_EQ(lookup.temperature(h, p, Z), values[0]);
+            }
+        }
+    }
+}
+
+TEST_F(EquilTableTest, Interpolation)
+{
+    table.build(*gas, {}, 1);
+    EquilTableLookup lookup(table);
+    size_t iH2O = table.variableIndex("H2O");
+
+    // Halfway between grid points in all directions
+    double T = 0.0, Y = 0.0;
+    for (double h : {3e5, 6e5}) {
+        for (double p : {1e5, 3e5}) {
+            for (double Z : {0.01, 0.02}) {
+                T += 0.125 * lookup.temperature(h, p, Z);
+                Y += 0.125 * lookup.value(iH2O, h, p, Z);
+            }
+        }
+    }
+    EXPECT_NEAR(lookup.temperature(4.5e5, 2e5, 0.015), T, 1e-9 * T);
+    EXPECT_NEAR(lookup.value(iH2O, 4.5e5, 2e5, 0.015), Y, 1e-9 * Y);
+
+    // Points outside the grid are clipped to the boundaries
+    EXPECT_DOUBLE_EQ(lookup.temperature(-1e6, 1e4, 0.0),
+                     lookup.temperature(0.0, 1e5, 0.005));
+    EXPECT_DOUBLE_EQ(lookup.temperature(1e7, 1e6, 1.0),
+                     lookup.temperature(9e5, 3e5, 0.02));
+    EXPECT_THROW(lookup.value(table.nVariables(), 0.0, 1e5, 0.01),
+                 CanteraError);
+}
+
+TEST_F(EquilTableTest, SaveLoad)
+{
+    table.build(*gas, {"H2O"}, 0);
+    table.save("equil_table.bin");
+
+    EquilTable loaded;
+    loaded.load("equil_table.bin");
+    ASSERT_EQ(loaded.nPoints(), table.nPoints());
+    ASSERT_EQ(loaded.nVariables(), table.nVariables());
+    EXPECT_EQ(loaded.variableName(4), "H2O");
+    EXPECT_EQ(loaded.enthalpies(), table.enthalpies());
+    EXPECT_EQ(loaded.pressures(), table.pressures());
+    EXPECT_EQ(loaded.mixtureFractions(), table.mixtureFractions());
+    for (size_t j = 0; j < table.nPoints(); j++) {
+        for (size_t i = 0; i < table.nVariables(); i++) {
+            EXPECT_EQ(loaded.point(j)[i], table.point(j)[i]);
+        }
+    }
+
+    EXPECT_THROW(loaded.load("h2o2.xml"), CanteraError);
+
+    // A file written with a different byte order is rejected
+    std::string contents;
+    {
+        std::ifstream in("equil_table.bin", std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in),
+                        std::istreambuf_iterator<char>());
+    }
+    std::reverse(contents.begin() + 8, contents.begin() + 12);
+    {
+        std::ofstream out("equil_table_swapped.bin", std::ios::binary);
+        out << contents;
+    }
+    EXPECT_THROW(loaded.load("equil_table_swapped.bin"), CanteraError);
+}
+
+TEST_F(EquilTableTest, InvalidInput)
+{
+    EXPECT_THROW(table.setGrid({1.0, 0.0}, {1e5}, {0.5}), CanteraError);
+    EXPECT_THROW(table.setGrid({0.0}, {1e5}, {0.5, 1.5}), CanteraError);
+    EXPECT_THROW(table.setStreams(Yfuel, {1.0}), CanteraError);
+    EXPECT_THROW(table.build(*gas, {"CH4"}), CanteraError);
+}
+
+//! Table whose grid points can be marked as failed
+class FailedPointsTable : public EquilTable
+{
+public:
+    void setFailed(size_t j) {
+        std::fill(m_data.begin() + j * nVariables(),
+                  m_data.begin() + (j + 1) * nVariables(),
+                  std::numeric_limits<float>::quiet_NaN());
+    }
+};
+
+TEST_F(EquilTableTest, FailedPoints)
+{
+    FailedPointsTable failed;
+    failed.setGrid({0.0, 3e5, 6e5, 9e5}, {1e5, 3e5}, {0.005, 0.01, 0.02});
+    failed.setStreams(Yfuel, Yox);
+    failed.build(*gas, {"H2O"}, 1);
+    EquilTableLookup lookup(failed);
+    double T1 = lookup.temperature(3e5, 1e5, 0.01);
+
+    // Interpolating along an edge of the cell uses only the remaining end
+    failed.setFailed(failed.pointIndex(2, 0, 1));
+    EXPECT_DOUBLE_EQ(lookup.temperature(4e5, 1e5, 0.01), T1);
+    vector_fp values(failed.nVariables());
+    lookup.lookup(5e5, 1e5, 0.01, values.data());
+    EXPECT_DOUBLE_EQ(values[0], T1);
+    for (double v : values) {
+        EXPECT_FALSE(std::isnan(v));
+    }
+
+    // Weights of the remaining corners are renormalized
+    double T = lookup.temperature(4.5e5, 2e5, 0.015);
+    double Tsum = 0.0;
+    for (double h : {3e5, 6e5}) {
+        for (double p : {1e5, 3e5}) {
+            for (double Z : {0.01, 0.02}) {
+                if (h != 6e5 || p != 1e5 || Z != 0.01) {
+                    Tsum += lookup.temperature(h, p, Z);
+                }
+            }
+        }
+    }
+    EXPECT_NEAR(T, Tsum / 7, 1e-9 * T);
+
+    // No value can be interpolated at a failed grid point, or between two
+    // failed points
+    EXPECT_THROW(lookup.temperature(6e5, 1e5, 0.01), CanteraError);
+    failed.setFailed(failed.pointIndex(1, 0, 1));
+    EXPECT_THROW(lookup.lookup(4e5, 1e5, 0.01, values.data()), CanteraError);
+    EXPECT_DOUBLE_EQ(lookup.temperature(6e5, 3e5, 0.01),
+                     failed.point(failed.pointIndex(2, 1, 1))[0]);
+}
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "cantera/numerics/BandMatrix.h"
+#include "cantera/numerics/BlockTridiagMatrix.h"
 #include "cantera/numerics/DenseMatrix.h"
 
 using namespace Cantera;
@@ -275,3 +276,147 @@ TEST_F(DenseMatrixTest, invert_partial)
         EXPECT_DOUBLE_EQ(Aref(i,3), A1(i,3));
     }
 }
+
+class BlockTridiagMatrixTest : public testing::Test
+{
+public:
+    BlockTridiagMatrixTest()
+        : A(std::vector<size_t>{2, 3, 0, 1, 3})
+        , Adense(9, 9, 0.0)
+    {
+        for (size_t i = 0; i < 9; i++) {
+            for (size_t j = 0; j < 9; j++) {
+                double v = (i == j) ? 0.0 : std::sin(1.0 + i + 3*j);
+                if (i == j && i != 0) {
+                    v = 4.0 + i;
+                }
+                A(i,j) = v;
+                Adense(i,j) = A(i,j);
+            }
+        }
+        for (size_t i = 0; i < 9; i++) {
+            x.push_back(i - 2.5);
+        }
+    }
+
+    BlockTridiagMatrix A;
+    DenseMatrix Adense;
+    vector_fp x;
+};
+
+TEST_F(BlockTridiagMatrixTest, structure)
+{
+    EXPECT_EQ(A.nRows(), (size_t) 9);
+    EXPECT_EQ(A.nBlocks(), (size_t) 5);
+    EXPECT_EQ(A.blockStart(3), (size_t) 5);
+    EXPECT_EQ(A.nStored(), (size_t) (4 + 9 + 1 + 9) + (6 + 0 + 0 + 3) * 2);
+
+    // Blocks 1 and 3 are not coupled, since block 2 is empty
+    EXPECT_DOUBLE_EQ(A(4, 5), 0.0);
+    EXPECT_DOUBLE_EQ(A(0, 2), std::sin(7.0));
+    EXPECT_DOUBLE_EQ(A(0, 5), 0.0);
+    EXPECT_DOUBLE_EQ(A(8, 5), std::sin(24.0));
+}
+
+TEST_F(BlockTridiagMatrixTest, matrix_times_vector)
+{
+    vector_fp b(9), c(9);
+    A.mult(x.data(), b.data());
+    Adense.mult(x.data(), c.data());
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_NEAR(b[i], c[i], 1e-14);
+    }
+}
+
+TEST_F(BlockTridiagMatrixTest, solve_linear_system)
+{
+    vector_fp b(9), c(9);
+    A.mult(x.data(), b.data());
+    A.solve(b.data(), c.data());
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_NEAR(x[i], c[i], 1e-12);
+    }
+
+    // Solve in place, after modifying the matrix
+    A(3,3) += 1.0;
+    Adense(3,3) += 1.0;
+    c = b;
+    A.solve(c.data());
+    solve(Adense, b.data());
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_NEAR(b[i], c[i], 1e-12);
+    }
+}
+
+TEST_F(BlockTridiagMatrixTest, singular)
+{
+    for (size_t j = 0; j < 9; j++) {
+        A(5, j) = 0.0;
+    }
+    vector_fp b(9, 1.0);
+    EXPECT_THROW(A.solve(b.data()), CanteraError);
+    EXPECT_EQ(A.info(), 6);
+}
+
+TEST_F(BlockTridiagMatrixTest, merged_blocks)
+{
+    // The diagonal block of row 5 is zero, so it has to be factored together
+    // with the following block
+    A(5,5) = 0.0;
+    Adense(5,5) = 0.0;
+    vector_fp b(9), c(9);
+    A.mult(x.data(), b.data());
+    A.solve(b.data(), c.data());
+    EXPECT_EQ(A.nFactorBlocks(), (size_t) 4);
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_NEAR(x[i], c[i], 1e-12);
+    }
+
+    // A variable which appears only in the equations of the next block
+    A(0,1) = 0.0;
+    A(1,1) = 0.0;
+    Adense(0,1) = 0.0;
+    Adense(1,1) = 0.0;
+    A.mult(x.data(), b.data());
+    A.solve(b.data(), c.data());
+    EXPECT_EQ(A.nFactorBlocks(), (size_t) 3);
+    solve(Adense, b.data());
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_NEAR(b[i], c[i], 1e-12);
+        EXPECT_NEAR(x[i], c[i], 1e-12);
+    }
+}
+
+TEST_F(BlockTridiagMatrixTest, diagonal_only)
+{
+    BlockTridiagMatrix B(std::vector<size_t>{2, 3, 0, 1, 3}, true);
+    EXPECT_TRUE(B.diagonalOnly());
+    for (size_t i = 0; i < 9; i++) {
+        for (size_t j = 0; j < 9; j++) {
+            B(i,j) = A(i,j);
+        }
+    }
+    EXPECT_EQ(B.nStored(), (size_t) (4 + 9 + 1 + 9));
+    EXPECT_DOUBLE_EQ(B(0, 2), 0.0);
+    EXPECT_DOUBLE_EQ(B(8, 6), A(8, 6));
+
+    // Product with the block-diagonal part of A
+    vector_fp b(9), c(9, 0.0);
+    B.mult(x.data(), b.data());
+    for (size_t k = 0; k < B.nBlocks(); k++) {
+        size_t start = B.blockStart(k);
+        for (size_t i = start; i < start + B.blockSize(k); i++) {
+            for (size_t j = start; j < start + B.blockSize(k); j++) {
+                c[i] += A(i,j) * x[j];
+            }
+        }
+    }
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_NEAR(b[i], c[i], 1e-14);
+    }
+
+    B.solve(b.data());
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_NEAR(b[i], x[i], 1e-12);
+    }
+}
@@ -4,6 +4,7 @@
 #include "cantera/thermo/IdealGasPhase.h"
 #include "cantera/thermo/SurfPhase.h"
 #include "cantera/kinetics/GasKinetics.h"
+#include "cantera/kinetics/InterfaceKinetics.h"
 
 namespace Cantera
 {
@@ -210,4 +211,245 @@ TEST(InterfaceReaction, CoverageDependency) {
     EXPECT_NEAR(kf[1], 3.7e20 * exp(-(67.4e6-6e6*0.3)/(GasConstant*T)), 1e-14*kf[1]);
 }
 
+TEST(InterfaceReaction, NetProductionRatesSurfaceJacobian) {
+    IdealGasPhase gas("../data/ptcombust-motzwise.cti", "gas");
+    SurfPhase surf("../data/ptcombust-motzwise.cti", "Pt_surf");
+    std::vector<ThermoPhase*> phases { &gas, &surf };
+    InterfaceKinetics kin;
+    importKinetics(surf.xml(), phases, &kin);
+
+    gas.setState_TPX(900, OneAtm, "CH4:0.095, O2:0.21, N2:0.79, H2O:0.05");
+    surf.setState_TP(900, OneAtm);
+    surf.setCoveragesByName("PT(S):0.5, H(S):0.2, O(S):0.1, CO(S):0.1, OH(S):0.1");
+
+    size_t nsurf = surf.nSpecies();
+    size_t kstart = kin.kineticsSpeciesIndex(0, kin.surfacePhaseIndex());
+    Array2D dwdot;
+    kin.getNetProductionRatesSurfaceJacobian(dwdot);
+    ASSERT_EQ(kin.nTotalSpecies(), dwdot.nRows());
+    ASSERT_EQ(nsurf, dwdot.nColumns());
+
+    vector_fp conc(nsurf), wdot0(kin.nTotalSpecies()),
+        wdot1(kin.nTotalSpecies()), wdot2(kin.nTotalSpecies());
+    surf.getConcentrations(conc.data());
+    kin.getNetProductionRates(wdot0.data());
+
+    // The net production rates are differences of much larger rates of
+    // progress, so the round-off error in each is proportional to the sum of
+    // the forward and reverse rates of the reactions involving the species
+    vector_fp ropf(kin.nReactions()), ropr(kin.nReactions()), ropsum(nsurf);
+    kin.getFwdRatesOfProgress(ropf.data());
+    kin.getRevRatesOfProgress(ropr.data());
+    for (size_t k = 0; k < nsurf; k++) {
+        for (size_t i = 0; i < kin.nReactions(); i++) {
+            ropsum[k] += (kin.reactantStoichCoeff(kstart + k, i) +
+                          kin.productStoichCoeff(kstart + k, i)) *
+                         (std::abs(ropf[i]) + std::abs(ropr[i]));
+        }
+    }
+
+    // Second order one-sided differences, since some of the concentrations
+    // are zero
+    double dc = 1e-5 * surf.siteDensity();
+    for (size_t j = 0; j < nsurf; j++) {
+        conc[j] += dc;
+        surf.setConcentrations(conc.data());
+        kin.getNetProductionRates(wdot1.data());
+        conc[j] += dc;
+        surf.setConcentrations(conc.data());
+        kin.getNetProductionRates(wdot2.data());
+        conc[j] -= 2 * dc;
+        surf.setConcentrations(conc.data());
+        for (size_t k = 0; k < nsurf; k++) {
+            double fd = (4 * wdot1[kstart + k] - 3 * wdot0[kstart + k]
+                         - wdot2[kstart + k]) / (2 * dc);
+            EXPECT_NEAR(fd, dwdot(kstart + k, j),
+                        1e-5 * std::abs(fd) + 1e-15 * ropsum[k] / dc)
+                << "k = " << k << ", j = " << j;
+        }
+    }
+}
+
+TEST(InterfaceReaction, SolvePseudoSteadyState) {
+    IdealGasPhase gas("ptcombust.cti", "gas");
+    SurfPhase surf("ptcombust.cti", "Pt_surf");
+    std::vector<ThermoPhase*> phases { &gas, &surf };
+    InterfaceKinetics kin;
+    importKinetics(surf.xml(), phases, &kin);
+
+    gas.setState_TPX(900, OneAtm, "CH4:0.095, O2:0.21, N2:0.79");
+    surf.setState_TP(900, OneAtm);
+    kin.solvePseudoSteadyStateProblem();
+
+    vector_fp wdot(kin.nTotalSpecies());
+    kin.getNetProductionRates(wdot.data());
+    size_t kstart = kin.kineticsSpeciesIndex(0, kin.surfacePhaseIndex());
+    for (size_t k = 0; k < surf.nSpecies(); k++) {
+        EXPECT_NEAR(0.0, wdot[kstart + k], 1e-10 * surf.siteDensity());
+    }
+}
+
+
+TEST(InterfaceReaction, SolvePseudoSteadyStateChargeTransfer) {
+    IdealGasPhase gas("../data/surface-charge-transfer.xml", "gas");
+    std::unique_ptr<ThermoPhase> metal(
+        newPhase("../data/surface-charge-transfer.xml", "metal"));
+    SurfPhase surf("../data/surface-charge-transfer.xml", "electrode_surface");
+    std::vector<ThermoPhase*> phases { &gas, metal.get(), &surf };
+    InterfaceKinetics kin;
+    importKinetics(surf.xml(), phases, &kin);
+    ASSERT_TRUE(kin.hasChargeTransferReactions());
+
+    // The analytic Jacobian only applies to mass action rate expressions, so
+    // solveSP uses finite differences instead
+    Array2D dwdot;
+    EXPECT_THROW(kin.getNetProductionRatesSurfaceJacobian(dwdot), CanteraError);
+
+    metal->setElectricPotential(0.1);
+    gas.setState_TPX(900, OneAtm, "H2:0.5, N2:0.5");
+    surf.setState_TP(900, OneAtm);
+    kin.solvePseudoSteadyStateProblem();
+
+    vector_fp wdot(kin.nTotalSpecies());
+    kin.getNetProductionRates(wdot.data());
+    size_t kstart = kin.kineticsSpeciesIndex(0, kin.surfacePhaseIndex());
+    for (size_t k = 0; k < surf.nSpecies(); k++) {
+        EXPECT_NEAR(0.0, wdot[kstart + k], 1e-10 * surf.siteDensity());
+    }
+    EXPECT_GT(surf.moleFraction(surf.speciesIndex("H+(m)")), 1e-6);
+}
+
+
+class InterfacePhaseExistence : public testing::Test
+{
+public:
+    InterfacePhaseExistence()
+        : gas("../data/surface-charge-transfer.xml", "gas")
+        , metal(newPhase("../data/surface-charge-transfer.xml", "metal"))
+        , surf("../data/surface-charge-transfer.xml", "electrode_surface")
+        , ropf0(2), ropr0(2), ropf(2), ropr(2)
+    {
+        std::vector<ThermoPhase*> phases { &gas, metal.get(), &surf };
+        importKinetics(surf.xml(), phases, &kin);
+        iGas = kin.phaseIndex("gas");
+        iMetal = kin.phaseIndex("metal");
+        iSurf = kin.phaseIndex("electrode_surface");
+    }
+
+    //! Compute the rates of progress with all phases present, in #ropf0 and
+    //! #ropr0, for the given electric potential of the metal. Reaction 0
+    //! (adsorption of H2 from the gas) always proceeds in the forward
+    //! direction, and the direction of reaction 1 (charge transfer to the
+    //! metal) is set by the potential.
+    void setPotential(double V) {
+        metal->setElectricPotential(V);
+        kin.getFwdRatesOfProgress(ropf0.data());
+        kin.getRevRatesOfProgress(ropr0.data());
+        ASSERT_GT(ropf0[0], ropr0[0]);
+    }
+
+    //! Compute the rates of progress with the current phase flags
+    void updateRates() {
+        kin.getFwdRatesOfProgress(ropf.data());
+        kin.getRevRatesOfProgress(ropr.data());
+    }
+
+    IdealGasPhase gas;
+    std::unique_ptr<ThermoPhase> metal;
+    SurfPhase surf;
+    InterfaceKinetics kin;
+    size_t iGas, iMetal, iSurf;
+    vector_fp ropf0, ropr0; //!< rates of progress with all phases present
+    vector_fp ropf, ropr;
+};
+
+TEST_F(InterfacePhaseExistence, MissingProductPhase)
+{
+    // Net reaction 1 produces electrons
+    setPotential(0.1);
+    ASSERT_GT(ropf0[1], ropr0[1]);
+    kin.setPhaseExistence(iMetal, false);
+    EXPECT_EQ(kin.phaseExistence(iMetal), 0);
+    EXPECT_EQ(kin.phaseStability(iMetal), 0);
+    updateRates();
+    EXPECT_DOUBLE_EQ(ropf[0], ropf0[0]);
+    EXPECT_DOUBLE_EQ(ropr[0], ropr0[0]);
+    // A missing phase is also unstable, so it can't be produced
+    EXPECT_DOUBLE_EQ(ropf[1], ropr0[1]);
+    EXPECT_DOUBLE_EQ(ropr[1], ropr0[1]);
+
+    // All rates are restored once the phase exists again
+    kin.setPhaseExistence(iMetal, true);
+    EXPECT_EQ(kin.phaseExistence(iMetal), 1);
+    EXPECT_EQ(kin.phaseStability(iMetal), 1);
+    updateRates();
+    EXPECT_EQ(ropf, ropf0);
+    EXPECT_EQ(ropr, ropr0);
+
+    // Net reaction 1 consumes electrons, which don't exist
+    setPotential(-0.1);
+    ASSERT_LT(ropf0[1], ropr0[1]);
+    kin.setPhaseExistence(iMetal, false);
+    updateRates();
+    EXPECT_DOUBLE_EQ(ropf[1], ropf0[1]);
+    EXPECT_DOUBLE_EQ(ropr[1], ropf0[1]);
+}
+
+TEST_F(InterfacePhaseExistence, MissingReactantPhase)
+{
+    setPotential(0.1);
+    kin.setPhaseExistence(iGas, false);
+    updateRates();
+    // H2 can't be consumed from a missing gas phase
+    EXPECT_DOUBLE_EQ(ropf[0], ropr0[0]);
+    EXPECT_DOUBLE_EQ(ropr[0], ropr0[0]);
+    EXPECT_DOUBLE_EQ(ropf[1], ropf0[1]);
+    EXPECT_DOUBLE_EQ(ropr[1], ropr0[1]);
+}
+
+TEST_F(InterfacePhaseExistence, UnstablePhase)
+{
+    setPotential(-0.1);
+    // The stability of the phases is only checked while some phase is
+    // missing
+    kin.setPhaseStability(iSurf, false);
+    EXPECT_EQ(kin.phaseExistence(iSurf), 1);
+    EXPECT_EQ(kin.phaseStability(iSurf), 0);
+    updateRates();
+    EXPECT_EQ(ropf, ropf0);
+    EXPECT_EQ(ropr, ropr0);
+
+    kin.setPhaseExistence(iMetal, false);
+    updateRates();
+    // Reaction 0 would produce surface species
+    EXPECT_DOUBLE_EQ(ropf[0], ropr0[0]);
+    EXPECT_DOUBLE_EQ(ropr[0], ropr0[0]);
+    EXPECT_DOUBLE_EQ(ropf[1], ropf0[1]);
+    EXPECT_DOUBLE_EQ(ropr[1], ropf0[1]);
+
+    // An unstable reactant phase only matters for reactions proceeding in
+    // the reverse direction
+    kin.setPhaseStability(iSurf, true);
+    kin.setPhaseStability(iGas, false);
+    updateRates();
+    EXPECT_DOUBLE_EQ(ropf[0], ropf0[0]);
+    EXPECT_DOUBLE_EQ(ropr[0], ropr0[0]);
+}
+
+TEST_F(InterfacePhaseExistence, MaximumPhases)
+{
+    InterfaceKinetics kin2;
+    for (size_t i = 0; i < 64; i++) {
+        kin2.addPhase(gas);
+    }
+    EXPECT_THROW(kin2.addPhase(gas), CanteraError);
+    EXPECT_EQ(kin2.nPhases(), (size_t) 64);
+    kin2.setPhaseExistence(63, false);
+    EXPECT_EQ(kin2.phaseExistence(63), 0);
+    EXPECT_EQ(kin2.phaseExistence(62), 1);
+    kin2.setPhaseStability(62, false);
+    EXPECT_EQ(kin2.phaseStability(62), 0);
+    EXPECT_THROW(kin2.setPhaseExistence(64, false), CanteraError);
+}
+
 }
@@ -0,0 +1,736 @@
+#include "gtest/gtest.h"
+
+#include "cantera/oneD/Sim1D.h"
+#include "cantera/oneD/Inlet1D.h"
+#include "cantera/oneD/StFlow.h"
+#include "cantera/oneD/MultiJac.h"
+#include "cantera/oneD/MultiNewton.h"
+#include "cantera/oneD/Continuation1D.h"
+#include "cantera/oneD/FlameSweep.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport/TransportFactory.h"
+#include "cantera/base/global.h"
+
+#include <numeric>
+
+using namespace Cantera;
+
+class FreeFlameJacobianTest : public testing::Test
+{
+public:
+    FreeFlameJacobianTest()
+        : gas("h2o2.xml", "ohmech")
+        , flow(&gas)
+    {
+        gas.setState_TPX(300.0, OneAtm, "H2:1.0, O2:0.5, AR:2.0");
+        vector_fp x(gas.nSpecies()), yin(gas.nSpecies()), yout(gas.nSpecies());
+        gas.getMoleFractions(x.data());
+        gas.getMassFractions(yin.data());
+        double rho_in = gas.density();
+        gas.equilibrate("HP");
+        gas.getMassFractions(yout.data());
+        double rho_out = gas.density();
+        double Tad = gas.temperature();
+
+        vector_fp z(10);
+        for (size_t j = 0; j < z.size(); j++) {
+            z[j] = 0.002 * j * j;
+        }
+        flow.setupGrid(z.size(), z.data());
+        flow.setKinetics(gas);
+        flow.setPressure(OneAtm);
+
+        inlet.setMoleFractions(x.data());
+        inlet.setMdot(0.5 * rho_in);
+        inlet.setTemperature(300.0);
+
+        std::vector<Domain1D*> domains { &inlet, &flow, &outlet };
+        sim.reset(new Sim1D(domains));
+        vector_fp locs{0.0, 0.3, 0.7, 1.0};
+        double uout = 0.5 * rho_in / rho_out;
+        vector_fp value{0.5, 0.5, uout, uout};
+        sim->setInitialGuess("u", locs, value);
+        value = {300.0, 300.0, Tad, Tad};
+        sim->setInitialGuess("T", locs, value);
+        for (size_t k = 0; k < gas.nSpecies(); k++) {
+            value = {yin[k], yin[k], yout[k], yout[k]};
+            sim->setInitialGuess(gas.speciesName(k), locs, value);
+        }
+        sim->setFixedTemperature(0.5 * (300.0 + Tad));
+        flow.solveEnergyEqn();
+    }
+
+    //! Check that the steady-state Jacobian is identical with and without
+    //! reusing properties at the unperturbed grid points
+    void checkJacobianCache() {
+        size_t n = sim->size();
+        size_t bw = sim->bandwidth();
+        flow.enableJacobianCache(false);
+        sim->evalSSJacobian();
+        vector_fp J0;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = (i > bw) ? i - bw : 0; j < std::min(n, i + bw + 1); j++) {
+                J0.push_back(sim->jacobian(i, j));
+            }
+        }
+
+        flow.enableJacobianCache(true);
+        sim->evalSSJacobian();
+        size_t m = 0;
+        size_t nonzero = 0;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = (i > bw) ? i - bw : 0; j < std::min(n, i + bw + 1); j++) {
+                // compare bit-for-bit
+                EXPECT_EQ(sim->jacobian(i, j), J0[m]) << "J(" << i << "," << j << ")";
+                if (J0[m] != 0.0) {
+                    nonzero++;
+                }
+                m++;
+            }
+        }
+        EXPECT_GT(nonzero, 10 * n);
+    }
+
+    //! Solve the flame starting from the initial guess, and again after
+    //! calling *setSolver*, and check that the same grid and solution are
+    //! obtained
+    void solveBothWays(std::function<void()> setSolver) {
+        vector_fp z0 = flow.grid();
+        vector_fp xinit(sim->solution(), sim->solution() + sim->size());
+        sim->solve(0, true);
+        vector_fp z1 = flow.grid();
+        vector_fp x1(sim->solution(), sim->solution() + sim->size());
+
+        flow.setupGrid(z0.size(), z0.data());
+        sim->resize();
+        sim->setSolution(xinit.data());
+        setSolver();
+        sim->solve(0, true);
+        ASSERT_EQ(flow.grid(), z1);
+        for (size_t i = 0; i < x1.size(); i++) {
+            EXPECT_NEAR(x1[i], sim->solution()[i],
+                        1e-5 * std::abs(x1[i]) + 1e-10) << i;
+        }
+    }
+
+    IdealGasMix gas;
+    FreeFlame flow;
+    Inlet1D inlet;
+    Outlet1D outlet;
+    std::unique_ptr<Transport> trans;
+    std::unique_ptr<Sim1D> sim;
+};
+
+TEST_F(FreeFlameJacobianTest, CachedMixtureAveraged)
+{
+    trans.reset(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    checkJacobianCache();
+}
+
+TEST_F(FreeFlameJacobianTest, CachedMulticomponentSoret)
+{
+    trans.reset(newTransportMgr("Multi", &gas));
+    flow.setTransport(*trans);
+    flow.enableSoret(true);
+    checkJacobianCache();
+}
+
+TEST_F(FreeFlameJacobianTest, CachedRadiation)
+{
+    trans.reset(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    flow.enableRadiation(true);
+    checkJacobianCache();
+}
+
+TEST_F(FreeFlameJacobianTest, BlockTridiagonalSolver)
+{
+    trans.reset(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    inlet.setMoleFractions("H2:1.0, O2:0.5, AR:2.0");
+    sim->setRefineCriteria(1, 10.0, 0.5, 0.5);
+    solveBothWays([&]() { sim->setLinearSolver("block-tridiagonal"); });
+}
+
+TEST_F(FreeFlameJacobianTest, JacobianFree)
+{
+    trans.reset(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    inlet.setMoleFractions("H2:1.0, O2:0.5, AR:2.0");
+    sim->setRefineCriteria(1, 10.0, 0.5, 0.5);
+    // Tight tolerances, so that both solutions are converged well enough to
+    // be compared
+    flow.setSteadyTolerances(1e-6, 1e-12);
+    solveBothWays([&]() { sim->setLinearSolver("jfnk"); });
+    EXPECT_TRUE(sim->newton().jacobianFree());
+    EXPECT_GT(sim->newton().krylovIterations(), 0u);
+    EXPECT_EQ(sim->newton().krylovFailures(), 0u);
+    // The diagonal blocks are a sufficient preconditioner
+    EXPECT_TRUE(sim->OneDim::jacobian().diagonalOnly());
+}
+
+TEST(OpticallyThinRadiation, HeatLoss)
+{
+    IdealGasMix gas("gri30.xml", "gri30");
+    OpticallyThinRadiation rad;
+    rad.setThermo(gas);
+    size_t nsp = gas.nSpecies();
+    size_t kH2O = gas.speciesIndex("H2O");
+    size_t kCO2 = gas.speciesIndex("CO2");
+    double T[4] = {300.0, 1200.0, 2100.0, 400.0};
+    vector_fp Y(4*nsp, 0.0), wtm(4), qdot(4, -1.0);
+    for (size_t j = 0; j < 4; j++) {
+        Y[j*nsp + kH2O] = 0.1 + 0.02*j;
+        Y[j*nsp + kCO2] = 0.12 - 0.01*j;
+        Y[j*nsp + gas.speciesIndex("N2")] = 1.0 - Y[j*nsp + kH2O] - Y[j*nsp + kCO2];
+        gas.setMassFractions(&Y[j*nsp]);
+        wtm[j] = gas.meanMolecularWeight();
+    }
+    double P = 2*OneAtm;
+    rad.getHeatLoss(4, T, Y.data(), nsp, wtm.data(), P, 0.3, 0.5, 1, 3, qdot.data());
+    EXPECT_EQ(qdot[0], -1.0);
+    EXPECT_EQ(qdot[3], -1.0);
+
+    const double c_H2O[6] = {-0.23093, -1.12390, 9.41530, -2.99880, 0.51382,
+                             -1.86840e-5};
+    const double c_CO2[6] = {18.741, -121.310, 273.500, -194.050, 56.310,
+                             -5.8169};
+    double boundary = StefanBoltz * (0.3 * pow(T[0], 4) + 0.5 * pow(T[3], 4));
+    for (size_t j = 1; j < 3; j++) {
+        double k_H2O = 0.0, k_CO2 = 0.0;
+        for (int n = 0; n <= 5; n++) {
+            k_H2O += c_H2O[n] * pow(1000 / T[j], n);
+            k_CO2 += c_CO2[n] * pow(1000 / T[j], n);
+        }
+        double X_H2O = Y[j*nsp + kH2O] * wtm[j] / gas.molecularWeight(kH2O);
+        double X_CO2 = Y[j*nsp + kCO2] * wtm[j] / gas.molecularWeight(kCO2);
+        double k_P = 2 * (X_H2O * k_H2O + X_CO2 * k_CO2);
+        double expected = 2 * k_P * (2 * StefanBoltz * pow(T[j], 4) - boundary);
+        EXPECT_NEAR(qdot[j], expected, 1e-12 * std::abs(expected));
+    }
+}
+
+TEST_F(FreeFlameJacobianTest, CustomRadiationModel)
+{
+    //! Model with a uniform heat loss, used to check that the flow domain
+    //! passes the heat loss of a plug-in model to the energy equation
+    class UniformLoss : public Radiation1D
+    {
+    public:
+        virtual void getHeatLoss(size_t nPoints, const double* T,
+                                 const double* Y, size_t ldY, const double* wtm,
+                                 double pressure, double epsLeft,
+                                 double epsRight, size_t j0, size_t j1,
+                                 double* qdot) {
+            for (size_t j = j0; j < j1; j++) {
+                qdot[j] = 1.0e6;
+            }
+            ncalls++;
+        }
+        int ncalls = 0;
+    };
+
+    trans.reset(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    size_t nv = flow.nComponents();
+    size_t np = flow.nPoints();
+    vector_fp x(sim->size()), r0(sim->size()), r1(sim->size());
+    std::copy(sim->solution(), sim->solution() + sim->size(), x.begin());
+    sim->OneDim::eval(npos, x.data(), r0.data(), 0.0, 0);
+
+    auto model = std::make_shared<UniformLoss>();
+    flow.setRadiationModel(model);
+    EXPECT_TRUE(flow.radiationEnabled());
+    flow.enableRadiation(false);
+    flow.enableRadiation(true);
+    EXPECT_EQ(flow.radiationModel().get(), model.get());
+
+    sim->OneDim::eval(npos, x.data(), r1.data(), 0.0, 0);
+    EXPECT_GT(model->ncalls, 0);
+    size_t loc = sim->start(flow.domainIndex());
+    size_t nchanged = 0;
+    for (size_t j = 0; j < np; j++) {
+        for (size_t n = 0; n < nv; n++) {
+            size_t i = loc + j*nv + n;
+            if (n == c_offset_T && j > 0 && j < np - 1) {
+                // the energy equation is replaced at the fixed-temperature point
+                EXPECT_LE(r1[i], r0[i]);
+                nchanged += (r1[i] < r0[i]);
+            } else {
+                EXPECT_EQ(r1[i], r0[i]) << j << " " << n;
+            }
+        }
+    }
+    EXPECT_GE(nchanged, np - 3);
+}
+
+TEST_F(FreeFlameJacobianTest, Profiling)
+{
+    trans.reset(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    inlet.setMoleFractions("H2:1.0, O2:0.5, AR:2.0");
+    sim->enableProfiling();
+    EXPECT_TRUE(flow.profiler().enabled());
+    sim->setRefineCriteria(1, 10.0, 0.5, 0.5);
+    sim->solve(0, true);
+
+    const std::vector<GridProfile1D>& stats = sim->profileStats();
+    ASSERT_EQ(stats.size(), sim->gridSizeStats().size());
+    ASSERT_GT(stats.size(), 1u);
+    size_t iflow = flow.domainIndex();
+    for (size_t i = 0; i < stats.size(); i++) {
+        EXPECT_EQ(stats[i].points, sim->gridSizeStats()[i]);
+        ASSERT_EQ(stats[i].domains.size(), sim->nDomains());
+        const Profile1D& solver = stats[i].solver;
+        EXPECT_EQ(solver.calls(Profile1D::Jacobian),
+                  (size_t) sim->jacobianCountStats()[i]);
+        EXPECT_GE(solver.calls(Profile1D::Factor),
+                  solver.calls(Profile1D::Jacobian));
+        EXPECT_GE(solver.calls(Profile1D::Solve),
+                  solver.calls(Profile1D::Factor));
+        EXPECT_GE(solver.calls(Profile1D::Residual),
+                  (size_t) sim->evalCountStats()[i]);
+
+        // Every evaluation of the flow residual updates the thermo
+        // properties, including those made for the Jacobian
+        const Profile1D& prof = stats[i].domains[iflow];
+        EXPECT_EQ(prof.calls(Profile1D::ThermoUpdate),
+                  prof.calls(Profile1D::DiffusiveFluxes));
+        EXPECT_GT(prof.calls(Profile1D::Residual),
+                  solver.calls(Profile1D::Residual));
+        EXPECT_GT(prof.elapsed(Profile1D::Kinetics), 0.0);
+        EXPECT_LT(prof.elapsed(Profile1D::ThermoUpdate) +
+                  prof.elapsed(Profile1D::TransportUpdate) +
+                  prof.elapsed(Profile1D::DiffusiveFluxes) +
+                  prof.elapsed(Profile1D::Kinetics),
+                  prof.elapsed(Profile1D::Residual));
+        EXPECT_EQ(prof.calls(Profile1D::Jacobian), 0u);
+    }
+
+    std::string json = sim->profileJSON();
+    EXPECT_NE(json.find("\"grids\""), std::string::npos);
+    EXPECT_NE(json.find("\"total\""), std::string::npos);
+    EXPECT_NE(json.find("\"id\": \"flame\""), std::string::npos);
+    EXPECT_NE(json.find("\"factor\""), std::string::npos);
+
+    sim->clearStats();
+    sim->enableProfiling(false);
+    sim->solve(0, false);
+    for (const auto& grid : sim->profileStats()) {
+        EXPECT_EQ(grid.solver.calls(Profile1D::Jacobian), 0u);
+        EXPECT_EQ(grid.domains[iflow].calls(Profile1D::ThermoUpdate), 0u);
+    }
+}
+
+TEST_F(FreeFlameJacobianTest, ReactionSensitivities)
+{
+    trans.reset(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    // The inlet composition is only applied once the inlet is connected to
+    // the flow domain
+    inlet.setMoleFractions("H2:1.0, O2:0.5, AR:2.0");
+    sim->setRefineCriteria(1, 10.0, 0.5, 0.5);
+    sim->solve(0, true);
+    flow.setSteadyTolerances(1e-10, 1e-16);
+    sim->solve(0, false);
+    vector_fp x0(sim->solution(), sim->solution() + sim->size());
+
+    size_t jmax = 0;
+    for (size_t j = 0; j < flow.nPoints(); j++) {
+        if (sim->value(1, c_offset_T, j) > sim->value(1, c_offset_T, jmax)) {
+            jmax = j;
+        }
+    }
+    std::vector<vector_fp> dgdx {
+        sim->componentDerivative(1, c_offset_U, 0),
+        sim->componentDerivative(1, c_offset_T, jmax)
+    };
+    Array2D sens = sim->reactionSensitivities(dgdx);
+    ASSERT_EQ(sens.nRows(), 2u);
+    ASSERT_EQ(sens.nColumns(), gas.nReactions());
+
+    // The block solve gives the same adjoint vectors as separate solves
+    size_t n = sim->size();
+    vector_fp b(2 * n), lambda(2 * n), lambda1(n);
+    std::copy(dgdx[0].begin(), dgdx[0].end(), b.begin());
+    std::copy(dgdx[1].begin(), dgdx[1].end(), b.begin() + n);
+    sim->solveAdjoint(b.data(), lambda.data(), 2);
+    sim->solveAdjoint(dgdx[1].data(), lambda1.data());
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(lambda[n + i], lambda1[i], 1e-10 * std::abs(lambda1[i]));
+    }
+
+    // The factored Jacobian can be reused only for the same solution and grid
+    vector_fp lambda2(n);
+    sim->solveAdjoint(dgdx[1].data(), lambda2.data(), 1, false);
+    EXPECT_EQ(lambda2, lambda1);
+    sim->setValue(1, c_offset_T, jmax, 1.001 * sim->value(1, c_offset_T, jmax));
+    EXPECT_THROW(sim->solveAdjoint(dgdx[1].data(), lambda2.data(), 1, false),
+                 CanteraError);
+    sim->setSolution(x0.data());
+    sim->solveAdjoint(dgdx[1].data(), lambda2.data(), 1, false);
+    sim->resize();
+    EXPECT_THROW(sim->solveAdjoint(dgdx[1].data(), lambda2.data(), 1, false),
+                 CanteraError);
+
+    // Compare with finite differences for the reaction with the largest
+    // sensitivity of the flame speed and for one other reaction
+    size_t imax = 0;
+    double smax[2] = {0.0, 0.0};
+    for (size_t i = 0; i < gas.nReactions(); i++) {
+        if (std::abs(sens(0, i)) > std::abs(sens(0, imax))) {
+            imax = i;
+        }
+        for (size_t r = 0; r < 2; r++) {
+            smax[r] = std::max(smax[r], std::abs(sens(r, i)));
+        }
+    }
+    double dp = 1e-2;
+    for (size_t i : {imax, size_t(0)}) {
+        double g[2][2];
+        for (int m = 0; m < 2; m++) {
+            gas.setMultiplier(i, m ? 1 - dp : 1 + dp);
+            sim->setSolution(x0.data());
+            sim->solve(0, false);
+            g[m][0] = sim->value(1, c_offset_U, 0);
+            g[m][1] = sim->value(1, c_offset_T, jmax);
+        }
+        gas.setMultiplier(i, 1.0);
+        for (size_t r = 0; r < 2; r++) {
+            double fd = (g[0][r] - g[1][r]) / (2 * dp);
+            EXPECT_NEAR(sens(r, i), fd, 0.02 * smax[r])
+                << "reaction " << i << ", output " << r;
+        }
+    }
+}
+
+class CounterflowContinuationTest : public testing::Test
+{
+public:
+    CounterflowContinuationTest()
+        : gas("h2o2.xml", "ohmech")
+        , flow(&gas)
+    {
+        gas.setState_TPX(300.0, OneAtm, "H2:1.0, AR:1.0");
+        trans.reset(newTransportMgr("Mix", &gas));
+        flow.setTransport(*trans);
+        flow.setKinetics(gas);
+        flow.setPressure(OneAtm);
+        vector_fp z(11);
+        for (size_t j = 0; j < z.size(); j++) {
+            z[j] = 0.002 * j;
+        }
+        flow.setupGrid(z.size(), z.data());
+
+        fuel.setMoleFractions("H2:1.0, AR:1.0");
+        fuel.setTemperature(300.0);
+        fuel.setMdot(0.2);
+        oxidizer.setMoleFractions("O2:0.21, AR:0.79");
+        oxidizer.setTemperature(300.0);
+        oxidizer.setMdot(0.4);
+
+        std::vector<Domain1D*> domains { &fuel, &flow, &oxidizer };
+        sim.reset(new Sim1D(domains));
+        flow.fixTemperature();
+        flow.setSteadyTolerances(1e-6, 1e-12);
+        zinit = flow.grid();
+        xinit.assign(sim->solution(), sim->solution() + sim->size());
+        sim->solve(0, true);
+        x0.assign(sim->solution(), sim->solution() + sim->size());
+    }
+
+    //! Solve directly from the initial solution for the parameter value *p*
+    //! and compare with the current solution
+    void checkSolution(std::function<void(double)> setParameter, double p) {
+        vector_fp x(sim->solution(), sim->solution() + sim->size());
+        sim->setSolution(x0.data());
+        setParameter(p);
+        sim->solve(0, false);
+        for (size_t i = 0; i < x.size(); i++) {
+            EXPECT_NEAR(x[i], sim->solution()[i],
+                        1e-3 * std::abs(sim->solution()[i]) + 1e-8) << i;
+        }
+    }
+
+    //! Solve again starting from the initial grid and initial guess, and
+    //! compare with the solution found by the constructor
+    void checkSteadySolution(double rtol=1e-5) {
+        vector_fp z1 = flow.grid();
+        flow.setupGrid(zinit.size(), zinit.data());
+        sim->resize();
+        sim->setSolution(xinit.data());
+        sim->solve(0, true);
+        ASSERT_EQ(flow.grid(), z1);
+        for (size_t i = 0; i < x0.size(); i++) {
+            EXPECT_NEAR(x0[i], sim->solution()[i],
+                        rtol * std::abs(x0[i]) + 1e-10) << i;
+        }
+    }
+
+    IdealGasMix gas;
+    AxiStagnFlow flow;
+    Inlet1D fuel, oxidizer;
+    std::unique_ptr<Transport> trans;
+    std::unique_ptr<Sim1D> sim;
+    vector_fp zinit; //!< initial grid
+    vector_fp xinit; //!< initial guess
+    vector_fp x0; //!< solution for the initial parameters
+};
+
+TEST_F(CounterflowContinuationTest, NaturalParameter)
+{
+    auto setMdot = Continuation1D::massFlowRate(oxidizer);
+    Continuation1D cont(*sim, setMdot, 0.4);
+    cont.setStepSize(0.05);
+    size_t nsteps = cont.advance(0.8);
+    EXPECT_EQ(nsteps, cont.nSteps());
+    EXPECT_GE(nsteps, 2u);
+    EXPECT_DOUBLE_EQ(cont.parameter(), 0.8);
+    EXPECT_DOUBLE_EQ(oxidizer.mdot(), 0.8);
+    // Jacobians are reused between steps
+    EXPECT_LT(cont.nJacobianEvals(), nsteps);
+    checkSolution(setMdot, 0.8);
+}
+
+TEST_F(CounterflowContinuationTest, ArcLength)
+{
+    auto setMdot = Continuation1D::massFlowRate(oxidizer);
+    Continuation1D cont(*sim, setMdot, 0.4);
+    cont.setArcLength(true);
+    cont.setStepSize(-0.05);
+    cont.advance(0.2);
+    EXPECT_LE(cont.parameter(), 0.2);
+    EXPECT_LT(cont.parameterSlope(), 0.0);
+    EXPECT_EQ(cont.nTurningPoints(), 0u);
+    EXPECT_LE(cont.nJacobianEvals(), cont.nSteps());
+    checkSolution(setMdot, cont.parameter());
+}
+
+TEST_F(CounterflowContinuationTest, CompositionBlend)
+{
+    vector_fp X0(gas.nSpecies()), X1(gas.nSpecies());
+    X0[gas.speciesIndex("O2")] = 0.21;
+    X0[gas.speciesIndex("AR")] = 0.79;
+    X1[gas.speciesIndex("O2")] = 0.5;
+    X1[gas.speciesIndex("AR")] = 0.5;
+    auto blend = Continuation1D::compositionBlend(oxidizer, X0, X1);
+    Continuation1D cont(*sim, blend, 0.0);
+    cont.setStepSize(0.25);
+    cont.setRefineGrid(true);
+    cont.advance(1.0);
+    EXPECT_DOUBLE_EQ(cont.parameter(), 1.0);
+    checkSolution(blend, 1.0);
+}
+
+TEST_F(CounterflowContinuationTest, DomainWidth)
+{
+    auto setWidth = Continuation1D::domainWidth(flow);
+    double width = flow.grid(flow.nPoints() - 1) - flow.grid(0);
+    Continuation1D cont(*sim, setWidth, width);
+    cont.setStepSize(0.1 * width);
+    cont.advance(1.5 * width);
+    EXPECT_NEAR(flow.grid(flow.nPoints() - 1) - flow.grid(0), 1.5 * width,
+                1e-12);
+    checkSolution(setWidth, 1.5 * width);
+}
+
+TEST_F(CounterflowContinuationTest, TransientMethod)
+{
+    EXPECT_EQ(sim->transientMethod(), "backward-euler");
+    EXPECT_THROW(sim->setTransientMethod("euler"), CanteraError);
+
+    // Solve from the initial guess with both methods, and compare the numbers
+    // of time steps and Jacobian evaluations
+    sim->clearStats();
+    checkSteadySolution();
+    const vector_int& stepsBE = sim->timeStepStats();
+    int nstepsBE = std::accumulate(stepsBE.begin(), stepsBE.end(), 0);
+    const vector_int& jacBE = sim->jacobianCountStats();
+    int njacBE = std::accumulate(jacBE.begin(), jacBE.end(), 0);
+    EXPECT_GT(nstepsBE, 0);
+
+    sim->setTransientMethod("bdf2");
+    EXPECT_EQ(sim->transientMethod(), "bdf2");
+    sim->clearStats();
+    checkSteadySolution();
+    const vector_int& steps = sim->timeStepStats();
+    const vector_int& jac = sim->jacobianCountStats();
+    EXPECT_LT(std::accumulate(steps.begin(), steps.end(), 0), nstepsBE);
+    EXPECT_LE(std::accumulate(jac.begin(), jac.end(), 0), njacBE);
+
+    // Integrate the transient problem after a change of the mass flow rate,
+    // which approaches the new steady-state solution
+    oxidizer.setMdot(0.6);
+    vector_fp x(x0), r(x0.size());
+    double dt = sim->timeStep(100, 1e-5, x.data(), r.data(), 0);
+    EXPECT_GT(dt, 1e-3);
+    EXPECT_EQ(sim->transientMethod(), "bdf2");
+    sim->setSolution(x.data());
+    checkSolution([&](double mdot) { oxidizer.setMdot(mdot); }, 0.6);
+}
+
+TEST_F(CounterflowContinuationTest, BlockTridiagonalSolver)
+{
+    // The pressure eigenvalue at the first point only appears in the
+    // equations of the second point, so blocks have to be merged
+    sim->setLinearSolver("block-tridiagonal");
+    checkSteadySolution();
+}
+
+TEST_F(CounterflowContinuationTest, JacobianFree)
+{
+    EXPECT_THROW(sim->newton().setKrylovOptions(0.0), CanteraError);
+    EXPECT_THROW(sim->newton().setKrylovOptions(1e-4, 0), CanteraError);
+
+    // Preconditioned by the full Jacobian. The solution found by the
+    // constructor was accepted with a Jacobian which is several steps old, so
+    // it is only converged to about the steady-state tolerances.
+    sim->newton().setJacobianFree(true);
+    checkSteadySolution(1e-4);
+    EXPECT_GT(sim->newton().krylovIterations(), 0u);
+    EXPECT_EQ(sim->newton().krylovFailures(), 0u);
+
+    // The diagonal blocks are singular, since the pressure eigenvalue at the
+    // first point does not appear in its equations, so the full
+    // block-tridiagonal Jacobian is used as the preconditioner
+    sim->setLinearSolver("jfnk");
+    size_t iter = sim->newton().krylovIterations();
+    checkSteadySolution(1e-4);
+    EXPECT_FALSE(sim->OneDim::jacobian().diagonalOnly());
+    EXPECT_GT(sim->newton().krylovIterations(), iter);
+    EXPECT_EQ(sim->newton().krylovFailures(), 0u);
+}
+
+TEST_F(CounterflowContinuationTest, IncrementalRefine)
+{
+    vector_fp z0 = flow.grid();
+    sim->setRefineCriteria(1, 5.0, 0.05, 0.05);
+    oxidizer.setMdot(0.8);
+    sim->setIncrementalRefine(true);
+    sim->solve(0, true);
+    vector_fp z1 = flow.grid();
+    vector_fp x1(sim->solution(), sim->solution() + sim->size());
+    EXPECT_GT(z1.size(), z0.size());
+
+    // Without incremental refinement, the same grid and solution are obtained
+    flow.setupGrid(z0.size(), z0.data());
+    sim->resize();
+    sim->setSolution(x0.data());
+    sim->setIncrementalRefine(false);
+    sim->solve(0, true);
+    ASSERT_EQ(flow.grid(), z1);
+    for (size_t i = 0; i < x1.size(); i++) {
+        EXPECT_NEAR(x1[i], sim->solution()[i],
+                    1e-4 * std::abs(x1[i]) + 1e-9) << i;
+    }
+}
+
+class CounterflowSweepTest : public testing::Test
+{
+public:
+    CounterflowSweepTest()
+        : gas("h2o2.xml", "ohmech")
+        , sweep(gas, "Mix", "counterflow")
+    {
+        vector_fp z(11);
+        for (size_t j = 0; j < z.size(); j++) {
+            z[j] = 0.002 * j;
+        }
+        sweep.setInitialGrid(z);
+        sweep.setSetupFunction([](FlameSweep::Flame& f) {
+            f.flow->fixTemperature();
+            f.flow->setSteadyTolerances(1e-6, 1e-12);
+        });
+        sweep.setParameterFunction(
+            [](FlameSweep::Flame& f, const vector_fp& p) {
+                f.flow->setPressure(OneAtm);
+                f.inlet->setMoleFractions("H2:1.0, AR:1.0");
+                f.inlet->setTemperature(300.0);
+                f.inlet->setMdot(0.2);
+                f.right->setMoleFractions("O2:0.21, AR:0.79");
+                f.right->setTemperature(300.0);
+                f.right->setMdot(p[0]);
+            });
+        for (size_t i = 0; i < 6; i++) {
+            sweep.addCase({0.2 + 0.1 * i});
+        }
+    }
+
+    IdealGasMix gas;
+    FlameSweep sweep;
+};
+
+TEST_F(CounterflowSweepTest, SerialAndParallel)
+{
+    sweep.run(1, false);
+    EXPECT_EQ(sweep.nFailed(), 0u);
+    // only the first case is started from the initial guess
+    EXPECT_EQ(sweep.nInitialGuess(), 1u);
+
+    FlameSweep sweep2(gas, "Mix", "counterflow");
+    sweep2.setInitialGrid(sweep.result(0).grid);
+    sweep2.setSetupFunction([](FlameSweep::Flame& f) {
+        f.flow->fixTemperature();
+        f.flow->setSteadyTolerances(1e-6, 1e-12);
+    });
+    sweep2.setParameterFunction([](FlameSweep::Flame& f, const vector_fp& p) {
+        f.inlet->setMoleFractions("H2:1.0, AR:1.0");
+        f.inlet->setTemperature(300.0);
+        f.inlet->setMdot(0.2);
+        f.right->setMoleFractions("O2:0.21, AR:0.79");
+        f.right->setTemperature(300.0);
+        f.right->setMdot(p[0]);
+    });
+    for (size_t i = 0; i < sweep.nCases(); i++) {
+        sweep2.addCase(sweep.result(i).parameters);
+    }
+    sweep2.run(3, false);
+    EXPECT_EQ(sweep2.nFailed(), 0u);
+    EXPECT_LE(sweep2.nInitialGuess(), 3u);
+
+    ASSERT_EQ(sweep.componentNames(), sweep2.componentNames());
+    for (size_t i = 0; i < sweep.nCases(); i++) {
+        const vector_fp& x1 = sweep.result(i).solution;
+        const vector_fp& x2 = sweep2.result(i).solution;
+        ASSERT_EQ(x1.size(), x2.size());
+        for (size_t n = 0; n < x1.size(); n++) {
+            EXPECT_NEAR(x1[n], x2[n], 1e-4 * std::abs(x1[n]) + 1e-8);
+        }
+    }
+}
+
+TEST_F(CounterflowSweepTest, SaveRestore)
+{
+    sweep.run(2, true);
+    EXPECT_EQ(sweep.nFailed(), 0u);
+    sweep.save("flame_sweep.xml", "mdot");
+
+    // restore one of the solutions into a separate simulation
+    AxiStagnFlow flow(&gas);
+    Inlet1D fuel, oxidizer;
+    std::unique_ptr<Transport> trans(newTransportMgr("Mix", &gas));
+    flow.setTransport(*trans);
+    flow.setKinetics(gas);
+    std::vector<Domain1D*> domains { &fuel, &flow, &oxidizer };
+    Sim1D sim(domains);
+    sim.restore("flame_sweep.xml", "mdot3", 0);
+    const FlameSweep::Result& r = sweep.result(3);
+    ASSERT_EQ(flow.nPoints(), r.grid.size());
+    size_t nc = flow.nComponents();
+    for (size_t j = 0; j < flow.nPoints(); j++) {
+        EXPECT_DOUBLE_EQ(flow.grid(j), r.grid[j]);
+        EXPECT_NEAR(sim.value(1, c_offset_U, j), r.solution[j * nc], 1e-12);
+    }
+    EXPECT_NEAR(oxidizer.mdot(), r.parameters[0], 1e-12);
+}
+
+int main(int argc, char** argv)
+{
+    printf("Running main() from test_oneD.cpp\n");
+    testing::InitGoogleTest(&argc, argv);
+    make_deprecation_warnings_fatal();
+    int result = RUN_ALL_TESTS();
+    appdelete();
+    return result;
+}
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+
+#include "cantera/thermo/CompactStateArray.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/thermo/ThermoPhase.h"
+
+using namespace Cantera;
+
+class CompactStateArrayTest : public testing::Test
+{
+public:
+    CompactStateArrayTest() {
+        gas.reset(newPhase("h2o2.xml"));
+        nsp = gas->nSpecies();
+        // States of a premixed flame-like profile
+        for (size_t i = 0; i < 50; i++) {
+            double a = i / 49.0;
+            gas->setState_TPX(300 + 2000 * a, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+            vector_fp X(nsp);
+            gas->getMoleFractions(X.data());
+            X[gas->speciesIndex("H2O")] = 2 * a;
+            X[gas->speciesIndex("H2")] *= 1 - a;
+            X[gas->speciesIndex("O2")] *= 1 - a;
+            X[gas->speciesIndex("OH")] = 1e-3 * a * (1 - a);
+            X[gas->speciesIndex("H")] = 1e-9 * a;
+            gas->setMoleFractions(X.data());
+            vector_fp state;
+            gas->saveState(state);
+            states.insert(states.end(), state.begin(), state.end());
+        }
+    }
+
+    std::unique_ptr<ThermoPhase> gas;
+    size_t nsp;
+    vector_fp states;
+};
+
+TEST_F(CompactStateArrayTest, float32)
+{
+    size_t n = states.size() / (nsp + 2);
+    CompactStateArray store(*gas, n);
+    EXPECT_EQ(store.stateSize(), nsp + 2);
+    EXPECT_EQ(store.storageBytes(), n * (nsp + 2) * sizeof(float));
+
+    store.setStates(0, n, states.data());
+    vector_fp states2(states.size());
+    store.getStates(0, n, states2.data());
+    for (size_t j = 0; j < states.size(); j++) {
+        EXPECT_NEAR(states2[j], states[j], 1e-7 * fabs(states[j]));
+    }
+
+    // Save and restore a single state
+    gas->restoreState(nsp + 2, &states[20 * (nsp + 2)]);
+    double T = gas->temperature();
+    double rho = gas->density();
+    double h = gas->enthalpy_mass();
+    store.save(3, *gas);
+    gas->setState_TP(500, 2 * OneAtm);
+    store.restore(3, *gas);
+    EXPECT_NEAR(gas->temperature(), T, 1e-7 * T);
+    EXPECT_NEAR(gas->density(), rho, 1e-7 * rho);
+    EXPECT_NEAR(gas->enthalpy_mass(), h, 1e-5 * fabs(h));
+}
+
+TEST_F(CompactStateArrayTest, scaled16)
+{
+    size_t n = states.size() / (nsp + 2);
+    CompactStateArray store(*gas, n, CompactStateArray::Precision::Scaled16);
+    EXPECT_EQ(store.storageBytes(), n * (nsp + 2) * sizeof(uint16_t));
+    store.fitRanges(n, states.data());
+    EXPECT_DOUBLE_EQ(store.lowerBound(0), 300);
+    EXPECT_DOUBLE_EQ(store.upperBound(0), 2300);
+
+    store.setStates(0, n, states.data());
+    vector_fp states2(states.size());
+    store.getStates(0, n, states2.data());
+    for (size_t j = 0; j < states.size(); j++) {
+        size_t m = j % (nsp + 2);
+        double range = store.upperBound(m) - store.lowerBound(m);
+        EXPECT_LE(fabs(states2[j] - states[j]), 0.5 * range / 65535 * 1.0001);
+    }
+
+    // Restored mass fractions are normalized
+    store.restore(n - 1, *gas);
+    vector_fp Y(nsp);
+    gas->getMassFractions(Y.data());
+    double sum = 0.0;
+    for (size_t k = 0; k < nsp; k++) {
+        sum += Y[k];
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-14);
+    EXPECT_NEAR(gas->temperature(), 2300, 0.02);
+
+    // Values outside the range are clipped
+    store.setRange(0, 500, 1000);
+    gas->setState_TP(2000, OneAtm);
+    store.save(0, *gas);
+    store.restore(0, *gas);
+    EXPECT_DOUBLE_EQ(gas->temperature(), 1000);
+}
+
+TEST_F(CompactStateArrayTest, resize_and_errors)
+{
+    CompactStateArray store(*gas, 2);
+    store.setStates(0, 2, states.data());
+    store.resize(5);
+    EXPECT_EQ(store.size(), (size_t) 5);
+    vector_fp state(nsp + 2);
+    store.getStates(1, 1, state.data());
+    EXPECT_NEAR(state[0], states[nsp + 2], 1e-4);
+
+    EXPECT_THROW(store.getStates(4, 2, state.data()), CanteraError);
+    EXPECT_THROW(store.save(5, *gas), CanteraError);
+    EXPECT_THROW(store.setRange(nsp + 2, 0, 1), CanteraError);
+    EXPECT_THROW(store.setRange(0, 1, 0), CanteraError);
+}
@@ -0,0 +1,256 @@
+#include "gtest/gtest.h"
+#include "cantera/thermo/PengRobinsonMFTP.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+
+namespace Cantera
+{
+
+class PengRobinsonMFTP_Test : public testing::Test
+{
+public:
+    PengRobinsonMFTP_Test() {
+        test_phase.reset(newPhase("../data/co2_PR_example.cti"));
+    }
+
+    //! Supercritical mixture of CO2, H2O and CH4
+    void setMixture(double T, double P) {
+        test_phase->setState_TPX(T, P, "CO2:0.7, H2O:0.1, CH4:0.2");
+    }
+
+    std::unique_ptr<ThermoPhase> test_phase;
+};
+
+TEST_F(PengRobinsonMFTP_Test, construct_from_cti)
+{
+    PengRobinsonMFTP* peng_robinson_phase = dynamic_cast<PengRobinsonMFTP*>(test_phase.get());
+    EXPECT_TRUE(peng_robinson_phase != NULL);
+}
+
+TEST_F(PengRobinsonMFTP_Test, critProperties)
+{
+    // The critical point of a pure fluid is recovered from its parameters
+    PengRobinsonMFTP& pr = dynamic_cast<PengRobinsonMFTP&>(*test_phase);
+    double Tc = 304.21;
+    double Pc = 7.3825e6;
+    double a = PengRobinsonMFTP::omega_a * pow(GasConstant * Tc, 2) / Pc;
+    double b = PengRobinsonMFTP::omega_b * GasConstant * Tc / Pc;
+    pr.setSpeciesCoeffs("CO2", a, b, 0.2236);
+    test_phase->setState_TPX(300.0, OneAtm, "CO2:1.0");
+    EXPECT_NEAR(pr.critTemperature(), Tc, 1e-10 * Tc);
+    EXPECT_NEAR(pr.critPressure(), Pc, 1e-10 * Pc);
+    EXPECT_NEAR(pr.critCompressibility(), PengRobinsonMFTP::omega_vc, 1e-12);
+
+    // At the critical point, the isotherm has an inflection point
+    pr.setState_TP(Tc, Pc);
+    double v = pr.molarVolume();
+    EXPECT_NEAR(v, pr.critVolume(), 1e-4 * v);
+}
+
+TEST_F(PengRobinsonMFTP_Test, setTP)
+{
+    setMixture(400.0, 100e5);
+    EXPECT_NEAR(test_phase->pressure(), 100e5, 1e-6);
+    EXPECT_NEAR(test_phase->temperature(), 400.0, 1e-12);
+    // The density is larger than the ideal gas density
+    double rho_ideal = 100e5 * test_phase->meanMolecularWeight() /
+        (GasConstant * 400.0);
+    EXPECT_GT(test_phase->density(), rho_ideal);
+
+    // Water vapor below its saturation pressure
+    test_phase->setState_TPX(300.0, 2000.0, "H2O:1.0");
+    EXPECT_NEAR(test_phase->pressure(), 2000.0, 1e-6);
+    EXPECT_LT(test_phase->density(), 0.1);
+
+    // The batched evaluation uses the root with the lowest Gibbs free energy
+    PengRobinsonMFTP& pr = dynamic_cast<PengRobinsonMFTP&>(*test_phase);
+    vector_fp X(pr.nSpecies());
+    pr.getMoleFractions(X.data());
+    double T = 300.0;
+    double P = 20e3;
+    double rho;
+    pr.getPropertiesBatch(1, &T, &P, X.data(), 0, &rho, nullptr,
+                          nullptr, nullptr, nullptr, nullptr);
+    EXPECT_GT(rho, 500.0);
+    // which setState_TP() finds when starting from a liquid state
+    pr.setState_TR(300.0, 1000.0);
+    pr.setState_TP(300.0, 20e3);
+    EXPECT_NEAR(pr.density(), rho, 1e-12 * rho);
+}
+
+TEST_F(PengRobinsonMFTP_Test, derivatives)
+{
+    // Compare the analytical derivatives with finite differences
+    PengRobinsonMFTP& pr = dynamic_cast<PengRobinsonMFTP&>(*test_phase);
+    double T = 400.0;
+    double P = 100e5;
+    double dT = 1e-3;
+    setMixture(T, P);
+    double cp = pr.cp_mole();
+    double cv = pr.cv_mole();
+    double rho = pr.density();
+    double mv = pr.molarVolume();
+    double c = pr.soundSpeed();
+    double dpdT, dpdV;
+    pr.getPressureDerivatives(dpdT, dpdV);
+
+    pr.setState_TP(T + dT, P);
+    double h1 = pr.enthalpy_mole();
+    double s1 = pr.entropy_mole();
+    pr.setState_TP(T - dT, P);
+    double h0 = pr.enthalpy_mole();
+    double s0 = pr.entropy_mole();
+    EXPECT_NEAR(cp, (h1 - h0) / (2 * dT), 1e-6 * cp);
+    EXPECT_NEAR(cp / T, (s1 - s0) / (2 * dT), 1e-6 * cp / T);
+
+    pr.setState_TR(T + dT, rho);
+    double u1 = pr.intEnergy_mole();
+    double p1 = pr.pressure();
+    pr.setState_TR(T - dT, rho);
+    double u0 = pr.intEnergy_mole();
+    double p0 = pr.pressure();
+    EXPECT_NEAR(cv, (u1 - u0) / (2 * dT), 1e-6 * cv);
+    EXPECT_NEAR(dpdT, (p1 - p0) / (2 * dT), 1e-6 * dpdT);
+
+    double drho = 1e-6 * rho;
+    pr.setState_TR(T, rho + drho);
+    p1 = pr.pressure();
+    pr.setState_TR(T, rho - drho);
+    p0 = pr.pressure();
+    double dpdrho = (p1 - p0) / (2 * drho);
+    EXPECT_NEAR(dpdV, - dpdrho * rho / mv, 1e-6 * fabs(dpdV));
+    EXPECT_NEAR(c, sqrt(cp / cv * dpdrho), 1e-6 * c);
+
+    pr.setState_TP(T, P);
+    EXPECT_NEAR(pr.isothermalCompressibility(), -1 / (mv * dpdV), 1e-12);
+    EXPECT_NEAR(pr.thermalExpansionCoeff(), -dpdT / (mv * dpdV), 1e-12);
+}
+
+TEST_F(PengRobinsonMFTP_Test, partialMolarProperties)
+{
+    double T = 400.0;
+    double P = 100e5;
+    setMixture(T, P);
+    size_t nsp = test_phase->nSpecies();
+    vector_fp x(nsp), hbar(nsp), sbar(nsp), vbar(nsp), mu(nsp);
+    test_phase->getMoleFractions(x.data());
+    test_phase->getPartialMolarEnthalpies(hbar.data());
+    test_phase->getPartialMolarEntropies(sbar.data());
+    test_phase->getPartialMolarVolumes(vbar.data());
+    test_phase->getChemPotentials(mu.data());
+
+    double h = test_phase->enthalpy_mole();
+    double s = test_phase->entropy_mole();
+    double g = test_phase->gibbs_mole();
+    double v = test_phase->molarVolume();
+    EXPECT_NEAR(dot(x.begin(), x.end(), hbar.begin()), h, 1e-9 * fabs(h));
+    EXPECT_NEAR(dot(x.begin(), x.end(), sbar.begin()), s, 1e-9 * fabs(s));
+    EXPECT_NEAR(dot(x.begin(), x.end(), vbar.begin()), v, 1e-9 * v);
+    EXPECT_NEAR(dot(x.begin(), x.end(), mu.begin()), g, 1e-9 * fabs(g));
+
+    // Derivatives of the total properties with respect to the mole numbers,
+    // for one mole of the mixture
+    double dn = 1e-6;
+    for (size_t k : {0, 1, 3}) {
+        vector_fp n = x;
+        n[k] = x[k] + dn;
+        test_phase->setState_TPX(T, P, n.data());
+        double N = 1 + dn;
+        double V1 = N * test_phase->molarVolume();
+        double H1 = N * test_phase->enthalpy_mole();
+        double G1 = N * test_phase->gibbs_mole();
+        n[k] = x[k] - dn;
+        test_phase->setState_TPX(T, P, n.data());
+        N = 1 - dn;
+        double V0 = N * test_phase->molarVolume();
+        double H0 = N * test_phase->enthalpy_mole();
+        double G0 = N * test_phase->gibbs_mole();
+        EXPECT_NEAR(vbar[k], (V1 - V0) / (2 * dn), 1e-6 * v);
+        EXPECT_NEAR(hbar[k], (H1 - H0) / (2 * dn), 1e-6 * fabs(hbar[k]));
+        EXPECT_NEAR(mu[k], (G1 - G0) / (2 * dn), 1e-6 * fabs(mu[k]));
+    }
+}
+
+TEST_F(PengRobinsonMFTP_Test, activityCoeffs)
+{
+    setMixture(400.0, 100e5);
+    size_t nsp = test_phase->nSpecies();
+    vector_fp x(nsp), ac(nsp), mu(nsp), mu0(nsp);
+    test_phase->getMoleFractions(x.data());
+    test_phase->getActivityCoefficients(ac.data());
+    test_phase->getChemPotentials(mu.data());
+    test_phase->getStandardChemPotentials(mu0.data());
+    for (size_t k = 0; k < nsp; k++) {
+        if (x[k] > 0) {
+            double mu_k = mu0[k] + test_phase->RT() * log(x[k] * ac[k]);
+            EXPECT_NEAR(mu[k], mu_k, 1e-9 * fabs(mu[k]));
+        }
+    }
+}
+
+TEST_F(PengRobinsonMFTP_Test, batchProperties)
+{
+    PengRobinsonMFTP& pr = dynamic_cast<PengRobinsonMFTP&>(*test_phase);
+    size_t nsp = pr.nSpecies();
+    const size_t n = 4;
+    double T[n] = {350.0, 400.0, 600.0, 1000.0};
+    double P[n] = {OneAtm, 50e5, 200e5, 100e5};
+    vector_fp X(n * nsp, 0.0);
+    for (size_t i = 0; i < n; i++) {
+        X[i * nsp + pr.speciesIndex("CO2")] = 0.4 + 0.1 * i;
+        X[i * nsp + pr.speciesIndex("H2O")] = 0.1;
+        X[i * nsp + pr.speciesIndex("N2")] = 0.5 - 0.1 * i;
+    }
+    setMixture(500.0, 20e5);
+    double rho0 = pr.density();
+
+    vector_fp rho(n), h(n), s(n), cp(n), cv(n), c(n);
+    pr.getPropertiesBatch(n, T, P, X.data(), nsp, rho.data(), h.data(),
+                          s.data(), cp.data(), cv.data(), c.data());
+    // The state of the phase is unchanged
+    EXPECT_DOUBLE_EQ(pr.temperature(), 500.0);
+    EXPECT_DOUBLE_EQ(pr.density(), rho0);
+    EXPECT_NEAR(pr.pressure(), 20e5, 1e-6);
+
+    for (size_t i = 0; i < n; i++) {
+        pr.setState_TPX(T[i], P[i], &X[i * nsp]);
+        EXPECT_NEAR(rho[i], pr.density(), 1e-12 * rho[i]);
+        EXPECT_NEAR(h[i], pr.enthalpy_mass(), 1e-12 * fabs(h[i]));
+        EXPECT_NEAR(s[i], pr.entropy_mass(), 1e-12 * fabs(s[i]));
+        EXPECT_NEAR(cp[i], pr.cp_mass(), 1e-12 * cp[i]);
+        EXPECT_NEAR(cv[i], pr.cv_mass(), 1e-12 * cv[i]);
+        EXPECT_NEAR(c[i], pr.soundSpeed(), 1e-12 * c[i]);
+    }
+
+    // All states with the same composition, and only some of the outputs
+    vector_fp rho2(n), cp2(n);
+    pr.getPropertiesBatch(n, T, P, X.data(), 0, rho2.data(), nullptr,
+                          nullptr, cp2.data(), nullptr, nullptr);
+    for (size_t i = 0; i < n; i++) {
+        pr.setState_TPX(T[i], P[i], X.data());
+        EXPECT_NEAR(rho2[i], pr.density(), 1e-12 * rho2[i]);
+        EXPECT_NEAR(cp2[i], pr.cp_mass(), 1e-12 * cp2[i]);
+    }
+}
+
+TEST_F(PengRobinsonMFTP_Test, setBinaryCoeffs)
+{
+    // Changing the coefficients after the state has been set invalidates the
+    // cached mixing sums
+    PengRobinsonMFTP& pr = dynamic_cast<PengRobinsonMFTP&>(*test_phase);
+    setMixture(400.0, 100e5);
+    double rho = pr.density();
+    double p1 = pr.pressure();
+    pr.setBinaryCoeffs("CO2", "CH4", 2.0e5);
+    pr.setState_TR(400.0, rho);
+    double p2 = pr.pressure();
+    EXPECT_GT(fabs(p2 - p1), 1e-3 * p1);
+
+    std::unique_ptr<ThermoPhase> fresh(newPhase("../data/co2_PR_example.cti"));
+    dynamic_cast<PengRobinsonMFTP&>(*fresh).setBinaryCoeffs("CO2", "CH4", 2.0e5);
+    fresh->setMoleFractionsByName("CO2:0.7, H2O:0.1, CH4:0.2");
+    fresh->setState_TR(400.0, rho);
+    EXPECT_NEAR(fresh->pressure(), p2, 1e-12 * fabs(p2));
+}
+
+};
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "cantera/thermo/PureFluidPhase.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+namespace Cantera
+{
+
+class SubstanceTable_Test : public testing::Test
+{
+public:
+    static void SetUpTestCase() {
+        PureFluidPhase* p = newWater();
+        table = std::make_shared<tpx::SubstanceTable>(p->TPX_Substance(),
+                                                      rtol);
+        delete p;
+    }
+
+    static PureFluidPhase* newWater() {
+        ThermoPhase* p = newPhase("liquidvapor.xml", "water");
+        return dynamic_cast<PureFluidPhase*>(p);
+    }
+
+    void SetUp() {
+        exact.reset(newWater());
+        fast.reset(newWater());
+        fast->useTable(table);
+    }
+
+    static const double rtol;
+    static shared_ptr<tpx::SubstanceTable> table;
+    std::unique_ptr<PureFluidPhase> exact;
+    std::unique_ptr<PureFluidPhase> fast;
+};
+
+const double SubstanceTable_Test::rtol = 1e-6;
+shared_ptr<tpx::SubstanceTable> SubstanceTable_Test::table;
+
+TEST_F(SubstanceTable_Test, accuracy)
+{
+    EXPECT_GT(table->validFraction(), 0.4);
+    for (double T = 290.0; T < 1500.0; T += 37.3) {
+        for (double logP = 3.0; logP < 7.7; logP += 0.31) {
+            double P = pow(10.0, logP);
+            exact->setState_TP(T, P);
+            fast->setState_TP(T, P);
+            double RT = GasConstant * T / exact->meanMolecularWeight();
+            double rho = exact->density();
+            double h = exact->enthalpy_mass();
+            double s = exact->entropy_mass();
+            ASSERT_NEAR(fast->density(), rho, rtol * rho);
+            EXPECT_NEAR(fast->enthalpy_mass(), h, rtol * RT);
+            EXPECT_NEAR(fast->entropy_mass(), s, rtol * RT / T);
+            EXPECT_NEAR(fast->cv_mass(), exact->cv_mass(),
+                        1e-4 * exact->cv_mass());
+            EXPECT_NEAR(fast->cp_mass(), exact->cp_mass(),
+                        1e-4 * exact->cp_mass());
+
+            fast->setState_TP(300.0, 101325.0);
+            fast->setState_HP(h, P);
+            EXPECT_NEAR(fast->temperature(), T, rtol * T);
+            fast->setState_SP(s, P);
+            EXPECT_NEAR(fast->temperature(), T, rtol * T);
+            EXPECT_NEAR(fast->density(), rho, rtol * rho);
+        }
+    }
+}
+
+TEST_F(SubstanceTable_Test, saturation)
+{
+    EXPECT_GT(table->maxSaturationTemperature(), 600.0);
+    for (double T = 280.0; T < 630.0; T += 7.1) {
+        double psat = exact->satPressure(T);
+        EXPECT_NEAR(fast->satPressure(T), psat, rtol * psat);
+
+        exact->setState_Tsat(T, 0.3);
+        fast->setState_Tsat(T, 0.3);
+        double h = exact->enthalpy_mass();
+        double RT = GasConstant * T / exact->meanMolecularWeight();
+        EXPECT_NEAR(fast->density(), exact->density(),
+                    rtol * exact->density());
+        EXPECT_NEAR(fast->enthalpy_mass(), h, rtol * RT);
+
+        // Two-phase states from (h, P)
+        fast->setState_TP(300.0, 101325.0);
+        fast->setState_HP(h, psat);
+        EXPECT_NEAR(fast->temperature(), T, rtol * T);
+        EXPECT_NEAR(fast->vaporFraction(), 0.3, 1e-5);
+    }
+}
+
+TEST_F(SubstanceTable_Test, invalid)
+{
+    std::unique_ptr<ThermoPhase> p(newPhase("liquidvapor.xml", "nitrogen"));
+    auto& nitrogen = dynamic_cast<PureFluidPhase&>(*p);
+    EXPECT_THROW(nitrogen.useTable(table), CanteraError);
+    PureFluidPhase empty;
+    EXPECT_THROW(empty.useTable(table), CanteraError);
+}
+
+}
@@ -165,4 +165,75 @@ TEST_F(RedlichKwongMFTP_Test, setTP)
         EXPECT_NEAR(test_phase->density(),p3[i],1.e-8);
     }
 }
+
+TEST_F(RedlichKwongMFTP_Test, partialMolarProperties)
+{
+    // The partial molar properties computed from the cached mixing sums
+    // should add up to the molar properties of the mixture
+    size_t nsp = test_phase->nSpecies();
+    vector_fp x(nsp), hbar(nsp), sbar(nsp), vbar(nsp);
+    for (size_t k = 0; k < nsp; k++) {
+        x[k] = 1.0 + k;
+    }
+    for (double T : {300.0, 500.0, 900.0}) {
+        for (double P : {1e5, 5e6, 3e7}) {
+            x[2] *= 1.5;
+            test_phase->setState_TPX(T, P, x.data());
+            test_phase->getMoleFractions(x.data());
+            test_phase->getPartialMolarEnthalpies(hbar.data());
+            test_phase->getPartialMolarEntropies(sbar.data());
+            test_phase->getPartialMolarVolumes(vbar.data());
+            double h = 0.0, s = 0.0, v = 0.0;
+            for (size_t k = 0; k < nsp; k++) {
+                h += x[k] * hbar[k];
+                s += x[k] * sbar[k];
+                v += x[k] * vbar[k];
+            }
+            double hmix = test_phase->enthalpy_mole();
+            double smix = test_phase->entropy_mole();
+            double vmix = test_phase->molarVolume();
+            EXPECT_NEAR(h, hmix, 1e-9 * std::abs(hmix)) << T << " " << P;
+            EXPECT_NEAR(s, smix, 1e-9 * std::abs(smix)) << T << " " << P;
+            EXPECT_NEAR(v, vmix, 1e-9 * vmix) << T << " " << P;
+        }
+    }
+}
+
+TEST_F(RedlichKwongMFTP_Test, setBinaryCoeffs)
+{
+    // Changing the coefficients takes effect at the next state change, even
+    // if the composition is unchanged
+    RedlichKwongMFTP& rk = dynamic_cast<RedlichKwongMFTP&>(*test_phase);
+    set_r(0.5);
+    test_phase->setState_TP(300, 5e6);
+    double rho1 = test_phase->density();
+    rk.setBinaryCoeffs("CO2", "H2", 5e11, 0.0);
+    test_phase->setState_TP(300, 5e6);
+    double rho2 = test_phase->density();
+    EXPECT_GT(std::abs(rho2 / rho1 - 1), 1e-3);
+
+    std::unique_ptr<ThermoPhase> fresh(newPhase("../data/co2_RK_example.cti"));
+    dynamic_cast<RedlichKwongMFTP&>(*fresh).setBinaryCoeffs("CO2", "H2", 5e11, 0.0);
+    fresh->setMoleFractionsByName("CO2:0.5, H2:0.5");
+    fresh->setState_TP(300, 5e6);
+    EXPECT_NEAR(fresh->density(), rho2, 1e-12 * rho2);
+}
+
+TEST_F(RedlichKwongMFTP_Test, densityFromPreviousState)
+{
+    // The density does not depend on the previous state, which is used as
+    // the starting point for solving the cubic. Each state is compared with
+    // a new phase object, for which the density is solved from a cold start.
+    set_r(0.9);
+    for (double T : {250.0, 320.0, 600.0}) {
+        for (double P : {1e5, 2e6, 8e6, 4e7}) {
+            test_phase->setState_TP(T, P);
+            std::unique_ptr<ThermoPhase> fresh(
+                newPhase("../data/co2_RK_example.cti"));
+            fresh->setState_TPX(T, P, "CO2:0.9, H2:0.1");
+            EXPECT_NEAR(test_phase->density(), fresh->density(),
+                        1e-12 * fresh->density()) << T << " " << P;
+        }
+    }
+}
 };
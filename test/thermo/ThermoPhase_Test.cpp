@@ -98,4 +98,55 @@ TEST_F(TestThermoMethods, setState_nan)
     EXPECT_THROW(thermo->setState_TR(555, nan), CanteraError);
 }
 
+
+TEST_F(TestThermoMethods, setState_HP_UV_SP_SV)
+{
+    thermo->setState_TPX(1500, 2e5, "H2:2.0, O2:1.0, AR:4.0");
+    double h = thermo->enthalpy_mass();
+    double u = thermo->intEnergy_mass();
+    double s = thermo->entropy_mass();
+    double v = 1.0 / thermo->density();
+
+    thermo->setState_TP(300, OneAtm);
+    thermo->setState_HP(h, 2e5);
+    EXPECT_NEAR(thermo->temperature(), 1500, 1e-8);
+    thermo->setState_TP(3000, OneAtm);
+    thermo->setState_UV(u, v);
+    EXPECT_NEAR(thermo->temperature(), 1500, 1e-8);
+    thermo->setState_TP(400, OneAtm);
+    thermo->setState_SP(s, 2e5);
+    EXPECT_NEAR(thermo->temperature(), 1500, 1e-8);
+    thermo->setState_TP(2500, OneAtm);
+    thermo->setState_SV(s, v);
+    EXPECT_NEAR(thermo->temperature(), 1500, 1e-8);
+    EXPECT_NEAR(thermo->pressure(), 2e5, 1e-6);
+}
+
+TEST_F(TestThermoMethods, solveTemperature)
+{
+    thermo->setState_TPX(1200, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+    double u = thermo->intEnergy_mass();
+    thermo->setState_TP(1210, OneAtm);
+    thermo->resetTemperatureStats();
+
+    // Starting close to the solution, Newton's method converges in a few
+    // iterations
+    EXPECT_TRUE(thermo->solveTemperature(u, 1e-14, true, false));
+    EXPECT_NEAR(thermo->temperature(), 1200, 1e-9);
+    EXPECT_EQ(thermo->nTemperatureSolves(), (size_t) 1);
+    EXPECT_LE(thermo->nTemperatureEvals(), (size_t) 4);
+    EXPECT_EQ(thermo->nTemperatureFailures(), (size_t) 0);
+
+    // Failure leaves the temperature unchanged
+    thermo->setState_TP(1210, OneAtm);
+    EXPECT_FALSE(thermo->solveTemperature(u, 1e-14, true, false, 1));
+    EXPECT_DOUBLE_EQ(thermo->temperature(), 1210);
+    EXPECT_EQ(thermo->nTemperatureSolves(), (size_t) 2);
+    EXPECT_EQ(thermo->nTemperatureFailures(), (size_t) 1);
+
+    thermo->resetTemperatureStats();
+    EXPECT_EQ(thermo->nTemperatureSolves(), (size_t) 0);
+    EXPECT_EQ(thermo->nTemperatureEvals(), (size_t) 0);
+}
+
 }
@@ -704,6 +704,151 @@ TEST(HMWSoln, fromScratch_HKFT)
     }
 }
 
+// Builds a seawater-like brine with an additional 'nSpectators' solute ions
+// which have no interaction parameters
+static void make_hmw_brine(HMWSoln& p, size_t nSpectators)
+{
+    auto sH2O = make_species("H2O(l)", "H:2, O:1", h2oliq_nasa_coeffs);
+    p.addSpecies(sH2O);
+    std::vector<std::pair<std::string, int>> solutes = {
+        {"Na+", 1}, {"K+", 1}, {"Mg+2", 2}, {"Ca+2", 2}, {"H+", 1},
+        {"Cl-", -1}, {"SO4-2", -2}, {"HCO3-", -1}, {"CO3-2", -2},
+        {"OH-", -1}, {"CO2(aq)", 0}};
+    for (size_t n = 0; n < nSpectators; n++) {
+        int z = (n % 2) ? -1 - int(n % 4 / 2) : 1 + int(n % 4 / 2);
+        solutes.emplace_back(fmt::format("X{}", n), z);
+    }
+    for (auto& s : solutes) {
+        auto sp = make_species(s.first, fmt::format("H:1, E:{}", -s.second),
+                               0.0, 298.15, -100.0, 333.15, -100.0, 1e5);
+        sp->charge = s.second;
+        p.addSpecies(sp);
+    }
+    std::unique_ptr<PDSS_Water> ss(new PDSS_Water());
+    p.installPDSS(0, std::move(ss));
+    for (size_t k = 1; k < p.nSpecies(); k++) {
+        std::unique_ptr<PDSS_ConstVol> ss(new PDSS_ConstVol());
+        ss->setMolarVolume(0.02);
+        p.installPDSS(k, std::move(ss));
+    }
+    p.setPitzerTempModel("complex");
+    p.setA_Debye(1.175930);
+    p.initThermo();
+
+    auto salt = [&](const char* M, const char* X, double b0, double b1,
+                    double b2, double cphi, double a1, double a2) {
+        double beta0[] = {b0, 1e-3, -1e-6, 0.0, 0.0};
+        double beta1[] = {b1, 2e-3, 0.0, 0.0, 0.0};
+        double beta2[] = {b2, 0.1, 0.0, 0.0, 0.0};
+        double Cphi[] = {cphi, -2e-5, 0.0, 1.0, 0.0};
+        p.setBinarySalt(M, X, 5, beta0, beta1, beta2, Cphi, a1, a2);
+    };
+    salt("Na+", "Cl-", 0.0765, 0.2664, 0.0, 0.00127, 2.0, 0.0);
+    salt("K+", "Cl-", 0.04835, 0.2122, 0.0, -0.00084, 2.0, 0.0);
+    salt("Mg+2", "Cl-", 0.35235, 1.6815, 0.0, 0.00519, 2.0, 0.0);
+    salt("Ca+2", "Cl-", 0.3159, 1.614, 0.0, -0.00034, 2.0, 0.0);
+    salt("H+", "Cl-", 0.1775, 0.2945, 0.0, 0.0008, 2.0, 0.0);
+    salt("Na+", "SO4-2", 0.01958, 1.113, 0.0, 0.00497, 2.0, 0.0);
+    salt("K+", "SO4-2", 0.04995, 0.7793, 0.0, 0.0, 2.0, 0.0);
+    salt("Mg+2", "SO4-2", 0.221, 3.343, -37.23, 0.025, 1.4, 12.0);
+    salt("Ca+2", "SO4-2", 0.2, 3.1973, -54.24, 0.0, 1.4, 12.0);
+    salt("Na+", "HCO3-", 0.0277, 0.0411, 0.0, 0.0, 2.0, 0.0);
+    salt("Na+", "CO3-2", 0.0399, 1.389, 0.0, 0.0044, 2.0, 0.0);
+    salt("Na+", "OH-", 0.0864, 0.253, 0.0, 0.0044, 2.0, 0.0);
+
+    auto theta = [&](const char* a, const char* b, double t0) {
+        double theta[] = {t0, 1e-4, 0.0, 0.0, 0.0};
+        p.setTheta(a, b, 5, theta);
+    };
+    theta("Na+", "K+", -0.012);
+    theta("Na+", "Mg+2", 0.07);
+    theta("Na+", "Ca+2", 0.07);
+    theta("Mg+2", "Ca+2", 0.007);
+    theta("Na+", "H+", 0.036);
+    theta("Cl-", "SO4-2", 0.02);
+    theta("Cl-", "HCO3-", 0.03);
+    theta("Cl-", "OH-", -0.05);
+
+    auto psi = [&](const char* a, const char* b, const char* c, double p0) {
+        double psi[] = {p0, 2e-5, 0.0, 0.0, 0.0};
+        p.setPsi(a, b, c, 5, psi);
+    };
+    psi("Na+", "K+", "Cl-", -0.0018);
+    psi("Na+", "Mg+2", "Cl-", -0.012);
+    psi("Na+", "Ca+2", "Cl-", -0.007);
+    psi("Na+", "Cl-", "SO4-2", 0.0014);
+    psi("Mg+2", "Cl-", "SO4-2", -0.004);
+    psi("Na+", "Cl-", "OH-", -0.006);
+
+    double lambdaNa[] = {0.1, 1e-4, 0.0, 0.0, 0.0};
+    double lambdaSO4[] = {0.097, 0.0, 0.0, 0.0, 0.0};
+    double lambdaCO2[] = {-0.02, 1e-4, 0.0, 0.0, 0.0};
+    double zeta[] = {-0.002, 3e-5, 0.0, 0.0, 0.0};
+    double mu[] = {0.001, 1e-5, 0.0, 0.0, 0.0};
+    p.setLambda("CO2(aq)", "Na+", 5, lambdaNa);
+    p.setLambda("CO2(aq)", "SO4-2", 5, lambdaSO4);
+    p.setLambda("CO2(aq)", "CO2(aq)", 5, lambdaCO2);
+    p.setZeta("CO2(aq)", "Na+", "Cl-", 5, zeta);
+    p.setMunnn("CO2(aq)", 5, mu);
+
+    std::string molalities = "Na+:0.49 K+:0.0106 Mg+2:0.0557 Ca+2:0.0107 "
+        "H+:1e-8 Cl-:0.571 SO4-2:0.0293 HCO3-:0.0018 CO3-2:0.0002 "
+        "OH-:1e-6 CO2(aq):0.02";
+    for (size_t n = 0; n < nSpectators; n++) {
+        molalities += fmt::format(" X{}:1e-4", n);
+    }
+    p.setMolalitiesByName(molalities);
+}
+
+TEST(HMWSoln, multiSaltBrine)
+{
+    HMWSoln p;
+    make_hmw_brine(p, 0);
+    double T = 323.15, dT = 1e-3, P = 2e5, dP = 1e2;
+    p.setState_TP(T, P);
+
+    size_t N = p.nSpecies();
+    vector_fp acMol(N), m(N), h(N), cp(N), v(N);
+    p.getMolalityActivityCoefficients(acMol.data());
+    p.getMolalities(m.data());
+    p.getPartialMolarEnthalpies(h.data());
+    p.getPartialMolarCp(cp.data());
+    p.getPartialMolarVolumes(v.data());
+
+    double acMolRef[] = {1.0015355025, 0.6585039205, 0.6061139762,
+        0.2094836383, 0.1910400732, 0.7460475493, 0.7077603289, 0.1086577227,
+        0.5683661672, 0.1013643053, 0.5904630579, 1.1104433020};
+    for (size_t k = 0; k < N; k++) {
+        EXPECT_NEAR(acMol[k], acMolRef[k], 1e-9) << p.speciesName(k);
+    }
+
+    // Check the temperature and pressure derivatives of the activity
+    // coefficients against finite differences of the chemical potentials
+    vector_fp muTp(N), muTm(N), muPp(N), muPm(N), hp(N), hm(N);
+    p.setState_TP(T + dT, P);
+    p.setMolalities(m.data());
+    p.getChemPotentials(muTp.data());
+    p.getPartialMolarEnthalpies(hp.data());
+    p.setState_TP(T - dT, P);
+    p.setMolalities(m.data());
+    p.getChemPotentials(muTm.data());
+    p.getPartialMolarEnthalpies(hm.data());
+    p.setState_TP(T, P + dP);
+    p.setMolalities(m.data());
+    p.getChemPotentials(muPp.data());
+    p.setState_TP(T, P - dP);
+    p.setMolalities(m.data());
+    p.getChemPotentials(muPm.data());
+    for (size_t k = 0; k < N; k++) {
+        double hfd = - T * T * (muTp[k] / (T + dT) - muTm[k] / (T - dT)) / (2 * dT);
+        EXPECT_NEAR(h[k], hfd, 1e-8 * std::abs(hfd) + 10.0) << p.speciesName(k);
+        double cpfd = (hp[k] - hm[k]) / (2 * dT);
+        EXPECT_NEAR(cp[k], cpfd, 1e-5 * std::abs(cpfd) + 0.1) << p.speciesName(k);
+        double vfd = (muPp[k] - muPm[k]) / (2 * dP);
+        EXPECT_NEAR(v[k], vfd, 1e-5 * std::abs(vfd) + 1e-8) << p.speciesName(k);
+    }
+}
+
 TEST(PDSS_SSVol, fromScratch)
 {
     // Regression test based on comparison with using XML input file
@@ -141,3 +141,81 @@ TEST_F(WaterPropsIAPWS_Test, expansion_coeffs)
                     beta_num[i], 2e-10 * beta_num[i]);
     }
 }
+
+class WaterPropsIAPWSTable_Test : public testing::Test
+{
+public:
+    static void SetUpTestCase() {
+        table = std::make_shared<WaterPropsIAPWSTable>(rtol);
+    }
+
+    void SetUp() {
+        fast.useTable(table);
+    }
+
+    static const double rtol;
+    static shared_ptr<WaterPropsIAPWSTable> table;
+    WaterPropsIAPWS exact;
+    WaterPropsIAPWS fast;
+};
+
+const double WaterPropsIAPWSTable_Test::rtol = 1e-6;
+shared_ptr<WaterPropsIAPWSTable> WaterPropsIAPWSTable_Test::table;
+
+TEST_F(WaterPropsIAPWSTable_Test, accuracy)
+{
+    EXPECT_GT(table->validFraction(), 0.4);
+    const double R = 8.314371E3;
+    for (double T = 275.0; T < 1270.0; T += 17.3) {
+        for (double logP = 3.0; logP < 8.0; logP += 0.23) {
+            double P = pow(10.0, logP);
+            int phase = (T < 647.0 && P > exact.psat_est(T)) ? WATER_LIQUID
+                                                               : WATER_GAS;
+            double rho = exact.density(T, P, phase);
+            ASSERT_GT(rho, 0.0);
+            ASSERT_NEAR(fast.density(T, P, phase), rho, rtol * rho);
+            EXPECT_NEAR(fast.enthalpy(), exact.enthalpy(), rtol * R * T);
+            EXPECT_NEAR(fast.entropy(), exact.entropy(), rtol * R);
+            EXPECT_NEAR(fast.Gibbs(), exact.Gibbs(), rtol * R * T);
+            EXPECT_NEAR(fast.cv(), exact.cv(), rtol * exact.cv());
+            EXPECT_NEAR(fast.cp(), exact.cp(), rtol * exact.cp());
+            EXPECT_NEAR(fast.pressure(), P, 1e-7 * P);
+        }
+    }
+}
+
+TEST_F(WaterPropsIAPWSTable_Test, saturation)
+{
+    EXPECT_GT(table->maxSaturationTemperature(), 600.0);
+    for (double T = 273.16; T < 640.0; T += 7.1) {
+        double psat = exact.psat(T, WATER_LIQUID);
+        double rhoLiq = exact.density();
+        double rhoGas = exact.density(T, psat, WATER_GAS);
+        EXPECT_NEAR(fast.psat(T, WATER_LIQUID), psat, rtol * psat);
+        EXPECT_NEAR(fast.density(), rhoLiq, rtol * rhoLiq);
+        EXPECT_NEAR(fast.psat(T, WATER_GAS), psat, rtol * psat);
+        EXPECT_NEAR(fast.density(), rhoGas, rtol * rhoGas);
+    }
+}
+
+TEST_F(WaterPropsIAPWSTable_Test, exact_fallback)
+{
+    // Near the critical point, and outside of the table, the exact
+    // formulation is used
+    double r[6];
+    for (auto& TR : std::vector<std::pair<double, double>>{
+             {647.0, 330.0}, {260.0, 998.0}, {1500.0, 10.0}, {500.0, 1300.0}}) {
+        EXPECT_FALSE(table->evalResidual(647.096 / TR.first, TR.second / 322.0, r));
+        exact.setState_TR(TR.first, TR.second);
+        fast.setState_TR(TR.first, TR.second);
+        EXPECT_DOUBLE_EQ(fast.pressure(), exact.pressure());
+        EXPECT_DOUBLE_EQ(fast.cp(), exact.cp());
+        EXPECT_DOUBLE_EQ(fast.enthalpy(), exact.enthalpy());
+    }
+
+    // Removing the table restores the exact formulation everywhere
+    fast.useTable(shared_ptr<WaterPropsIAPWSTable>());
+    fast.setState_TR(400.0, 900.0);
+    exact.setState_TR(400.0, 900.0);
+    EXPECT_DOUBLE_EQ(fast.pressure(), exact.pressure());
+}
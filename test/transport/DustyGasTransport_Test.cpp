@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+
+#include "cantera/transport/DustyGasTransport.h"
+#include "cantera/transport/TransportFactory.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+using namespace Cantera;
+
+class DustyGasTransportTest : public testing::Test
+{
+public:
+    DustyGasTransportTest() {
+        gas.reset(newPhase("h2o2.xml"));
+        nsp = gas->nSpecies();
+        tran.reset(makeTransport());
+
+        gas->setState_TPX(500.0, OneAtm, "O2:2.0, H2:1.001, H2O:0.999");
+        state2 = getState();
+        gas->setState_TPX(500.0, OneAtm, "O2:2.0, H2:1.0, H2O:1.0");
+        state1 = getState();
+    }
+
+    DustyGasTransport* makeTransport() {
+        auto tr = dynamic_cast<DustyGasTransport*>(
+            newTransportMgr("DustyGas", gas.get()));
+        tr->setPorosity(0.2);
+        tr->setTortuosity(0.3);
+        tr->setMeanPoreRadius(1e-4);
+        tr->setMeanParticleDiameter(5e-4);
+        return tr;
+    }
+
+    vector_fp getState() {
+        vector_fp state(nsp + 2);
+        state[0] = gas->temperature();
+        state[1] = gas->density();
+        gas->getMassFractions(&state[2]);
+        return state;
+    }
+
+    std::unique_ptr<ThermoPhase> gas;
+    std::unique_ptr<DustyGasTransport> tran;
+    size_t nsp;
+    vector_fp state1, state2;
+};
+
+TEST_F(DustyGasTransportTest, multi_diff_coeffs)
+{
+    vector_fp Dref(nsp * nsp), D(nsp * nsp);
+    tran->getMultiDiffCoeffs(nsp, Dref.data());
+    tran->setPorosity(0.4);
+    tran->getMultiDiffCoeffs(nsp, D.data());
+    for (size_t i = 0; i < nsp * nsp; i++) {
+        EXPECT_NEAR(D[i], 2 * Dref[i], 1e-12 * fabs(Dref[i]));
+    }
+    tran->setTortuosity(0.6);
+    tran->getMultiDiffCoeffs(nsp, D.data());
+    for (size_t i = 0; i < nsp * nsp; i++) {
+        EXPECT_NEAR(D[i], Dref[i], 1e-12 * fabs(Dref[i]));
+    }
+}
+
+TEST_F(DustyGasTransportTest, molar_fluxes)
+{
+    vector_fp fluxes(nsp), fluxes2(nsp);
+    tran->getMolarFluxes(state1.data(), state1.data(), 1e-4, fluxes.data());
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_NEAR(fluxes[k], 0.0, 1e-15);
+    }
+
+    tran->getMolarFluxes(state1.data(), state2.data(), 1e-4, fluxes.data());
+    EXPECT_LT(fluxes[gas->speciesIndex("H2")], 0.0);
+    EXPECT_GT(fluxes[gas->speciesIndex("H2O")], 0.0);
+
+    // Fluxes are the product of the multicomponent diffusion coefficients
+    // and the gradients of the concentrations, if there is no pressure
+    // gradient
+    vector_fp D(nsp * nsp), gradc(nsp);
+    tran->getMultiDiffCoeffs(nsp, D.data());
+    for (size_t k = 0; k < nsp; k++) {
+        gradc[k] = (state2[1] * state2[k+2] - state1[1] * state1[k+2])
+                   / gas->molecularWeight(k) / 1e-4;
+    }
+    for (size_t k = 0; k < nsp; k++) {
+        double J = 0.0;
+        for (size_t j = 0; j < nsp; j++) {
+            J -= D[nsp*j + k] * gradc[j];
+        }
+        EXPECT_NEAR(fluxes[k], J, 1e-8 * fabs(fluxes[0]));
+    }
+
+    // Changing the parameters of the porous medium invalidates the stored
+    // factorization
+    tran->setMeanPoreRadius(2e-4);
+    tran->getMolarFluxes(state1.data(), state2.data(), 1e-4, fluxes.data());
+    std::unique_ptr<DustyGasTransport> fresh(makeTransport());
+    fresh->setMeanPoreRadius(2e-4);
+    fresh->getMolarFluxes(state1.data(), state2.data(), 1e-4,
+                          fluxes2.data());
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_DOUBLE_EQ(fluxes[k], fluxes2[k]);
+    }
+}
+
+TEST_F(DustyGasTransportTest, molar_fluxes_batch)
+{
+    // Three control volume faces, two of which have the same mean state
+    size_t n = 3;
+    vector_fp states1, states2;
+    double delta[] = {1e-4, 2e-4, 1e-4};
+    for (const vector_fp* s : {&state1, &state2, &state1}) {
+        states1.insert(states1.end(), s->begin(), s->end());
+    }
+    for (const vector_fp* s : {&state2, &state1, &state2}) {
+        states2.insert(states2.end(), s->begin(), s->end());
+    }
+    states2[0] = 510.0;
+    states2[(nsp + 2) * 2] = 510.0;
+
+    vector_fp fluxes(n * nsp), fluxes2(nsp);
+    tran->getMolarFluxesBatch(n, states1.data(), states2.data(), delta,
+                              fluxes.data());
+    std::unique_ptr<DustyGasTransport> ref(makeTransport());
+    for (size_t i = 0; i < n; i++) {
+        ref->getMolarFluxes(&states1[i * (nsp + 2)], &states2[i * (nsp + 2)],
+                            delta[i], fluxes2.data());
+        for (size_t k = 0; k < nsp; k++) {
+            EXPECT_DOUBLE_EQ(fluxes[i * nsp + k], fluxes2[k]);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+
+#include "cantera/transport/HighPressureGasTransport.h"
+#include "cantera/transport/TransportFactory.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+using namespace Cantera;
+
+class HighPressureGasTransportTest : public testing::Test
+{
+public:
+    HighPressureGasTransportTest() {
+        gas.reset(newPhase("../data/co2_RK_example.cti"));
+        gas->setState_TPX(900, 5e6, "CO2:0.7, H2O:0.2, CH4:0.1");
+        tran.reset(newTransportMgr("HighP", gas.get()));
+    }
+
+    std::unique_ptr<ThermoPhase> gas;
+    std::unique_ptr<Transport> tran;
+};
+
+TEST_F(HighPressureGasTransportTest, supercritical_mixture)
+{
+    EXPECT_NEAR(tran->viscosity(), 3.491445177709297e-05, 1e-15);
+    EXPECT_NEAR(tran->thermalConductivity(), 7.802171696646418e-02, 1e-12);
+
+    size_t nsp = gas->nSpecies();
+    vector_fp d(nsp * nsp);
+    tran->getBinaryDiffCoeffs(nsp, d.data());
+    EXPECT_NEAR(d[1], 2.732663545761483e-06, 1e-17);
+    for (size_t i = 0; i < nsp; i++) {
+        for (size_t j = 0; j < nsp; j++) {
+            EXPECT_GT(d[nsp*j + i], 0.0);
+        }
+    }
+}
+
+TEST_F(HighPressureGasTransportTest, composition_change)
+{
+    // Cached mixture properties are updated when the composition changes
+    double mu1 = tran->viscosity();
+    double k1 = tran->thermalConductivity();
+    gas->setState_TPX(900, 5e6, "H2:0.3, O2:0.2, N2:0.4, CO:0.1");
+    std::unique_ptr<Transport> fresh(newTransportMgr("HighP", gas.get()));
+    EXPECT_DOUBLE_EQ(tran->viscosity(), fresh->viscosity());
+    EXPECT_DOUBLE_EQ(tran->thermalConductivity(),
+                     fresh->thermalConductivity());
+    EXPECT_GT(fabs(tran->viscosity() - mu1), 1e-3 * mu1);
+    EXPECT_GT(fabs(tran->thermalConductivity() - k1), 1e-3 * k1);
+
+    size_t nsp = gas->nSpecies();
+    vector_fp d1(nsp * nsp), d2(nsp * nsp);
+    tran->getBinaryDiffCoeffs(nsp, d1.data());
+    fresh->getBinaryDiffCoeffs(nsp, d2.data());
+    for (size_t k = 0; k < nsp * nsp; k++) {
+        EXPECT_DOUBLE_EQ(d1[k], d2[k]);
+    }
+}
+
+TEST_F(HighPressureGasTransportTest, batch)
+{
+    auto& hp = dynamic_cast<HighPressureGasTransport&>(*tran);
+    size_t nsp = gas->nSpecies();
+    double T[] = {600.0, 900.0, 1500.0};
+    double P[] = {1e6, 5e6, 2e7};
+    vector_fp X(3 * nsp, 0.0);
+    X[gas->speciesIndex("CO2")] = 1.0;
+    X[nsp + gas->speciesIndex("CO2")] = 0.5;
+    X[nsp + gas->speciesIndex("H2")] = 0.5;
+    X[2 * nsp + gas->speciesIndex("N2")] = 0.8;
+    X[2 * nsp + gas->speciesIndex("O2")] = 0.2;
+
+    double Tsave = gas->temperature();
+    double Psave = gas->pressure();
+    double visc[3], cond[3];
+    for (size_t ldX : {size_t(0), nsp}) {
+        hp.getPropertiesBatch(3, T, P, X.data(), ldX, visc, cond);
+        EXPECT_DOUBLE_EQ(gas->temperature(), Tsave);
+        EXPECT_DOUBLE_EQ(gas->pressure(), Psave);
+
+        std::unique_ptr<ThermoPhase> ref(
+            newPhase("../data/co2_RK_example.cti"));
+        std::unique_ptr<Transport> refTran(
+            newTransportMgr("HighP", ref.get()));
+        for (size_t n = 0; n < 3; n++) {
+            ref->setMoleFractions(X.data() + n * ldX);
+            ref->setState_TP(T[n], P[n]);
+            EXPECT_DOUBLE_EQ(visc[n], refTran->viscosity());
+            EXPECT_DOUBLE_EQ(cond[n], refTran->thermalConductivity());
+        }
+    }
+}
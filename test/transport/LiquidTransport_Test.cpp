@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include "cantera/transport/LiquidTransport.h"
+#include "cantera/transport/TransportFactory.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+using namespace Cantera;
+
+class LiquidTransportTest : public testing::Test
+{
+public:
+    LiquidTransportTest() {
+        melt.reset(newPhase("LiKCl_liquid_transport.xml", "LiKCl_liquid"));
+        tran.reset(newTransportMgr("Liquid", melt.get()));
+        nsp = melt->nSpecies();
+        iLi = melt->speciesIndex("LiCl(L)");
+        iK = melt->speciesIndex("KCl(L)");
+    }
+
+    std::unique_ptr<ThermoPhase> melt;
+    std::unique_ptr<Transport> tran;
+    size_t nsp, iLi, iK;
+};
+
+TEST_F(LiquidTransportTest, mixture_properties)
+{
+    for (double T = 800.0; T < 1200.0; T += 130.0) {
+        melt->setState_TPX(T, OneAtm, "LiCl(L):0.6, KCl(L):0.4");
+        double xLi = melt->moleFraction(iLi);
+        double xK = melt->moleFraction(iK);
+        double yLi = melt->massFraction(iLi);
+        double yK = melt->massFraction(iK);
+
+        // Viscosity: Arrhenius and constant, log mole fraction mixing
+        double muLi = 1.2e-4 * exp(1.5e7 / (GasConstant * T));
+        double mu = exp(xLi * log(muLi) + xK * log(1.1e-3));
+        EXPECT_NEAR(tran->viscosity(), mu, 1e-13 * mu);
+
+        // Ionic conductivity: polynomial and Arrhenius, mole fraction mixing
+        double kLi = 100.0 + 0.5 * T + 1e-4 * T * T;
+        double kK = 1.5e3 * exp(-1.7e7 / (GasConstant * T));
+        double k = xLi * kLi + xK * kK;
+        EXPECT_NEAR(tran->ionConductivity(), k, 1e-13 * k);
+
+        // Thermal conductivity: exponential and polynomial, mass fraction
+        // mixing
+        double lambda = yLi * 0.4 * exp(2e-4 * T) + yK * (0.3 + 1e-4 * T);
+        EXPECT_NEAR(tran->thermalConductivity(), lambda, 1e-13 * lambda);
+
+        vector_fp radius(nsp);
+        auto& liquid = dynamic_cast<LiquidTransport&>(*tran);
+        liquid.getSpeciesHydrodynamicRadius(radius.data());
+        EXPECT_DOUBLE_EQ(radius[iLi], 1.2e-10);
+        EXPECT_DOUBLE_EQ(radius[iK], 1.6e-10);
+    }
+}
+
+TEST_F(LiquidTransportTest, state_changes)
+{
+    // Properties are evaluated lazily, in any order, and updated when the
+    // state changes
+    melt->setState_TPX(900.0, OneAtm, "LiCl(L):0.6, KCl(L):0.4");
+    double k1 = tran->ionConductivity();
+    double mu1 = tran->viscosity();
+    melt->setState_TPX(1000.0, OneAtm, "LiCl(L):0.3, KCl(L):0.7");
+    std::unique_ptr<Transport> fresh(newTransportMgr("Liquid", melt.get()));
+    EXPECT_DOUBLE_EQ(tran->viscosity(), fresh->viscosity());
+    EXPECT_DOUBLE_EQ(tran->ionConductivity(), fresh->ionConductivity());
+    EXPECT_DOUBLE_EQ(tran->thermalConductivity(),
+                     fresh->thermalConductivity());
+    EXPECT_GT(fabs(tran->viscosity() - mu1), 1e-3 * mu1);
+    EXPECT_GT(fabs(tran->ionConductivity() - k1), 1e-3 * k1);
+
+    melt->setState_TPX(900.0, OneAtm, "LiCl(L):0.6, KCl(L):0.4");
+    EXPECT_DOUBLE_EQ(tran->ionConductivity(), k1);
+    EXPECT_DOUBLE_EQ(tran->viscosity(), mu1);
+}
+
+TEST_F(LiquidTransportTest, fluxes)
+{
+    melt->setState_TPX(900.0, OneAtm, "LiCl(L):0.6, KCl(L):0.4");
+    double gradT = 0.0;
+    vector_fp gradX(nsp), V1(nsp), V2(nsp), V3(nsp);
+    gradX[iLi] = 10.0;
+    gradX[iK] = -10.0;
+    tran->getSpeciesVdiff(1, &gradT, nsp, gradX.data(), nsp, V1.data());
+
+    // Diffusion velocities are relative to the mole-averaged velocity, and
+    // down the gradient
+    EXPECT_NEAR(0.6 * V1[iLi] + 0.4 * V1[iK], 0.0, 1e-12 * fabs(V1[iLi]));
+    EXPECT_LT(V1[iLi], 0.0);
+    EXPECT_GT(V1[iK], 0.0);
+
+    // Changing the gradient or the state invalidates the stored solution
+    gradX[iLi] = 20.0;
+    gradX[iK] = -20.0;
+    tran->getSpeciesVdiff(1, &gradT, nsp, gradX.data(), nsp, V2.data());
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_NEAR(V2[k], 2 * V1[k], 1e-12 * fabs(V1[k]));
+    }
+    melt->setState_TP(1000.0, OneAtm);
+    tran->getSpeciesVdiff(1, &gradT, nsp, gradX.data(), nsp, V3.data());
+    std::unique_ptr<Transport> fresh(newTransportMgr("Liquid", melt.get()));
+    fresh->getSpeciesVdiff(1, &gradT, nsp, gradX.data(), nsp, V2.data());
+    for (size_t k = 0; k < nsp; k++) {
+        EXPECT_DOUBLE_EQ(V3[k], V2[k]);
+    }
+    EXPECT_GT(fabs(V3[iLi]), 2.1 * fabs(V1[iLi]));
+}
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "cantera/zeroD/Reactor.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/base/global.h"
+
+using namespace Cantera;
+
+// The state vector of a Reactor is [mass, volume, internal energy, mass
+// fractions]. These tests set the internal energy directly and check the
+// temperature found by updateState().
+
+TEST(ReactorUpdateState, NewtonIteration)
+{
+    IdealGasMix gas("h2o2.xml", "ohmech");
+    gas.setState_TPX(1200, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+    double rho = gas.density();
+    Reactor reactor;
+    reactor.insert(gas);
+    reactor.setInitialVolume(0.5);
+    reactor.initialize();
+    vector_fp y(reactor.neq());
+    reactor.getState(y.data());
+
+    // A small change of the internal energy, as between two evaluations of
+    // the right-hand side during time integration
+    gas.setState_TR(1210, rho);
+    y[2] = gas.intEnergy_mass() * y[0];
+    gas.setState_TR(1200, rho);
+    gas.resetTemperatureStats();
+    reactor.updateState(y.data());
+    EXPECT_NEAR(reactor.temperature(), 1210, 1e-8);
+    EXPECT_NEAR(reactor.density(), rho, 1e-12 * rho);
+    EXPECT_EQ(gas.nTemperatureSolves(), (size_t) 1);
+    EXPECT_LE(gas.nTemperatureEvals(), (size_t) 4);
+    EXPECT_EQ(gas.nTemperatureFailures(), (size_t) 0);
+}
+
+TEST(ReactorUpdateState, BracketingNearMinTemp)
+{
+    // The Newton iteration for liquid water steps below the triple point,
+    // where the phase can't be evaluated, so the temperature is found by
+    // bracketing instead
+    std::unique_ptr<ThermoPhase> water(newPhase("liquidvapor.xml", "water"));
+    double Tmin = water->minTemp();
+    water->setState_TR(400, 990);
+    Reactor reactor;
+    reactor.setThermoMgr(*water);
+    reactor.setInitialVolume(1e-3);
+    reactor.initialize();
+    vector_fp y(reactor.neq());
+    reactor.getState(y.data());
+
+    water->setState_TR(Tmin + 1.0, 990);
+    y[2] = water->intEnergy_mass() * y[0];
+    water->setState_TR(400, 990);
+    water->resetTemperatureStats();
+    reactor.updateState(y.data());
+    EXPECT_NEAR(reactor.temperature(), Tmin + 1.0, 1e-5);
+    EXPECT_EQ(water->nTemperatureFailures(), (size_t) 1);
+    EXPECT_DOUBLE_EQ(reactor.density(), 990);
+
+    // Energies below that of the triple point can't be matched at all
+    water->setState_TR(Tmin, 990);
+    y[2] = (water->intEnergy_mass() - 1e4) * y[0];
+    EXPECT_THROW(reactor.updateState(y.data()), CanteraError);
+}
+
+int main(int argc, char** argv)
+{
+    printf("Running main() from test_zeroD.cpp\n");
+    testing::InitGoogleTest(&argc, argv);
+    make_deprecation_warnings_fatal();
+    int result = RUN_ALL_TESTS();
+    appdelete();
+    return result;
+}